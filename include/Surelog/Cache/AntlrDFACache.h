@@ -0,0 +1,58 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_ANTLRDFACACHE_H
+#define SURELOG_ANTLRDFACACHE_H
+#pragma once
+
+#include <Surelog/Cache/AntlrDFACache.capnp.h>
+#include <Surelog/Cache/Cache.h>
+#include <Surelog/Common/PathId.h>
+
+#include <cstddef>
+
+namespace SURELOG {
+
+class Session;
+
+// Persists the decision DFAs that ANTLR builds while parsing with
+// SV3_1aParser and SV3_1aPpParser, so that a new process starts with warm
+// prediction caches. A grammar's DFAs are only restored if the hash of its
+// ATN and token vocabulary matches the one they were saved with.
+class AntlrDFACache final : Cache {
+ public:
+  explicit AntlrDFACache(Session* session);
+  AntlrDFACache(const AntlrDFACache& orig) = delete;
+
+  // Seeds the still empty DFAs, to be called before any parsing.
+  bool restore();
+
+  // Writes the DFAs back if they grew since restore(), to be called once
+  // no parser is running anymore.
+  bool save();
+
+  // Number of DFA states the last restore() left in the parsers.
+  size_t getRestoredStateCount() const { return m_restoredStateCount; }
+
+  PathId getCacheFileId() const;
+
+ private:
+  size_t m_restoredStateCount = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_ANTLRDFACACHE_H */
@@ -42,6 +42,7 @@ class FileContent;
 class Session;
 class SymbolTable;
 class VObject;
+class VObjectStore;
 
 // A cache class used as a base for various other caches persisting
 // things in Cap'n'Proto.
@@ -53,7 +54,8 @@ class VObject;
 class Cache {
  public:
   Cache(const Cache& orig) = delete;
-  static constexpr uint64_t Capacity = 0x000000000FFFFFFF;
+  // Node ids are stored at full width, only bounded by RawNodeId.
+  static constexpr uint64_t Capacity = 0x00000000FFFFFFFF;
 
  protected:
   explicit Cache(Session* session);
@@ -69,7 +71,7 @@ class Cache {
                    const std::vector<Error>& sourceErrors, const SymbolTable& sourceSymbols);
 
   void cacheVObjects(::capnp::List<::VObject, ::capnp::Kind::STRUCT>::Builder targetVObjects,
-                     SymbolTable& targetSymbols, const std::vector<VObject>& sourceVObjects,
+                     SymbolTable& targetSymbols, const VObjectStore& sourceVObjects,
                      const SymbolTable& sourceSymbols);
 
   void cacheSymbols(::capnp::List<::capnp::Text, ::capnp::Kind::BLOB>::Builder targetSymbols,
@@ -85,7 +87,7 @@ class Cache {
   // Restore objects coming from the flatbuffer cache and with the corresponding
   // "cacheSymbols" into "fileContent", with IDs relevant in the local
   // symbol table "localSymbols" (which is updated).
-  void restoreVObjects(std::vector<VObject>& targetVObjects, SymbolTable& targetSymbols,
+  void restoreVObjects(VObjectStore& targetVObjects, SymbolTable& targetSymbols,
                        const ::capnp::List<::VObject>::Reader& sourceVObjects, const SymbolTable& sourceSymbols);
 
   void restoreSymbols(SymbolTable& targetSymbols, const ::capnp::List<::capnp::Text>::Reader& sourceSymbols);
@@ -0,0 +1,90 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_CACHESTORE_H
+#define SURELOG_CACHESTORE_H
+#pragma once
+
+#include <Surelog/Common/PathId.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace SURELOG {
+
+class FileSystem;
+class Session;
+
+/*
+ * class CacheStore
+ *
+ * Content addressed cache directory shared by concurrent Surelog processes,
+ * enabled by -sharedcache.
+ *
+ * Entries are named after a hash of everything their content depends on
+ * (source contents, defines, include paths, options...), so processes
+ * compiling the same sources with different output directories share them.
+ * Entries are published with an atomic rename (see CacheWriter), readers
+ * need no locking. A hit refreshes the entry's modification time, and
+ * evict() removes the least recently used entries beyond the size budget
+ * given by -cachesize.
+ */
+class CacheStore final {
+ public:
+  // Hash of the inputs an entry depends on.
+  class Key final {
+   public:
+    Key& add(std::string_view text);
+    Key& add(uint64_t value);
+    // False when the file can't be read
+    bool addFileContent(FileSystem* fileSystem, PathId fileId);
+
+    // 32 hex digits
+    std::string toString() const;
+
+   private:
+    void mix(uint64_t word);
+
+    uint64_t m_hash1 = 0xCBF29CE484222325;
+    uint64_t m_hash2 = 0x9E3779B97F4A7C15;
+  };
+
+  explicit CacheStore(Session* session);
+  CacheStore(const CacheStore& orig) = delete;
+
+  bool enabled() const { return m_enabled; }
+
+  // <dir>/<first 2 digits>/<key><extension>
+  PathId getEntryFileId(const Key& key, std::string_view extension) const;
+
+  // Marks the entry as most recently used.
+  void touch(PathId entryFileId) const;
+
+  // Removes the least recently used entries until the store is 10% under
+  // its size budget. Only files laid out as entries are considered, other
+  // files in the directory are left alone. Returns the number of removed
+  // entries.
+  uint32_t evict() const;
+
+ private:
+  Session* const m_session = nullptr;
+  const bool m_enabled = false;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_CACHESTORE_H */
@@ -0,0 +1,94 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_CACHEWRITER_H
+#define SURELOG_CACHEWRITER_H
+#pragma once
+
+#include <capnp/message.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SURELOG {
+
+/*
+ * class CacheWriter
+ *
+ * Writes cache messages to disk from a background thread, so that the
+ * compilation threads hand their message over and move on.
+ *
+ * Every file is written next to its target under a process unique name and
+ * then renamed over it: readers, in this or a concurrent process, either see
+ * the previous cache or the complete new one, never a partial file.
+ *
+ * The messages waiting to be written are bounded in size, write() only
+ * waits when the bound is reached. The destructor drains the queue.
+ *
+ * Once a file fails to be written, disk full or alike, further messages are
+ * dropped. drain() reports the files that were not written.
+ */
+class CacheWriter final {
+ public:
+  static constexpr size_t kMaxPendingBytes = 256 * 1024 * 1024;
+
+  explicit CacheWriter(size_t maxPendingBytes = kMaxPendingBytes);
+  CacheWriter(const CacheWriter& orig) = delete;
+  ~CacheWriter();
+
+  // Queues message to be written to filepath, parent directories included.
+  // Returns false, dropping message, if an earlier write failed.
+  bool write(const std::filesystem::path& filepath, std::unique_ptr<::capnp::MallocMessageBuilder> message);
+
+  // Waits until every queued message is on disk, returns the files that
+  // could not be written since the previous call.
+  std::vector<std::filesystem::path> drain();
+
+  // Writes message to filepath from the calling thread, through a temporary
+  // file renamed into place.
+  static bool writeFile(const std::filesystem::path& filepath, ::capnp::MessageBuilder& message);
+
+ private:
+  struct Request final {
+    std::filesystem::path m_filepath;
+    std::unique_ptr<::capnp::MallocMessageBuilder> m_message;
+    size_t m_size = 0;
+  };
+
+  void run();
+
+ private:
+  const size_t m_maxPendingBytes;
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+  std::deque<Request> m_requests;
+  size_t m_pendingBytes = 0;  // Size of the queued and in flight messages
+  bool m_writing = false;
+  bool m_stop = false;
+  bool m_failed = false;  // A write failed, the cache is turned off
+  std::vector<std::filesystem::path> m_failedFiles;  // Not reported by drain() yet
+  std::thread m_thread;                              // Started by the first write
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_CACHEWRITER_H */
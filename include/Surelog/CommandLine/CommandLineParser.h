@@ -85,6 +85,9 @@ class CommandLineParser final {
   void setUsePPOutputFileLocation(bool val) { m_ppOutputFileLocation = val; }
   bool lineOffsetsAsComments() const { return m_lineOffsetsAsComments; }
   PathId getCacheDirId() const { return m_cacheDirId; }
+  // -sharedcache: content addressed store shared between processes
+  bool sharedCache() const { return m_sharedCache; }
+  uint64_t getCacheSizeBudget() const { return m_cacheSizeBudget; }
   PathId getPrecompiledDirId() const { return m_precompiledDirId; }
   bool usePPOutputFileLocation() const { return m_ppOutputFileLocation; }
   void printExtraPpLineInfo(bool on) { m_ppPrintLineInfo = on; }
@@ -111,6 +114,8 @@ class CommandLineParser final {
   void setMuteStdout() { m_muteStdout = true; }
   bool verbose() const { return m_verbose; }
   bool profile() const { return m_profile; }
+  PathId traceFileId() const { return m_traceFileId; }
+  PathId memoryStatsFileId() const { return m_memoryStatsFileId; }
   int32_t getDebugLevel() const { return m_debugLevel; }
   bool getDebugAstModel() const { return m_debugAstModel; }
   bool getDebugUhdm() const { return m_dumpUhdm; }
@@ -132,6 +137,8 @@ class CommandLineParser final {
   bool parse() const { return m_parse; }
   bool parseOnly() const { return m_parseOnly; }
   bool lowMem() const { return m_lowMem; }
+  bool streamParse() const { return m_streamParse; }
+  bool fastLexer() const { return m_fastLexer; }
   bool compile() const { return m_compile; }
   bool elaborate() const { return m_elaborate; }
   bool reduce() const { return m_reduce; }
@@ -145,6 +152,8 @@ class CommandLineParser final {
   void setParseTree(bool val) { m_parseTree = val; }
   void setParseOnly(bool val) { m_parseOnly = val; }
   void setLowMem(bool val) { m_lowMem = val; }
+  void setStreamParse(bool val) { m_streamParse = val; }
+  void setFastLexer(bool val) { m_fastLexer = val; }
   void setCompile(bool val) { m_compile = val; }
   void setElaborate(bool val) { m_elaborate = val; }
   void setDisableLineMarkings(bool val) { m_disableLineMarkings = val; }
@@ -201,9 +210,11 @@ class CommandLineParser final {
   PathId getProgramId() const { return m_programId; }
   std::string getExeCommand() const { return m_exeCommand; }
   std::set<std::string, std::less<>>& getTopLevelModules() { return m_topLevelModules; }
+  bool topOnly() const { return m_topOnly; }
   std::set<std::string, std::less<>>& getBlackBoxModules() { return m_blackboxModules; }
   std::set<std::string, std::less<>>& getBlackBoxInstances() { return m_blackboxInstances; }
   void setTopLevelModule(std::string_view module) { m_topLevelModules.emplace(module); }
+  void setTopOnly(bool val) { m_topOnly = val; }
   void setBlackBoxModule(std::string_view module) { m_blackboxModules.emplace(module); }
   void setBlackBoxInstance(std::string_view instance) { m_blackboxInstances.emplace(instance); }
 
@@ -305,12 +316,15 @@ class CommandLineParser final {
   bool m_debugIncludeFileInfo;
   bool m_createCache;
   bool m_profile;
+  PathId m_traceFileId;
+  PathId m_memoryStatsFileId;
   bool m_parseBuiltIn;
   bool m_ppOutputFileLocation;
   bool m_ppPrintLineInfo;
   PathId m_programId;
   std::string m_exeCommand;
   std::set<std::string, std::less<>> m_topLevelModules;
+  bool m_topOnly;
   std::set<std::string, std::less<>> m_blackboxModules;
   std::set<std::string, std::less<>> m_blackboxInstances;
   bool m_sverilog;
@@ -321,10 +335,14 @@ class CommandLineParser final {
   bool m_replay;
   bool m_uhdmStats;
   bool m_lowMem;
+  bool m_streamParse;
+  bool m_fastLexer;
   bool m_writeUhdm;
   bool m_nonSynthesizable;
   bool m_nonSynthesizableWithFormal;
   bool m_noCacheHash;
+  bool m_sharedCache;
+  uint64_t m_cacheSizeBudget;
   bool m_sepComp;
   bool m_link;
   bool m_gc;
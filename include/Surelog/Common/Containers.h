@@ -28,7 +28,6 @@ using PackageDefinitionVec = std::vector<Package *>;
 using ProgramNameProgramDefinitionMap = std::map<std::string, Program *, StringViewCompare>;
 
 using ClassNameClassDefinitionMultiMap = std::multimap<std::string, ClassDefinition *, StringViewCompare>;
-using ClassNameClassDefinitionMap = std::map<std::string, ClassDefinition *, StringViewCompare>;
 
 using MacroStorage = std::vector<MacroInfo *>;
 using LineColumn = std::pair<uint32_t, uint16_t>;
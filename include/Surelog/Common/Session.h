@@ -28,18 +28,21 @@
 #include <cstdint>
 
 namespace SURELOG {
+class CacheWriter;
 class CommandLineParser;
 class ErrorContainer;
 class FileSystem;
 class LogListener;
 class Precompiled;
 class SymbolTable;
+class Tracer;
 
 class Session final {
  public:
   Session();
   Session(FileSystem* fileSystem, SymbolTable* symbolTable, LogListener* logListener, ErrorContainer* errorContainer,
-          CommandLineParser* commandLineParser, Precompiled* precompiled);
+          CommandLineParser* commandLineParser, Precompiled* precompiled, CacheWriter* cacheWriter = nullptr,
+          Tracer* tracer = nullptr);
   explicit Session(Session* session);
   ~Session();
 
@@ -63,6 +66,12 @@ class Session final {
   CommandLineParser* getCommandLineParser() { return m_commandLineParser; }
   const CommandLineParser* getCommandLineParser() const { return m_commandLineParser; }
 
+  CacheWriter* getCacheWriter() { return m_cacheWriter; }
+  const CacheWriter* getCacheWriter() const { return m_cacheWriter; }
+
+  Tracer* getTracer() { return m_tracer; }
+  const Tracer* getTracer() const { return m_tracer; }
+
  private:
   FileSystem* const m_fileSystem = nullptr;
   SymbolTable* const m_symbolTable = nullptr;
@@ -70,6 +79,8 @@ class Session final {
   Precompiled* const m_precompiled = nullptr;
   ErrorContainer* const m_errorContainer = nullptr;
   CommandLineParser* const m_commandLineParser = nullptr;
+  CacheWriter* const m_cacheWriter = nullptr;
+  Tracer* const m_tracer = nullptr;
 
   const bool m_ownsFileSystem = false;
   const bool m_ownsSymbolTable = false;
@@ -77,6 +88,8 @@ class Session final {
   const bool m_ownsPrecompiled = false;
   const bool m_ownsErrorContainer = false;
   const bool m_ownsCommandLineParser = false;
+  const bool m_ownsCacheWriter = false;
+  const bool m_ownsTracer = false;
 };
 };  // namespace SURELOG
 
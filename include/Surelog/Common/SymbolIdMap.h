@@ -0,0 +1,160 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_SYMBOLIDMAP_H
+#define SURELOG_SYMBOLIDMAP_H
+#pragma once
+
+#include <Surelog/Common/SymbolId.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace SURELOG {
+
+/**
+ * class SymbolIdMap
+ *
+ * Flat map keyed by interned symbols, for the small maps held by every
+ * design component and instance (parameter values...).
+ *
+ * The first InlineCapacity entries live in the object itself and are looked
+ * up by a linear scan. Past that, entries move to a vector indexed by an
+ * open-addressed hash table. Either way entries are kept contiguous in
+ * insertion order, which is the iteration order.
+ *
+ * Erasing shifts the following entries, and inserting may move all of them:
+ * pointers to values are invalidated by any update.
+ */
+template <typename T, uint32_t InlineCapacity = 4>
+class SymbolIdMap final {
+ public:
+  using value_type = std::pair<SymbolId, T>;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + m_size; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + m_size; }
+
+  uint32_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  T* find(SymbolId id) {
+    const int32_t index = indexOf(id);
+    return (index < 0) ? nullptr : &data()[index].second;
+  }
+  const T* find(SymbolId id) const { return const_cast<SymbolIdMap*>(this)->find(id); }
+
+  // Returns the value of id, and whether it was inserted (false when id was
+  // already there, its value is then left untouched).
+  std::pair<T*, bool> emplace(SymbolId id, T value) {
+    if (T* const existing = find(id)) return {existing, false};
+    if (m_heap.empty() && (m_size < InlineCapacity)) {
+      m_inline[m_size] = value_type(id, std::move(value));
+      return {&m_inline[m_size++].second, true};
+    }
+    if (m_heap.empty()) {
+      m_heap.reserve(2 * InlineCapacity);
+      for (value_type& entry : m_inline) m_heap.emplace_back(std::move(entry));
+      m_inline.fill(value_type());
+    }
+    m_heap.emplace_back(id, std::move(value));
+    ++m_size;
+    if (2 * m_size > m_index.size()) {
+      rehash();
+    } else {
+      insertIndex(m_size - 1);
+    }
+    return {&m_heap.back().second, true};
+  }
+
+  bool erase(SymbolId id) {
+    const int32_t index = indexOf(id);
+    if (index < 0) return false;
+    value_type* const entries = data();
+    for (uint32_t i = index + 1; i < m_size; ++i) entries[i - 1] = std::move(entries[i]);
+    --m_size;
+    if (m_heap.empty()) {
+      m_inline[m_size] = value_type();
+    } else {
+      m_heap.pop_back();
+      rehash();
+    }
+    return true;
+  }
+
+  void clear() {
+    m_inline.fill(value_type());
+    m_heap.clear();
+    m_index.clear();
+    m_size = 0;
+  }
+
+ private:
+  value_type* data() { return m_heap.empty() ? m_inline.data() : m_heap.data(); }
+  const value_type* data() const { return m_heap.empty() ? m_inline.data() : m_heap.data(); }
+
+  static uint32_t hash(SymbolId id) { return static_cast<uint32_t>((RawSymbolId)id) * 0x9E3779B1U; }
+
+  int32_t indexOf(SymbolId id) const {
+    const RawSymbolId rawId = (RawSymbolId)id;
+    if (m_heap.empty()) {
+      for (uint32_t i = 0; i < m_size; ++i) {
+        if ((RawSymbolId)m_inline[i].first == rawId) return i;
+      }
+      return -1;
+    }
+    const uint32_t mask = m_index.size() - 1;
+    for (uint32_t slot = hash(id) & mask;; slot = (slot + 1) & mask) {
+      const uint32_t entry = m_index[slot];
+      if (entry == 0) return -1;
+      if ((RawSymbolId)m_heap[entry - 1].first == rawId) return entry - 1;
+    }
+  }
+
+  void insertIndex(uint32_t index) {
+    const uint32_t mask = m_index.size() - 1;
+    uint32_t slot = hash(m_heap[index].first) & mask;
+    while (m_index[slot] != 0) slot = (slot + 1) & mask;
+    m_index[slot] = index + 1;
+  }
+
+  // Keeps the load factor at most 1/2
+  void rehash() {
+    if (m_heap.empty()) {
+      m_index.clear();
+      return;
+    }
+    uint32_t capacity = 4 * InlineCapacity;
+    while (capacity < 2 * m_size) capacity *= 2;
+    m_index.assign(capacity, 0);
+    for (uint32_t i = 0; i < m_size; ++i) insertIndex(i);
+  }
+
+ private:
+  uint32_t m_size = 0;
+  std::array<value_type, InlineCapacity> m_inline;
+  std::vector<value_type> m_heap;  // All the entries once past InlineCapacity
+  std::vector<uint32_t> m_index;   // Entry index + 1, 0 for free slots
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_SYMBOLIDMAP_H */
@@ -0,0 +1,111 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_UHDMIDMAP_H
+#define SURELOG_UHDMIDMAP_H
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace SURELOG {
+
+/**
+ * class UhdmIdMap
+ *
+ * Side table of UHDM objects, keyed by their serializer id
+ * (uhdm::Any::getUhdmId()): one open-addressed array of id, value slots.
+ * Unlike object addresses, ids are never reused for another object.
+ */
+template <typename T>
+class UhdmIdMap final {
+ public:
+  uint32_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  // Makes room for count entries without rehashing
+  void reserve(uint32_t count) {
+    if (2 * count > m_slots.size()) rehash(count);
+  }
+
+  const T* find(uint32_t id) const {
+    if (m_slots.empty()) return nullptr;
+    const uint32_t mask = m_slots.size() - 1;
+    for (uint32_t slot = hash(id) & mask;; slot = (slot + 1) & mask) {
+      const Slot& entry = m_slots[slot];
+      if (entry.m_key == 0) return nullptr;
+      if (entry.m_key == id + 1) return &entry.m_value;
+    }
+  }
+  T* find(uint32_t id) { return const_cast<T*>(static_cast<const UhdmIdMap*>(this)->find(id)); }
+
+  void insert_or_assign(uint32_t id, const T& value) {
+    if (T* const existing = find(id)) {
+      *existing = value;
+      return;
+    }
+    if (2 * (m_size + 1) > m_slots.size()) rehash(m_size + 1);
+    insert(id, value);
+    ++m_size;
+  }
+
+  void clear() {
+    m_slots.clear();
+    m_size = 0;
+  }
+
+ private:
+  struct Slot final {
+    uint32_t m_key = 0;  // Id + 1, 0 for a free slot
+    T m_value{};
+  };
+
+  // Ids of a file are allocated in strides, all the bits get mixed in
+  static uint32_t hash(uint32_t id) {
+    id ^= id >> 16;
+    id *= 0x7FEB352DU;
+    id ^= id >> 15;
+    id *= 0x846CA68BU;
+    return id ^ (id >> 16);
+  }
+
+  void insert(uint32_t id, const T& value) {
+    const uint32_t mask = m_slots.size() - 1;
+    uint32_t slot = hash(id) & mask;
+    while (m_slots[slot].m_key != 0) slot = (slot + 1) & mask;
+    m_slots[slot].m_key = id + 1;
+    m_slots[slot].m_value = value;
+  }
+
+  // Keeps the load factor at most 1/2
+  void rehash(uint32_t count) {
+    uint32_t capacity = 16;
+    while (capacity < 2 * count) capacity *= 2;
+    std::vector<Slot> slots(capacity);
+    slots.swap(m_slots);
+    for (const Slot& entry : slots) {
+      if (entry.m_key != 0) insert(entry.m_key - 1, entry.m_value);
+    }
+  }
+
+ private:
+  std::vector<Slot> m_slots;
+  uint32_t m_size = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_UHDMIDMAP_H */
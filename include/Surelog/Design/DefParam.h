@@ -27,6 +27,7 @@
 
 #include <Surelog/Common/NodeId.h>
 
+#include <functional>
 #include <map>
 #include <string>
 #include <string_view>
@@ -46,8 +47,14 @@ class DefParam final {
   Value* getValue() const { return m_value; }
   void setValue(Value* value) { m_value = value; }
 
-  void setChild(const std::string& name, DefParam* child) { m_children.emplace(name, child); }
-  std::map<std::string, DefParam*>& getChildren() { return m_children; }
+  using ChildrenMap = std::map<std::string, DefParam*, std::less<>>;
+
+  void setChild(std::string_view name, DefParam* child) { m_children.emplace(name, child); }
+  ChildrenMap& getChildren() { return m_children; }
+  DefParam* getChild(std::string_view name) const {
+    ChildrenMap::const_iterator itr = m_children.find(name);
+    return (itr == m_children.end()) ? nullptr : itr->second;
+  }
   bool isUsed() const { return m_used; }
   void setUsed() { m_used = true; }
   void setLocation(const FileContent* fC, NodeId nodeId) {
@@ -61,7 +68,7 @@ class DefParam final {
 
  private:
   const std::string m_name;
-  std::map<std::string, DefParam*> m_children;
+  ChildrenMap m_children;
   Value* m_value;
   bool m_used;
   DefParam* m_parent;
@@ -28,12 +28,16 @@
 #include <Surelog/Common/Containers.h>
 #include <Surelog/Common/NodeId.h>
 #include <Surelog/Common/PathId.h>
+#include <Surelog/Common/SymbolIdMap.h>
 #include <uhdm/vpi_user.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -99,17 +103,37 @@ class Design final {
 
   ConfigSet* getConfigSet() const { return m_configSet; }
 
-  ModuleNameModuleDefinitionMap& getModuleDefinitions() { return m_moduleDefinitions; }
+  // Keyed by the interned definition names, they iterate in the order the
+  // definitions were added. A package name may have several definitions.
+  using ModuleDefinitionMap = SymbolIdMap<ModuleDefinition*>;
+  using PackageDefinitionMap = SymbolIdMap<std::vector<Package*>>;
+  using ProgramDefinitionMap = SymbolIdMap<Program*>;
+  using ClassDefinitionMap = SymbolIdMap<ClassDefinition*>;
+
+  // The entries of one of the definition maps in name order, for the walks
+  // whose result or output depends on the order
+  template <typename T>
+  std::vector<std::pair<std::string_view, T>> sortedByName(const SymbolIdMap<T>& definitions) const {
+    std::vector<std::pair<std::string_view, T>> sorted;
+    sorted.reserve(definitions.size());
+    for (const auto& [id, definition] : definitions) sorted.emplace_back(getName_(id), definition);
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    return sorted;
+  }
+
+  ModuleDefinitionMap& getModuleDefinitions() { return m_moduleDefinitions; }
 
-  PackageNamePackageDefinitionMultiMap& getPackageDefinitions() { return m_packageDefinitions; }
+  PackageDefinitionMap& getPackageDefinitions() { return m_packageDefinitions; }
 
   PackageDefinitionVec& getOrderedPackageDefinitions() { return m_orderedPackageDefinitions; }
 
-  ProgramNameProgramDefinitionMap& getProgramDefinitions() { return m_programDefinitions; }
+  // Package names in the order AnalyzeFile found them
+  const std::vector<std::string>& getOrderedPackageNames() const { return m_orderedPackageNames; }
 
-  ClassNameClassDefinitionMultiMap& getClassDefinitions() { return m_classDefinitions; }
+  ProgramDefinitionMap& getProgramDefinitions() { return m_programDefinitions; }
 
-  ClassNameClassDefinitionMap& getUniqueClassDefinitions() { return m_uniqueClassDefinitions; }
+  // The first definition of each class name
+  ClassDefinitionMap& getClassDefinitions() { return m_classDefinitions; }
 
   ModuleDefinition* getModuleDefinition(std::string_view moduleName) const;
   Modport* getModport(std::string_view modportName) const;
@@ -128,7 +152,8 @@ class Design final {
 
   Value* getDefParamValue(std::string_view name);
 
-  std::map<std::string, DefParam*>& getDefParams() { return m_defParams; }
+  using DefParamMap = std::map<std::string, DefParam*, std::less<>>;
+  DefParamMap& getDefParams() { return m_defParams; }
 
   void checkDefParamUsage(DefParam* parent = nullptr);
 
@@ -142,9 +167,10 @@ class Design final {
 
   ClassDefinition* getClassDefinition(std::string_view name) const;
 
-  using BindMap = std::multimap<std::string, BindStmt*, std::less<>>;
+  // Keyed by the interned target names, nothing needs them in name order
+  using BindMap = SymbolIdMap<std::vector<BindStmt*>>;
 
-  BindMap& getBindMap() { return m_bindMap; }
+  const BindMap& getBindMap() const { return m_bindMap; }
 
   std::vector<BindStmt*> getBindStmts(std::string_view targetName);
 
@@ -164,9 +190,7 @@ class Design final {
 
   void addOrderedPackage(std::string_view packageName) { m_orderedPackageNames.emplace_back(packageName); }
 
-  void addModuleDefinition(std::string_view moduleName, ModuleDefinition* def) {
-    m_moduleDefinitions.emplace(moduleName, def);
-  }
+  void addModuleDefinition(std::string_view moduleName, ModuleDefinition* def);
 
   void addTopLevelModuleInstance(ModuleInstance* instance) { m_topLevelModuleInstances.emplace_back(instance); }
 
@@ -174,21 +198,24 @@ class Design final {
 
   void addClassDefinition(std::string_view className, ClassDefinition* classDef);
 
-  void addProgramDefinition(const std::string& programName, Program* program) {
-    m_programDefinitions.emplace(programName, program);
-  }
+  void addProgramDefinition(std::string_view programName, Program* program);
 
   Package* addPackageDefinition(std::string_view packageName, Package* package);
 
   void clearContainers();
 
+  // Takes ownership of a definition -toponly removed from the containers
+  void addPrunedComponent(const DesignComponent* component) { m_prunedComponents.emplace(component); }
+
   void orderPackages();
 
  private:
-  ModuleInstance* findInstance_(const std::vector<std::string>& path, ModuleInstance* scope) const;
-  void addDefParam_(std::vector<std::string>& path, const FileContent* fC, NodeId nodeId, Value* value,
-                    DefParam* parent);
-  DefParam* getDefParam_(std::vector<std::string>& path, DefParam* parent) const;
+  ModuleInstance* findInstance_(const std::vector<std::string_view>& path, size_t index, ModuleInstance* scope) const;
+  ModuleInstance* findInstanceInScope_(const std::vector<std::string_view>& path, size_t index,
+                                       ModuleInstance* scope) const;
+  SymbolId lookupName_(std::string_view name) const;
+  SymbolId registerName_(std::string_view name);
+  std::string_view getName_(SymbolId id) const;
 
   Session* const m_session = nullptr;
   uhdm::Design* const m_uhdmDesign = nullptr;
@@ -198,26 +225,26 @@ class Design final {
 
   FileIdDesignContentMap m_ppFileContents;
 
-  ModuleNameModuleDefinitionMap m_moduleDefinitions;
+  ModuleDefinitionMap m_moduleDefinitions;
 
   std::vector<ModuleInstance*> m_topLevelModuleInstances;
 
-  std::map<std::string, DefParam*> m_defParams;
+  DefParamMap m_defParams;
 
-  PackageNamePackageDefinitionMultiMap m_packageDefinitions;
+  PackageDefinitionMap m_packageDefinitions;
 
   PackageDefinitionVec m_orderedPackageDefinitions;
 
-  ProgramNameProgramDefinitionMap m_programDefinitions;
-
-  ClassNameClassDefinitionMultiMap m_classDefinitions;
+  ProgramDefinitionMap m_programDefinitions;
 
-  ClassNameClassDefinitionMap m_uniqueClassDefinitions;
+  ClassDefinitionMap m_classDefinitions;
 
   std::vector<std::string> m_orderedPackageNames;
 
   BindMap m_bindMap;
 
+  std::set<const DesignComponent*> m_prunedComponents;
+
   std::mutex m_mutex;
 };
 
@@ -31,11 +31,13 @@
 #include <Surelog/Common/PortNetHolder.h>
 #include <Surelog/Common/RTTI.h>
 #include <Surelog/Common/SymbolId.h>
+#include <Surelog/Common/SymbolIdMap.h>
 #include <Surelog/Design/FileCNodeId.h>
 #include <Surelog/Design/LetStmt.h>
 #include <Surelog/Design/ValuedComponentI.h>
 #include <Surelog/SourceCompile/VObjectTypes.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -86,20 +88,33 @@ class DesignComponent : public ValuedComponentI, public PortNetHolder {
   virtual std::string_view getName() const = 0;
   void append(DesignComponent*);
 
-  using DataTypeMap = std::map<std::string, DataType*, StringViewCompare>;
-  using TypeDefMap = std::map<std::string, TypeDef*, StringViewCompare>;
+  // Declarations are keyed by their names interned in the symbols of the
+  // component's session, they iterate in declaration order.
+  using DataTypeMap = SymbolIdMap<DataType*>;
+  using TypeDefMap = SymbolIdMap<TypeDef*>;
   using DataTypeVec = std::vector<DataType*>;
   using TypeDefVec = std::vector<TypeDef*>;
-  using FunctionMap = std::map<std::string, Function*, StringViewCompare>;
-  using TaskMap = std::map<std::string, Task*, StringViewCompare>;
-  using VariableMap = std::map<std::string, Variable*, StringViewCompare>;
-  using ParameterMap = std::map<std::string, Parameter*, StringViewCompare>;
+  using FunctionMap = SymbolIdMap<Function*>;
+  using TaskMap = SymbolIdMap<Task*>;
+  using VariableMap = SymbolIdMap<Variable*>;
+  using ParameterMap = SymbolIdMap<Parameter*>;
   using ParameterVec = std::vector<Parameter*>;
   using ParamAssignVec = std::vector<ParamAssign*>;
-  using LetStmtMap = std::map<std::string, LetStmt*, StringViewCompare>;
-  using NamedObjectMap = std::map<std::string, std::pair<FileCNodeId, DesignComponent*>, StringViewCompare>;
+  using LetStmtMap = SymbolIdMap<LetStmt*>;
+  using NamedObjectMap = SymbolIdMap<std::pair<FileCNodeId, DesignComponent*>>;
   using FuncNameTypespecVec = std::vector<std::pair<std::string, uhdm::Typespec*>>;
 
+  // The entries of one of the declaration maps of this component in name
+  // order, for the walks whose result or output depends on the order
+  template <typename T>
+  std::vector<std::pair<std::string_view, T>> sortedByName(const SymbolIdMap<T>& declarations) const {
+    std::vector<std::pair<std::string_view, T>> sorted;
+    sorted.reserve(declarations.size());
+    for (const auto& [id, declaration] : declarations) sorted.emplace_back(getValueName(id), declaration);
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    return sorted;
+  }
+
   void addFileContent(const FileContent* fileContent, NodeId nodeId);
   const std::vector<const FileContent*>& getFileContents() const { return m_fileContents; }
   const std::vector<NodeId>& getNodeIds() const { return m_nodeIds; }
@@ -110,9 +125,10 @@ class DesignComponent : public ValuedComponentI, public PortNetHolder {
 
   void addNamedObject(std::string_view name, FileCNodeId object, DesignComponent* def = nullptr);
   const NamedObjectMap& getNamedObjects() const { return m_namedObjects; }
+  // Invalidated by the next addNamedObject
   const std::pair<FileCNodeId, DesignComponent*>* getNamedObject(std::string_view name) const;
 
-  DataTypeMap& getUsedDataTypeMap() { return m_usedDataTypes; }
+  const DataTypeMap& getUsedDataTypeMap() const { return m_usedDataTypes; }
   DataType* getUsedDataType(std::string_view name);
   void insertUsedDataType(std::string_view dataTypeName, DataType* dataType);
 
@@ -124,11 +140,11 @@ class DesignComponent : public ValuedComponentI, public PortNetHolder {
   const TypeDef* getTypeDef(std::string_view name) const;
   void insertTypeDef(TypeDef* p);
 
-  FunctionMap& getFunctionMap() { return m_functions; }
+  const FunctionMap& getFunctionMap() const { return m_functions; }
   virtual Function* getFunction(std::string_view name) const;
   void insertFunction(Function* p);
 
-  TaskMap& getTaskMap() { return m_tasks; }
+  const TaskMap& getTaskMap() const { return m_tasks; }
   virtual Task* getTask(std::string_view name) const;
   void insertTask(Task* p);
 
@@ -183,9 +199,16 @@ class DesignComponent : public ValuedComponentI, public PortNetHolder {
 
   const LetStmtMap& getLetStmts() const { return m_letDecls; }
 
+ protected:
+  // Declared in this component, parent scopes excluded
+  const DataType* getLocalDataType(std::string_view name) const;
+  Function* getLocalFunction(std::string_view name) const;
+
  private:
   const DataType* getDataTypeRecursive(Design* design, std::string_view name,
                                        std::set<const DesignComponent*>& visited) const;
+  SymbolId lookupName_(std::string_view name) const;
+  SymbolId registerName_(std::string_view name);
 
  protected:
   std::vector<const FileContent*> m_fileContents;
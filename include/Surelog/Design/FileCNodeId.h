@@ -33,10 +33,11 @@ class FileContent;
 
 class FileCNodeId {
  public:
+  FileCNodeId() = default;
   FileCNodeId(const FileContent* f, NodeId n) : fC(f), nodeId(n) {}
 
-  const FileContent* const fC;
-  const NodeId nodeId;
+  const FileContent* fC = nullptr;
+  NodeId nodeId;
 };
 
 };  // namespace SURELOG
@@ -30,8 +30,11 @@
 #include <Surelog/Common/PathId.h>
 #include <Surelog/Common/RTTI.h>
 #include <Surelog/Common/SymbolId.h>
+#include <Surelog/Common/UhdmIdMap.h>
 #include <Surelog/Design/DesignComponent.h>
 #include <Surelog/Design/VObject.h>
+#include <Surelog/Design/VObjectStore.h>
+#include <Surelog/SourceCompile/VObjectTypeBitSet.h>
 #include <Surelog/SourceCompile/VObjectTypes.h>
 #include <uhdm/uhdm_types.h>
 
@@ -61,7 +64,9 @@ class FileContent final : public DesignComponent {
   SURELOG_IMPLEMENT_RTTI(FileContent, DesignComponent)
 
  public:
-  using AnyToNodeIdPairCache = std::map<const uhdm::Any*, std::pair<NodeId, NodeId>>;
+  // Start and end nodes of the UHDM objects built from this file, keyed by
+  // uhdm::Any::getUhdmId()
+  using AnyToNodeIdPairCache = UhdmIdMap<std::pair<NodeId, NodeId>>;
 
  public:
   FileContent(Session* session, PathId fileId, Library* library, FileContent* parent, PathId fileChunkId);
@@ -104,13 +109,27 @@ class FileContent final : public DesignComponent {
                                      const VObjectTypeUnorderedSet& stopPoints, bool first = false) const;
   // Recursively search for all items of types
   // and stops at types stopPoints
+
+  // Preorder index answering sl_collect_all with binary searches over per
+  // type node lists instead of walking the subtree. Built once the tree is
+  // final (after symbol resolution) and released after the design
+  // compilation steps; any mutation drops it and queries fall back to the
+  // tree walk.
+  void buildSubtreeIndex();
+  void clearSubtreeIndex();
+  bool hasSubtreeIndex() const { return !m_preorderNodes.empty(); }
+
+  // Drops the objects and design elements produced by a parser listener so
+  // that the file can be parsed again from scratch.
+  void clearParsedContent();
+
   uint32_t getSize() const final { return static_cast<uint32_t>(m_objects.size()); }
   VObjectType getType() const final { return VObjectType::NO_TYPE; }
   bool isInstance() const final { return false; }
   std::string_view getName() const final;
   NodeId getRootNode() const;
   PathId getFileId(NodeId id) const;
-  PathId* getMutableFileId(NodeId id);
+  void setFileId(NodeId id, PathId fileId);
   Library* getLibrary() const { return m_library; }
   std::vector<DesignElement*>& getDesignElements() { return m_elements; }
   const std::vector<DesignElement*>& getDesignElements() const { return m_elements; }
@@ -120,14 +139,17 @@ class FileContent final : public DesignComponent {
   NodeId addObject(SymbolId name, PathId fileId, VObjectType type, uint32_t line, uint16_t column, uint32_t endLine,
                    uint16_t endColumn, NodeId parent = InvalidNodeId, NodeId definition = InvalidNodeId,
                    NodeId child = InvalidNodeId, NodeId sibling = InvalidNodeId);
-  const std::vector<VObject>& getVObjects() const { return m_objects; }
-  std::vector<VObject>* mutableVObjects() { return &m_objects; }
+  const VObjectStore& getVObjects() const { return m_objects; }
+  VObjectStore* mutableVObjects() {
+    clearSubtreeIndex();
+    return &m_objects;
+  }
   const NameIdMap& getObjectLookup() const { return m_objectLookup; }
   void insertObjectLookup(std::string_view name, NodeId id, ErrorContainer* errors);
   std::set<std::string, std::less<>>& getReferencedObjects() { return m_referencedObjects; }
 
-  const VObject& Object(NodeId index) const;
-  VObject* MutableObject(NodeId index);
+  VObject Object(NodeId index) const;
+  VObjectStore::Reference MutableObject(NodeId index);
 
   NodeId UniqueId(NodeId index) const;
 
@@ -139,6 +161,9 @@ class FileContent final : public DesignComponent {
 
   NodeId Definition(NodeId index) const;
 
+  void SetDefinition(NodeId index, NodeId def);
+  void SetType(NodeId index, VObjectType type);
+
   void SetDefinitionFile(NodeId index, PathId def);
   PathId GetDefinitionFile(NodeId index) const;
 
@@ -212,13 +237,22 @@ class FileContent final : public DesignComponent {
   bool validate(NodeId parentId) const;
   bool isComment(NodeId nodeId) const;
   NodeId skipComments(NodeId nodeId) const;
+  bool isIndexed(NodeId parent) const;
+  void collectIndexed(NodeId parent, VObjectType type, bool first, std::vector<uint32_t>& ranks) const;
+  std::vector<NodeId> toNodeIds(std::vector<uint32_t>& ranks, bool sort, bool first) const;
 
  protected:
   std::vector<DesignElement*> m_elements;
   std::map<std::string, DesignElement*, StringViewCompare> m_elementMap;
-  std::vector<VObject> m_objects;
+  VObjectStore m_objects;
   std::unordered_map<NodeId, PathId, NodeIdHasher, NodeIdEqualityComparer> m_definitionFiles;
 
+  // Subtree index, see buildSubtreeIndex()
+  std::vector<uint32_t> m_preorderRanks;     // NodeId -> preorder rank
+  std::vector<uint32_t> m_subtreeLastRanks;  // NodeId -> rank of last descendant
+  std::vector<NodeId> m_preorderNodes;       // preorder rank -> NodeId
+  std::unordered_map<VObjectType, std::vector<uint32_t>> m_typeRanks;  // sorted ranks per type
+
   NameIdMap m_objectLookup;  // Populated at ResolveSymbol stage
   std::set<std::string, std::less<>> m_referencedObjects;
 
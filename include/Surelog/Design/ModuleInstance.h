@@ -40,6 +40,7 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace SURELOG {
@@ -59,6 +60,8 @@ class ModuleInstance final : public ValuedComponentI {
   ~ModuleInstance() final;
 
   using ModuleArrayModuleInstancesMap = std::map<uhdm::ModuleArray*, std::vector<ModuleInstance*>>;
+  // Keyed by instance name, equal names keep their insertion order
+  using ChildrenByNameMap = std::multimap<std::string_view, ModuleInstance*>;
 
   void addSubInstance(ModuleInstance* subInstance);
   std::vector<ModuleInstance*>& getAllSubInstances() { return m_allSubInstances; }
@@ -89,6 +92,7 @@ class ModuleInstance final : public ValuedComponentI {
   SymbolId getInstanceId(SymbolTable* symbols) const;
   SymbolId getModuleNameId(SymbolTable* symbols) const;
   std::string getInstanceName() const;
+  std::string_view getInstanceNameView() const;
   std::string getFullPathName() const;
   std::string_view getModuleName() const;
   uint32_t getDepth() const;
@@ -97,7 +101,7 @@ class ModuleInstance final : public ValuedComponentI {
 
   std::vector<Parameter*>& getTypeParams() { return m_typeParams; }
 
-  Value* getValue(std::string_view name, ExprBuilder& exprBuilder) const final;
+  using ValuedComponentI::getComplexValue;
   uhdm::Expr* getComplexValue(std::string_view name) const final;
 
   ModuleInstance* getInstanceBinding() { return m_boundInstance; }
@@ -106,10 +110,18 @@ class ModuleInstance final : public ValuedComponentI {
   std::string decompile(char* valueName) final;
 
   ModuleInstance* getChildByName(std::string_view name);
+  std::pair<ChildrenByNameMap::const_iterator, ChildrenByNameMap::const_iterator> getChildrenByName(
+      std::string_view name) const {
+    return m_childrenByName.equal_range(name);
+  }
+
+ private:
+  Value* getValue_(std::string_view name, SymbolId id, ExprBuilder& exprBuilder) const final;
 
  private:
   DesignComponent* m_definition;
   std::vector<ModuleInstance*> m_allSubInstances;
+  ChildrenByNameMap m_childrenByName;
   const FileContent* m_fileContent;
   NodeId m_nodeId;
   ModuleInstance* m_parent;
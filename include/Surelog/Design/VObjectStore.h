@@ -0,0 +1,137 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_VOBJECTSTORE_H
+#define SURELOG_VOBJECTSTORE_H
+#pragma once
+
+#include <Surelog/Common/NodeId.h>
+#include <Surelog/Common/PathId.h>
+#include <Surelog/Common/SymbolId.h>
+#include <Surelog/Design/VObject.h>
+#include <Surelog/SourceCompile/VObjectTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SURELOG {
+
+/*
+ * class VObjectStore
+ *
+ * Structure-of-arrays storage for the VObjects of a FileContent.
+ *
+ * Tree walks (Child, Sibling, Parent, Type, sl_xxx) only touch the dense
+ * type and link arrays. Names, files and source locations live in separate
+ * cold arrays and are only read for reporting and UHDM population. Files
+ * are interned in a small per-store table since a file content references
+ * only a handful of distinct (include) files.
+ *
+ * operator[] materializes a full VObject copy; use the field accessors on
+ * hot paths.
+ */
+class VObjectStore final {
+ public:
+  struct Location final {
+    uint32_t m_startLine = 0;
+    uint32_t m_endLine = 0;
+    uint16_t m_startColumn = 0;
+    uint16_t m_endColumn = 0;
+  };
+
+  // Mutable view over a single node using the VObject member names.
+  // File id is interned and so has to be changed using setFileId.
+  // Invalidated by the next insertion.
+  struct Reference final {
+    SymbolId& m_name;
+    VObjectType& m_type;
+    uint32_t& m_startLine;
+    uint32_t& m_endLine;
+    uint16_t& m_startColumn;
+    uint16_t& m_endColumn;
+    uint32_t& m_ppStartLine;
+    uint32_t& m_ppEndLine;
+    uint16_t& m_ppStartColumn;
+    uint16_t& m_ppEndColumn;
+    NodeId& m_parent;
+    NodeId& m_definition;
+    NodeId& m_child;
+    NodeId& m_sibling;
+  };
+
+  size_t size() const { return m_types.size(); }
+  bool empty() const { return m_types.empty(); }
+
+  void reserve(size_t count);
+  void clear();
+
+  NodeId emplace_back(SymbolId name, PathId fileId, VObjectType type, uint32_t startLine, uint16_t startColumn,
+                      uint32_t endLine, uint16_t endColumn, NodeId parent = InvalidNodeId,
+                      NodeId definition = InvalidNodeId, NodeId child = InvalidNodeId, NodeId sibling = InvalidNodeId);
+  NodeId push_back(const VObject& object);
+
+  VObject operator[](NodeId id) const;
+  Reference mutableObject(NodeId id);
+
+  // Hot fields
+  VObjectType type(NodeId id) const { return m_types[id]; }
+  NodeId parent(NodeId id) const { return m_parents[id]; }
+  NodeId child(NodeId id) const { return m_children[id]; }
+  NodeId sibling(NodeId id) const { return m_siblings[id]; }
+  NodeId definition(NodeId id) const { return m_definitions[id]; }
+
+  VObjectType& type(NodeId id) { return m_types[id]; }
+  NodeId& parent(NodeId id) { return m_parents[id]; }
+  NodeId& child(NodeId id) { return m_children[id]; }
+  NodeId& sibling(NodeId id) { return m_siblings[id]; }
+  NodeId& definition(NodeId id) { return m_definitions[id]; }
+
+  // Cold fields
+  SymbolId name(NodeId id) const { return m_names[id]; }
+  PathId fileId(NodeId id) const { return m_files[m_fileIndices[id]]; }
+  void setFileId(NodeId id, PathId fileId) { m_fileIndices[id] = internFileId(fileId); }
+  const Location& location(NodeId id) const { return m_locations[id]; }
+  const Location& ppLocation(NodeId id) const { return m_ppLocations[id]; }
+  Location& location(NodeId id) { return m_locations[id]; }
+  Location& ppLocation(NodeId id) { return m_ppLocations[id]; }
+
+  // Bytes owned by the store (capacity, not size).
+  size_t getMemoryUsage() const;
+
+ private:
+  uint32_t internFileId(PathId fileId);
+
+ private:
+  // Hot
+  std::vector<VObjectType> m_types;
+  std::vector<NodeId> m_parents;
+  std::vector<NodeId> m_children;
+  std::vector<NodeId> m_siblings;
+  std::vector<NodeId> m_definitions;
+
+  // Cold
+  std::vector<SymbolId> m_names;
+  std::vector<uint32_t> m_fileIndices;
+  std::vector<Location> m_locations;
+  std::vector<Location> m_ppLocations;
+  std::vector<PathId> m_files;
+  uint32_t m_lastFileIndex = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_VOBJECTSTORE_H */
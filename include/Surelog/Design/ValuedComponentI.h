@@ -27,14 +27,16 @@
 
 #include <Surelog/Common/Containers.h>
 #include <Surelog/Common/RTTI.h>
+#include <Surelog/Common/SymbolId.h>
+#include <Surelog/Common/SymbolIdMap.h>
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 // UHDM
 #include <uhdm/uhdm_forward_decl.h>
 
-#include <map>
 #include <string>
 #include <string_view>
 
@@ -42,13 +44,17 @@ namespace SURELOG {
 
 class ExprBuilder;
 class Session;
+class SymbolTable;
 class Value;
 
 class ValuedComponentI : public RTTI {
   SURELOG_IMPLEMENT_RTTI(ValuedComponentI, RTTI)
  public:
-  using ParamMap = std::map<std::string, std::pair<Value*, int32_t>, StringViewCompare>;
-  using ComplexValueMap = std::map<std::string, uhdm::Expr*, StringViewCompare>;
+  // Keyed by the names interned in the symbol table of the component's
+  // session, see getValueId(). The table is not locked: a session and its
+  // symbols are only used by one compilation thread at a time.
+  using ParamMap = SymbolIdMap<std::pair<Value*, int32_t>>;
+  using ComplexValueMap = SymbolIdMap<uhdm::Expr*>;
 
   ValuedComponentI(Session* session, const ValuedComponentI* parentScope, ValuedComponentI* definition)
       : m_session(session), m_parentScope(parentScope), m_definition(definition) {}
@@ -62,6 +68,11 @@ class ValuedComponentI : public RTTI {
   virtual Value* getValue(std::string_view name, ExprBuilder& exprBuilder) const;
   virtual void setValue(std::string_view name, Value* val,  // NOLINT
                         ExprBuilder& exprBuilder, int32_t lineNb = 0);
+  // Same as above, for a name resolved once with getValueId()
+  Value* getValue(SymbolId id) const;
+  Value* getValue(SymbolId id, ExprBuilder& exprBuilder) const;
+  void setValue(SymbolId id, Value* val,  // NOLINT
+                ExprBuilder& exprBuilder, int32_t lineNb = 0);
   virtual void deleteValue(std::string_view name, ExprBuilder& exprBuilder);
   virtual void forgetValue(std::string_view name);
   const ParamMap& getMappedValues() const { return m_paramMap; }
@@ -70,11 +81,29 @@ class ValuedComponentI : public RTTI {
 
   virtual void setComplexValue(std::string_view name, uhdm::Expr* val);
   virtual uhdm::Expr* getComplexValue(std::string_view name) const;
+  uhdm::Expr* getComplexValue(SymbolId id) const;
   virtual void forgetComplexValue(std::string_view name);
   const ComplexValueMap& getComplexValues() const { return m_complexValues; }
+
+  // Key of name in the maps above, BadSymbolId for a name no value has
+  SymbolId getValueId(std::string_view name) const;
+  // Name of a key of the maps above
+  std::string_view getValueName(SymbolId id) const;
+  // The maps above iterate in insertion order, these list them by name
+  std::vector<std::pair<std::string_view, const std::pair<Value*, int32_t>*>> getMappedValuesByName() const;
+  std::vector<std::string_view> getComplexValueNames() const;
+
   // Do not change the signature of this method, it's use in gdb for debug.
   virtual std::string decompile(char* valueName) { return "Undefined"; }
 
+ protected:
+  // Value of id in this component or its definition or parent scopes, id
+  // being a key in symbols. The name of id is only needed, and looked up
+  // when empty, to cross into a component of a session with other symbols.
+  Value* findValue_(std::string_view name, SymbolId id, const SymbolTable* symbols) const;
+  // name is the name of id, or empty for the callers that only hold id
+  virtual Value* getValue_(std::string_view name, SymbolId id, ExprBuilder& exprBuilder) const;
+
  protected:
   Session* const m_session = nullptr;
 
@@ -27,9 +27,13 @@
 
 #include <Surelog/Common/PathId.h>
 #include <Surelog/Design/Design.h>
+#include <Surelog/DesignCompile/TypespecInterner.h>
 
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <set>
+#include <string_view>
 #include <vector>
 
 // UHDM
@@ -47,6 +51,7 @@ class Serializer;
 
 namespace SURELOG {
 class Compiler;
+class DesignComponent;
 class Session;
 class SymbolTable;
 class ValuedComponentI;
@@ -73,12 +78,21 @@ class CompileDesign {
   void unlockSerializer();
   uhdm::SourceFileCollection* getUhdmSourceFiles() { return m_uhdmSourcefiles; }
   std::map<const uhdm::Typespec*, const uhdm::Typespec*>& getSwapedObjects() { return m_typespecSwapMap; }
+  TypespecInterner* getTypespecInterner();
 
  private:
+  // name identifies the step in the -trace timeline
   template <class ObjectType, class ObjectMapType, typename FunctorType>
-  void compileMT_(ObjectMapType& objects, int32_t maxThreadCount);
+  void compileMT_(ObjectMapType& objects, int32_t maxThreadCount, std::string_view name);
 
   void collectObjects_(Design::FileIdDesignContentMap& all_files, Design* design, bool finalCollection);
+
+  // -toponly: the design components that no -top module instantiates,
+  // binds, imports, extends or references, directly or not.
+  void computeUnreachableComponents_();
+  // Removes the unreachable components from the design containers, so they
+  // are neither compiled nor written to UHDM, and hands them to the design.
+  void pruneUnreachableComponents_();
   bool compilation_();
 
   Session* const m_session = nullptr;
@@ -86,6 +100,8 @@ class CompileDesign {
   std::vector<Session*> m_sessions;
   uhdm::SourceFileCollection* m_uhdmSourcefiles = nullptr;
   std::map<const uhdm::Typespec*, const uhdm::Typespec*> m_typespecSwapMap;
+  std::unique_ptr<TypespecInterner> m_typespecInterner;
+  std::set<const DesignComponent*> m_unreachableComponents;
 };
 
 }  // namespace SURELOG
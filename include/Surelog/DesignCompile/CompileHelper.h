@@ -28,6 +28,8 @@
 #include <Surelog/Common/NodeId.h>
 #include <Surelog/Common/PathId.h>
 #include <Surelog/Common/RTTI.h>
+#include <Surelog/Common/SymbolId.h>
+#include <Surelog/Common/SymbolIdMap.h>
 #include <Surelog/Design/ValuedComponentI.h>
 #include <Surelog/Expression/ExprBuilder.h>
 #include <Surelog/SourceCompile/VObjectTypes.h>
@@ -56,6 +58,7 @@ class DesignComponent;
 class FileContent;
 class Function;
 class NodeId;
+class ParamAssign;
 class Parameter;
 class Procedure;
 class Scope;
@@ -433,6 +436,38 @@ class CompileHelper final {
                                       uint16_t column, uint32_t eline, uint16_t ecolumn);
   uhdm::TypespecMember* buildTypespecMember(const FileContent* fC, NodeId id);
   uhdm::Typespec* getTypespecFromType(int32_t type, uhdm::Serializer& s);
+  // Clone of c that shares its typespec when that one is interned
+  uhdm::Constant* cloneConstant_(uhdm::Constant* c);
+
+  // Positions of the names of a collection that getObject() searches, keyed
+  // by the interned names. The first position of a name is kept, as a scan
+  // would find it. The collections grow by appending, so the size tells what
+  // is left to index and a miss costs a lookup. A collection that shrank is
+  // indexed again, as is one with an element replaced in place up to a hit.
+  struct NameIndex final {
+    std::vector<const void*> m_elements;  // As indexed, their count is the size indexed
+    SymbolIdMap<uint32_t> m_positions;
+  };
+  struct ScopeNames final {
+    NameIndex m_variables;
+    NameIndex m_ioDecls;
+  };
+  struct ComponentNames final {
+    NameIndex m_paramAssigns;
+    NameIndex m_ports;
+    NameIndex m_signals;
+  };
+  // Indexes the elements of collection past the indexed ones
+  template <typename Collection, typename NameOf>
+  void indexNames_(NameIndex& index, const Collection& collection, NameOf nameOf);
+  // Returns the position of name in collection, -1 if it's not there. id is
+  // the interned name, set once an index interned it.
+  template <typename Collection, typename NameOf>
+  int32_t findName_(NameIndex& index, const Collection& collection, std::string_view name, SymbolId& id,
+                    NameOf nameOf);
+  // Value of the first substituted assignment of parameter name
+  uhdm::Any* getParamAssignValue_(ComponentNames& names, const std::vector<ParamAssign*>& passigns,
+                                  std::string_view name, SymbolId& id);
 
  private:
   Session* const m_session = nullptr;
@@ -442,6 +477,8 @@ class CompileHelper final {
   bool m_checkForLoops = false;
   int32_t m_stackLevel = 0;
   bool m_unwind = false;
+  std::unordered_map<uint32_t, ScopeNames> m_scopeNames;  // By UHDM id of the scope
+  std::unordered_map<const DesignComponent*, ComponentNames> m_componentNames;
 };
 
 }  // namespace SURELOG
@@ -78,7 +78,6 @@ class ResolveSymbols final : public CompileStep {
   bool resolve();
 
   VObject Object(NodeId index) const final;
-  VObject* MutableObject(NodeId index);
 
   NodeId UniqueId(NodeId index) const final;
 
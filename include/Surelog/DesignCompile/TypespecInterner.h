@@ -0,0 +1,92 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_TYPESPECINTERNER_H
+#define SURELOG_TYPESPECINTERNER_H
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+// UHDM
+#include <uhdm/uhdm_forward_decl.h>
+#include <uhdm/uhdm_types.h>
+
+namespace SURELOG {
+
+/*
+ * class TypespecInterner
+ *
+ * Shares, within a scope, the typespecs that only depend on their kind,
+ * signedness and constant range: the types of the literals (int, logic,
+ * bit, real, string, time...) and the logic [left:right] types of the
+ * evaluated constant expressions, which otherwise get a typespec of their
+ * own each. Declared types keep their own typespec, as they carry the
+ * location of the declaration.
+ *
+ * The interned typespecs have no location and the scope they are
+ * requested for as parent, as the typespecs they replace. They are
+ * immutable: they are neither cloned nor re-parented, and a site that
+ * modifies a typespec it did not create goes through unshare() or
+ * setSigned() first (copy on write).
+ */
+class TypespecInterner final {
+ public:
+  explicit TypespecInterner(uhdm::Serializer& serializer) : m_serializer(serializer) {}
+  TypespecInterner(const TypespecInterner& orig) = delete;
+
+  // Null for a kind that has ranges, members or a name.
+  uhdm::Typespec* get(uhdm::UhdmType type, uhdm::Any* parent, bool isSigned = false);
+  // logic [left:right]
+  uhdm::Typespec* getRanged(uint16_t left, uint16_t right, uhdm::Any* parent, bool isSigned = false);
+  bool isInterned(const uhdm::Typespec* typespec) const;
+
+  // Sets the signedness of typespec in place, unless it is shared: returns
+  // the typespec to reference from now on.
+  uhdm::Typespec* setSigned(uhdm::Typespec* typespec, bool isSigned);
+
+  // typespec itself, or a private copy of it when it is shared, for the
+  // caller to modify, re-parent and reference from now on.
+  uhdm::Typespec* unshare(uhdm::Typespec* typespec);
+
+ private:
+  struct Key final {
+    uhdm::Any* parent = nullptr;
+    uhdm::UhdmType type = uhdm::UhdmType::IntTypespec;
+    bool isSigned = false;
+    bool ranged = false;
+    uint16_t left = 0;
+    uint16_t right = 0;
+
+    bool operator<(const Key& rhs) const;
+  };
+
+  // Callers hold m_mutex
+  uhdm::Typespec* intern_(const Key& key);
+  uhdm::Typespec* make_(const Key& key);
+
+ private:
+  uhdm::Serializer& m_serializer;
+
+  mutable std::mutex m_mutex;
+  std::map<Key, uhdm::Typespec*> m_typespecs;
+  std::map<const uhdm::Typespec*, Key> m_interned;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_TYPESPECINTERNER_H */
@@ -87,9 +87,9 @@ class UhdmWriter final {
   void writeNets(DesignComponent* mod, const std::vector<Signal*>& orig_nets, uhdm::BaseClass* parent,
                  uhdm::Serializer& s, SignalBaseClassMap& signalBaseMap, SignalMap& signalMap, SignalMap& portMap,
                  ModuleInstance* instance = nullptr);
-  void writeDataTypes(const DesignComponent::DataTypeMap& datatypeMap, uhdm::BaseClass* parent,
+  void writeDataTypes(const DesignComponent* component, uhdm::BaseClass* parent,
                       uhdm::TypespecCollection* dest_typespecs, uhdm::Serializer& s, bool setParent);
-  void writeVariables(const DesignComponent::VariableMap& orig_vars, uhdm::BaseClass* parent, uhdm::Serializer& s);
+  void writeVariables(const DesignComponent* component, uhdm::BaseClass* parent, uhdm::Serializer& s);
   void writeModule(ModuleDefinition* mod, uhdm::Module* m, uhdm::Serializer& s,
                    InstanceDefinitionMap& instanceDefinitionMap, ModportMap& modPortMap,
                    ModuleInstance* instance = nullptr);
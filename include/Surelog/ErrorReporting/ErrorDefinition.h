@@ -106,6 +106,10 @@ class ErrorDefinition {
     CMD_WD_MISSING_DIR = 31,
     CMD_CD_MISSING_DIR = 32,
     CMD_REMAP_MISSING_DIRS = 33,
+    CMD_CACHE_MISSING_SIZE = 34,
+    CMD_TRACE_MISSING_FILE = 35,
+    CMD_MEMSTATS_MISSING_FILE = 36,
+    CMD_CANNOT_WRITE_CACHE_FILE = 37,
     PP_CANNOT_OPEN_FILE = 100,
     PP_CANNOT_OPEN_INCLUDE_FILE = 101,
     PP_UNKOWN_MACRO = 102,
@@ -25,15 +25,19 @@
 #define SURELOG_EXPRBUILDER_H
 #pragma once
 
+#include <Surelog/Common/NodeId.h>
 #include <Surelog/Expression/Value.h>
 
 #include <cstdint>
+#include <map>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <vector>
 
 namespace SURELOG {
 class Design;
 class FileContent;
-class NodeId;
 class Session;
 class ValuedComponentI;
 
@@ -41,20 +45,82 @@ class ExprBuilder final {
  public:
   explicit ExprBuilder(Session* session) : m_session(session) {}
   ExprBuilder(const ExprBuilder& orig) = delete;
+  ~ExprBuilder();
 
+  // The results of the expressions evaluated more than once and reading
+  // parameters are memoized per values of these parameters: instances with
+  // the same parameter values reuse the result of the first one.
   Value* evalExpr(const FileContent*, NodeId id, ValuedComponentI* instance = nullptr, bool muteErrors = false);
   Value* fromVpiValue(std::string_view value, int32_t constType, int32_t size);
   Value* fromString(std::string_view value);
   Value* clone(Value* val);
 
-  void setDesign(Design* design) { m_design = design; }
+  void setDesign(Design* design) {
+    m_design = design;
+    clearMemo();
+  }
   void deleteValue(Value* value) { m_valueFactory.deleteValue(value); }
   ValueFactory& getValueFactory() { return m_valueFactory; }
 
+  void clearMemo();
+  // On by default
+  void setMemoEnabled(bool enabled) {
+    m_memoEnabled = enabled;
+    clearMemo();
+  }
+
+ private:
+  // A parameter read by an evaluation, and what it resolved to
+  struct ParameterRead final {
+    std::string m_packageName;  // Empty for a parameter of the instance
+    std::string m_name;
+    bool m_complex = false;
+    Value* m_value = nullptr;  // Owned copy, null when undefined or complex
+  };
+  struct Reads final {
+    std::vector<ParameterRead> m_reads;
+    // Cleared by a value that is not in the parameter maps but built from
+    // the parameter assignments: it can't be compared without building it
+    bool m_comparable = true;
+  };
+  struct MemoEntry final {
+    std::vector<ParameterRead> m_reads;
+    Value* m_result = nullptr;  // Owned copy
+  };
+  // File content, expression, muteErrors: an undefined parameter only errors
+  // when not muted. The chunks of a split file share its file id and number
+  // their nodes from the same start, the FileContent tells them apart. The
+  // FileContents of a design outlive its compilation, clearMemo() before
+  // deleting one the memo has seen.
+  using MemoKey = std::tuple<const FileContent*, NodeId, bool>;
+
+  Value* evalMemoized_(const FileContent* fC, NodeId parent, ValuedComponentI* instance, bool muteErrors);
+  Value* evalExpr_(const FileContent* fC, NodeId parent, ValuedComponentI* instance, bool muteErrors);
+  // Value of the parameter name of instance, or of package packageName when
+  // not empty. complex is set when the parameter holds a complex value
+  // instead. Recorded for the memo entry of the evaluation in progress.
+  Value* lookupParameter_(ValuedComponentI* instance, std::string_view packageName, std::string_view name,
+                          bool withBuilder, bool& complex);
+  // Same, from the parameter maps only: doesn't allocate
+  Value* findParameter_(ValuedComponentI* instance, std::string_view packageName, std::string_view name,
+                        bool& complex) const;
+  bool sameReads_(const std::vector<ParameterRead>& reads, ValuedComponentI* instance) const;
+  void deleteReads_(std::vector<ParameterRead>& reads);
+
  private:
   Session* const m_session = nullptr;
   ValueFactory m_valueFactory;
   Design* m_design = nullptr;
+
+  // A few entries per expression, for the distinct parameter environments,
+  // and a bounded number of expressions: the memo starts over when full
+  static constexpr uint32_t MaxMemoEntriesPerExpr = 4;
+  static constexpr uint32_t MaxMemoExprs = 4096;
+  bool m_memoEnabled = true;
+  std::map<MemoKey, std::vector<MemoEntry>> m_memo;
+  bool m_evaluating = false;
+  Reads* m_reads = nullptr;           // Of the evaluation in progress, when memoized
+  std::vector<Value*> m_builtValues;  // Built by the parameter lookups of the evaluation
 };
 
 }  // namespace SURELOG
@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace SURELOG {
 
@@ -281,9 +282,15 @@ class SValue final : public Value {
   bool m_signed = false;
 };
 
+// LValues released through deleteValue() are kept for reuse by the next
+// newLValue()/newValue(LValue&) of the same factory: constant evaluation
+// creates and drops a temporary per sub-expression.
 class ValueFactory {
  public:
-  ValueFactory();
+  ValueFactory() = default;
+  ValueFactory(const ValueFactory& orig) = delete;
+  ~ValueFactory();
+
   Value* newSValue();
   Value* newLValue();
   Value* newStValue();
@@ -293,8 +300,11 @@ class ValueFactory {
   void deleteValue(Value*);
 
  protected:
-  LValue* m_headFree;
-  LValue* m_headInUse;
+  LValue* recycledLValue_();
+
+  // Bounds the memory held by an idle factory
+  static constexpr uint32_t MaxFreeLValues = 64;
+  std::vector<LValue*> m_freeLValues;
 };
 
 class LValue final : public Value {
@@ -304,6 +314,7 @@ class LValue final : public Value {
  public:
   LValue(const LValue&);
   LValue() = default;
+  LValue& operator=(const LValue&);
   LValue(Type type, SValue* values, uint16_t nbWords)
       : m_type(type), m_nbWords(nbWords), m_valueArray(values), m_valid(1), m_negative(0) {}
   explicit LValue(uint64_t val);
@@ -395,7 +406,16 @@ class LValue final : public Value {
 
   void adjust(const Value* a);
 
+  // Words of values up to this many 64 bits words are stored in the value
+  // itself
+  static constexpr uint16_t InlineWordCount = 2;
+
  private:
+  // Points m_valueArray to nbWords words, inline when they fit. The words
+  // content is undefined.
+  void allocateWords_(uint16_t nbWords);
+  void releaseWords_();
+
   Type m_type = Type::None;
   uint16_t m_nbWords = 0;
   SValue* m_valueArray = nullptr;
@@ -405,6 +425,7 @@ class LValue final : public Value {
   uint16_t m_rrange = 0;
   bool m_signed = false;
   const uhdm::Typespec* m_typespec = nullptr;
+  SValue m_inlineWords[InlineWordCount];
 };
 
 class StValue final : public Value {
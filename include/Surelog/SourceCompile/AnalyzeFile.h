@@ -72,6 +72,8 @@ class AnalyzeFile final {
   void analyze();
   const std::vector<PathId>& getSplitFiles() const { return m_splitFiles; }
   const std::vector<uint32_t>& getLineOffsets() const { return m_lineOffsets; }
+  // Design units found by the last analyze()
+  const std::vector<FileChunk>& getFileChunks() const { return m_fileChunks; }
 
   AnalyzeFile(const AnalyzeFile& orig) = delete;
   ~AnalyzeFile() = default;
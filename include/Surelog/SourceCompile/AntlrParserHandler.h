@@ -37,6 +37,7 @@ class ParseTree;
 namespace SURELOG {
 
 class AntlrParserErrorListener;
+class SV3_1aFastLexer;
 class SV3_1aLexer;
 class SV3_1aParser;
 
@@ -47,6 +48,7 @@ class AntlrParserHandler {
   bool m_clearAntlrCache = false;
   antlr4::ANTLRInputStream* m_inputStream = nullptr;
   SV3_1aLexer* m_lexer = nullptr;
+  SV3_1aFastLexer* m_fastLexer = nullptr;  // Instead of m_lexer with -fastlexer
   antlr4::CommonTokenStream* m_tokens = nullptr;
   SV3_1aParser* m_parser = nullptr;
   antlr4::tree::ParseTree* m_tree = nullptr;
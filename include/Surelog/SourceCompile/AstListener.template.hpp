@@ -66,36 +66,36 @@
 namespace SURELOG {
 class AstListener;
 class Session;
-class VObject;
+class VObjectStore;
 struct AstNodeEqualityComparer;
 struct AstNodeHash;
 struct AstNodeLessComparer;
 
 class AstNode final {
  public:
-  AstNode() : m_index(), m_object(nullptr) {}
-  AstNode(const AstNode& node) : m_index(node.m_index), m_object(node.m_object) {}
-  AstNode(const NodeId& index, const VObject* const object) : m_index(index), m_object(object) {}
+  AstNode() : m_index(), m_objects(nullptr) {}
+  AstNode(const AstNode& node) : m_index(node.m_index), m_objects(node.m_objects) {}
+  AstNode(const NodeId& index, const VObjectStore* const objects) : m_index(index), m_objects(objects) {}
 
   AstNode& operator=(const AstNode& rhs) {
     if (this != &rhs) {
       m_index = rhs.m_index;
-      m_object = rhs.m_object;
+      m_objects = rhs.m_objects;
     }
     return *this;
   }
 
-  bool operator==(const AstNode& rhs) const { return (m_index == rhs.m_index) && (m_object == rhs.m_object); }
+  bool operator==(const AstNode& rhs) const { return (m_index == rhs.m_index) && (m_objects == rhs.m_objects); }
 
-  bool operator!=(const AstNode& rhs) const { return (m_index != rhs.m_index) || (m_object != rhs.m_object); }
+  bool operator!=(const AstNode& rhs) const { return (m_index != rhs.m_index) || (m_objects != rhs.m_objects); }
 
  public:
-  operator bool() const { return m_index && (m_object != nullptr); }
+  operator bool() const { return m_index && (m_objects != nullptr); }
   operator NodeId() const { return m_index; }
 
  private:
   NodeId m_index;
-  const VObject* m_object = nullptr;
+  const VObjectStore* m_objects = nullptr;
 
   friend class AstListener;
   friend struct AstNodeHash;
@@ -105,7 +105,7 @@ class AstNode final {
 
 struct AstNodeEqualityComparer final {
   bool operator()(const AstNode& lhs, const AstNode& rhs) const {
-    return (lhs.m_index == rhs.m_index) && (lhs.m_object == rhs.m_object);
+    return (lhs.m_index == rhs.m_index) && (lhs.m_objects == rhs.m_objects);
   }
 };
 
@@ -191,7 +191,6 @@ class AstListener {
     T* const listener = new T(args...);
     listener->m_session = m_session;
     listener->m_objects = m_objects;
-    listener->m_count = m_count;
     return listener;
   }
 
@@ -199,7 +198,7 @@ class AstListener {
   void listenChildren(const AstNode& node);
   void listenSiblings(const AstNode& node);
 
-  void listen(Session* session, PathId fileId, const std::string& sourceText, const VObject* objects, size_t count);
+  void listen(Session* session, PathId fileId, const std::string& sourceText, const VObjectStore& objects);
 
   VObjectType getNodeType(const AstNode& node) const;
   AstNode getRootNode() const;
@@ -281,8 +280,7 @@ class AstListener {
  private:
   NodeIdSet m_visited;
 
-  const VObject* m_objects = nullptr;
-  size_t m_count = 0;
+  const VObjectStore* m_objects = nullptr;
 };
 
 inline AstNodeIterationHelper::Iterator& AstNodeIterationHelper::Iterator::operator++() {
@@ -68,12 +68,16 @@ class CommonListenerHelper {
   FileContent* getFileContent() { return m_fileContent; }
   const FileContent* getFileContent() const { return m_fileContent; }
 
+  // Forgets the contexts below an already visited subtree and frees their
+  // children lists. Only the node of the subtree root remains resolvable.
+  void releaseSubTree(antlr4::tree::ParseTree* tree);
+
  protected:
   virtual SymbolId registerSymbol(std::string_view symbol) = 0;
 
   NodeId NodeIdFromContext(const antlr4::tree::ParseTree* tree) const;
 
-  const VObject& Object(NodeId index);
+  VObject Object(NodeId index);
 
   NodeId UniqueId(NodeId index) const;
 
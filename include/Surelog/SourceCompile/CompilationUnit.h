@@ -31,6 +31,8 @@
 #include <Surelog/Design/TimeInfo.h>
 #include <Surelog/SourceCompile/VObjectTypes.h>
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 #include <vector>
@@ -60,20 +62,19 @@ class CompilationUnit {
   std::vector<TimeInfo>& getTimeInfo() { return m_timeInfo; }
   void recordTimeInfo(TimeInfo& info);
   TimeInfo& getTimeInfo(PathId fileId, uint32_t line);
+  // Same, from the first count records only
+  TimeInfo& getTimeInfo(PathId fileId, uint32_t line, size_t count);
 
   /* Following methods deal with `default_nettype */
   std::vector<NetTypeInfo>& getDefaultNetType() { return m_defaultNetTypes; }
   void recordDefaultNetType(NetTypeInfo& info);
   VObjectType getDefaultNetType(PathId fileId, uint32_t line);
+  // Same, from the first count records only
+  VObjectType getDefaultNetType(PathId fileId, uint32_t line, size_t count);
 
-  NodeId generateUniqueDesignElemId() {
-    m_uniqueIdGenerator++;
-    return m_uniqueIdGenerator;
-  }
-  NodeId generateUniqueNodeId() {
-    m_uniqueNodeIdGenerator++;
-    return m_uniqueNodeIdGenerator;
-  }
+  // The chunks of a split file are walked in parallel
+  NodeId generateUniqueDesignElemId() { return NodeId(++m_uniqueIdGenerator); }
+  NodeId generateUniqueNodeId() { return NodeId(++m_uniqueNodeIdGenerator); }
 
  private:
   const bool m_fileUnit;
@@ -86,8 +87,8 @@ class CompilationUnit {
   TimeInfo m_noTimeInfo;
 
   /* Design Info helper data */
-  NodeId m_uniqueIdGenerator;
-  NodeId m_uniqueNodeIdGenerator;
+  std::atomic<RawNodeId> m_uniqueIdGenerator = InvalidRawNodeId;
+  std::atomic<RawNodeId> m_uniqueNodeIdGenerator = InvalidRawNodeId;
 };
 
 };  // namespace SURELOG
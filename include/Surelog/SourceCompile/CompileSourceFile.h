@@ -106,6 +106,17 @@ class CompileSourceFile final {
   ParseFile* getParser() const { return m_parser; }
   PreprocessFile* getPreprocessor() const { return m_pp; }
 
+  // Estimated bytes held by the ANTLR input and token streams of this file
+  // and of its includes and macros.
+  uint64_t getAntlrMemoryUsage() const;
+  static uint64_t getAntlrMemoryUsage(const PreprocessFile::AntlrParserHandler* handler);
+
+  // Estimated bytes held by the preprocessor parse trees still alive, those
+  // of includes and macro bodies. The trees of the files themselves are
+  // released right after their listener walk.
+  uint64_t getAntlrTreeMemoryUsage() const;
+  static uint64_t getAntlrTreeMemoryUsage(const PreprocessFile::AntlrParserHandler* handler);
+
   const uhdm::PreprocMacroInstanceCollection& getPreprocMacroInstances() const { return m_preprocMacroInstances; }
 
  private:
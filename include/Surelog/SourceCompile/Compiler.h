@@ -30,6 +30,7 @@ limitations under the License.
 #include <Surelog/ErrorReporting/ErrorContainer.h>
 #include <Surelog/SourceCompile/CompileSourceFile.h>
 #include <Surelog/SourceCompile/PreprocessFile.h>
+#include <Surelog/Utils/MemoryStats.h>
 #include <uhdm/Serializer.h>
 #include <uhdm/vpi_user.h>
 
@@ -118,6 +119,13 @@ class Compiler {
   void writeUhdmSourceFiles();
   void writePreprocMacroInstances();
 
+  // Waits for the background cache writes, warns about the failed ones
+  void drainCacheWriter_();
+
+  // -memstats: bytes held by the major structures alive at this point
+  MemoryStats::Counts getMemoryCounts_() const;
+  void recordMemoryStats_(std::string_view phase);
+
  private:
   uhdm::Serializer m_serializer;
   Session* const m_session = nullptr;
@@ -136,6 +144,7 @@ class Compiler {
   CompileDesign* m_compileDesign;
   PPFileMap m_ppFileMap;
   std::mutex m_serializerMutex;
+  MemoryStats m_memoryStats;
 #ifdef USETBB
   tbb::task_group m_taskGroup;
 #endif
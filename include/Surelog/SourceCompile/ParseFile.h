@@ -27,7 +27,9 @@
 
 #include <Surelog/Common/PathId.h>
 #include <Surelog/Common/SymbolId.h>
+#include <Surelog/Design/TimeInfo.h>
 #include <Surelog/ErrorReporting/Error.h>
+#include <Surelog/SourceCompile/VObjectTypes.h>
 
 #include <cstdint>
 #include <string>
@@ -38,6 +40,7 @@
 namespace SURELOG {
 class AntlrParserErrorListener;
 class AntlrParserHandler;
+class CommonListenerHelper;
 class CompilationUnit;
 class CompileSourceFile;
 class FileContent;
@@ -116,6 +119,13 @@ class ParseFile final {
 
   const std::string& getSourceText() const { return m_sourceText; }
 
+  // `timescale and `default_nettype records of the compilation unit, as
+  // seen from the current walk position
+  void recordTimeInfo(TimeInfo& info);
+  TimeInfo& getTimeInfo(PathId fileId, uint32_t line);
+  void recordDefaultNetType(NetTypeInfo& info);
+  VObjectType getDefaultNetType(PathId fileId, uint32_t line);
+
  private:
   struct LocationCacheEntry final {
     uint32_t m_column = 0;  // Line in preprocess file
@@ -131,6 +141,13 @@ class ParseFile final {
   using location_cache_t = std::vector<location_cache_entry_t>;
 
   bool parseOneFile_(PathId fileId, uint32_t lineOffset);
+  // (Re)creates m_listener for this file or chunk
+  CommonListenerHelper* createListener_();
+  // Records the directives of a re-parsed chunk in the compilation unit,
+  // before the chunks are walked
+  void recordChunkDirectives_();
+  // Builds the file content of a re-parsed chunk from its parse tree
+  bool walkChunk_(bool saveCache);
   void buildLocationCache();
   void buildLocationCache_recurse(uint32_t index);
   void printLocationCache() const;
@@ -154,6 +171,10 @@ class ParseFile final {
   std::vector<ParseFile*> m_children;
   ParseFile* const m_parent = nullptr;
   uint32_t m_offsetLine = 0;
+  // Compilation unit records the walk of a chunk sees, those of the chunks
+  // before it and its own up to the walk position. -1 when not a chunk
+  int32_t m_timeInfoCount = -1;
+  int32_t m_netTypeCount = -1;
   std::string m_profileInfo;
   std::string m_sourceText;  // For Unit tests
   location_cache_t m_locationCache;
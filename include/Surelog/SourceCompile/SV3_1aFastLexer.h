@@ -0,0 +1,112 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_SV3_1AFASTLEXER_H
+#define SURELOG_SV3_1AFASTLEXER_H
+#pragma once
+
+#include <antlr4-runtime.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace SURELOG {
+
+/*
+ * class SV3_1aFastLexer
+ *
+ * Hand written equivalent of the ANTLR generated SV3_1aLexer (see
+ * grammar/SV3_1aLexer.g4). Produces the very same token stream: types,
+ * channels, start/stop indices, lines and columns, including the longest
+ * match and rule order tie breaking of the generated lexer.
+ *
+ * Instead of walking the lexer DFA one character at a time, tokens are
+ * recognized by dispatching on their first character; keywords are found
+ * with a single probe in a perfect hash table and long runs (blanks,
+ * comments, identifiers) are scanned in bulk.
+ *
+ * Any change to the lexer grammar has to be reflected here, the
+ * differential test in SV3_1aFastLexer_test.cpp compares both lexers.
+ */
+class SV3_1aFastLexer final : public antlr4::TokenSource {
+ public:
+  explicit SV3_1aFastLexer(antlr4::CharStream* input);
+  SV3_1aFastLexer(const SV3_1aFastLexer& orig) = delete;
+  ~SV3_1aFastLexer() final = default;
+
+  // Same as the generated SV3_1aLexer::sverilog, gates the SystemVerilog
+  // only keywords.
+  void setSVerilog(bool sverilog) { m_sverilog = sverilog; }
+  bool getSVerilog() const { return m_sverilog; }
+
+  std::unique_ptr<antlr4::Token> nextToken() final;
+  size_t getLine() const final { return m_line; }
+  size_t getCharPositionInLine() final { return m_column; }
+  antlr4::CharStream* getInputStream() final { return m_input; }
+  std::string getSourceName() final { return m_input->getSourceName(); }
+  antlr4::TokenFactory<antlr4::CommonToken>* getTokenFactory() final;
+
+ private:
+  static constexpr uint32_t kEndOfInput = 0xFFFFFFFF;
+
+  uint32_t at(size_t index) const { return (index < m_text.size()) ? m_text[index] : kEndOfInput; }
+
+  // Each returns the length of the longest match of its rule(s) starting at
+  // index, 0 when there is none.
+  size_t matchLiteral(size_t index, size_t* type) const;
+  size_t matchIdentifier(size_t index) const;
+  size_t matchUnsignedNumber(size_t index) const;
+  size_t matchBasedNumber(size_t index) const;
+  size_t matchIntegralNumber(size_t index) const;
+  size_t matchRealNumber(size_t index) const;
+  size_t matchDelay(size_t index, size_t pounds) const;
+  size_t matchQuotedString(size_t index) const;
+  size_t matchDelimited(size_t index, std::u32string_view open, std::u32string_view close) const;
+  size_t matchLineComment(size_t index) const;
+  size_t matchPreprocMarker(size_t index, size_t* type) const;
+  size_t matchAtStar(size_t index, size_t* type) const;
+  size_t matchPreprocIdentifier(size_t index) const;
+  size_t matchAssociativeUnspecified(size_t index) const;
+  size_t matchMacroNotDefined(size_t index) const;
+
+  size_t skipBlanks(size_t index) const;
+  size_t skipWhiteSpace(size_t index) const;
+  size_t findNewline(size_t index) const;
+
+  // Type of the identifier [index, index + length), keyword or
+  // SIMPLE_IDENTIFIER.
+  size_t identifierType(size_t index, size_t length) const;
+
+  // Longest match at m_index: (type, length).
+  std::pair<size_t, size_t> recognize() const;
+
+ private:
+  antlr4::CharStream* const m_input;
+  std::pair<antlr4::TokenSource*, antlr4::CharStream*> m_sourcePair;
+  std::u32string m_text;  // Code points, as indexed by the ANTLR tokens
+  size_t m_index = 0;
+  size_t m_line = 1;
+  size_t m_column = 0;
+  bool m_sverilog = true;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_SV3_1AFASTLEXER_H */
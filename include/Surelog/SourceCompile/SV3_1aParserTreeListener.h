@@ -25,6 +25,7 @@
 #define SURELOG_SV3_1APARSERTREELISTENER_H
 #pragma once
 
+#include <Surelog/Design/VObjectStore.h>
 #include <Surelog/SourceCompile/SV3_1aTreeShapeHelper.h>
 #include <parser/SV3_1aParserBaseListener.h>
 
@@ -38,7 +39,7 @@ namespace SURELOG {
 class Session;
 
 class SV3_1aParserTreeListener final : public SV3_1aParserBaseListener, public SV3_1aTreeShapeHelper {
-  using vobjects_t = std::vector<VObject>;
+  using vobjects_t = VObjectStore;
 
   using visited_tokens_t = std::set<const antlr4::Token*>;
   using preproc_begin_statck_t = std::vector<antlr4::Token*>;
@@ -68,7 +69,7 @@ class SV3_1aParserTreeListener final : public SV3_1aParserBaseListener, public S
   std::optional<bool> isUnaryOperator(const antlr4::tree::TerminalNode* node) const;
 
   void overrideLocation(NodeId nodeId, antlr4::Token* token);
-  void applyLocationOffsets(VObject& object);
+  void applyLocationOffsets(VObjectStore::Location& object);
   void applyLocationOffsets();
 
   void visitPreprocBegin(antlr4::Token* token);
@@ -29,6 +29,7 @@
 #include <Surelog/Common/PathId.h>
 #include <Surelog/Common/SymbolId.h>
 #include <Surelog/Design/DesignElement.h>
+#include <Surelog/Design/TimeInfo.h>
 #include <Surelog/ErrorReporting/ErrorDefinition.h>
 #include <Surelog/ErrorReporting/Location.h>
 #include <Surelog/SourceCompile/CommonListenerHelper.h>
@@ -59,6 +60,14 @@ class SV3_1aTreeShapeHelper : public CommonListenerHelper {
  public:
   ~SV3_1aTreeShapeHelper() override = default;
 
+  // Records of the `timescale and `default_nettype directives of pf. Split
+  // file chunks record theirs ahead of their walks, see ParseFile::parse.
+  // Invalid values are reported to reporter, if any.
+  static TimeInfo getTimescaleInfo(ParseFile* pf, SV3_1aParser::Timescale_directiveContext* ctx,
+                                   SV3_1aTreeShapeHelper* reporter);
+  static NetTypeInfo getDefaultNetTypeInfo(ParseFile* pf, antlr4::CommonTokenStream* tokens,
+                                           SV3_1aParser::Default_nettype_directiveContext* ctx);
+
  protected:
   void logError(ErrorDefinition::ErrorType error, antlr4::ParserRuleContext* ctx, std::string_view object,
                 bool printColumn = false);
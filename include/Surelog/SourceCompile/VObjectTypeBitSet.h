@@ -0,0 +1,82 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_VOBJECTTYPEBITSET_H
+#define SURELOG_VOBJECTTYPEBITSET_H
+#pragma once
+
+#include <Surelog/SourceCompile/VObjectTypes.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace SURELOG {
+
+// Fixed size set of VObjectType usable in constant expressions.
+// Membership is a single word lookup, unlike VObjectTypeUnorderedSet.
+class VObjectTypeBitSet final {
+ public:
+  static constexpr size_t kTypeCount = static_cast<size_t>(VObjectType::paForcedIndexEnd) + 1;
+
+  constexpr VObjectTypeBitSet() = default;
+  constexpr VObjectTypeBitSet(std::initializer_list<VObjectType> types) {
+    for (VObjectType type : types) insert(type);
+  }
+  explicit VObjectTypeBitSet(const VObjectTypeUnorderedSet& types) {
+    for (VObjectType type : types) insert(type);
+  }
+
+  constexpr void insert(VObjectType type) {
+    const size_t index = static_cast<size_t>(type);
+    m_words[index / kWordBits] |= uint64_t(1) << (index % kWordBits);
+  }
+
+  constexpr bool contains(VObjectType type) const {
+    const size_t index = static_cast<size_t>(type);
+    return (m_words[index / kWordBits] & (uint64_t(1) << (index % kWordBits))) != 0;
+  }
+
+  constexpr bool empty() const {
+    for (uint64_t word : m_words) {
+      if (word != 0) return false;
+    }
+    return true;
+  }
+
+  // Invokes fn(VObjectType) for every member, in increasing type order.
+  template <typename FunctorType>
+  void forEach(FunctorType fn) const {
+    for (size_t i = 0; i < kWordCount; ++i) {
+      const uint64_t word = m_words[i];
+      if (word == 0) continue;
+      for (size_t bit = 0; bit < kWordBits; ++bit) {
+        if ((word >> bit) & 1) fn(static_cast<VObjectType>((i * kWordBits) + bit));
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kWordBits = 64;
+  static constexpr size_t kWordCount = (kTypeCount + kWordBits - 1) / kWordBits;
+
+  std::array<uint64_t, kWordCount> m_words{};
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_VOBJECTTYPEBITSET_H */
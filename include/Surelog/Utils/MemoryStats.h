@@ -0,0 +1,67 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_MEMORYSTATS_H
+#define SURELOG_MEMORYSTATS_H
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SURELOG {
+
+/*
+ * class MemoryStats
+ *
+ * Memory use of the process at the compilation phase boundaries, enabled
+ * by -memstats <file>: the resident set size, its peak so far, and the
+ * bytes held by the major structures alive at that point.
+ */
+class MemoryStats final {
+ public:
+  using Counts = std::vector<std::pair<std::string_view, uint64_t>>;
+
+  struct Phase final {
+    std::string m_name;
+    uint64_t m_residentSetSize = 0;
+    uint64_t m_peakResidentSetSize = 0;
+    Counts m_counts;  // Structure name, bytes
+  };
+
+  // In bytes, 0 when the platform doesn't tell
+  static uint64_t getResidentSetSize();
+  static uint64_t getPeakResidentSetSize();
+
+  // Records the process memory at the end of the named phase.
+  const Phase& addPhase(std::string_view name, Counts&& counts);
+  const std::vector<Phase>& getPhases() const { return m_phases; }
+
+  // One line per phase, sizes in MB
+  static std::string toString(const Phase& phase);
+  // {"phases": [{"name", "rss", "peak_rss", "counts": {...}}, ...]}, sizes
+  // in bytes
+  std::string toJson() const;
+
+ private:
+  std::vector<Phase> m_phases;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_MEMORYSTATS_H */
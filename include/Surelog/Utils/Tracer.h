@@ -0,0 +1,106 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#ifndef SURELOG_TRACER_H
+#define SURELOG_TRACER_H
+#pragma once
+
+#include <Surelog/Common/PathId.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace SURELOG {
+
+class FileSystem;
+
+/*
+ * class Tracer
+ *
+ * Records the timeline of the compilation, enabled by -trace <file>: one
+ * span per compiler phase and per unit of work (file, chunk, design
+ * component...), tagged with the thread that ran it. The spans are written
+ * in the Chrome trace event format, which chrome://tracing and
+ * ui.perfetto.dev display.
+ *
+ * A disabled tracer records nothing, spans then cost a pointer test.
+ */
+class Tracer final {
+ public:
+  // Times the enclosing scope, or up to end().
+  // category and name must outlive the tracer (string literals), detail is
+  // copied.
+  class Span final {
+   public:
+    Span(Tracer* tracer, std::string_view category, std::string_view name, std::string_view detail = {});
+    Span(const Span& orig) = delete;
+    ~Span() { end(); }
+
+    void end();
+
+   private:
+    Tracer* m_tracer = nullptr;  // Null when disabled or ended
+    std::string_view m_category;
+    std::string_view m_name;
+    std::string m_detail;
+    uint64_t m_begin = 0;
+  };
+
+  Tracer() = default;
+  Tracer(const Tracer& orig) = delete;
+  ~Tracer();  // Writes the trace when not written yet
+
+  // Starts recording, the calling thread is reported as the main thread.
+  void enable(FileSystem* fileSystem, PathId fileId);
+  bool enabled() const { return m_enabled; }
+
+  // Writes the spans recorded so far.
+  bool write();
+
+ private:
+  struct Event final {
+    std::string_view m_category;
+    std::string_view m_name;
+    std::string m_detail;
+    uint64_t m_begin = 0;  // In us since enable()
+    uint64_t m_duration = 0;
+    uint32_t m_threadIndex = 0;
+  };
+
+  uint64_t now() const;
+  void record(std::string_view category, std::string_view name, std::string&& detail, uint64_t begin);
+
+ private:
+  bool m_enabled = false;
+  bool m_written = false;
+  FileSystem* m_fileSystem = nullptr;
+  PathId m_fileId;
+  std::chrono::steady_clock::time_point m_origin;
+
+  std::mutex m_mutex;
+  std::vector<Event> m_events;
+  std::map<std::thread::id, uint32_t> m_threadIndexes;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_TRACER_H */
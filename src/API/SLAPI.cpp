@@ -365,12 +365,14 @@ uint32_t SLgetnProgramDefinition(Design* design) {
 
 uint32_t SLgetnPackageDefinition(Design* design) {
   if (!design) return 0;
-  return design->getPackageDefinitions().size();
+  uint32_t count = 0;
+  for (const auto& [id, packages] : design->getPackageDefinitions()) count += packages.size();
+  return count;
 }
 
 uint32_t SLgetnClassDefinition(Design* design) {
   if (!design) return 0;
-  return design->getUniqueClassDefinitions().size();
+  return design->getClassDefinitions().size();
 }
 
 uint32_t SLgetnTopModuleInstance(Design* design) {
@@ -378,32 +380,33 @@ uint32_t SLgetnTopModuleInstance(Design* design) {
   return design->getTopLevelModuleInstances().size();
 }
 
+// The definitions are indexed in name order
+
 ModuleDefinition* SLgetModuleDefinition(Design* design, uint32_t index) {
   if (!design) return nullptr;
-  ModuleNameModuleDefinitionMap::iterator itr = design->getModuleDefinitions().begin();
-  for (uint32_t i = 0; i < index; i++) itr++;
-  return (*itr).second;
+  const auto modules = design->sortedByName(design->getModuleDefinitions());
+  return (index < modules.size()) ? modules[index].second : nullptr;
 }
 
 Program* SLgetProgramDefinition(Design* design, uint32_t index) {
   if (!design) return nullptr;
-  ProgramNameProgramDefinitionMap::iterator itr = design->getProgramDefinitions().begin();
-  for (uint32_t i = 0; i < index; i++) itr++;
-  return (*itr).second;
+  const auto programs = design->sortedByName(design->getProgramDefinitions());
+  return (index < programs.size()) ? programs[index].second : nullptr;
 }
 
 Package* SLgetPackageDefinition(Design* design, uint32_t index) {
   if (!design) return nullptr;
-  PackageNamePackageDefinitionMultiMap::iterator itr = design->getPackageDefinitions().begin();
-  for (uint32_t i = 0; i < index; i++) itr++;
-  return (*itr).second;
+  for (const auto& [name, packages] : design->sortedByName(design->getPackageDefinitions())) {
+    if (index < packages.size()) return packages[index];
+    index -= packages.size();
+  }
+  return nullptr;
 }
 
 ClassDefinition* SLgetClassDefinition(Design* design, uint32_t index) {
   if (!design) return nullptr;
-  ClassNameClassDefinitionMap::iterator itr = design->getUniqueClassDefinitions().begin();
-  for (uint32_t i = 0; i < index; i++) itr++;
-  return (*itr).second;
+  const auto classes = design->sortedByName(design->getClassDefinitions());
+  return (index < classes.size()) ? classes[index].second : nullptr;
 }
 
 ModuleInstance* SLgetTopModuleInstance(Design* design, uint32_t index) {
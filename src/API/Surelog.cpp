@@ -25,6 +25,7 @@
 #include "Surelog/Common/Session.h"
 #include "Surelog/Design/Design.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/DesignCompile/CompileDesign.h"
 #include "Surelog/SourceCompile/AstListener.h"
 #include "Surelog/SourceCompile/CompileSourceFile.h"
@@ -80,23 +81,22 @@ void walk(scompiler* compiler, AstListener* listener) {
     ParseFile* const parser = csf->getParser();
     FileContent* const fC = parser->getFileContent();
     if (listener->shouldWalkSourceFile(fC->getSession(), fC->getFileId())) {
-      const std::vector<VObject>& objects = fC->getVObjects();
-      listener->listen(fC->getSession(), fC->getFileId(), parser->getSourceText(), objects.data(), objects.size());
+      listener->listen(fC->getSession(), fC->getFileId(), parser->getSourceText(), fC->getVObjects());
     }
   }
 }
 
 static bool isSpace(VObjectType type) { return (type == VObjectType::WHITE_SPACE) || (type == VObjectType::CR); }
 
-static NodeId skipSpace(NodeId nodeId, const std::vector<VObject>& objects) {
-  while (nodeId && isSpace(objects[nodeId].m_type)) {
-    nodeId = objects[nodeId].m_sibling;
+static NodeId skipSpace(NodeId nodeId, const VObjectStore& objects) {
+  while (nodeId && isSpace(objects.type(nodeId))) {
+    nodeId = objects.sibling(nodeId);
   }
   return nodeId;
 }
 
-static bool compareTrees(NodeId nodeIdA, const std::vector<VObject>& objectsA, NodeId nodeIdB,
-                         const std::vector<VObject>& objectsB) {
+static bool compareTrees(NodeId nodeIdA, const VObjectStore& objectsA, NodeId nodeIdB,
+                         const VObjectStore& objectsB) {
   if (!nodeIdA && !nodeIdB) {
     // Both nodes are null
     return true;
@@ -107,21 +107,21 @@ static bool compareTrees(NodeId nodeIdA, const std::vector<VObject>& objectsA, N
     return false;
   }
 
-  if (objectsA[nodeIdA].m_type != objectsB[nodeIdB].m_type) {
+  if (objectsA.type(nodeIdA) != objectsB.type(nodeIdB)) {
     // Type mismatch
     return false;
   }
 
-  nodeIdA = skipSpace(objectsA[nodeIdA].m_child, objectsA);
-  nodeIdB = skipSpace(objectsB[nodeIdB].m_child, objectsB);
+  nodeIdA = skipSpace(objectsA.child(nodeIdA), objectsA);
+  nodeIdB = skipSpace(objectsB.child(nodeIdB), objectsB);
 
   while (nodeIdA || nodeIdB) {
     if (!compareTrees(nodeIdA, objectsA, nodeIdB, objectsB)) {
       return false;
     }
 
-    nodeIdA = skipSpace(objectsA[nodeIdA].m_sibling, objectsA);
-    nodeIdB = skipSpace(objectsB[nodeIdB].m_sibling, objectsB);
+    nodeIdA = skipSpace(objectsA.sibling(nodeIdA), objectsA);
+    nodeIdB = skipSpace(objectsB.sibling(nodeIdB), objectsB);
   }
 
   return true;
@@ -154,10 +154,10 @@ bool compareParserOutputs(scompiler* lhs, scompiler* rhs) {
     const FileContent* const rhsFC = fc;
 
     NodeId lhsRootNode = lhsFC->getRootNode();
-    const std::vector<VObject>& lhsObjects = lhsFC->getVObjects();
+    const VObjectStore& lhsObjects = lhsFC->getVObjects();
 
     NodeId rhsRootNode = rhsFC->getRootNode();
-    const std::vector<VObject>& rhsObjects = rhsFC->getVObjects();
+    const VObjectStore& rhsObjects = rhsFC->getVObjects();
 
     if (!compareTrees(lhsRootNode, lhsObjects, rhsRootNode, rhsObjects)) {
       return false;
@@ -0,0 +1,536 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/Cache/AntlrDFACache.h"
+
+#include <antlr4-runtime.h>
+#include <capnp/list.h>
+#include <capnp/serialize-packed.h>
+#include <fcntl.h>
+#include <parser/SV3_1aLexer.h>
+#include <parser/SV3_1aParser.h>
+#include <parser/SV3_1aPpLexer.h>
+#include <parser/SV3_1aPpParser.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Surelog/Cache/CacheWriter.h"
+#include "Surelog/CommandLine/CommandLineParser.h"
+#include "Surelog/Common/FileSystem.h"
+#include "Surelog/Common/PathId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
+
+#if defined(_MSC_VER)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace SURELOG {
+static constexpr char kSchemaVersion[] = "1.0";
+static constexpr std::string_view kCacheFileName = "antlr.dfa";
+static constexpr uint32_t kNoIndex = std::numeric_limits<uint32_t>::max();
+
+namespace {
+using antlr4::atn::ATN;
+using antlr4::atn::ATNConfig;
+using antlr4::atn::ATNConfigSet;
+using antlr4::atn::PredictionContext;
+using antlr4::dfa::DFA;
+using antlr4::dfa::DFAState;
+
+// The decision DFAs live in the static data of the generated parsers and
+// are shared by all their instances, a throwaway instance gives access.
+template <typename LexerType, typename ParserType, typename FunctorType>
+void withGrammar(FunctorType fn) {
+  antlr4::ANTLRInputStream input;
+  LexerType lexer(&input);
+  antlr4::CommonTokenStream tokens(&lexer);
+  ParserType parser(&tokens);
+  fn(lexer, parser, parser.template getInterpreter<antlr4::atn::ParserATNSimulator>()->decisionToDFA);
+}
+
+template <typename FunctorType>
+void forEachGrammar(FunctorType fn) {
+  withGrammar<SV3_1aLexer, SV3_1aParser>(fn);
+  withGrammar<SV3_1aPpLexer, SV3_1aPpParser>(fn);
+}
+
+// FNV-1a over the ATN and the token vocabulary: DFA state configurations
+// refer to ATN state numbers and DFA edges to token types, so any grammar
+// change, a relabeled transition included, has to invalidate them.
+class GrammarHasher final {
+ public:
+  uint64_t hash(const antlr4::Lexer& lexer, const antlr4::Parser& parser) {
+    const ATN& atn = parser.getATN();
+    mix(static_cast<uint64_t>(atn.grammarType));
+    mix(atn.maxTokenType);
+    mix(atn.decisionToState.size());
+    for (const antlr4::atn::ATNState* state : atn.states) {
+      if (state == nullptr) {
+        mix(kNoIndex);
+        continue;
+      }
+      mix(static_cast<uint64_t>(state->getStateType()));
+      mix(state->ruleIndex);
+      for (const auto& transition : state->transitions) {
+        mixTransition(transition.get());
+      }
+    }
+    mixVocabulary(lexer.getVocabulary());
+    mixVocabulary(parser.getVocabulary());
+    for (const std::string& name : parser.getRuleNames()) {
+      mix(name);
+    }
+    return m_hash;
+  }
+
+ private:
+  void mix(uint64_t value) {
+    for (int32_t i = 0; i < 8; ++i) {
+      m_hash ^= (value >> (i * 8)) & 0xFF;
+      m_hash *= 0x100000001b3ULL;
+    }
+  }
+
+  void mix(std::string_view text) {
+    mix(text.size());
+    for (char c : text) {
+      m_hash ^= static_cast<uint8_t>(c);
+      m_hash *= 0x100000001b3ULL;
+    }
+  }
+
+  void mixTransition(const antlr4::atn::Transition* transition) {
+    using antlr4::atn::TransitionType;
+    mix(static_cast<uint64_t>(transition->getTransitionType()));
+    mix(transition->target->stateNumber);
+    // Atom, range, set and not set labels
+    const antlr4::misc::IntervalSet label = transition->label();
+    for (const antlr4::misc::Interval& interval : label.getIntervals()) {
+      mix(static_cast<uint64_t>(interval.a));
+      mix(static_cast<uint64_t>(interval.b));
+    }
+    switch (transition->getTransitionType()) {
+      case TransitionType::RULE: {
+        const auto* rule = static_cast<const antlr4::atn::RuleTransition*>(transition);
+        mix(rule->ruleIndex);
+        mix(static_cast<uint64_t>(rule->precedence));
+        mix(rule->followState->stateNumber);
+        break;
+      }
+      case TransitionType::PREDICATE: {
+        const auto* predicate = static_cast<const antlr4::atn::PredicateTransition*>(transition);
+        mix(predicate->getRuleIndex());
+        mix(predicate->getPredIndex());
+        mix(static_cast<uint64_t>(predicate->isCtxDependent()));
+        break;
+      }
+      case TransitionType::PRECEDENCE: {
+        const auto* precedence = static_cast<const antlr4::atn::PrecedencePredicateTransition*>(transition);
+        mix(static_cast<uint64_t>(precedence->getPrecedence()));
+        break;
+      }
+      case TransitionType::ACTION: {
+        const auto* action = static_cast<const antlr4::atn::ActionTransition*>(transition);
+        mix(action->ruleIndex);
+        mix(action->actionIndex);
+        mix(static_cast<uint64_t>(action->isCtxDependent));
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  void mixVocabulary(const antlr4::dfa::Vocabulary& vocabulary) {
+    const size_t maxTokenType = vocabulary.getMaxTokenType();
+    mix(maxTokenType);
+    for (size_t type = 0; type <= maxTokenType; ++type) {
+      mix(vocabulary.getLiteralName(type));
+      mix(vocabulary.getSymbolicName(type));
+    }
+  }
+
+ private:
+  uint64_t m_hash = 0xcbf29ce484222325ULL;
+};
+
+uint64_t hashGrammar(const antlr4::Lexer& lexer, const antlr4::Parser& parser) {
+  return GrammarHasher().hash(lexer, parser);
+}
+
+size_t countStates(const std::vector<DFA>& dfas) {
+  size_t count = 0;
+  for (const DFA& dfa : dfas) {
+    count += dfa.states.size();
+    if (dfa.isPrecedenceDfa() && (dfa.s0 != nullptr)) count += dfa.s0->edges.size();
+  }
+  return count;
+}
+
+// Predicated DFAs are not cached, their semantic contexts would need to be
+// serialized too and Surelog's grammars hardly use any.
+bool isCachable(const DFAState* state) {
+  if ((state->configs == nullptr) || !state->predicates.empty()) return false;
+  for (const auto& config : state->configs->configs) {
+    if (config->semanticContext != antlr4::atn::SemanticContext::Empty::Instance) return false;
+  }
+  return true;
+}
+
+class GrammarWriter final {
+ public:
+  explicit GrammarWriter(::AntlrGrammar::Builder builder) : m_builder(builder) {}
+
+  void write(std::string_view name, uint64_t atnHash, const std::vector<DFA>& dfas) {
+    m_builder.setName(std::string(name));
+    m_builder.setAtnHash(atnHash);
+
+    std::vector<const DFA*> cachable;
+    for (const DFA& dfa : dfas) {
+      if (dfa.states.empty() && (!dfa.isPrecedenceDfa() || (dfa.s0 == nullptr) || dfa.s0->edges.empty())) continue;
+      bool ok = true;
+      for (const DFAState* state : dfa.states) {
+        ok = ok && isCachable(state);
+      }
+      if (ok) cachable.emplace_back(&dfa);
+    }
+
+    ::capnp::List<::AntlrDFA>::Builder targetDFAs = m_builder.initDfas(cachable.size());
+    for (size_t i = 0, ni = cachable.size(); i < ni; ++i) {
+      writeDFA(targetDFAs[i], *cachable[i]);
+    }
+
+    ::capnp::List<::AntlrPredictionContext>::Builder targetContexts = m_builder.initContexts(m_contexts.size());
+    for (size_t i = 0, ni = m_contexts.size(); i < ni; ++i) {
+      const PredictionContext* const context = m_contexts[i];
+      ::AntlrPredictionContext::Builder target = targetContexts[i];
+      ::capnp::List<uint32_t>::Builder parents = target.initParents(context->size());
+      ::capnp::List<uint32_t>::Builder returnStates = target.initReturnStates(context->size());
+      for (size_t j = 0, nj = context->size(); j < nj; ++j) {
+        const PredictionContext* const parent = context->getParent(j).get();
+        parents.set(j, (parent == nullptr) ? kNoIndex : m_contextIndices.at(parent));
+        returnStates.set(j, static_cast<uint32_t>(context->getReturnState(j)));
+      }
+    }
+  }
+
+ private:
+  void writeDFA(::AntlrDFA::Builder builder, const DFA& dfa) {
+    std::vector<const DFAState*> states(dfa.states.cbegin(), dfa.states.cend());
+    std::unordered_map<const DFAState*, uint32_t> indices;
+    for (size_t i = 0, ni = states.size(); i < ni; ++i) {
+      indices.emplace(states[i], static_cast<uint32_t>(i));
+    }
+    auto writeEdges = [&indices](const DFAState* state, auto initEdges) {
+      std::vector<std::pair<uint32_t, uint32_t>> edges;
+      for (const auto& [symbol, target] : state->edges) {
+        // Edges to the shared error state or to states of another DFA
+        // are simply recomputed.
+        auto it = indices.find(target);
+        if (it != indices.end()) edges.emplace_back(static_cast<uint32_t>(symbol), it->second);
+      }
+      ::capnp::List<::AntlrDFAEdge>::Builder targetEdges = initEdges(edges.size());
+      for (size_t i = 0, ni = edges.size(); i < ni; ++i) {
+        targetEdges[i].setSymbol(edges[i].first);
+        targetEdges[i].setTarget(edges[i].second);
+      }
+    };
+
+    builder.setDecision(static_cast<uint32_t>(dfa.decision));
+    builder.setStart(kNoIndex);
+    if (dfa.isPrecedenceDfa()) {
+      if (dfa.s0 != nullptr) writeEdges(dfa.s0, [&builder](size_t size) { return builder.initPrecedenceEdges(size); });
+    } else if (dfa.s0 != nullptr) {
+      auto it = indices.find(dfa.s0);
+      if (it != indices.end()) builder.setStart(it->second);
+    }
+
+    ::capnp::List<::AntlrDFAState>::Builder targetStates = builder.initStates(states.size());
+    for (size_t i = 0, ni = states.size(); i < ni; ++i) {
+      const DFAState* const state = states[i];
+      const ATNConfigSet* const configs = state->configs.get();
+      ::AntlrDFAState::Builder target = targetStates[i];
+      target.setFullContext(configs->fullCtx);
+      target.setUniqueAlt(static_cast<uint32_t>(configs->uniqueAlt));
+      target.setIsAcceptState(state->isAcceptState);
+      target.setPrediction(static_cast<uint32_t>(state->prediction));
+      target.setRequiresFullContext(state->requiresFullContext);
+
+      std::vector<uint32_t> conflictingAlts;
+      for (size_t alt = 0, nalt = configs->conflictingAlts.size(); alt < nalt; ++alt) {
+        if (configs->conflictingAlts.test(alt)) conflictingAlts.emplace_back(static_cast<uint32_t>(alt));
+      }
+      ::capnp::List<uint32_t>::Builder targetAlts = target.initConflictingAlts(conflictingAlts.size());
+      for (size_t j = 0, nj = conflictingAlts.size(); j < nj; ++j) {
+        targetAlts.set(j, conflictingAlts[j]);
+      }
+
+      ::capnp::List<::AntlrATNConfig>::Builder targetConfigs = target.initConfigs(configs->configs.size());
+      for (size_t j = 0, nj = configs->configs.size(); j < nj; ++j) {
+        const ATNConfig* const config = configs->configs[j].get();
+        ::AntlrATNConfig::Builder targetConfig = targetConfigs[j];
+        targetConfig.setState(static_cast<uint32_t>(config->state->stateNumber));
+        targetConfig.setAlt(static_cast<uint32_t>(config->alt));
+        targetConfig.setContext(internContext(config->context.get()));
+        targetConfig.setReachesIntoOuterContext(static_cast<uint32_t>(config->reachesIntoOuterContext));
+        targetConfig.setPrecedenceFilterSuppressed(config->isPrecedenceFilterSuppressed());
+      }
+
+      writeEdges(state, [&target](size_t size) { return target.initEdges(size); });
+    }
+  }
+
+  // Numbers contexts parents first, so that they can be rebuilt in order.
+  uint32_t internContext(const PredictionContext* context) {
+    std::vector<const PredictionContext*> stack{context};
+    while (!stack.empty()) {
+      const PredictionContext* const top = stack.back();
+      if (m_contextIndices.find(top) != m_contextIndices.end()) {
+        stack.pop_back();
+        continue;
+      }
+      bool ready = true;
+      for (size_t i = 0, ni = top->size(); i < ni; ++i) {
+        const PredictionContext* const parent = top->getParent(i).get();
+        if ((parent != nullptr) && (m_contextIndices.find(parent) == m_contextIndices.end())) {
+          stack.emplace_back(parent);
+          ready = false;
+        }
+      }
+      if (ready) {
+        m_contextIndices.emplace(top, static_cast<uint32_t>(m_contexts.size()));
+        m_contexts.emplace_back(top);
+        stack.pop_back();
+      }
+    }
+    return m_contextIndices.at(context);
+  }
+
+  ::AntlrGrammar::Builder m_builder;
+  std::vector<const PredictionContext*> m_contexts;
+  std::unordered_map<const PredictionContext*, uint32_t> m_contextIndices;
+};
+
+// A truncated or corrupted file must not index out of the ATN or of the
+// lists it comes with, the grammar is then simply parsed cold.
+bool isValidGrammar(const ::AntlrGrammar::Reader& source, const ATN& atn) {
+  const ::capnp::List<::AntlrPredictionContext>::Reader contexts = source.getContexts();
+  for (uint32_t i = 0, ni = contexts.size(); i < ni; ++i) {
+    const ::capnp::List<uint32_t>::Reader parentIds = contexts[i].getParents();
+    if (parentIds.size() == 0) return false;
+    if (parentIds.size() != contexts[i].getReturnStates().size()) return false;
+    for (uint32_t parentId : parentIds) {
+      // Parents are numbered first
+      if ((parentId != kNoIndex) && (parentId >= i)) return false;
+    }
+  }
+
+  const size_t maxAlt = antlrcpp::BitSet().size();
+  for (const ::AntlrDFA::Reader& sourceDFA : source.getDfas()) {
+    const ::capnp::List<::AntlrDFAState>::Reader sourceStates = sourceDFA.getStates();
+    auto validEdges = [&sourceStates](const ::capnp::List<::AntlrDFAEdge>::Reader& edges) {
+      for (const ::AntlrDFAEdge::Reader& edge : edges) {
+        if (edge.getTarget() >= sourceStates.size()) return false;
+      }
+      return true;
+    };
+    if ((sourceDFA.getStart() != kNoIndex) && (sourceDFA.getStart() >= sourceStates.size())) return false;
+    if (!validEdges(sourceDFA.getPrecedenceEdges())) return false;
+    for (const ::AntlrDFAState::Reader& sourceState : sourceStates) {
+      for (const ::AntlrATNConfig::Reader& sourceConfig : sourceState.getConfigs()) {
+        if (sourceConfig.getState() >= atn.states.size()) return false;
+        if (atn.states[sourceConfig.getState()] == nullptr) return false;
+        if (sourceConfig.getContext() >= contexts.size()) return false;
+      }
+      for (uint32_t alt : sourceState.getConflictingAlts()) {
+        if (alt >= maxAlt) return false;
+      }
+      if (!validEdges(sourceState.getEdges())) return false;
+    }
+  }
+  return true;
+}
+
+// Expects a grammar that passed isValidGrammar().
+void readGrammar(const ::AntlrGrammar::Reader& source, const ATN& atn, std::vector<DFA>& dfas) {
+  std::vector<antlr4::Ref<const PredictionContext>> contexts;
+  contexts.reserve(source.getContexts().size());
+  for (const ::AntlrPredictionContext::Reader& context : source.getContexts()) {
+    const ::capnp::List<uint32_t>::Reader parentIds = context.getParents();
+    const ::capnp::List<uint32_t>::Reader returnStates = context.getReturnStates();
+    auto parent = [&contexts](uint32_t index) {
+      return (index == kNoIndex) ? antlr4::Ref<const PredictionContext>() : contexts[index];
+    };
+    if (parentIds.size() == 1) {
+      contexts.emplace_back(antlr4::atn::SingletonPredictionContext::create(parent(parentIds[0]), returnStates[0]));
+    } else {
+      std::vector<antlr4::Ref<const PredictionContext>> parents;
+      std::vector<size_t> states;
+      for (uint32_t i = 0, ni = parentIds.size(); i < ni; ++i) {
+        parents.emplace_back(parent(parentIds[i]));
+        states.emplace_back(returnStates[i]);
+      }
+      contexts.emplace_back(
+          std::make_shared<antlr4::atn::ArrayPredictionContext>(std::move(parents), std::move(states)));
+    }
+  }
+
+  for (const ::AntlrDFA::Reader& sourceDFA : source.getDfas()) {
+    if (sourceDFA.getDecision() >= dfas.size()) continue;
+    DFA& dfa = dfas[sourceDFA.getDecision()];
+    // Never mix with states computed by this process
+    if (!dfa.states.empty()) continue;
+    if (dfa.isPrecedenceDfa() && ((dfa.s0 == nullptr) || !dfa.s0->edges.empty())) continue;
+
+    std::vector<DFAState*> states;
+    states.reserve(sourceDFA.getStates().size());
+    for (const ::AntlrDFAState::Reader& sourceState : sourceDFA.getStates()) {
+      std::unique_ptr<ATNConfigSet> configs = std::make_unique<ATNConfigSet>(sourceState.getFullContext());
+      for (const ::AntlrATNConfig::Reader& sourceConfig : sourceState.getConfigs()) {
+        antlr4::Ref<ATNConfig> config = std::make_shared<ATNConfig>(
+            atn.states[sourceConfig.getState()], sourceConfig.getAlt(), contexts[sourceConfig.getContext()]);
+        config->reachesIntoOuterContext = sourceConfig.getReachesIntoOuterContext();
+        config->setPrecedenceFilterSuppressed(sourceConfig.getPrecedenceFilterSuppressed());
+        configs->add(config);
+      }
+      configs->uniqueAlt = sourceState.getUniqueAlt();
+      for (uint32_t alt : sourceState.getConflictingAlts()) {
+        configs->conflictingAlts.set(alt);
+      }
+      configs->setReadonly(true);
+
+      DFAState* const state = new DFAState(std::move(configs));
+      state->stateNumber = static_cast<int32_t>(states.size());
+      state->isAcceptState = sourceState.getIsAcceptState();
+      state->prediction = sourceState.getPrediction();
+      state->requiresFullContext = sourceState.getRequiresFullContext();
+      states.emplace_back(state);
+      dfa.states.insert(state);
+    }
+
+    const ::capnp::List<::AntlrDFAState>::Reader sourceStates = sourceDFA.getStates();
+    for (uint32_t i = 0, ni = sourceStates.size(); i < ni; ++i) {
+      for (const ::AntlrDFAEdge::Reader& edge : sourceStates[i].getEdges()) {
+        states[i]->edges[edge.getSymbol()] = states[edge.getTarget()];
+      }
+    }
+    if (dfa.isPrecedenceDfa()) {
+      for (const ::AntlrDFAEdge::Reader& edge : sourceDFA.getPrecedenceEdges()) {
+        dfa.s0->edges[edge.getSymbol()] = states[edge.getTarget()];
+      }
+    } else if (sourceDFA.getStart() != kNoIndex) {
+      dfa.s0 = states[sourceDFA.getStart()];
+    }
+  }
+}
+}  // namespace
+
+AntlrDFACache::AntlrDFACache(Session* session) : Cache(session) {}
+
+PathId AntlrDFACache::getCacheFileId() const {
+  const PathId cacheDirId = m_session->getCommandLineParser()->getCacheDirId();
+  if (!cacheDirId) return BadPathId;
+  return m_session->getFileSystem()->getChild(cacheDirId, kCacheFileName, m_session->getSymbolTable());
+}
+
+bool AntlrDFACache::restore() {
+  CommandLineParser* const clp = m_session->getCommandLineParser();
+  if (!clp->cacheAllowed() || clp->lowMem()) return false;
+
+  const PathId cacheFileId = getCacheFileId();
+  if (!cacheFileId) return false;
+
+  FileSystem* const fileSystem = m_session->getFileSystem();
+  const std::string filepath = fileSystem->toPlatformAbsPath(cacheFileId).string();
+  const int32_t fd = ::open(filepath.c_str(), O_RDONLY | O_BINARY);
+  if (fd < 0) return false;
+
+  bool result = false;
+  do {
+    ::capnp::ReaderOptions options;
+    options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    options.nestingLimit = 1024;
+    ::capnp::PackedFdMessageReader message(fd, options);
+    const ::AntlrDFACache::Reader& root = message.getRoot<::AntlrDFACache>();
+    if (!checkIfCacheIsValid(root.getHeader(), kSchemaVersion, BadPathId, BadPathId)) break;
+
+    result = true;
+    forEachGrammar([&root, &result](const antlr4::Lexer& lexer, const antlr4::Parser& parser, std::vector<DFA>& dfas) {
+      const std::string name = parser.getGrammarFileName();
+      const uint64_t atnHash = hashGrammar(lexer, parser);
+      for (const ::AntlrGrammar::Reader& grammar : root.getGrammars()) {
+        if ((name == grammar.getName().cStr()) && (grammar.getAtnHash() == atnHash)) {
+          if (isValidGrammar(grammar, parser.getATN())) {
+            readGrammar(grammar, parser.getATN(), dfas);
+          } else {
+            result = false;
+          }
+          break;
+        }
+      }
+    });
+  } while (false);
+  ::close(fd);
+
+  forEachGrammar([this](const antlr4::Lexer&, const antlr4::Parser&, std::vector<DFA>& dfas) {
+    m_restoredStateCount += countStates(dfas);
+  });
+  return result;
+}
+
+bool AntlrDFACache::save() {
+  CommandLineParser* const clp = m_session->getCommandLineParser();
+  if (!clp->writeCache() || clp->lowMem()) return true;
+
+  size_t stateCount = 0;
+  forEachGrammar([&stateCount](const antlr4::Lexer&, const antlr4::Parser&, std::vector<DFA>& dfas) {
+    stateCount += countStates(dfas);
+  });
+  // Nothing learned, e.g. a -mp parent process or a fully cached run
+  if (stateCount <= m_restoredStateCount) return true;
+
+  const PathId cacheFileId = getCacheFileId();
+  if (!cacheFileId) return false;
+
+  std::unique_ptr<::capnp::MallocMessageBuilder> message = std::make_unique<::capnp::MallocMessageBuilder>();
+  ::AntlrDFACache::Builder builder = message->initRoot<::AntlrDFACache>();
+  cacheHeader(builder.getHeader(), kSchemaVersion);
+
+  ::capnp::List<::AntlrGrammar>::Builder grammars = builder.initGrammars(2);
+  uint32_t index = 0;
+  forEachGrammar(
+      [&grammars, &index](const antlr4::Lexer& lexer, const antlr4::Parser& parser, std::vector<DFA>& dfas) {
+        GrammarWriter(grammars[index++]).write(parser.getGrammarFileName(), hashGrammar(lexer, parser), dfas);
+      });
+
+  // Concurrent -mp processes share the file, the writer renames it into place
+  FileSystem* const fileSystem = m_session->getFileSystem();
+  return m_session->getCacheWriter()->write(fileSystem->toPlatformAbsPath(cacheFileId), std::move(message));
+}
+}  // namespace SURELOG
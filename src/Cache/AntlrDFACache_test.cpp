@@ -0,0 +1,212 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Cache/AntlrDFACache.h"
+
+#include <Surelog/Cache/AntlrDFACache.capnp.h>
+#include <antlr4-runtime.h>
+#include <capnp/message.h>
+#include <capnp/serialize-packed.h>
+#include <gtest/gtest.h>
+#include <kj/io.h>
+#include <parser/SV3_1aLexer.h>
+#include <parser/SV3_1aParser.h>
+#include <parser/SV3_1aPpLexer.h>
+#include <parser/SV3_1aPpParser.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "Surelog/Cache/CacheWriter.h"
+#include "Surelog/CommandLine/CommandLineParser.h"
+#include "Surelog/Common/FileSystem.h"
+#include "Surelog/Common/PathId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/Design/FileContent.h"
+#include "Surelog/SourceCompile/ParserHarness.h"
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr std::string_view kSource =
+    "module top(input logic clk, input logic [7:0] a, output logic [7:0] q);\n"
+    "  always_ff @(posedge clk) q <= (a + 8'd1) ^ {a[3:0], a[7:4]};\n"
+    "endmodule\n";
+
+// Drops the DFAs the generated parsers share, as a new process starts.
+template <typename LexerType, typename ParserType>
+void clearDFAs() {
+  antlr4::ANTLRInputStream input;
+  LexerType lexer(&input);
+  antlr4::CommonTokenStream tokens(&lexer);
+  ParserType parser(&tokens);
+  parser.template getInterpreter<antlr4::atn::ParserATNSimulator>()->clearDFA();
+}
+
+void clearAllDFAs() {
+  clearDFAs<SV3_1aLexer, SV3_1aParser>();
+  clearDFAs<SV3_1aPpLexer, SV3_1aPpParser>();
+}
+
+class AntlrDFACacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_outputDir = fs::temp_directory_path() / "surelog_antlrdfacache_test";
+    std::error_code ec;
+    fs::remove_all(m_outputDir, ec);
+
+    const std::string outputDir = m_outputDir.string();
+    const char* const args[] = {"surelog", "-nostdout", "-o", outputDir.c_str()};
+    m_session.parseCommandLine(static_cast<int32_t>(std::size(args)), args, false, false);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    fs::remove_all(m_outputDir, ec);
+  }
+
+  // Parses kSource from cold DFAs and saves what the parsers learned.
+  fs::path populate() {
+    clearAllDFAs();
+    ParserHarness harness(&m_session);
+    std::unique_ptr<FileContent> fC = harness.parse(kSource);
+    EXPECT_NE(fC, nullptr);
+    if (fC) m_coldTree = fC->printObjects();
+
+    AntlrDFACache cache(&m_session);
+    EXPECT_TRUE(cache.save());
+    m_session.getCacheWriter()->drain();
+    return m_session.getFileSystem()->toPlatformAbsPath(cache.getCacheFileId());
+  }
+
+  // Rewrites the saved cache file through fn(::AntlrDFACache::Builder).
+  template <typename FunctorType>
+  void rewrite(const fs::path& cacheFile, FunctorType fn) {
+    std::vector<char> data;
+    {
+      std::ifstream strm(cacheFile, std::ios_base::binary);
+      data.assign(std::istreambuf_iterator<char>(strm), std::istreambuf_iterator<char>());
+    }
+    kj::ArrayInputStream input(
+        kj::ArrayPtr<const kj::byte>(reinterpret_cast<const kj::byte*>(data.data()), data.size()));
+    ::capnp::ReaderOptions options;
+    options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    options.nestingLimit = 1024;
+    ::capnp::PackedMessageReader reader(input, options);
+    ::capnp::MallocMessageBuilder message;
+    message.setRoot(reader.getRoot<::AntlrDFACache>());
+    fn(message.getRoot<::AntlrDFACache>());
+    ASSERT_TRUE(CacheWriter::writeFile(cacheFile, message));
+  }
+
+  size_t restore() {
+    clearAllDFAs();
+    // ParserHarness turns the caches off
+    m_session.getCommandLineParser()->setCacheAllowed(true);
+    AntlrDFACache cache(&m_session);
+    cache.restore();
+    return cache.getRestoredStateCount();
+  }
+
+ protected:
+  Session m_session;
+  fs::path m_outputDir;
+  std::string m_coldTree;
+};
+
+TEST_F(AntlrDFACacheTest, RoundTrip) {
+  const fs::path cacheFile = populate();
+  ASSERT_TRUE(fs::exists(cacheFile));
+
+  const size_t restored = restore();
+  EXPECT_GT(restored, 0U);
+
+  // The restored DFAs predict the same parse
+  ParserHarness harness(&m_session);
+  std::unique_ptr<FileContent> fC = harness.parse(kSource);
+  ASSERT_NE(fC, nullptr);
+  EXPECT_EQ(fC->printObjects(), m_coldTree);
+
+  // And a second restore reads the very same states back
+  EXPECT_EQ(restore(), restored);
+}
+
+TEST_F(AntlrDFACacheTest, RejectsChangedGrammar) {
+  const fs::path cacheFile = populate();
+  ASSERT_TRUE(fs::exists(cacheFile));
+
+  // Pretend the DFAs were saved by a build with another grammar
+  rewrite(cacheFile, [](::AntlrDFACache::Builder root) {
+    for (::AntlrGrammar::Builder grammar : root.getGrammars()) {
+      grammar.setAtnHash(grammar.getAtnHash() + 1);
+    }
+  });
+
+  EXPECT_EQ(restore(), 0U);
+}
+
+TEST_F(AntlrDFACacheTest, RejectsOutOfRangeIndices) {
+  const fs::path cacheFile = populate();
+  ASSERT_TRUE(fs::exists(cacheFile));
+
+  // A corrupted context reference, past the end of the grammar's contexts
+  rewrite(cacheFile, [](::AntlrDFACache::Builder root) {
+    for (::AntlrGrammar::Builder grammar : root.getGrammars()) {
+      for (::AntlrDFA::Builder dfa : grammar.getDfas()) {
+        for (::AntlrDFAState::Builder state : dfa.getStates()) {
+          for (::AntlrATNConfig::Builder config : state.getConfigs()) {
+            config.setContext(grammar.getContexts().size());
+          }
+        }
+      }
+    }
+  });
+
+  EXPECT_EQ(restore(), 0U);
+
+  // Parsed cold instead
+  ParserHarness harness(&m_session);
+  std::unique_ptr<FileContent> fC = harness.parse(kSource);
+  ASSERT_NE(fC, nullptr);
+  EXPECT_EQ(fC->printObjects(), m_coldTree);
+}
+
+TEST_F(AntlrDFACacheTest, UsesCacheDir) {
+  const fs::path cacheDir = m_outputDir / "dfa_cache";
+  const std::string cacheDirArg = cacheDir.string();
+  const char* const args[] = {"surelog", "-nostdout", "-cache", cacheDirArg.c_str()};
+  Session session;
+  session.parseCommandLine(static_cast<int32_t>(std::size(args)), args, false, false);
+
+  AntlrDFACache cache(&session);
+  const fs::path cacheFile = session.getFileSystem()->toPlatformAbsPath(cache.getCacheFileId());
+  EXPECT_EQ(cacheFile.parent_path(), session.getFileSystem()->toPlatformAbsPath(
+                                         session.getCommandLineParser()->getCacheDirId()));
+  EXPECT_EQ(cacheFile.parent_path().filename(), "dfa_cache");
+}
+}  // namespace
+}  // namespace SURELOG
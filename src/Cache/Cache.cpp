@@ -43,6 +43,7 @@
 #include "Surelog/Common/Session.h"
 #include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/ErrorReporting/Error.h"
 #include "Surelog/ErrorReporting/ErrorContainer.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
@@ -123,62 +124,37 @@ void Cache::cacheErrors(::capnp::List<::Error, ::capnp::Kind::STRUCT>::Builder t
 }
 
 void Cache::cacheVObjects(::capnp::List<::VObject, ::capnp::Kind::STRUCT>::Builder targetVObjects,
-                          SymbolTable& targetSymbols, const std::vector<VObject>& sourceVObjects,
+                          SymbolTable& targetSymbols, const VObjectStore& sourceVObjects,
                           const SymbolTable& sourceSymbols) {
   if (sourceVObjects.size() > Capacity) {
     std::cerr << "INTERNAL ERROR: Cache is saturated, Use -nocache option\n";
     return;
   }
   // Convert a local symbol ID to a cache symbol ID to be stored.
-  std::function<uint64_t(SymbolId)> toCacheSym = [&targetSymbols, &sourceSymbols](SymbolId id) {
+  std::function<RawSymbolId(SymbolId)> toCacheSym = [&targetSymbols, &sourceSymbols](SymbolId id) {
     return (RawSymbolId)targetSymbols.copyFrom(id, &sourceSymbols);
   };
   FileSystem* const fileSystem = m_session->getFileSystem();
-  std::function<uint64_t(PathId)> toCachePath = [&targetSymbols, &fileSystem](PathId id) {
+  std::function<RawPathId(PathId)> toCachePath = [&targetSymbols, &fileSystem](PathId id) {
     return (RawPathId)fileSystem->copy(id, &targetSymbols);
   };
 
   for (size_t i = 0, ni = sourceVObjects.size(); i < ni; ++i) {
-    // Lets compress this struct into 20 and 16 bits fields:
-    //  object_vec.push_back(PARSECACHE::CreateVObject(builder,
-    //                                                 toCacheSym(object.m_name),
-    //                                                 object.m_uniqueId,
-    //                                                 object.m_type,
-    //                                                 object.m_column,
-    //                                                 object.m_line,
-    //                                                 object.m_parent,
-    //                                                 object.m_definition,
-    //                                                 object.m_child,
-    //                                                 object.m_sibling));
-
-    uint64_t field1 = 0;
-    uint64_t field2 = 0;
-    uint64_t field3 = 0;
-    uint64_t field4 = 0;
-    const VObject& object = sourceVObjects[i];
-
-    // clang-format off
-    field1 |= 0x0000000000FFFFFF & toCacheSym(object.m_name);
-    field1 |= 0x0000000FFF000000 & (((uint64_t)object.m_type)                  << (24));
-    field1 |= 0x0000FFF000000000 & (((uint64_t)object.m_startColumn)           << (24 + 12));
-    field1 |= 0xFFFF000000000000 & (((uint64_t)(RawNodeId)object.m_parent)     << (24 + 12 + 12));
-    field2 |= 0x0000000000000FFF & (((uint64_t)(RawNodeId)object.m_parent)     >> (16));
-    field2 |= 0x000000FFFFFFF000 & (((uint64_t)(RawNodeId)object.m_definition) << (12));
-    field2 |= 0xFFFFFF0000000000 & (((uint64_t)(RawNodeId)object.m_child)      << (12 + 28));
-    field3 |= 0x000000000000000F & (((uint64_t)(RawNodeId)object.m_child)      >> (24));
-    field3 |= 0x00000000FFFFFFF0 & (((uint64_t)(RawNodeId)object.m_sibling)    << (4));
-    field3 |= 0x00FFFFFF00000000 & (toCachePath(object.m_fileId)               << (4 + 28));
-    field3 |= 0xFF00000000000000 & (((uint64_t)object.m_startLine)             << (4 + 28 + 24));
-    field4 |= 0x000000000000FFFF & (((uint64_t)object.m_startLine)             >> (8));
-    field4 |= 0x000000FFFFFF0000 & (((uint64_t)object.m_endLine)               << (16));
-    field4 |= 0x000FFF0000000000 & (((uint64_t)object.m_endColumn)             << (16 + 24));
-    // clang-format on
+    const NodeId id(static_cast<RawNodeId>(i));
+    const VObjectStore::Location& location = sourceVObjects.location(id);
 
     ::VObject::Builder targetVObject = targetVObjects[i];
-    targetVObject.setField1(field1);
-    targetVObject.setField2(field2);
-    targetVObject.setField3(field3);
-    targetVObject.setField4(field4);
+    targetVObject.setName(toCacheSym(sourceVObjects.name(id)));
+    targetVObject.setFileId(toCachePath(sourceVObjects.fileId(id)));
+    targetVObject.setParent((RawNodeId)sourceVObjects.parent(id));
+    targetVObject.setDefinition((RawNodeId)sourceVObjects.definition(id));
+    targetVObject.setChild((RawNodeId)sourceVObjects.child(id));
+    targetVObject.setSibling((RawNodeId)sourceVObjects.sibling(id));
+    targetVObject.setStartLine(location.m_startLine);
+    targetVObject.setEndLine(location.m_endLine);
+    targetVObject.setType((uint16_t)sourceVObjects.type(id));
+    targetVObject.setStartColumn(location.m_startColumn);
+    targetVObject.setEndColumn(location.m_endColumn);
   }
 }
 
@@ -214,48 +190,21 @@ void Cache::restoreErrors(ErrorContainer* errorContainer, SymbolTable& targetSym
   }
 }
 
-void Cache::restoreVObjects(std::vector<VObject>& targetVObjects, SymbolTable& targetSymbols,
+void Cache::restoreVObjects(VObjectStore& targetVObjects, SymbolTable& targetSymbols,
                             const ::capnp::List<::VObject>::Reader& sourceVObjects, const SymbolTable& sourceSymbols) {
   FileSystem* const fileSystem = m_session->getFileSystem();
   /* Restore design objects */
   targetVObjects.clear();
   targetVObjects.reserve(sourceVObjects.size());
   for (const ::VObject::Reader& sourceVObject : sourceVObjects) {
-    // VObject object
-    // (m_parse->getCompileSourceFile()->getSymbolTable()->registerSymbol(canonicalSymbols.getSymbol(objectc->m_name())),
-    //                (VObjectType) objectc->m_type(), objectc->m_uniqueId(),
-    //                objectc->m_column(), objectc->m_line(),
-    //                objectc->m_parent(), objectc->m_definition(),
-    //               objectc->m_child(),  objectc->m_sibling());
-
-    uint64_t field1 = sourceVObject.getField1();
-    uint64_t field2 = sourceVObject.getField2();
-    uint64_t field3 = sourceVObject.getField3();
-    uint64_t field4 = sourceVObject.getField4();
-    // Decode compression done when saving cache (see below)
-    // clang-format off
-    RawSymbolId name =      (field1 & 0x0000000000FFFFFF);
-    uint16_t type =         (field1 & 0x0000000FFF000000) >> (24);
-    uint16_t column =       (field1 & 0x0000FFF000000000) >> (24 + 12);
-    RawNodeId parent =      (field1 & 0xFFFF000000000000) >> (24 + 12 + 12);
-    parent |=               (field2 & 0x0000000000000FFF) << (16);
-    RawNodeId definition =  (field2 & 0x000000FFFFFFF000) >> (12);
-    RawNodeId child =       (field2 & 0xFFFFFF0000000000) >> (12 + 28);
-    child |=                (field3 & 0x000000000000000F) << (24);
-    RawNodeId sibling =     (field3 & 0x00000000FFFFFFF0) >> (4);
-    RawSymbolId fileId =    (field3 & 0x00FFFFFF00000000) >> (4 + 28);
-    uint32_t line =         (field3 & 0xFF00000000000000) >> (4 + 28 + 24);
-    line |=                 (field4 & 0x000000000000FFFF) << (8);
-    uint32_t endLine =      (field4 & 0x000000FFFFFF0000) >> (16);
-    uint16_t endColumn =    (field4 & 0x000FFF0000000000) >> (16 + 24);
-    // clang-format on
-
     targetVObjects.emplace_back(
-        targetSymbols.copyFrom(SymbolId(name, UnknownRawPath), &sourceSymbols),
-        fileSystem->toPathId(fileSystem->remap(sourceSymbols.getSymbol(SymbolId(fileId, UnknownRawPath))),
-                             &targetSymbols),
-        (VObjectType)type, line, column, endLine, endColumn, NodeId(parent), NodeId(definition), NodeId(child),
-        NodeId(sibling));
+        targetSymbols.copyFrom(SymbolId(sourceVObject.getName(), UnknownRawPath), &sourceSymbols),
+        fileSystem->toPathId(
+            fileSystem->remap(sourceSymbols.getSymbol(SymbolId(sourceVObject.getFileId(), UnknownRawPath))),
+            &targetSymbols),
+        (VObjectType)sourceVObject.getType(), sourceVObject.getStartLine(), sourceVObject.getStartColumn(),
+        sourceVObject.getEndLine(), sourceVObject.getEndColumn(), NodeId(sourceVObject.getParent()),
+        NodeId(sourceVObject.getDefinition()), NodeId(sourceVObject.getChild()), NodeId(sourceVObject.getSibling()));
   }
 }
 }  // namespace SURELOG
@@ -0,0 +1,175 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/Cache/CacheStore.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "Surelog/CommandLine/CommandLineParser.h"
+#include "Surelog/Common/FileSystem.h"
+#include "Surelog/Common/PathId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+// Temporary files older than that were left behind by a dead process
+static constexpr std::chrono::hours kStaleTemporaryAge(1);
+
+static constexpr std::string_view kEntryExtensions[] = {".slpp", ".slpa"};
+
+static bool isHexDigits(std::string_view text) {
+  return std::all_of(text.cbegin(), text.cend(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); });
+}
+
+// <2 digits>/<32 digits><extension>, see getEntryFileId()
+static bool isEntryFile(const fs::path& filepath) {
+  const std::string dirname = filepath.parent_path().filename().string();
+  const std::string stem = filepath.stem().string();
+  const std::string extension = filepath.extension().string();
+  return (dirname.size() == 2) && (stem.size() == 32) && isHexDigits(stem) && (stem.compare(0, 2, dirname) == 0) &&
+         (std::find(std::begin(kEntryExtensions), std::end(kEntryExtensions), extension) !=
+          std::end(kEntryExtensions));
+}
+
+void CacheStore::Key::mix(uint64_t word) {
+  m_hash1 = (m_hash1 ^ word) * 0x100000001B3;
+  m_hash1 ^= m_hash1 >> 29;
+  m_hash2 += word * 0xC2B2AE3D27D4EB4F;
+  m_hash2 = ((m_hash2 << 31) | (m_hash2 >> 33)) * 0x9E3779B97F4A7C15;
+}
+
+CacheStore::Key& CacheStore::Key::add(std::string_view text) {
+  mix(text.size());
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= text.size(); i += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    std::memcpy(&word, text.data() + i, sizeof(uint64_t));
+    mix(word);
+  }
+  uint64_t tail = 0;
+  if (i < text.size()) std::memcpy(&tail, text.data() + i, text.size() - i);
+  mix(tail);
+  return *this;
+}
+
+CacheStore::Key& CacheStore::Key::add(uint64_t value) {
+  mix(value);
+  return *this;
+}
+
+bool CacheStore::Key::addFileContent(FileSystem* fileSystem, PathId fileId) {
+  std::string content;
+  if (!fileSystem->readContent(fileId, content)) return false;
+  add(content);
+  return true;
+}
+
+std::string CacheStore::Key::toString() const {
+  static constexpr std::string_view kDigits = "0123456789abcdef";
+  std::string result(32, '0');
+  for (int32_t i = 0; i < 16; ++i) {
+    result[15 - i] = kDigits[(m_hash1 >> (4 * i)) & 0xF];
+    result[31 - i] = kDigits[(m_hash2 >> (4 * i)) & 0xF];
+  }
+  return result;
+}
+
+CacheStore::CacheStore(Session* session)
+    : m_session(session), m_enabled(session->getCommandLineParser()->sharedCache()) {}
+
+PathId CacheStore::getEntryFileId(const Key& key, std::string_view extension) const {
+  FileSystem* const fileSystem = m_session->getFileSystem();
+  SymbolTable* const symbols = m_session->getSymbolTable();
+  CommandLineParser* const clp = m_session->getCommandLineParser();
+
+  const std::string name = key.toString();
+  const PathId dirId = fileSystem->getChild(clp->getCacheDirId(), name.substr(0, 2), symbols);
+  return fileSystem->getChild(dirId, name + std::string(extension), symbols);
+}
+
+void CacheStore::touch(PathId entryFileId) const {
+  if (!m_enabled || !entryFileId) return;
+  const fs::path filepath = m_session->getFileSystem()->toPlatformAbsPath(entryFileId);
+  std::error_code ec;
+  fs::last_write_time(filepath, fs::file_time_type::clock::now(), ec);
+}
+
+uint32_t CacheStore::evict() const {
+  if (!m_enabled) return 0;
+
+  FileSystem* const fileSystem = m_session->getFileSystem();
+  CommandLineParser* const clp = m_session->getCommandLineParser();
+  const fs::path rootDir = fileSystem->toPlatformAbsPath(clp->getCacheDirId());
+  const fs::file_time_type now = fs::file_time_type::clock::now();
+
+  struct Entry final {
+    fs::path m_filepath;
+    uint64_t m_size;
+    fs::file_time_type m_time;
+  };
+  std::vector<Entry> entries;
+  uint64_t totalSize = 0;
+  std::error_code ec;
+  for (fs::recursive_directory_iterator it(rootDir, ec), end; !ec && (it != end); it.increment(ec)) {
+    std::error_code entryEc;
+    if ((it.depth() != 1) || !it->is_regular_file(entryEc)) continue;
+    // CacheWriter's temporaries are named <entry>.tmp<suffix>
+    const bool isTemporary = it->path().extension().string().compare(0, 4, ".tmp") == 0;
+    if (!isEntryFile(isTemporary ? it->path().parent_path() / it->path().stem() : it->path())) continue;
+    const uint64_t size = it->file_size(entryEc);
+    const fs::file_time_type time = it->last_write_time(entryEc);
+    if (entryEc) continue;  // Removed by a concurrent eviction
+    if (isTemporary) {
+      // Being written by another process, unless stale
+      if ((now - time) > kStaleTemporaryAge) fs::remove(it->path(), entryEc);
+      continue;
+    }
+    entries.emplace_back(Entry{it->path(), size, time});
+    totalSize += size;
+  }
+
+  const uint64_t budget = clp->getCacheSizeBudget();
+  if (totalSize <= budget) return 0;
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.m_time < rhs.m_time; });
+  // Leave some room so that the next runs don't all evict again
+  const uint64_t target = budget - (budget / 10);
+  uint32_t removed = 0;
+  for (const Entry& entry : entries) {
+    if (totalSize <= target) break;
+    // Another process may have removed it already. Windows refuses to remove
+    // entries being read, these are kept.
+    const bool removedHere = fs::remove(entry.m_filepath, ec);
+    if (ec) continue;
+    totalSize -= entry.m_size;
+    if (removedHere) ++removed;
+  }
+  return removed;
+}
+
+}  // namespace SURELOG
@@ -0,0 +1,141 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Cache/CacheStore.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "Surelog/Common/PlatformFileSystem.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+TEST(CacheStoreTest, KeyIsDeterministic) {
+  CacheStore::Key key1;
+  key1.add("source.sv").add(uint64_t{1}).add("A=1");
+  CacheStore::Key key2;
+  key2.add("source.sv").add(uint64_t{1}).add("A=1");
+  EXPECT_EQ(key1.toString(), key2.toString());
+  EXPECT_EQ(key1.toString().size(), 32);
+
+  // Boundaries between the parts are part of the key
+  CacheStore::Key key3;
+  key3.add("source.s").add(uint64_t{1}).add("vA=1");
+  EXPECT_NE(key1.toString(), key3.toString());
+
+  CacheStore::Key key4;
+  key4.add("source.sv").add(uint64_t{1}).add("A=2");
+  EXPECT_NE(key1.toString(), key4.toString());
+}
+
+TEST(CacheStoreTest, EvictsLeastRecentlyUsed) {
+  const fs::path cacheDir = fs::temp_directory_path() / "surelog_cachestore_test";
+  std::error_code ec;
+  fs::remove_all(cacheDir, ec);
+  fs::create_directories(cacheDir / "ab", ec);
+
+  const fs::file_time_type now = fs::file_time_type::clock::now();
+  const auto createFile = [&](const fs::path& filepath, std::chrono::minutes age) {
+    std::ofstream strm(filepath, std::ios_base::binary);
+    strm << std::string(400 * 1024, 'x');
+    strm.close();
+    fs::last_write_time(filepath, now - age, ec);
+  };
+  // Entry names, <2 digits>/<32 digits><extension>
+  const auto entry = [&](char digit, const std::string& extension) {
+    return cacheDir / "ab" / ("ab" + std::string(30, digit) + extension);
+  };
+  createFile(entry('0', ".slpp"), std::chrono::minutes(30));
+  createFile(entry('1', ".slpa"), std::chrono::minutes(20));
+  createFile(entry('2', ".slpp"), std::chrono::minutes(10));
+  createFile(entry('3', ".slpp.tmp12_0"), std::chrono::minutes(120));
+  createFile(entry('4', ".slpp.tmp12_1"), std::chrono::minutes(0));
+  // Not entries of the store, never evicted
+  createFile(cacheDir / "antlr.dfa", std::chrono::minutes(60));
+  createFile(cacheDir / "ab" / "notes.txt", std::chrono::minutes(60));
+  createFile(cacheDir / "ab" / "stale.slpp.tmp12_2", std::chrono::minutes(120));
+
+  std::unique_ptr<FileSystem> fileSystem(new PlatformFileSystem(fs::current_path()));
+  std::unique_ptr<SymbolTable> symbolTable(new SymbolTable);
+  Session session(fileSystem.get(), symbolTable.get(), nullptr, nullptr, nullptr, nullptr);
+
+  const std::vector<std::string> args{"surelog",      "-nostdout",   "-cache", cacheDir.string(),
+                                      "-sharedcache", "-cachesize", "1"};
+  std::vector<const char*> cargs;
+  std::transform(args.begin(), args.end(), std::back_inserter(cargs),
+                 [](const std::string& arg) { return arg.data(); });
+  session.parseCommandLine(cargs.size(), cargs.data(), false, false);
+
+  CacheStore store(&session);
+  ASSERT_TRUE(store.enabled());
+
+  // 1200KB of entries for a 1024KB budget, down to 800KB
+  EXPECT_EQ(store.evict(), 1);
+  EXPECT_FALSE(fs::exists(entry('0', ".slpp")));
+  EXPECT_TRUE(fs::exists(entry('1', ".slpa")));
+  EXPECT_TRUE(fs::exists(entry('2', ".slpp")));
+  EXPECT_FALSE(fs::exists(entry('3', ".slpp.tmp12_0")));
+  EXPECT_TRUE(fs::exists(entry('4', ".slpp.tmp12_1")));
+  EXPECT_TRUE(fs::exists(cacheDir / "antlr.dfa"));
+  EXPECT_TRUE(fs::exists(cacheDir / "ab" / "notes.txt"));
+  EXPECT_TRUE(fs::exists(cacheDir / "ab" / "stale.slpp.tmp12_2"));
+
+  // Entries are named after their key
+  CacheStore::Key key;
+  key.add("source.sv");
+  const fs::path entryPath = fileSystem->toPlatformAbsPath(store.getEntryFileId(key, ".slpp"));
+  EXPECT_EQ(entryPath.filename().string(), key.toString() + ".slpp");
+  EXPECT_EQ(entryPath.parent_path().filename().string(), key.toString().substr(0, 2));
+
+  fs::remove_all(cacheDir, ec);
+}
+
+TEST(CacheStoreTest, SharedIsOptIn) {
+  const fs::path cacheDir = fs::temp_directory_path() / "surelog_cachestore_optin_test";
+  std::unique_ptr<FileSystem> fileSystem(new PlatformFileSystem(fs::current_path()));
+  std::unique_ptr<SymbolTable> symbolTable(new SymbolTable);
+  Session session(fileSystem.get(), symbolTable.get(), nullptr, nullptr, nullptr, nullptr);
+
+  const std::vector<std::string> args{"surelog", "-nostdout", "-cache", cacheDir.string()};
+  std::vector<const char*> cargs;
+  std::transform(args.begin(), args.end(), std::back_inserter(cargs),
+                 [](const std::string& arg) { return arg.data(); });
+  session.parseCommandLine(cargs.size(), cargs.data(), false, false);
+
+  // A plain cache directory, still removed by -nocache
+  EXPECT_FALSE(session.getCommandLineParser()->sharedCache());
+  EXPECT_FALSE(CacheStore(&session).enabled());
+
+  std::error_code ec;
+  fs::remove_all(cacheDir, ec);
+}
+}  // namespace
+}  // namespace SURELOG
@@ -0,0 +1,143 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/Cache/CacheWriter.h"
+
+#include <capnp/serialize-packed.h>
+#include <capnp/serialize.h>
+#include <fcntl.h>
+#include <kj/exception.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <io.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace SURELOG {
+
+CacheWriter::CacheWriter(size_t maxPendingBytes) : m_maxPendingBytes(maxPendingBytes) {}
+
+CacheWriter::~CacheWriter() {
+  drain();
+  {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_changed.notify_all();
+  if (m_thread.joinable()) m_thread.join();
+}
+
+bool CacheWriter::write(const std::filesystem::path& filepath,
+                        std::unique_ptr<::capnp::MallocMessageBuilder> message) {
+  const size_t size = ::capnp::computeSerializedSizeInWords(*message) * sizeof(::capnp::word);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // A message larger than the bound is still accepted once the queue is empty
+  m_changed.wait(lock, [this, size] {
+    return m_failed || (m_pendingBytes == 0) || (m_pendingBytes + size <= m_maxPendingBytes);
+  });
+  if (m_failed) return false;
+  m_requests.push_back(Request{filepath, std::move(message), size});
+  m_pendingBytes += size;
+  if (!m_thread.joinable()) m_thread = std::thread(&CacheWriter::run, this);
+  lock.unlock();
+  m_changed.notify_all();
+  return true;
+}
+
+std::vector<std::filesystem::path> CacheWriter::drain() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_changed.wait(lock, [this] { return m_requests.empty() && !m_writing; });
+  std::vector<std::filesystem::path> failedFiles;
+  failedFiles.swap(m_failedFiles);
+  return failedFiles;
+}
+
+void CacheWriter::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_changed.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+    if (m_requests.empty()) break;
+
+    Request request = std::move(m_requests.front());
+    m_requests.pop_front();
+    m_writing = true;
+    const bool failed = m_failed;
+    lock.unlock();
+
+    const bool written = !failed && writeFile(request.m_filepath, *request.m_message);
+    request.m_message.reset();
+
+    lock.lock();
+    if (!written) {
+      // Most likely the next ones would fail as well, drop them
+      m_failed = true;
+      m_failedFiles.emplace_back(std::move(request.m_filepath));
+    }
+    m_writing = false;
+    m_pendingBytes -= request.m_size;
+    m_changed.notify_all();
+  }
+}
+
+bool CacheWriter::writeFile(const std::filesystem::path& filepath, ::capnp::MessageBuilder& message) {
+  static std::atomic<uint32_t> sTempCounter(0);
+
+  std::error_code ec;
+  std::filesystem::create_directories(filepath.parent_path(), ec);
+  if (ec) return false;
+
+  // Unique across the threads and the processes sharing the cache directory
+#if defined(_MSC_VER)
+  const int32_t pid = _getpid();
+#else
+  const int32_t pid = getpid();
+#endif
+  std::filesystem::path tmpFilepath = filepath;
+  tmpFilepath += ".tmp" + std::to_string(pid) + "_" + std::to_string(sTempCounter++);
+
+  const int32_t fd = ::open(tmpFilepath.string().c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_BINARY, S_IRWXU);
+  if (fd < 0) return false;
+
+  bool result = true;
+  try {
+    writePackedMessageToFd(fd, message);
+  } catch (const kj::Exception&) {
+    // Disk full or alike, the cache is simply not updated
+    result = false;
+  }
+  ::close(fd);
+
+  if (result) {
+    std::filesystem::rename(tmpFilepath, filepath, ec);
+    result = !ec;
+  }
+  if (!result) std::filesystem::remove(tmpFilepath, ec);
+  return result;
+}
+
+}  // namespace SURELOG
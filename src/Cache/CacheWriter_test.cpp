@@ -0,0 +1,112 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Cache/CacheWriter.h"
+
+#include <Surelog/Cache/Cache.capnp.h>
+#include <capnp/serialize-packed.h>
+#include <gtest/gtest.h>
+#include <kj/io.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string readSchemaVersion(const fs::path& filepath) {
+  std::ifstream strm(filepath, std::ios_base::binary);
+  const std::vector<char> data((std::istreambuf_iterator<char>(strm)), std::istreambuf_iterator<char>());
+  kj::ArrayInputStream input(kj::ArrayPtr<const kj::byte>(reinterpret_cast<const kj::byte*>(data.data()), data.size()));
+  ::capnp::PackedMessageReader reader(input);
+  return reader.getRoot<::Header>().getSchemaVersion().cStr();
+}
+
+TEST(CacheWriterTest, PublishesCompleteFiles) {
+  const fs::path baseDir = fs::temp_directory_path() / "surelog_cachewriter_test";
+  const fs::path cacheDir = baseDir / "nested" / "cache";
+  std::error_code ec;
+  fs::remove_all(baseDir, ec);
+
+  {
+    // A one byte bound makes every write wait for the previous one
+    CacheWriter writer(1);
+    for (int32_t i = 0; i < 16; ++i) {
+      std::unique_ptr<::capnp::MallocMessageBuilder> message = std::make_unique<::capnp::MallocMessageBuilder>();
+      message->initRoot<::Header>().setSchemaVersion(std::to_string(i));
+      writer.write(cacheDir / ("file" + std::to_string(i % 4)), std::move(message));
+    }
+    writer.drain();
+    EXPECT_EQ(readSchemaVersion(cacheDir / "file0"), "12");
+
+    std::unique_ptr<::capnp::MallocMessageBuilder> message = std::make_unique<::capnp::MallocMessageBuilder>();
+    message->initRoot<::Header>().setSchemaVersion("last");
+    writer.write(cacheDir / "file1", std::move(message));
+  }  // The destructor drains the queue
+
+  EXPECT_EQ(readSchemaVersion(cacheDir / "file1"), "last");
+  EXPECT_EQ(readSchemaVersion(cacheDir / "file2"), "14");
+  EXPECT_EQ(readSchemaVersion(cacheDir / "file3"), "15");
+
+  // No temporary file left behind
+  size_t fileCount = 0;
+  for (const fs::directory_entry& entry : fs::directory_iterator(cacheDir, ec)) {
+    EXPECT_EQ(entry.path().filename().string().find(".tmp"), std::string::npos) << entry.path();
+    ++fileCount;
+  }
+  EXPECT_EQ(fileCount, 4);
+
+  fs::remove_all(baseDir, ec);
+}
+
+TEST(CacheWriterTest, ReportsFailedWrites) {
+  const fs::path baseDir = fs::temp_directory_path() / "surelog_cachewriter_failure_test";
+  std::error_code ec;
+  fs::remove_all(baseDir, ec);
+  fs::create_directories(baseDir, ec);
+  // A file where a directory is expected
+  const fs::path blocker = baseDir / "blocker";
+  std::ofstream(blocker) << "not a directory";
+
+  CacheWriter writer;
+  auto makeMessage = []() {
+    std::unique_ptr<::capnp::MallocMessageBuilder> message = std::make_unique<::capnp::MallocMessageBuilder>();
+    message->initRoot<::Header>().setSchemaVersion("1");
+    return message;
+  };
+  EXPECT_TRUE(writer.write(blocker / "file", makeMessage()));
+  const std::vector<fs::path> failedFiles = writer.drain();
+  ASSERT_EQ(failedFiles.size(), 1);
+  EXPECT_EQ(failedFiles[0], blocker / "file");
+
+  // Turned off, and reported once only
+  EXPECT_FALSE(writer.write(baseDir / "other", makeMessage()));
+  EXPECT_TRUE(writer.drain().empty());
+  EXPECT_FALSE(fs::exists(baseDir / "other"));
+
+  fs::remove_all(baseDir, ec);
+}
+}  // namespace
+}  // namespace SURELOG
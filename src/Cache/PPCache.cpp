@@ -30,12 +30,17 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "Surelog/Cache/CacheStore.h"
+#include "Surelog/Cache/CacheWriter.h"
 #include "Surelog/CommandLine/CommandLineParser.h"
 #include "Surelog/Common/FileSystem.h"
 #include "Surelog/Common/PathId.h"
@@ -44,7 +49,7 @@
 #include "Surelog/Design/Design.h"
 #include "Surelog/Design/FileContent.h"
 #include "Surelog/Design/TimeInfo.h"
-#include "Surelog/Design/VObject.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
 #include "Surelog/ErrorReporting/Location.h"
 #include "Surelog/Library/Library.h"
@@ -69,7 +74,7 @@
 #include <limits>
 
 namespace SURELOG {
-static constexpr std::string_view kSchemaVersion = "1.6";
+static constexpr std::string_view kSchemaVersion = "1.8";
 static constexpr std::string_view UnknownRawPath = "<unknown>";
 
 PPCache::PPCache(Session* session, PreprocessFile* pp) : Cache(session), m_pp(pp) {}
@@ -95,6 +100,27 @@ PathId PPCache::getCacheFileId(PathId sourceFileId) const {
   Precompiled* const precompiled = m_session->getPrecompiled();
   const bool isPrecompiled = precompiled->isFilePrecompiled(sourceFileId);
 
+  CacheStore store(m_session);
+  if (store.enabled() && !isPrecompiled) {
+    // Everything the preprocessed content depends on. The includes are only
+    // known once preprocessed, the entry records their contents instead, see
+    // includesKey.
+    CacheStore::Key key;
+    key.add(kSchemaVersion).add(CommandLineParser::getVersionNumber());
+    key.add(fileSystem->toPath(sourceFileId)).add(libName);
+    key.add(clp->fileUnit()).add(clp->fullSVMode());
+    std::vector<std::string> defines;
+    defines.reserve(clp->getDefineList().size());
+    for (const auto& definePair : clp->getDefineList()) {
+      defines.emplace_back(StrCat(symbols->getSymbol(definePair.first), "=", definePair.second));
+    }
+    std::sort(defines.begin(), defines.end());
+    for (const std::string& define : defines) key.add(define);
+    for (const PathId& includePathId : clp->getIncludePaths()) key.add(fileSystem->toPath(includePathId));
+    if (!key.addFileContent(fileSystem, sourceFileId)) return BadPathId;
+    return store.getEntryFileId(key, ".slpp");
+  }
+
   return fileSystem->getPpCacheFile(clp->fileUnit(), sourceFileId, libName, isPrecompiled, symbols);
 }
 
@@ -124,7 +150,7 @@ void PPCache::cacheErrors(::PPCache::Builder builder, SymbolTable& targetSymbols
 
 void PPCache::cacheVObjects(::PPCache::Builder builder, const FileContent* fC, SymbolTable& targetSymbols,
                             const SymbolTable& sourceSymbols, PathId fileId) {
-  const std::vector<VObject>& sourceVObjects = fC->getVObjects();
+  const VObjectStore& sourceVObjects = fC->getVObjects();
   ::capnp::List<::VObject, ::capnp::Kind::STRUCT>::Builder targetVObjects = builder.initObjects(sourceVObjects.size());
   Cache::cacheVObjects(targetVObjects, targetSymbols, sourceVObjects, sourceSymbols);
 }
@@ -147,7 +173,9 @@ bool PPCache::checkCacheIsValid(PathId cacheFileId, const ::PPCache::Reader& roo
     return checkIfCacheIsValid(sourceHeader, kSchemaVersion, BadPathId, BadPathId);
   }
 
-  if (!checkIfCacheIsValid(sourceHeader, kSchemaVersion, cacheFileId, m_pp->getFileId(LINE1))) {
+  // Shared store entries are addressed by content, their age is irrelevant
+  const PathId timestampedFileId = CacheStore(m_session).enabled() ? BadPathId : cacheFileId;
+  if (!checkIfCacheIsValid(sourceHeader, kSchemaVersion, timestampedFileId, m_pp->getFileId(LINE1))) {
     return false;
   }
 
@@ -183,6 +211,7 @@ bool PPCache::checkCacheIsValid(PathId cacheFileId, const ::PPCache::Reader& roo
   const ::capnp::List<::IncludeFileInfo, ::capnp::Kind::STRUCT>::Reader& sourceIncludeFileInfos =
       root.getIncludeFileInfos();
   PathIdSet targetIncludedFileIds;
+  CacheStore::Key includesKey;
   for (const ::IncludeFileInfo::Reader& sourceIncludeFileInfo : sourceIncludeFileInfos) {
     IncludeFileInfo::Context context = static_cast<IncludeFileInfo::Context>(sourceIncludeFileInfo.getContext());
     IncludeFileInfo::Action action = static_cast<IncludeFileInfo::Action>(sourceIncludeFileInfo.getAction());
@@ -195,9 +224,17 @@ bool PPCache::checkCacheIsValid(PathId cacheFileId, const ::PPCache::Reader& roo
         return false;  // Symbols don't resolve to the same file!
       }
       targetIncludedFileIds.emplace(sessionFileId);
+      if (!includesKey.addFileContent(fileSystem, sessionFileId)) return false;
     }
   }
 
+  // The body has the includes expanded, the entries of the included files
+  // can't vouch for it: another process may have stored them for newer
+  // contents.
+  if (CacheStore(m_session).enabled() && (includesKey.toString() != root.getIncludesKey().cStr())) {
+    return false;
+  }
+
   // Check all includes recursively!
   if (!std::all_of(targetIncludedFileIds.begin(), targetIncludedFileIds.end(),
                    [this](const PathId& targetIncludedFileId) {
@@ -386,6 +423,18 @@ void PPCache::cacheIncludeFileInfos(::PPCache::Builder builder, SymbolTable& tar
   ::capnp::List<::IncludeFileInfo, ::capnp::Kind::STRUCT>::Builder targetIncludeFileInfos =
       builder.initIncludeFileInfos(sourceIncludeFileInfos.size());
 
+  // Every include, nested ones too, in the order checkCacheIsValid() reads them
+  if (CacheStore(m_session).enabled()) {
+    CacheStore::Key includesKey;
+    for (const IncludeFileInfo& sourceIncludeFileInfo : sourceIncludeFileInfos) {
+      if ((sourceIncludeFileInfo.m_context == IncludeFileInfo::Context::Include) &&
+          (sourceIncludeFileInfo.m_action == IncludeFileInfo::Action::Push)) {
+        includesKey.addFileContent(fileSystem, sourceIncludeFileInfo.m_sectionFileId);
+      }
+    }
+    builder.setIncludesKey(includesKey.toString());
+  }
+
   for (size_t i = 0, ni = sourceIncludeFileInfos.size(); i < ni; ++i) {
     const IncludeFileInfo& sourceIncludeFileInfo = sourceIncludeFileInfos[i];
     ::IncludeFileInfo::Builder targetIncludeFileInfo = targetIncludeFileInfos[i];
@@ -646,7 +695,9 @@ bool PPCache::restore(bool errorsOnly) {
   }
 
   PathId cacheFileId = getCacheFileId(BadPathId);
-  return cacheFileId && restore(cacheFileId, errorsOnly, 0);
+  if (!cacheFileId || !restore(cacheFileId, errorsOnly, 0)) return false;
+  CacheStore(m_session).touch(cacheFileId);
+  return true;
 }
 
 bool PPCache::save() {
@@ -677,8 +728,8 @@ bool PPCache::save() {
   SymbolTable* const sourceSymbols = m_session->getSymbolTable();
   SymbolTable targetSymbols;
 
-  ::capnp::MallocMessageBuilder message;
-  ::PPCache::Builder builder = message.initRoot<::PPCache>();
+  std::unique_ptr<::capnp::MallocMessageBuilder> message = std::make_unique<::capnp::MallocMessageBuilder>();
+  ::PPCache::Builder builder = message->initRoot<::PPCache>();
 
   // Create header section
   cacheHeader(builder.getHeader(), kSchemaVersion);
@@ -717,16 +768,7 @@ bool PPCache::save() {
   // Cache symbols
   cacheSymbols(builder, targetSymbols);
 
-  // Finally, save to disk
-  PathId cacheDirId = fileSystem->getParent(cacheFileId, sourceSymbols);
-  if (!fileSystem->mkdirs(cacheDirId)) return false;
-
-  const std::string filepath = fileSystem->toPlatformAbsPath(cacheFileId).string();
-  const int32_t fd = ::open(filepath.c_str(), O_CREAT | O_WRONLY | O_BINARY, S_IRWXU);
-  if (fd < 0) return false;
-
-  writePackedMessageToFd(fd, message);
-  ::close(fd);
-  return true;
+  // Finally, hand over to the background writer
+  return m_session->getCacheWriter()->write(fileSystem->toPlatformAbsPath(cacheFileId), std::move(message));
 }
 }  // namespace SURELOG
@@ -32,6 +32,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <thread>
 #include <vector>
@@ -246,5 +247,75 @@ TEST(PPCacheTest, IncludeChangeTolerance) {
   fs::remove_all(kBaseDir, ec);
   EXPECT_FALSE(ec) << ec;
 }
+
+TEST(PPCacheTest, SharedStoreChecksIncludeContents) {
+  // source.sv includes header.sv, which changes from A to B and back to A.
+  // The third run finds the header's entry for A, but source.sv's entry
+  // was last stored with B expanded in it.
+  const fs::path kBaseDir = fs::path(testing::TempDir()) / "shared_store_includes";
+  const fs::path kInputDir = kBaseDir / "input";
+  const fs::path kCacheDir = kBaseDir / "cache";
+  const fs::path kProgramFile = FileSystem::getProgramPath();
+
+  std::error_code ec;
+  fs::remove_all(kBaseDir, ec);
+
+  std::unique_ptr<FileSystem> fileSystem(new TestFileSystem(kInputDir));
+  std::unique_ptr<SymbolTable> symbolTable(new SymbolTable);
+
+  const PathId kInputDirId = fileSystem->toPathId(kInputDir.string(), symbolTable.get());
+  EXPECT_TRUE(fileSystem->mkdirs(kInputDirId));
+  const PathId headerFileId = fileSystem->getChild(kInputDirId, "header.sv", symbolTable.get());
+  const PathId sourceFileId = fileSystem->getChild(kInputDirId, "source.sv", symbolTable.get());
+
+  std::ostream &strm1 = fileSystem->openForWrite(sourceFileId);
+  EXPECT_TRUE(strm1.good());
+  strm1 << "`include \"header.sv\"" << std::endl << "module top(output int o);" << std::endl
+        << "  assign o = `VALUE;" << std::endl << "endmodule" << std::endl;
+  fileSystem->close(strm1);
+
+  // Returns whether source.sv was restored from the cache
+  const auto run = [&](std::string_view value, const std::string &outputDir) {
+    std::ostream &strm = fileSystem->openForWrite(headerFileId);
+    EXPECT_TRUE(strm.good());
+    strm << "`define VALUE " << value << std::endl;
+    fileSystem->close(strm);
+
+    Session session(fileSystem.get(), symbolTable.get(), nullptr, nullptr, nullptr, nullptr);
+    const std::vector<std::string> args{kProgramFile.string(),
+                                        "-nostdout",
+                                        "-nobuiltin",
+                                        "-parse",
+                                        std::string("-I").append(fileSystem->toPath(kInputDirId)),
+                                        std::string(fileSystem->toPath(sourceFileId)),
+                                        std::string(fileSystem->toPath(headerFileId)),
+                                        "-cache",
+                                        kCacheDir.string(),
+                                        "-sharedcache",
+                                        "-o",
+                                        (kBaseDir / outputDir).string()};
+    std::vector<const char *> cargs;
+    std::transform(args.begin(), args.end(), std::back_inserter(cargs),
+                   [](const std::string &arg) { return arg.data(); });
+    session.parseCommandLine(cargs.size(), cargs.data(), false, false);
+
+    std::unique_ptr<Compiler> compiler(new Compiler(&session));
+    compiler->compile();
+    bool cached = false;
+    for (CompileSourceFile *csf : compiler->getCompileSourceFiles()) {
+      if (csf->getFileId() == sourceFileId) cached = csf->getPreprocessor()->usingCachedVersion();
+    }
+    return cached;
+  };
+
+  EXPECT_FALSE(run("1", "output1"));
+  EXPECT_FALSE(run("2", "output2"));
+  EXPECT_FALSE(run("1", "output3"));
+  // Nothing changed since
+  EXPECT_TRUE(run("1", "output4"));
+
+  fs::remove_all(kBaseDir, ec);
+  EXPECT_FALSE(ec) << ec;
+}
 }  // namespace
 }  // namespace SURELOG
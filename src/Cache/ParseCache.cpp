@@ -32,10 +32,14 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "Surelog/Cache/CacheStore.h"
+#include "Surelog/Cache/CacheWriter.h"
 #include "Surelog/CommandLine/CommandLineParser.h"
 #include "Surelog/Common/FileSystem.h"
 #include "Surelog/Common/NodeId.h"
@@ -45,7 +49,7 @@
 #include "Surelog/Design/Design.h"
 #include "Surelog/Design/DesignElement.h"
 #include "Surelog/Design/FileContent.h"
-#include "Surelog/Design/VObject.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/ErrorReporting/Error.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
 #include "Surelog/ErrorReporting/Location.h"
@@ -70,7 +74,7 @@
 #include <limits>
 
 namespace SURELOG {
-static constexpr char kSchemaVersion[] = "1.4";
+static constexpr char kSchemaVersion[] = "1.5";
 static constexpr std::string_view UnknownRawPath = "<unknown>";
 
 ParseCache::ParseCache(Session* session, ParseFile* parser) : Cache(session), m_parse(parser) {}
@@ -96,6 +100,18 @@ PathId ParseCache::getCacheFileId(PathId ppFileId) const {
   Precompiled* const precompiled = m_session->getPrecompiled();
   const bool isPrecompiled = precompiled->isFilePrecompiled(ppFileId);
 
+  CacheStore store(m_session);
+  if (store.enabled() && !isPrecompiled) {
+    // The preprocessed content and the source it maps back to, not the
+    // preprocessor output location which differs between output dirs.
+    CacheStore::Key key;
+    key.add(kSchemaVersion).add(CommandLineParser::getVersionNumber());
+    key.add(fileSystem->toPath(m_parse->getFileId(LINE1))).add(libName);
+    key.add(clp->fileUnit()).add(clp->fullSVMode());
+    if (!key.addFileContent(fileSystem, ppFileId)) return BadPathId;
+    return store.getEntryFileId(key, ".slpa");
+  }
+
   return fileSystem->getParseCacheFile(clp->fileUnit(), ppFileId, libName, isPrecompiled, symbols);
 }
 
@@ -108,7 +124,9 @@ bool ParseCache::checkCacheIsValid(PathId cacheFileId, const ::ParseCache::Reade
     // BadPathId instead of the actual arguments)
     return checkIfCacheIsValid(sourceHeader, kSchemaVersion, BadPathId, BadPathId);
   } else {
-    return checkIfCacheIsValid(sourceHeader, kSchemaVersion, cacheFileId, m_parse->getPpFileId());
+    // Shared store entries are addressed by content, their age is irrelevant
+    const PathId timestampedFileId = CacheStore(m_session).enabled() ? BadPathId : cacheFileId;
+    return checkIfCacheIsValid(sourceHeader, kSchemaVersion, timestampedFileId, m_parse->getPpFileId());
   }
 }
 
@@ -163,7 +181,7 @@ void ParseCache::cacheErrors(::ParseCache::Builder builder, SymbolTable& targetS
 
 void ParseCache::cacheVObjects(::ParseCache::Builder builder, const FileContent* fC, SymbolTable& targetSymbols,
                                const SymbolTable& sourceSymbols, PathId fileId) {
-  const std::vector<VObject>& sourceVObjects = fC->getVObjects();
+  const VObjectStore& sourceVObjects = fC->getVObjects();
   ::capnp::List<::VObject, ::capnp::Kind::STRUCT>::Builder targetVObjects = builder.initObjects(sourceVObjects.size());
   Cache::cacheVObjects(targetVObjects, targetSymbols, sourceVObjects, sourceSymbols);
 }
@@ -299,7 +317,9 @@ bool ParseCache::restore() {
   }
 
   PathId cacheFileId = getCacheFileId(BadPathId);
-  return cacheFileId && restore(cacheFileId);
+  if (!cacheFileId || !restore(cacheFileId)) return false;
+  CacheStore(m_session).touch(cacheFileId);
+  return true;
 }
 
 bool ParseCache::save() {
@@ -327,8 +347,8 @@ bool ParseCache::save() {
   SymbolTable* const sourceSymbols = m_session->getSymbolTable();
   SymbolTable targetSymbols;
 
-  ::capnp::MallocMessageBuilder message;
-  ::ParseCache::Builder builder = message.initRoot<::ParseCache>();
+  std::unique_ptr<::capnp::MallocMessageBuilder> message = std::make_unique<::capnp::MallocMessageBuilder>();
+  ::ParseCache::Builder builder = message->initRoot<::ParseCache>();
 
   // Create header section
   cacheHeader(builder.getHeader(), kSchemaVersion);
@@ -347,16 +367,7 @@ bool ParseCache::save() {
   // Cache symbols
   cacheSymbols(builder, targetSymbols);
 
-  // Finally, save to disk
-  PathId cacheDirId = fileSystem->getParent(cacheFileId, sourceSymbols);
-  if (!fileSystem->mkdirs(cacheDirId)) return false;
-
-  const std::string filepath = fileSystem->toPlatformAbsPath(cacheFileId).string();
-  const int32_t fd = ::open(filepath.c_str(), O_CREAT | O_WRONLY | O_BINARY, S_IRWXU);
-  if (fd < 0) return false;
-
-  writePackedMessageToFd(fd, message);
-  ::close(fd);
-  return true;
+  // Finally, hand over to the background writer
+  return m_session->getCacheWriter()->write(fileSystem->toPlatformAbsPath(cacheFileId), std::move(message));
 }
 }  // namespace SURELOG
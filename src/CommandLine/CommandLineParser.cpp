@@ -60,6 +60,7 @@ namespace SURELOG {
 namespace fs = std::filesystem;
 
 constexpr uint32_t kLinesForFileSplitting = 10000000;
+constexpr uint64_t kDefaultCacheSizeMB = 4096;
 
 static std::unordered_map<std::string, int32_t> cmd_ignore;  // commands with an arg to be dropped, and the number of
                                                              // args to drop
@@ -162,6 +163,8 @@ static const std::initializer_list<std::string_view> helpText = {
     "  -top/--top-module <module>",
     "                        Top level module for elaboration",
     "                        (multiple cmds ok)",
+    "  -toponly              Only compiles and writes to UHDM the design units",
+    "                        reachable from the -top modules",
     "  -bb_mod <module>      Blackbox module (multiple cmds ok, ex: -bb_mod",
     "                        work@top)",
     "  -bb_inst <instance>   Blackbox instance (multiple cmds ok, ex:",
@@ -197,8 +200,14 @@ static const std::initializer_list<std::string_view> helpText = {
     "  -lowmem               Minimizes memory high water mark (uses multiple",
     "                        staggered processes for preproc, parsing and",
     "                        elaboration)",
+    "  -streamparse          Builds the parser objects while parsing, releasing",
+    "                        each top level description once it is converted",
+    "  -fastlexer            Tokenizes with the hand written lexer instead of",
+    "                        the ANTLR generated one",
     "  -split <line number>  Split files or modules larger than specified",
-    "                        line number for multi thread compilation",
+    "                        line number for multi thread compilation. By",
+    "                        default (0), large files are split in as many",
+    "                        chunks as there are threads",
     "  -timescale=<timescale>",
     "                        Specifies the overall timescale",
     "  -nobuiltin            Do not parse SV builtin classes (array...)",
@@ -209,6 +218,12 @@ static const std::initializer_list<std::string_view> helpText = {
     "  -nostdout             Mutes Standard output",
     "  -verbose              Gives verbose processing information",
     "  -profile              Gives Profiling information",
+    "  -trace <file>         Writes the timeline of the compilation phases and",
+    "                        of each file, per thread, in the Chrome trace",
+    "                        format (chrome://tracing, ui.perfetto.dev)",
+    "  -memstats <file>      Reports the resident set size and the bytes held",
+    "                        by the main structures after each compilation",
+    "                        phase, in the log and as JSON in <file>",
     "  -replay               Enables replay of internal elaboration errors",
     "  -l <filename>         Specifies log file name, default is surelog.log",
     "",
@@ -229,6 +244,11 @@ static const std::initializer_list<std::string_view> helpText = {
     "                        prevents it",
     "  -cache <dir>          Specifies the cache directory, default is",
     "                        slpp_all/cache or slpp_unit/cache",
+    "  -sharedcache          Makes the cache directory a content addressed",
+    "                        store that concurrent runs can share",
+    "  -cachesize <MB>       Size budget of the -sharedcache store, least",
+    "                        recently used entries are evicted beyond it",
+    "                        (default 4096)",
     "  -nohash               Treat cache as always valid (no",
     "                        timestamp/dependancy check)",
     "  -createcache          Create cache for precompiled packages",
@@ -398,7 +418,7 @@ CommandLineParser::CommandLineParser(Session* session)
 #else
       m_pythonAllowed(false),
 #endif
-      m_linesForFileSplitting(kLinesForFileSplitting),
+      m_linesForFileSplitting(0),
       m_pythonEvalScriptPerFile(false),
       m_pythonEvalScript(false),
       m_debugIncludeFileInfo(false),
@@ -407,6 +427,7 @@ CommandLineParser::CommandLineParser(Session* session)
       m_parseBuiltIn(true),
       m_ppOutputFileLocation(false),
       m_ppPrintLineInfo(false),
+      m_topOnly(false),
       m_sverilog(false),
       m_dumpUhdm(false),
       m_elabUhdm(false),
@@ -415,10 +436,14 @@ CommandLineParser::CommandLineParser(Session* session)
       m_replay(false),
       m_uhdmStats(false),
       m_lowMem(false),
+      m_streamParse(false),
+      m_fastLexer(false),
       m_writeUhdm(true),
       m_nonSynthesizable(false),
       m_nonSynthesizableWithFormal(false),
       m_noCacheHash(false),
+      m_sharedCache(false),
+      m_cacheSizeBudget(kDefaultCacheSizeMB * 1024 * 1024),
       m_sepComp(false),
       m_link(false),
       m_gc(true),
@@ -1066,7 +1091,11 @@ bool CommandLineParser::parse(int32_t argc, const char** argv, bool diffCompMode
       m_lowMem = true;
     }
 #endif
-    else if (all_arguments[i] == "-nouhdm") {
+    else if (all_arguments[i] == "-streamparse") {
+      m_streamParse = true;
+    } else if (all_arguments[i] == "-fastlexer") {
+      m_fastLexer = true;
+    } else if (all_arguments[i] == "-nouhdm") {
       m_writeUhdm = false;
     } else if (all_arguments[i] == "-mt" || all_arguments[i] == "--threads" || all_arguments[i] == "-mp") {
       bool mt = ((all_arguments[i] == "-mt") || (all_arguments[i] == "--threads"));
@@ -1126,6 +1155,8 @@ bool CommandLineParser::parse(int32_t argc, const char** argv, bool diffCompMode
     } else if ((all_arguments[i] == "--top-module") || (all_arguments[i] == "-top")) {
       i++;
       m_topLevelModules.insert(all_arguments[i]);
+    } else if (all_arguments[i] == "-toponly") {
+      m_topOnly = true;
     } else if (all_arguments[i] == "-bb_mod") {
       i++;
       m_blackboxModules.insert(all_arguments[i]);
@@ -1202,6 +1233,16 @@ bool CommandLineParser::parse(int32_t argc, const char** argv, bool diffCompMode
       } else {
         m_cacheDirId = fileSystem->toPathId(dirpath.string(), symbols);
       }
+    } else if (all_arguments[i] == "-sharedcache") {
+      m_sharedCache = true;
+    } else if (all_arguments[i] == "-cachesize") {
+      if (i == all_arguments.size() - 1) {
+        Location loc(symbols->registerSymbol(all_arguments[i]));
+        errors->addError(ErrorDefinition::CMD_CACHE_MISSING_SIZE, loc);
+        break;
+      }
+      i++;
+      m_cacheSizeBudget = std::stoull(all_arguments[i]) * 1024 * 1024;
     } else if (all_arguments[i] == "-replay") {
       m_replay = true;
     } else if (all_arguments[i] == "-writepp") {
@@ -1219,6 +1260,30 @@ bool CommandLineParser::parse(int32_t argc, const char** argv, bool diffCompMode
       m_nonSynthesizableWithFormal = true;
     } else if (all_arguments[i] == "-profile") {
       m_profile = true;
+    } else if (all_arguments[i] == "-trace") {
+      if (i == all_arguments.size() - 1) {
+        Location loc(symbols->registerSymbol(all_arguments[i]));
+        errors->addError(ErrorDefinition::CMD_TRACE_MISSING_FILE, loc);
+        break;
+      }
+      fs::path filepath = FileSystem::normalize(all_arguments[++i]);
+      if (filepath.is_relative()) {
+        m_traceFileId = fileSystem->getChild(m_outputDirId, filepath.string(), symbols);
+      } else {
+        m_traceFileId = fileSystem->toPathId(filepath.string(), symbols);
+      }
+    } else if (all_arguments[i] == "-memstats") {
+      if (i == all_arguments.size() - 1) {
+        Location loc(symbols->registerSymbol(all_arguments[i]));
+        errors->addError(ErrorDefinition::CMD_MEMSTATS_MISSING_FILE, loc);
+        break;
+      }
+      fs::path filepath = FileSystem::normalize(all_arguments[++i]);
+      if (filepath.is_relative()) {
+        m_memoryStatsFileId = fileSystem->getChild(m_outputDirId, filepath.string(), symbols);
+      } else {
+        m_memoryStatsFileId = fileSystem->toPathId(filepath.string(), symbols);
+      }
     } else if (all_arguments[i] == "-nobuiltin") {
       m_parseBuiltIn = false;
     } else if (all_arguments[i] == "-outputlineinfo") {
@@ -1568,7 +1633,8 @@ bool CommandLineParser::cleanCache() {
     m_cacheDirId = fileSystem->getCacheDir(m_fileUnit, symbols);
   }
 
-  if (!m_cacheAllowed && !fileSystem->rmtree(m_cacheDirId)) {
+  // Other processes may be using a shared cache, it is trimmed by eviction
+  if (!m_cacheAllowed && !m_sharedCache && !fileSystem->rmtree(m_cacheDirId)) {
     std::cerr << "ERROR: Cannot delete cache directory: " << PathIdPP(m_cacheDirId, fileSystem) << std::endl;
     noError = false;
   }
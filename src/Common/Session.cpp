@@ -21,6 +21,7 @@
  * Created on April 1, 2024, 0:00 AM
  */
 
+#include <Surelog/Cache/CacheWriter.h>
 #include <Surelog/CommandLine/CommandLineParser.h>
 #include <Surelog/Common/PlatformFileSystem.h>
 #include <Surelog/Common/Session.h>
@@ -28,6 +29,7 @@
 #include <Surelog/ErrorReporting/LogListener.h>
 #include <Surelog/Package/Precompiled.h>
 #include <Surelog/SourceCompile/SymbolTable.h>
+#include <Surelog/Utils/Tracer.h>
 
 #include <filesystem>
 
@@ -35,27 +37,36 @@ namespace fs = std::filesystem;
 
 namespace SURELOG {
 Session::Session(FileSystem *fileSystem, SymbolTable *symbolTable, LogListener *logListener,
-                 ErrorContainer *errorContainer, CommandLineParser *commandLineParser, Precompiled *precompiled)
+                 ErrorContainer *errorContainer, CommandLineParser *commandLineParser, Precompiled *precompiled,
+                 CacheWriter *cacheWriter, Tracer *tracer)
     : m_fileSystem(fileSystem == nullptr ? new PlatformFileSystem(fs::current_path()) : fileSystem),
       m_symbolTable(symbolTable == nullptr ? new SymbolTable : symbolTable),
       m_logListener(logListener == nullptr ? new LogListener(this) : logListener),
       m_precompiled(precompiled == nullptr ? new Precompiled(this) : precompiled),
       m_errorContainer(errorContainer == nullptr ? new ErrorContainer(this) : errorContainer),
       m_commandLineParser(commandLineParser == nullptr ? new CommandLineParser(this) : commandLineParser),
+      m_cacheWriter(cacheWriter == nullptr ? new CacheWriter : cacheWriter),
+      m_tracer(tracer == nullptr ? new Tracer : tracer),
       m_ownsFileSystem(fileSystem == nullptr),
       m_ownsSymbolTable(symbolTable == nullptr),
       m_ownsLogListener(logListener == nullptr),
       m_ownsPrecompiled(precompiled == nullptr),
       m_ownsErrorContainer(errorContainer == nullptr),
-      m_ownsCommandLineParser(commandLineParser == nullptr) {}
+      m_ownsCommandLineParser(commandLineParser == nullptr),
+      m_ownsCacheWriter(cacheWriter == nullptr),
+      m_ownsTracer(tracer == nullptr) {}
 
 Session::Session() : Session(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr) {}
 
 Session::Session(Session *session)
     : Session(session->m_fileSystem, session->m_symbolTable, session->m_logListener, session->m_errorContainer,
-              session->m_commandLineParser, session->m_precompiled) {}
+              session->m_commandLineParser, session->m_precompiled, session->m_cacheWriter, session->m_tracer) {}
 
 Session::~Session() {
+  // Drains the pending cache writes
+  if (m_ownsCacheWriter) delete m_cacheWriter;
+  // Writes the trace, if enabled
+  if (m_ownsTracer) delete m_tracer;
   if (m_ownsFileSystem) delete m_fileSystem;
   if (m_ownsSymbolTable) delete m_symbolTable;
   if (m_ownsLogListener) delete m_logListener;
@@ -65,7 +76,11 @@ Session::~Session() {
 }
 
 bool Session::parseCommandLine(int32_t argc, const char **argv, bool diffCompMode, bool fileUnit) {
-  return m_commandLineParser->parse(argc, argv, diffCompMode, fileUnit);
+  const bool result = m_commandLineParser->parse(argc, argv, diffCompMode, fileUnit);
+  if (const PathId traceFileId = m_commandLineParser->traceFileId()) {
+    m_tracer->enable(m_fileSystem, traceFileId);
+  }
+  return result;
 }
 
 }  // namespace SURELOG
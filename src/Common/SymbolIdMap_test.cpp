@@ -0,0 +1,87 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Common/SymbolIdMap.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Surelog/Common/SymbolId.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
+
+namespace SURELOG {
+
+namespace {
+TEST(SymbolIdMapTest, InlineEntries) {
+  SymbolTable symbols;
+  const SymbolId a = symbols.registerSymbol("a");
+  const SymbolId b = symbols.registerSymbol("b");
+
+  SymbolIdMap<int32_t> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find(a), nullptr);
+
+  EXPECT_TRUE(map.emplace(b, 2).second);
+  EXPECT_TRUE(map.emplace(a, 1).second);
+  EXPECT_FALSE(map.emplace(a, 3).second);
+  ASSERT_NE(map.find(a), nullptr);
+  EXPECT_EQ(*map.find(a), 1);
+  EXPECT_EQ(map.size(), 2);
+
+  // Insertion order
+  std::vector<std::string> names;
+  for (const auto& [id, value] : map) names.emplace_back(symbols.getSymbol(id));
+  EXPECT_EQ(names, (std::vector<std::string>{"b", "a"}));
+
+  EXPECT_TRUE(map.erase(b));
+  EXPECT_FALSE(map.erase(b));
+  EXPECT_EQ(map.find(b), nullptr);
+  EXPECT_EQ(*map.find(a), 1);
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(SymbolIdMapTest, HashedEntries) {
+  SymbolTable symbols;
+  std::vector<SymbolId> ids;
+  for (int32_t i = 0; i < 100; ++i) ids.emplace_back(symbols.registerSymbol("p" + std::to_string(i)));
+
+  SymbolIdMap<int32_t, 2> map;
+  for (int32_t i = 0; i < 100; ++i) map.emplace(ids[i], i);
+  EXPECT_EQ(map.size(), 100);
+  for (int32_t i = 0; i < 100; ++i) {
+    ASSERT_NE(map.find(ids[i]), nullptr);
+    EXPECT_EQ(*map.find(ids[i]), i);
+  }
+
+  for (int32_t i = 0; i < 100; i += 2) EXPECT_TRUE(map.erase(ids[i]));
+  EXPECT_EQ(map.size(), 50);
+  int32_t expected = 1;
+  for (const auto& [id, value] : map) {
+    EXPECT_EQ(value, expected);
+    expected += 2;
+  }
+  for (int32_t i = 0; i < 100; ++i) EXPECT_EQ(map.find(ids[i]) != nullptr, (i % 2) == 1);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find(ids[1]), nullptr);
+  EXPECT_TRUE(map.emplace(ids[1], 1).second);
+}
+}  // namespace
+}  // namespace SURELOG
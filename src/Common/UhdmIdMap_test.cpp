@@ -0,0 +1,59 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Common/UhdmIdMap.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+
+namespace SURELOG {
+
+namespace {
+TEST(UhdmIdMapTest, InsertAndFind) {
+  UhdmIdMap<int32_t> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find(0), nullptr);
+
+  map.insert_or_assign(0, 10);
+  map.insert_or_assign(7, 70);
+  map.insert_or_assign(0, 11);
+  EXPECT_EQ(map.size(), 2);
+  ASSERT_NE(map.find(0), nullptr);
+  EXPECT_EQ(*map.find(0), 11);
+  EXPECT_EQ(*map.find(7), 70);
+  EXPECT_EQ(map.find(1), nullptr);
+}
+
+TEST(UhdmIdMapTest, Rehash) {
+  UhdmIdMap<uint32_t> map;
+  map.reserve(10);
+  std::map<uint32_t, uint32_t> expected;
+  // Strided ids, as allocated to the objects of a file
+  for (uint32_t id = 3; id < 40000; id += 4) {
+    map.insert_or_assign(id, id * 2);
+    expected.emplace(id, id * 2);
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  for (const auto& [id, value] : expected) {
+    ASSERT_NE(map.find(id), nullptr);
+    EXPECT_EQ(*map.find(id), value);
+    EXPECT_EQ(map.find(id + 1), nullptr);
+  }
+}
+}  // namespace
+}  // namespace SURELOG
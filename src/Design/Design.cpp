@@ -36,6 +36,7 @@
 
 #include "Surelog/Common/NodeId.h"
 #include "Surelog/Common/Session.h"
+#include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/DefParam.h"
 #include "Surelog/Design/DesignComponent.h"
 #include "Surelog/Design/FileContent.h"
@@ -62,6 +63,13 @@ Design::Design(Session* session, uhdm::Serializer& serializer, LibrarySet* libra
       m_librarySet(librarySet),
       m_configSet(configSet) {}
 
+// A name that is not in the symbol table can't be defined either
+SymbolId Design::lookupName_(std::string_view name) const { return m_session->getSymbolTable()->getId(name); }
+
+SymbolId Design::registerName_(std::string_view name) { return m_session->getSymbolTable()->registerSymbol(name); }
+
+std::string_view Design::getName_(SymbolId id) const { return m_session->getSymbolTable()->getSymbol(id); }
+
 Design::~Design() {
   for (const auto& elem : m_ppFileContents) {
     delete elem.second;
@@ -81,9 +89,12 @@ Design::~Design() {
   for (const auto& elem : m_programDefinitions) {
     delete elem.second;
   }
-  for (const auto& elem : m_uniqueClassDefinitions) {
+  for (const auto& elem : m_classDefinitions) {
     delete elem.second;
   }
+  for (const DesignComponent* component : m_prunedComponents) {
+    delete component;
+  }
 }
 
 void Design::addFileContent(PathId fileId, FileContent* content) {
@@ -112,15 +123,21 @@ DesignComponent* Design::getComponentDefinition(std::string_view componentName)
 }
 
 ModuleDefinition* Design::getModuleDefinition(std::string_view moduleName) const {
-  ModuleNameModuleDefinitionMap::const_iterator itr = m_moduleDefinitions.find(moduleName);
-  if (itr != m_moduleDefinitions.end()) {
-    return itr->second;
-  }
-  return nullptr;
+  ModuleDefinition* const* const def = m_moduleDefinitions.find(lookupName_(moduleName));
+  return (def == nullptr) ? nullptr : *def;
+}
+
+void Design::addModuleDefinition(std::string_view moduleName, ModuleDefinition* def) {
+  m_moduleDefinitions.emplace(registerName_(moduleName), def);
+}
+
+void Design::addProgramDefinition(std::string_view programName, Program* program) {
+  m_programDefinitions.emplace(registerName_(programName), program);
 }
 
 Modport* Design::getModport(std::string_view modportName) const {
-  for (auto& entry : m_moduleDefinitions) {
+  // The first module declaring it by name, as modport names are not unique
+  for (const auto& entry : sortedByName(m_moduleDefinitions)) {
     if (Modport* mp = entry.second->getModport(modportName)) {
       return mp;
     }
@@ -196,13 +213,12 @@ std::string Design::reportInstanceTree() const {
       if (tmp) {
         ModuleInstance* inst = valuedcomponenti_cast<ModuleInstance*>(tmp);
         if (inst) {
-          for (const auto& ps : inst->getMappedValues()) {
-            const std::string& name = ps.first;
-            Value* val = ps.second.first;
+          for (const auto& ps : inst->getMappedValuesByName()) {
+            const std::string_view name = ps.first;
+            Value* val = ps.second->first;
             StrAppend(&tree, "    ", name, " = ", val->uhdmValue(), "\n");
           }
-          for (const auto& ps : inst->getComplexValues()) {
-            const std::string& name = ps.first;
+          for (std::string_view name : inst->getComplexValueNames()) {
             StrAppend(&tree, "    ", name, " = ", "complex", "\n");
           }
         }
@@ -265,71 +281,61 @@ void Design::reportInstanceTreeStats(uint32_t& nbTopLevelModules, uint32_t& maxD
 }
 
 ModuleInstance* Design::findInstance(std::string_view path, ModuleInstance* scope) const {
-  std::vector<std::string> vpath;
+  std::vector<std::string_view> vpath;
   StringUtils::tokenize(path, ".", vpath);
-  return findInstance(vpath, scope);
+  return findInstance_(vpath, 0, scope);
 }
 
 ModuleInstance* Design::findInstance(const std::vector<std::string>& path, ModuleInstance* scope) const {
-  if (path.empty()) return nullptr;
-  if (scope) {
-    ModuleInstance* res = findInstance_(path, scope);
-    if (res) return res;
-  } else {
+  std::vector<std::string_view> vpath(path.begin(), path.end());
+  return findInstance_(vpath, 0, scope);
+}
+
+ModuleInstance* Design::findInstance_(const std::vector<std::string_view>& path, size_t index,
+                                      ModuleInstance* scope) const {
+  if (index >= path.size()) return nullptr;
+  const std::string_view name = path[index];
+  const bool last = (index + 1) == path.size();
+  if (scope == nullptr) {
     for (auto top : m_topLevelModuleInstances) {
-      if (path.size() == 1) {
-        if (top->getInstanceName() == path[0]) {
-          return top;
-        }
-      } else {
-        if (top->getInstanceName() == path[0]) {
-          std::vector<std::string> subpath = path;
-          subpath.erase(subpath.begin());
-          ModuleInstance* res = findInstance_(subpath, top);
-          if (res) return res;
-        }
-      }
+      if (top->getInstanceNameView() != name) continue;
+      if (last) return top;
+      if (ModuleInstance* res = findInstanceInScope_(path, index + 1, top)) return res;
     }
+    return nullptr;
   }
-
-  return nullptr;
+  return findInstanceInScope_(path, index, scope);
 }
 
-ModuleInstance* Design::findInstance_(const std::vector<std::string>& path, ModuleInstance* scope) const {
-  if (path.empty()) return nullptr;
-  if (scope == nullptr) return nullptr;
-  if (path.size() == 1) {
-    if (scope->getInstanceName() == path[0]) {
-      return scope;
-    }
+ModuleInstance* Design::findInstanceInScope_(const std::vector<std::string_view>& path, size_t index,
+                                             ModuleInstance* scope) const {
+  if (index >= path.size()) return nullptr;
+  const std::string_view name = path[index];
+  const bool last = (index + 1) == path.size();
+  if (last && (scope->getInstanceNameView() == name)) {
+    return scope;
   }
 
-  for (uint32_t i = 0; i < scope->getNbChildren(); i++) {
-    ModuleInstance* child = scope->getChildren(i);
-    if (path.empty()) continue;
-    if (child->getInstanceName() == path[0]) {
-      if (path.size() == 1) {
-        return child;
-      } else {
-        std::vector<std::string> subpath = path;
-        subpath.erase(subpath.begin());
-        ModuleInstance* res = findInstance(subpath, child);
-        if (res) return res;
-      }
-    }
+  const auto [begin, end] = scope->getChildrenByName(name);
+  for (auto itr = begin; itr != end; ++itr) {
+    ModuleInstance* const child = itr->second;
+    if (last) return child;
+    if (ModuleInstance* res = findInstanceInScope_(path, index + 1, child)) return res;
   }
   return nullptr;
 }
 
 DefParam* Design::getDefParam(std::string_view name) const {
-  std::vector<std::string> vpath;
+  std::vector<std::string_view> vpath;
   StringUtils::tokenize(name, ".", vpath);
-  std::map<std::string, DefParam*>::const_iterator itr = m_defParams.find(vpath[0]);
-  if (itr != m_defParams.end()) {
-    vpath.erase(vpath.begin());
-    return getDefParam_(vpath, itr->second);
-  }
-  return nullptr;
+  if (vpath.empty()) return nullptr;
+  DefParamMap::const_iterator itr = m_defParams.find(vpath[0]);
+  if (itr == m_defParams.end()) return nullptr;
+  DefParam* def = itr->second;
+  for (size_t i = 1, ni = vpath.size(); (i < ni) && (def != nullptr); ++i) {
+    def = def->getChild(vpath[i]);
+  }
+  return def;
 }
 
 Value* Design::getDefParamValue(std::string_view name) {
@@ -338,66 +344,43 @@ Value* Design::getDefParamValue(std::string_view name) {
   return nullptr;
 }
 
-DefParam* Design::getDefParam_(std::vector<std::string>& path, DefParam* parent) const {
-  if (path.empty()) {
-    return parent;
-  }
-  std::map<std::string, DefParam*>::iterator itr = parent->getChildren().find(path[0]);
-  if (itr != parent->getChildren().end()) {
-    path.erase(path.begin());
-    return getDefParam_(path, itr->second);
-  }
-  return nullptr;
-}
-
 void Design::addDefParam(std::string_view name, const FileContent* fC, NodeId nodeId, Value* value) {
-  std::vector<std::string> vpath;
+  std::vector<std::string_view> vpath;
   StringUtils::tokenize(name, ".", vpath);
-  std::map<std::string, DefParam*>::iterator itr = m_defParams.find(vpath[0]);
-  if (itr != m_defParams.end()) {
-    vpath.erase(vpath.begin());
-    addDefParam_(vpath, fC, nodeId, value, itr->second);
-  } else {
-    DefParam* def = new DefParam(vpath[0]);
-    m_defParams.emplace(vpath[0], def);
-    vpath.erase(vpath.begin());
-    addDefParam_(vpath, fC, nodeId, value, def);
-  }
-}
+  if (vpath.empty()) return;
 
-void Design::addDefParam_(std::vector<std::string>& path, const FileContent* fC, NodeId nodeId, Value* value,
-                          DefParam* parent) {
-  if (path.empty()) {
-    parent->setValue(value);
-    parent->setLocation(fC, nodeId);
-    return;
-  }
   ErrorContainer* const errors = m_session->getErrorContainer();
   SymbolTable* const symbols = m_session->getSymbolTable();
   FileSystem* const fileSystem = m_session->getFileSystem();
-  std::map<std::string, DefParam*>::iterator itr = parent->getChildren().find(path[0]);
-  if (itr != parent->getChildren().end()) {
-    path.erase(path.begin());
-    if (path.empty()) {
-      DefParam* previous = itr->second;
-      if (!fC->getFileId(nodeId).equals(previous->getLocation()->getFileId(previous->getNodeId()), fileSystem) ||
-          (fC->Line(nodeId) != previous->getLocation()->Line(previous->getNodeId()))) {
-        Location loc1(fC->getFileId(nodeId), fC->Line(nodeId), fC->Column(nodeId),
-                      symbols->registerSymbol(previous->getFullName()));
-        Location loc2(previous->getLocation()->getFileId(previous->getNodeId()),
-                      previous->getLocation()->Line(previous->getNodeId()),
-                      previous->getLocation()->Column(previous->getNodeId()));
-        Error err(ErrorDefinition::ELAB_MULTI_DEFPARAM_ON_OBJECT, loc1, loc2);
-        errors->addError(err);
+
+  DefParamMap::iterator itr = m_defParams.find(vpath[0]);
+  if (itr == m_defParams.end()) {
+    itr = m_defParams.emplace(vpath[0], new DefParam(vpath[0])).first;
+  }
+  DefParam* parent = itr->second;
+  for (size_t i = 1, ni = vpath.size(); i < ni; ++i) {
+    if (DefParam* previous = parent->getChild(vpath[i])) {
+      if (((i + 1) == ni) && previous->getLocation()) {
+        if (!fC->getFileId(nodeId).equals(previous->getLocation()->getFileId(previous->getNodeId()), fileSystem) ||
+            (fC->Line(nodeId) != previous->getLocation()->Line(previous->getNodeId()))) {
+          Location loc1(fC->getFileId(nodeId), fC->Line(nodeId), fC->Column(nodeId),
+                        symbols->registerSymbol(previous->getFullName()));
+          Location loc2(previous->getLocation()->getFileId(previous->getNodeId()),
+                        previous->getLocation()->Line(previous->getNodeId()),
+                        previous->getLocation()->Column(previous->getNodeId()));
+          Error err(ErrorDefinition::ELAB_MULTI_DEFPARAM_ON_OBJECT, loc1, loc2);
+          errors->addError(err);
+        }
       }
+      parent = previous;
+    } else {
+      DefParam* def = new DefParam(vpath[i], parent);
+      parent->setChild(vpath[i], def);
+      parent = def;
     }
-    addDefParam_(path, fC, nodeId, value, itr->second);
-  } else {
-    DefParam* def = new DefParam(path[0], parent);
-    parent->setChild(path[0], def);
-    path.erase(path.begin());
-    addDefParam_(path, fC, nodeId, value, def);
   }
+  parent->setValue(value);
+  parent->setLocation(fC, nodeId);
 }
 
 void Design::checkDefParamUsage(DefParam* parent) {
@@ -434,82 +417,60 @@ void Design::checkDefParamUsage(DefParam* parent) {
 }
 
 Package* Design::getPackage(std::string_view name) const {
-  PackageNamePackageDefinitionMultiMap::const_iterator itr = m_packageDefinitions.find(name);
-  if (itr == m_packageDefinitions.end()) {
-    return nullptr;
-  } else {
-    return itr->second;
-  }
+  const std::vector<Package*>* const packages = m_packageDefinitions.find(lookupName_(name));
+  return (packages == nullptr) ? nullptr : packages->front();
 }
 
 Program* Design::getProgram(std::string_view name) const {
-  ProgramNameProgramDefinitionMap::const_iterator itr = m_programDefinitions.find(name);
-  if (itr == m_programDefinitions.end()) {
-    return nullptr;
-  } else {
-    return itr->second;
-  }
+  Program* const* const program = m_programDefinitions.find(lookupName_(name));
+  return (program == nullptr) ? nullptr : *program;
 }
 
 ClassDefinition* Design::getClassDefinition(std::string_view name) const {
-  ClassNameClassDefinitionMap::const_iterator itr = m_uniqueClassDefinitions.find(name);
-  if (itr == m_uniqueClassDefinitions.end()) {
-    return nullptr;
-  } else {
-    return itr->second;
-  }
+  ClassDefinition* const* const classDef = m_classDefinitions.find(lookupName_(name));
+  return (classDef == nullptr) ? nullptr : *classDef;
 }
 
 void Design::orderPackages() {
   if (m_orderedPackageNames.empty()) return;
-  m_orderedPackageDefinitions.resize(m_orderedPackageNames.size());
-  uint32_t index = 0;
-  typedef std::map<std::string, int32_t> MultiDefCount;
-  MultiDefCount multiDefCount;
+  m_orderedPackageDefinitions.clear();
+  m_orderedPackageDefinitions.reserve(m_orderedPackageNames.size());
+  // The nth occurrence of a name maps to the nth definition of that name.
+  // Occurrences past the definitions, e.g. of a package split across chunks
+  // and appended into one definition, are skipped: the vector owns them.
+  std::map<std::string_view, int32_t> multiDefCount;
+  std::set<const Package*> ordered;
   for (const auto& packageName : m_orderedPackageNames) {
-    for (uint32_t i = 0; i < m_packageDefinitions.size(); i++) {
-      PackageNamePackageDefinitionMultiMap::iterator pos = m_packageDefinitions.begin();
-      std::advance(pos, i);
-
-      if (packageName == pos->first) {
-        MultiDefCount::iterator itr = multiDefCount.find(packageName);
-        if (itr == multiDefCount.end()) {
-          multiDefCount.emplace(packageName, 1);
-        } else {
-          int32_t level = itr->second++;
-          pos = m_packageDefinitions.begin();
-          std::advance(pos, i + level);
-        }
-        m_orderedPackageDefinitions[index] = pos->second;
-        index++;
-        break;
-      }
-    }
+    int32_t& level = multiDefCount.emplace(packageName, 0).first->second;
+    const std::vector<Package*>* const packages = m_packageDefinitions.find(lookupName_(packageName));
+    if ((packages == nullptr) || (level >= static_cast<int32_t>(packages->size()))) continue;
+    Package* const package = (*packages)[level++];
+    if (!ordered.emplace(package).second) continue;
+    m_orderedPackageDefinitions.emplace_back(package);
   }
 }
 
 Package* Design::addPackageDefinition(std::string_view packageName, Package* package) {
-  PackageNamePackageDefinitionMultiMap::iterator itr = m_packageDefinitions.find(packageName);
-  if (itr == m_packageDefinitions.end()) {
-    m_packageDefinitions.emplace(packageName, package);
+  std::vector<Package*>* const packages =
+      m_packageDefinitions.emplace(registerName_(packageName), std::vector<Package*>()).first;
+  if (packages->empty()) {
+    packages->emplace_back(package);
     return package;
   } else {
-    Package* old = itr->second;
+    Package* old = packages->front();
     if (old->getFileContents()[0]->getParent() &&
         (old->getFileContents()[0]->getParent() == package->getFileContents()[0]->getParent())) {
       old->append(package);
       return old;
     } else {
-      m_packageDefinitions.emplace(packageName, package);
+      packages->emplace_back(package);
       return package;
     }
   }
 }
 
 void Design::addClassDefinition(std::string_view className, ClassDefinition* classDef) {
-  if (m_uniqueClassDefinitions.emplace(className, classDef).second) {
-    m_classDefinitions.emplace(className, classDef);
-  }
+  m_classDefinitions.emplace(registerName_(className), classDef);
 }
 
 void Design::clearContainers() {
@@ -528,25 +489,17 @@ void Design::clearContainers() {
 
   m_classDefinitions.clear();
 
-  m_uniqueClassDefinitions.clear();
-
   m_orderedPackageNames.clear();
 }
 
 std::vector<BindStmt*> Design::getBindStmts(std::string_view targetName) {
-  std::vector<BindStmt*> results;
-  BindMap::iterator itr = m_bindMap.find(targetName);
-  while (itr != m_bindMap.end()) {
-    if (itr->first != targetName) {
-      break;
-    }
-    results.emplace_back(itr->second);
-    itr++;
-  }
-  return results;
+  const std::vector<BindStmt*>* const stmts = m_bindMap.find(lookupName_(targetName));
+  return (stmts == nullptr) ? std::vector<BindStmt*>() : *stmts;
 }
 
-void Design::addBindStmt(std::string_view targetName, BindStmt* stmt) { m_bindMap.emplace(targetName, stmt); }
+void Design::addBindStmt(std::string_view targetName, BindStmt* stmt) {
+  m_bindMap.emplace(registerName_(targetName), std::vector<BindStmt*>()).first->emplace_back(stmt);
+}
 
 vpiHandle Design::getVpiDesign() const {
   if (m_uhdmDesign != nullptr) {
@@ -30,12 +30,15 @@
 #include <vector>
 
 #include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/Design.h"
 #include "Surelog/Design/FileCNodeId.h"
 #include "Surelog/Design/FileContent.h"
 #include "Surelog/Design/ParamAssign.h"
 #include "Surelog/Design/Parameter.h"
 #include "Surelog/Design/ValuedComponentI.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
 #include "Surelog/SourceCompile/VObjectTypes.h"
 #include "Surelog/Testbench/FunctionMethod.h"
 #include "Surelog/Testbench/TaskMethod.h"
@@ -48,6 +51,13 @@ DesignComponent::~DesignComponent() {
   DeleteAssociativeContainerValuePointersAndClear(&m_parameterMap);
 }
 
+// A name that is not in the symbol table can't be declared either
+SymbolId DesignComponent::lookupName_(std::string_view name) const { return m_session->getSymbolTable()->getId(name); }
+
+SymbolId DesignComponent::registerName_(std::string_view name) {
+  return m_session->getSymbolTable()->registerSymbol(name);
+}
+
 void DesignComponent::addFileContent(const FileContent* fileContent, NodeId nodeId) {
   if ((fileContent != nullptr) &&
       (std::find(m_fileContents.cbegin(), m_fileContents.cend(), fileContent) == m_fileContents.cend())) {
@@ -77,16 +87,11 @@ void DesignComponent::addObject(VObjectType type, FileCNodeId object) {
 }
 
 void DesignComponent::addNamedObject(std::string_view name, FileCNodeId object, DesignComponent* def) {
-  m_namedObjects.emplace(name, std::make_pair(object, def));
+  m_namedObjects.emplace(registerName_(name), std::make_pair(object, def));
 }
 
 const std::pair<FileCNodeId, DesignComponent*>* DesignComponent::getNamedObject(std::string_view name) const {
-  auto itr = m_namedObjects.find(name);
-  if (itr == m_namedObjects.end()) {
-    return nullptr;
-  } else {
-    return &itr->second;
-  }
+  return m_namedObjects.find(lookupName_(name));
 }
 
 void DesignComponent::append(DesignComponent* comp) {
@@ -95,21 +100,28 @@ void DesignComponent::append(DesignComponent* comp) {
   for (auto& obj : comp->m_objects) {
     for (auto& elem : obj.second) addObject(obj.first, elem);
   }
-  for (auto& obj : comp->m_namedObjects) {
-    addNamedObject(obj.first, obj.second.first, obj.second.second);
+  // The names are interned again, comp may hold the symbols of another session
+  for (const auto& [id, object] : comp->m_namedObjects) {
+    m_namedObjects.emplace(registerName_(comp->m_session->getSymbolTable()->getSymbol(id)), object);
+  }
+  for (const auto& [id, dataType] : comp->m_dataTypes) {
+    m_dataTypes.emplace(registerName_(comp->m_session->getSymbolTable()->getSymbol(id)), dataType);
   }
-  for (const auto& dtype : comp->m_dataTypes) insertDataType(dtype.first, dtype.second);
 }
 
 void DesignComponent::insertDataType(std::string_view dataTypeName, DataType* dataType) {
-  m_dataTypes.emplace(dataTypeName, dataType);
+  m_dataTypes.emplace(registerName_(dataTypeName), dataType);
+}
+
+const DataType* DesignComponent::getLocalDataType(std::string_view name) const {
+  DataType* const* const dt = m_dataTypes.find(lookupName_(name));
+  return (dt == nullptr) ? nullptr : *dt;
 }
 
 const DataType* DesignComponent::getDataTypeRecursive(Design* design, std::string_view name,
                                                       std::set<const DesignComponent*>& visited) const {
   if (!visited.insert(this).second) return nullptr;
-  DataTypeMap::const_iterator itr = m_dataTypes.find(name);
-  if (itr != m_dataTypes.end()) return itr->second;
+  if (const DataType* const dt = getLocalDataType(name)) return dt;
   if (const DesignComponent* const parent = valuedcomponenti_cast<DesignComponent>(getParentScope())) {
     if (const DataType* const dt = parent->getDataTypeRecursive(design, name, visited)) {
       return dt;
@@ -136,93 +148,73 @@ const DataType* DesignComponent::getDataType(Design* design, std::string_view na
 }
 
 void DesignComponent::insertUsedDataType(std::string_view dataTypeName, DataType* dataType) {
-  m_usedDataTypes.emplace(dataTypeName, dataType);
+  m_usedDataTypes.emplace(registerName_(dataTypeName), dataType);
 }
 
 DataType* DesignComponent::getUsedDataType(std::string_view name) {
-  DataTypeMap::iterator itr = m_usedDataTypes.find(name);
-  if (itr == m_usedDataTypes.end()) {
-    return nullptr;
-  } else {
-    return itr->second;
-  }
+  DataType* const* const dt = m_usedDataTypes.find(lookupName_(name));
+  return (dt == nullptr) ? nullptr : *dt;
 }
 
 const TypeDef* DesignComponent::getTypeDef(std::string_view name) const {
-  TypeDefMap::const_iterator itr = m_typedefs.find(name);
-  if (itr == m_typedefs.end()) {
-    if (const DesignComponent* const parent = valuedcomponenti_cast<const DesignComponent*>(getParentScope())) {
-      return parent->getTypeDef(name);
-    }
-  } else {
-    return itr->second;
+  if (TypeDef* const* const typeDef = m_typedefs.find(lookupName_(name))) return *typeDef;
+  if (const DesignComponent* const parent = valuedcomponenti_cast<const DesignComponent*>(getParentScope())) {
+    return parent->getTypeDef(name);
   }
   return nullptr;
 }
 
-void DesignComponent::insertTypeDef(TypeDef* p) { m_typedefs.emplace(p->getName(), p); }
+void DesignComponent::insertTypeDef(TypeDef* p) { m_typedefs.emplace(registerName_(p->getName()), p); }
+
+Function* DesignComponent::getLocalFunction(std::string_view name) const {
+  Function* const* const function = m_functions.find(lookupName_(name));
+  return (function == nullptr) ? nullptr : *function;
+}
 
 Function* DesignComponent::getFunction(std::string_view name) const {
-  FunctionMap::const_iterator itr = m_functions.find(name);
-  if (itr == m_functions.end()) {
-    if (const DesignComponent* const parent = valuedcomponenti_cast<const DesignComponent*>(getParentScope())) {
-      return parent->getFunction(name);
-    }
-  } else {
-    return itr->second;
+  if (Function* const function = getLocalFunction(name)) return function;
+  if (const DesignComponent* const parent = valuedcomponenti_cast<const DesignComponent*>(getParentScope())) {
+    return parent->getFunction(name);
   }
   return nullptr;
 }
 
-void DesignComponent::insertFunction(Function* p) { m_functions.emplace(p->getName(), p); }
+void DesignComponent::insertFunction(Function* p) { m_functions.emplace(registerName_(p->getName()), p); }
 
 Task* DesignComponent::getTask(std::string_view name) const {
-  TaskMap::const_iterator itr = m_tasks.find(name);
-  if (itr == m_tasks.end()) {
-    if (const DesignComponent* const parent = valuedcomponenti_cast<const DesignComponent*>(getParentScope())) {
-      return parent->getTask(name);
-    }
-  } else {
-    return itr->second;
+  if (Task* const* const task = m_tasks.find(lookupName_(name))) return *task;
+  if (const DesignComponent* const parent = valuedcomponenti_cast<const DesignComponent*>(getParentScope())) {
+    return parent->getTask(name);
   }
   return nullptr;
 }
 
-void DesignComponent::insertTask(Task* p) { m_tasks.emplace(p->getName(), p); }
+void DesignComponent::insertTask(Task* p) { m_tasks.emplace(registerName_(p->getName()), p); }
 
-void DesignComponent::addVariable(Variable* var) { m_variables.emplace(var->getName(), var); }
+void DesignComponent::addVariable(Variable* var) { m_variables.emplace(registerName_(var->getName()), var); }
 
 Variable* DesignComponent::getVariable(std::string_view name) {
-  VariableMap::const_iterator itr = m_variables.find(name);
-  if (itr == m_variables.end()) {
-    return nullptr;
-  } else {
-    return itr->second;
-  }
+  Variable* const* const var = m_variables.find(lookupName_(name));
+  return (var == nullptr) ? nullptr : *var;
 }
 
 Parameter* DesignComponent::getParameter(std::string_view name) const {
-  ParameterMap::const_iterator itr = m_parameterMap.find(name);
-  if (itr == m_parameterMap.end()) {
-    return nullptr;
-  } else {
-    return itr->second;
-  }
+  Parameter* const* const param = m_parameterMap.find(lookupName_(name));
+  return (param == nullptr) ? nullptr : *param;
 }
 
 void DesignComponent::insertParameter(Parameter* p) {
-  m_parameterMap.emplace(p->getName(), p);
+  m_parameterMap.emplace(registerName_(p->getName()), p);
   m_orderedParameters.emplace_back(p);
 }
 
-void DesignComponent::insertLetStmt(std::string_view name, LetStmt* decl) { m_letDecls.emplace(name, decl); }
+void DesignComponent::insertLetStmt(std::string_view name, LetStmt* decl) {
+  m_letDecls.emplace(registerName_(name), decl);
+}
+
 LetStmt* DesignComponent::getLetStmt(std::string_view name) {
-  auto itr = m_letDecls.find(name);
-  if (itr == m_letDecls.end()) {
-    return nullptr;
-  } else {
-    return itr->second;
-  }
+  LetStmt* const* const decl = m_letDecls.find(lookupName_(name));
+  return (decl == nullptr) ? nullptr : *decl;
 }
 
 }  // namespace SURELOG
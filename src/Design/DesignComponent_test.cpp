@@ -0,0 +1,137 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/Design/DesignComponent.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <uhdm/Serializer.h>
+#include <uhdm/uhdm.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/Common/SymbolId.h"
+#include "Surelog/Design/DataType.h"
+#include "Surelog/Design/FileCNodeId.h"
+#include "Surelog/Design/Parameter.h"
+#include "Surelog/Expression/ExprBuilder.h"
+#include "Surelog/Expression/Value.h"
+#include "Surelog/Package/Package.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
+
+namespace SURELOG {
+
+using ::testing::ElementsAre;
+
+namespace {
+TEST(DesignComponentTest, LookupsByName) {
+  Session session;
+  uhdm::Serializer s;
+  Package package(&session, "pkg", nullptr, nullptr, InvalidNodeId, s);
+
+  Parameter* const width = new Parameter(nullptr, InvalidNodeId, "WIDTH", InvalidNodeId, false);
+  Parameter* const depth = new Parameter(nullptr, InvalidNodeId, "DEPTH", InvalidNodeId, false);
+  package.insertParameter(width);
+  package.insertParameter(depth);
+  EXPECT_EQ(package.getParameter("WIDTH"), width);
+  EXPECT_EQ(package.getParameter("DEPTH"), depth);
+  // Not even a symbol
+  EXPECT_EQ(package.getParameter("never_seen_name"), nullptr);
+  // A symbol, but not a parameter of the package
+  EXPECT_EQ(package.getParameter("pkg"), nullptr);
+
+  // Declarations iterate in declaration order
+  std::vector<std::string_view> names;
+  for (const auto& [id, param] : package.getParameterMap()) names.emplace_back(session.getSymbolTable()->getSymbol(id));
+  EXPECT_THAT(names, ElementsAre("WIDTH", "DEPTH"));
+  EXPECT_THAT(package.getOrderedParameters(), ElementsAre(width, depth));
+}
+
+TEST(DesignComponentTest, FirstDeclarationWins) {
+  Session session;
+  uhdm::Serializer s;
+  Package package(&session, "pkg", nullptr, nullptr, InvalidNodeId, s);
+
+  DataType first;
+  DataType second;
+  package.insertDataType("t", &first);
+  package.insertDataType("t", &second);
+  EXPECT_EQ(package.getDataType(nullptr, "t"), &first);
+  EXPECT_EQ(package.getDataTypeMap().size(), 1);
+
+  package.insertUsedDataType("u", &second);
+  EXPECT_EQ(package.getUsedDataType("u"), &second);
+  EXPECT_EQ(package.getUsedDataType("t"), nullptr);
+}
+
+TEST(DesignComponentTest, AppendKeepsFirstDeclarations) {
+  Session session;
+  uhdm::Serializer s;
+  Package package(&session, "pkg", nullptr, nullptr, InvalidNodeId, s);
+  Package split(&session, "pkg", nullptr, nullptr, InvalidNodeId, s);
+
+  DataType first;
+  DataType second;
+  DataType other;
+  package.insertDataType("t", &first);
+  split.insertDataType("t", &second);
+  split.insertDataType("u", &other);
+  split.addNamedObject("P", FileCNodeId(nullptr, InvalidNodeId));
+  package.append(&split);
+  EXPECT_EQ(package.getDataType(nullptr, "t"), &first);
+  EXPECT_EQ(package.getDataType(nullptr, "u"), &other);
+  EXPECT_NE(package.getNamedObject("P"), nullptr);
+}
+
+TEST(DesignComponentTest, ValuesListedByName) {
+  Session session;
+  uhdm::Serializer s;
+  Package package(&session, "pkg", nullptr, nullptr, InvalidNodeId, s);
+  Package split(&session, "pkg", nullptr, nullptr, InvalidNodeId, s);
+
+  ExprBuilder& builder = *split.getExprBuilder();
+  std::unique_ptr<Value> one(builder.fromString("1"));
+  split.setValue("B", one.get(), builder);
+  split.setValue("A", one.get(), builder);
+  split.setComplexValue("D", s.make<uhdm::Constant>());
+  split.setComplexValue("C", s.make<uhdm::Constant>());
+
+  // The maps iterate in insertion order
+  std::vector<std::string_view> names;
+  for (const auto& entry : split.getMappedValues()) names.emplace_back(split.getValueName(entry.first));
+  EXPECT_THAT(names, ElementsAre("B", "A"));
+  names.clear();
+  for (const auto& entry : split.getMappedValuesByName()) names.emplace_back(entry.first);
+  EXPECT_THAT(names, ElementsAre("A", "B"));
+  EXPECT_THAT(split.getComplexValueNames(), ElementsAre("C", "D"));
+
+  const SymbolId id = split.getValueId("A");
+  ASSERT_NE(split.getValue(id), nullptr);
+  EXPECT_EQ(split.getValue(id), split.getValue("A"));
+  EXPECT_EQ(split.getValueId("never_seen_name"), BadSymbolId);
+
+  // Package::append merges the values in name order
+  package.append(&split);
+  names.clear();
+  for (const auto& entry : package.getMappedValues()) names.emplace_back(package.getValueName(entry.first));
+  EXPECT_THAT(names, ElementsAre("A", "B"));
+}
+}  // namespace
+}  // namespace SURELOG
@@ -25,11 +25,14 @@
 
 #include <uhdm/uhdm_types.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <stack>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Surelog/Common/Containers.h"
@@ -40,12 +43,14 @@
 #include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/DesignComponent.h"
 #include "Surelog/Design/DesignElement.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/ErrorReporting/Error.h"
 #include "Surelog/ErrorReporting/ErrorContainer.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
 #include "Surelog/ErrorReporting/Location.h"
 #include "Surelog/Library/Library.h"
 #include "Surelog/SourceCompile/SymbolTable.h"
+#include "Surelog/SourceCompile/VObjectTypeBitSet.h"
 #include "Surelog/SourceCompile/VObjectTypes.h"
 #include "Surelog/Testbench/ClassDefinition.h"
 #include "Surelog/Utils/StringUtils.h"
@@ -68,15 +73,14 @@ FileContent::~FileContent() {
 }
 
 inline bool FileContent::isComment(NodeId nodeId) const {
-  return m_objects[nodeId].m_type == VObjectType::LINE_COMMENT ||
-         m_objects[nodeId].m_type == VObjectType::BLOCK_COMMENT ||
-         m_objects[nodeId].m_type == VObjectType::ESCAPED_LINE_COMMENT ||
-         m_objects[nodeId].m_type == VObjectType::SYNOPSIS_BLOCK_COMMENT;
+  const VObjectType type = m_objects.type(nodeId);
+  return type == VObjectType::LINE_COMMENT || type == VObjectType::BLOCK_COMMENT ||
+         type == VObjectType::ESCAPED_LINE_COMMENT || type == VObjectType::SYNOPSIS_BLOCK_COMMENT;
 }
 
 inline NodeId FileContent::skipComments(NodeId nodeId) const {
   while (nodeId && isComment(nodeId)) {
-    nodeId = m_objects[nodeId].m_sibling;
+    nodeId = m_objects.sibling(nodeId);
   }
   return nodeId;
 }
@@ -97,25 +101,25 @@ NodeId FileContent::getRootNode() const {
 
   int32_t index = static_cast<int32_t>(m_objects.size());
   while (--index >= 0) {
-    if ((m_objects[index].m_type == VObjectType::ppTop_level_rule) ||
-        (m_objects[index].m_type == VObjectType::paTop_level_rule) ||
-        (m_objects[index].m_type == VObjectType::paTop_level_library_rule)) {
+    const VObjectType type = m_objects.type(NodeId(index));
+    if ((type == VObjectType::ppTop_level_rule) || (type == VObjectType::paTop_level_rule) ||
+        (type == VObjectType::paTop_level_library_rule)) {
       return NodeId(index);
     }
   }
   return InvalidNodeId;
 }
 
-PathId FileContent::getFileId(NodeId id) const { return m_objects[id].m_fileId; }
+PathId FileContent::getFileId(NodeId id) const { return m_objects.fileId(id); }
 
-PathId* FileContent::getMutableFileId(NodeId id) { return &m_objects[id].m_fileId; }
+void FileContent::setFileId(NodeId id, PathId fileId) { m_objects.setFileId(id, fileId); }
 
 void FileContent::printTree(std::ostream& strm, NodeId id, size_t indent /* = 0 */) const {
   if (!id) return;
 
   strm << std::string(indent * 2, ' ') << m_objects[id].print(m_session, id, GetDefinitionFile(id), m_fileId)
        << std::endl;
-  for (NodeId childId = m_objects[id].m_child; childId; childId = m_objects[childId].m_sibling) {
+  for (NodeId childId = m_objects.child(id); childId; childId = m_objects.sibling(childId)) {
     printTree(strm, childId, indent + 1);
   }
 }
@@ -128,9 +132,10 @@ void FileContent::printTree(std::ostream& strm) const {
   strm << "FILE: " << fileSystem->toPath(m_fileId) << std::endl;
 
   PathIdSet includes;
-  for (const auto& object : m_objects) {
-    if (object.m_fileId && (object.m_fileId != m_fileId)) {
-      includes.insert(object.m_fileId);
+  for (size_t i = 0, ni = m_objects.size(); i < ni; ++i) {
+    const PathId fileId = m_objects.fileId(NodeId(i));
+    if (fileId && (fileId != m_fileId)) {
+      includes.insert(fileId);
     }
   }
   for (const PathId& include : includes) {
@@ -150,9 +155,10 @@ std::string FileContent::printObjects() const {
   if (m_library) strm << "LIB: " << m_library->getName() << "\n";
   strm << "FILE f<" << (RawPathId)m_fileId << ">:" << fileSystem->toPath(m_fileId) << "\n";
   PathIdSet includes;
-  for (const auto& object : m_objects) {
-    if (object.m_fileId && (object.m_fileId != m_fileId)) {
-      includes.insert(object.m_fileId);
+  for (size_t i = 0, ni = m_objects.size(); i < ni; ++i) {
+    const PathId fileId = m_objects.fileId(NodeId(i));
+    if (fileId && (fileId != m_fileId)) {
+      includes.insert(fileId);
     }
   }
   for (const PathId& include : includes) {
@@ -162,7 +168,7 @@ std::string FileContent::printObjects() const {
     printTree(strm, id, 0);
   } else {
     for (size_t i = 0, ni = m_objects.size(); i < ni; ++i) {
-      if (m_objects[i].m_type == VObjectType::PREPROC_END) {
+      if (m_objects.type(NodeId(i)) == VObjectType::PREPROC_END) {
         printTree(strm, NodeId(i), 0);
       }
     }
@@ -248,6 +254,13 @@ const DataType* FileContent::getDataType(Design* design, std::string_view name)
   return nullptr;
 }
 
+void FileContent::SetDefinition(NodeId index, NodeId def) { m_objects.definition(index) = def; }
+
+void FileContent::SetType(NodeId index, VObjectType type) {
+  clearSubtreeIndex();
+  m_objects.type(index) = type;
+}
+
 void FileContent::SetDefinitionFile(NodeId index, PathId def) { m_definitionFiles.emplace(index, def); }
 
 PathId FileContent::GetDefinitionFile(NodeId index) const {
@@ -259,29 +272,30 @@ NodeId FileContent::addObject(SymbolId name, PathId fileId, VObjectType type, ui
                               uint32_t endLine, uint16_t endColumn, NodeId parent /* = InvalidNodeId */,
                               NodeId definition /* = InvalidNodeId */, NodeId child /* = InvalidNodeId */,
                               NodeId sibling /* = InvalidNodeId */) {
-  RawNodeId index = m_objects.size();
-  m_objects.emplace_back(name, fileId, type, line, column, endLine, endColumn, parent, definition, child, sibling);
-  return NodeId(index);
+  clearSubtreeIndex();
+  return m_objects.emplace_back(name, fileId, type, line, column, endLine, endColumn, parent, definition, child,
+                                sibling);
 }
 
-const VObject& FileContent::Object(NodeId index) const {
-  if (!index) return m_objects[0];
+VObject FileContent::Object(NodeId index) const {
+  if (!index) return m_objects[InvalidNodeId];
   if (index >= m_objects.size()) {
     m_session->getErrorContainer()->addError(ErrorDefinition::COMP_INTERNAL_ERROR_OUT_OF_BOUND, Location(m_fileId));
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
-    return m_objects[0];
+    return m_objects[InvalidNodeId];
   }
   return m_objects[index];
 }
 
-VObject* FileContent::MutableObject(NodeId index) {
-  if (!index) return &m_objects[0];
+VObjectStore::Reference FileContent::MutableObject(NodeId index) {
+  clearSubtreeIndex();
+  if (!index) return m_objects.mutableObject(InvalidNodeId);
   if (index >= m_objects.size()) {
     m_session->getErrorContainer()->addError(ErrorDefinition::COMP_INTERNAL_ERROR_OUT_OF_BOUND, Location(m_fileId));
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
-    return &m_objects[0];
+    return m_objects.mutableObject(InvalidNodeId);
   }
-  return &m_objects[index];
+  return m_objects.mutableObject(index);
 }
 
 NodeId FileContent::UniqueId(NodeId index) const {
@@ -301,7 +315,7 @@ SymbolId FileContent::Name(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return BadSymbolId;
   }
-  return m_objects[index].m_name;
+  return m_objects.name(index);
 }
 
 NodeId FileContent::Child(NodeId index) const {
@@ -311,7 +325,7 @@ NodeId FileContent::Child(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return InvalidNodeId;
   }
-  return skipComments(m_objects[index].m_child);
+  return skipComments(m_objects.child(index));
 }
 
 NodeId FileContent::Sibling(NodeId index) const {
@@ -321,7 +335,7 @@ NodeId FileContent::Sibling(NodeId index) const {
     std::cout << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return InvalidNodeId;
   }
-  return skipComments(m_objects[index].m_sibling);
+  return skipComments(m_objects.sibling(index));
 }
 
 NodeId FileContent::Definition(NodeId index) const {
@@ -331,7 +345,7 @@ NodeId FileContent::Definition(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return InvalidNodeId;
   }
-  return m_objects[index].m_definition;
+  return m_objects.definition(index);
 }
 
 NodeId FileContent::Parent(NodeId index) const {
@@ -341,7 +355,7 @@ NodeId FileContent::Parent(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return InvalidNodeId;
   }
-  return m_objects[index].m_parent;
+  return m_objects.parent(index);
 }
 
 VObjectType FileContent::Type(NodeId index) const {
@@ -351,7 +365,7 @@ VObjectType FileContent::Type(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return VObjectType::_INVALID_;
   }
-  return (VObjectType)m_objects[index].m_type;
+  return (VObjectType)m_objects.type(index);
 }
 
 uint32_t FileContent::Line(NodeId index) const {
@@ -361,7 +375,7 @@ uint32_t FileContent::Line(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return 0;
   }
-  return m_objects[index].m_startLine;
+  return m_objects.location(index).m_startLine;
 }
 
 uint16_t FileContent::Column(NodeId index) const {
@@ -371,7 +385,7 @@ uint16_t FileContent::Column(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return 0;
   }
-  return m_objects[index].m_startColumn;
+  return m_objects.location(index).m_startColumn;
 }
 
 uint32_t FileContent::EndLine(NodeId index) const {
@@ -381,7 +395,7 @@ uint32_t FileContent::EndLine(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return 0;
   }
-  return m_objects[index].m_endLine;
+  return m_objects.location(index).m_endLine;
 }
 
 uint16_t FileContent::EndColumn(NodeId index) const {
@@ -391,22 +405,20 @@ uint16_t FileContent::EndColumn(NodeId index) const {
     std::cerr << "\nINTERNAL OUT OF BOUND ERROR\n\n";
     return 0;
   }
-  return m_objects[index].m_endColumn;
+  return m_objects.location(index).m_endColumn;
 }
 
 NodeId FileContent::sl_get(NodeId parent, VObjectType type) const {
   if (!parent) return InvalidNodeId;
   if (m_objects.empty()) return InvalidNodeId;
   if (parent >= m_objects.size()) return InvalidNodeId;
-  const VObject& current = Object(parent);
-  if (current.m_type == type) return parent;
-  NodeId id = current.m_child;
+  if (m_objects.type(parent) == type) return parent;
+  NodeId id = m_objects.child(parent);
   while (id) {
-    const VObject& current = Object(id);
-    if (current.m_type == type) {
+    if (m_objects.type(id) == type) {
       return id;
     }
-    id = current.m_sibling;
+    id = m_objects.sibling(id);
   }
   return InvalidNodeId;
 }
@@ -417,12 +429,12 @@ NodeId FileContent::sl_parent(NodeId parent, const VObjectTypeUnorderedSet& type
   if (parent >= m_objects.size()) return InvalidNodeId;
   NodeId id = parent;
   while (id) {
-    const VObject& current = Object(id);
-    if (types.find(current.m_type) != types.end()) {
-      actualType = current.m_type;
+    const VObjectType type = m_objects.type(id);
+    if (types.find(type) != types.end()) {
+      actualType = type;
       return id;
     }
-    id = current.m_parent;
+    id = m_objects.parent(id);
   }
   return InvalidNodeId;
 }
@@ -433,11 +445,10 @@ NodeId FileContent::sl_parent(NodeId parent, VObjectType type) const {
   if (parent >= m_objects.size()) return InvalidNodeId;
   NodeId id = parent;
   while (id) {
-    const VObject& current = Object(id);
-    if (current.m_type == type) {
+    if (m_objects.type(id) == type) {
       return id;
     }
-    id = current.m_parent;
+    id = m_objects.parent(id);
   }
   return InvalidNodeId;
 }
@@ -447,15 +458,13 @@ std::vector<NodeId> FileContent::sl_get_all(NodeId parent, VObjectType type) con
   if (!parent) return objects;
   if (m_objects.empty()) return objects;
   if (parent >= m_objects.size()) return objects;
-  const VObject& current = Object(parent);
-  if (current.m_type == type) objects.emplace_back(parent);
-  NodeId id = current.m_child;
+  if (m_objects.type(parent) == type) objects.emplace_back(parent);
+  NodeId id = m_objects.child(parent);
   while (id) {
-    const VObject& current = Object(id);
-    if (current.m_type == type) {
+    if (m_objects.type(id) == type) {
       objects.emplace_back(id);
     }
-    id = current.m_sibling;
+    id = m_objects.sibling(id);
   }
   return objects;
 }
@@ -465,18 +474,16 @@ std::vector<NodeId> FileContent::sl_get_all(NodeId parent, const VObjectTypeUnor
   if (!parent) return objects;
   if (m_objects.empty()) return objects;
   if (parent >= m_objects.size()) return objects;
-  const VObject& current = Object(parent);
-  if (types.find(current.m_type) != types.end()) {
+  if (types.find(m_objects.type(parent)) != types.end()) {
     objects.emplace_back(parent);
   }
 
-  NodeId id = current.m_child;
+  NodeId id = m_objects.child(parent);
   while (id) {
-    const VObject& current = Object(id);
-    if (types.find(current.m_type) != types.end()) {
+    if (types.find(m_objects.type(id)) != types.end()) {
       objects.emplace_back(id);
     }
-    id = current.m_sibling;
+    id = m_objects.sibling(id);
   }
   return objects;
 }
@@ -485,18 +492,16 @@ NodeId FileContent::sl_collect(NodeId parent, VObjectType type) const {
   if (!parent) return InvalidNodeId;
   if (m_objects.empty()) return InvalidNodeId;
   if (parent >= m_objects.size()) return InvalidNodeId;
-  const VObject& current = Object(parent);
-  if (current.m_type == type) return parent;
-  NodeId id = current.m_child;
+  if (m_objects.type(parent) == type) return parent;
+  NodeId id = m_objects.child(parent);
   while (id) {
     NodeId idsub = sl_collect(id, type);
     if (idsub) return idsub;
 
-    const VObject& current = Object(id);
-    if (current.m_type == type) {
+    if (m_objects.type(id) == type) {
       return id;
     }
-    id = current.m_sibling;
+    id = m_objects.sibling(id);
   }
   return InvalidNodeId;
 }
@@ -506,22 +511,25 @@ std::vector<NodeId> FileContent::sl_collect_all(NodeId parent, VObjectType type,
   if (!parent) return objects;
   if (m_objects.empty()) return objects;
   if (parent >= m_objects.size()) return objects;
-  const VObject& current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  if (isIndexed(parent)) {
+    std::vector<uint32_t> ranks;
+    collectIndexed(parent, type, first, ranks);
+    return toNodeIds(ranks, false, first);
+  }
+  NodeId id = m_objects.child(parent);
+  if (!id) id = m_objects.sibling(parent);
   if (!id) return objects;
   std::stack<NodeId> stack;
   stack.emplace(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    const VObject& current = Object(id);
-    if (current.m_type == type) {
+    if (m_objects.type(id) == type) {
       objects.emplace_back(id);
       if (first) return objects;
     }
-    if (current.m_sibling) stack.emplace(current.m_sibling);
-    if (current.m_child) stack.emplace(current.m_child);
+    if (const NodeId siblingId = m_objects.sibling(id)) stack.emplace(siblingId);
+    if (const NodeId childId = m_objects.child(id)) stack.emplace(childId);
   }
   return objects;
 }
@@ -531,24 +539,27 @@ std::vector<NodeId> FileContent::sl_collect_all(NodeId parent, const VObjectType
   if (!parent) return objects;
   if (m_objects.empty()) return objects;
   if (parent >= m_objects.size()) return objects;
-  const VObject& current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  if (isIndexed(parent)) {
+    std::vector<uint32_t> ranks;
+    for (VObjectType type : types) {
+      collectIndexed(parent, type, first, ranks);
+    }
+    return toNodeIds(ranks, types.size() > 1, first);
+  }
+  NodeId id = m_objects.child(parent);
+  if (!id) id = m_objects.sibling(parent);
   if (!id) return objects;
   std::stack<NodeId> stack;
   stack.emplace(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    const VObject& current = Object(id);
-    // std::cout << "COLLECT:" << current.print (m_symbolTable, id,
-    // GetDefinitionFile(id)) << std::endl;
-    if (types.find(current.m_type) != types.end()) {
+    if (types.find(m_objects.type(id)) != types.end()) {
       objects.emplace_back(id);
       if (first) return objects;
     }
-    if (current.m_sibling) stack.emplace(current.m_sibling);
-    if (current.m_child) stack.emplace(current.m_child);
+    if (const NodeId siblingId = m_objects.sibling(id)) stack.emplace(siblingId);
+    if (const NodeId childId = m_objects.child(id)) stack.emplace(childId);
   }
   return objects;
 }
@@ -557,20 +568,20 @@ NodeId FileContent::sl_collect(NodeId parent, VObjectType type, VObjectType stop
   if (!parent) return InvalidNodeId;
   if (m_objects.empty()) return InvalidNodeId;
   if (parent >= m_objects.size()) return InvalidNodeId;
-  const VObject& current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  NodeId id = m_objects.child(parent);
+  if (!id) id = m_objects.sibling(parent);
   if (!id) return InvalidNodeId;
   std::stack<NodeId> stack;
   stack.emplace(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    const VObject& current = Object(id);
-    if (current.m_type == type) return id;
-    if (current.m_sibling) stack.emplace(current.m_sibling);
-    if (current.m_child && (stopPoint != current.m_type)) {
-      stack.emplace(current.m_child);
+    const VObjectType currentType = m_objects.type(id);
+    if (currentType == type) return id;
+    if (const NodeId siblingId = m_objects.sibling(id)) stack.emplace(siblingId);
+    const NodeId childId = m_objects.child(id);
+    if (childId && (stopPoint != currentType)) {
+      stack.emplace(childId);
     }
   }
   return InvalidNodeId;
@@ -582,40 +593,156 @@ std::vector<NodeId> FileContent::sl_collect_all(NodeId parent, const VObjectType
   if (!parent) return objects;
   if (m_objects.empty()) return objects;
   if (parent >= m_objects.size()) return objects;
-  const VObject& current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  if (isIndexed(parent)) {
+    // Linear scan in preorder, jumping over the subtrees of stop points
+    const VObjectTypeBitSet typeBits(types);
+    const VObjectTypeBitSet stopBits(stopPoints);
+    for (uint32_t rank = m_preorderRanks[parent] + 1, last = m_subtreeLastRanks[parent]; rank <= last;) {
+      const NodeId id = m_preorderNodes[rank];
+      const VObjectType currentType = m_objects.type(id);
+      if (typeBits.contains(currentType)) {
+        objects.emplace_back(id);
+        if (first) return objects;
+      }
+      rank = stopBits.contains(currentType) ? m_subtreeLastRanks[id] + 1 : rank + 1;
+    }
+    return objects;
+  }
+  NodeId id = m_objects.child(parent);
+  if (!id) id = m_objects.sibling(parent);
   if (!id) return objects;
   std::stack<NodeId> stack;
   stack.emplace(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    const VObject& current = Object(id);
-    // std::cout << "COLLECT:" << current.print (m_symbolTable, id,
-    // GetDefinitionFile(id)) << std::endl;
-    if (types.find(current.m_type) != types.end()) {
+    const VObjectType currentType = m_objects.type(id);
+    if (types.find(currentType) != types.end()) {
       objects.emplace_back(id);
       if (first) return objects;
     }
-    if (current.m_sibling) stack.emplace(current.m_sibling);
-    if (current.m_child && (stopPoints.find(current.m_type) == stopPoints.end())) {
-      stack.emplace(current.m_child);
+    if (const NodeId siblingId = m_objects.sibling(id)) stack.emplace(siblingId);
+    const NodeId childId = m_objects.child(id);
+    if (childId && (stopPoints.find(currentType) == stopPoints.end())) {
+      stack.emplace(childId);
     }
   }
   return objects;
 }
 
+// Rank of nodes not reachable from a root of the tree
+static constexpr uint32_t kUnrankedNode = UINT32_MAX;
+
+void FileContent::clearSubtreeIndex() {
+  if (m_preorderNodes.empty()) return;
+  // Releases the memory, not only the contents
+  std::vector<uint32_t>().swap(m_preorderRanks);
+  std::vector<uint32_t>().swap(m_subtreeLastRanks);
+  std::vector<NodeId>().swap(m_preorderNodes);
+  std::unordered_map<VObjectType, std::vector<uint32_t>>().swap(m_typeRanks);
+}
+
+void FileContent::clearParsedContent() {
+  for (auto de : m_elements) {
+    delete de;
+  }
+  m_elements.clear();
+  m_elementMap.clear();
+  m_objects.clear();
+  // NodeId 0 stays the invalid node, as in the constructor
+  addObject(BadSymbolId, m_fileId, VObjectType::_INVALID_, 0, 0, 0, 0, InvalidNodeId, InvalidNodeId, InvalidNodeId,
+            InvalidNodeId);
+  m_definitionFiles.clear();
+  clearSubtreeIndex();
+}
+
+void FileContent::buildSubtreeIndex() {
+  clearSubtreeIndex();
+  const size_t count = m_objects.size();
+  if (count < 2) return;
+
+  m_preorderRanks.assign(count, kUnrankedNode);
+  m_subtreeLastRanks.assign(count, kUnrankedNode);
+  m_preorderNodes.reserve(count);
+
+  // Iterative preorder over every tree rooted at a parentless node. The
+  // second member of a stack entry marks the exit of a subtree.
+  std::vector<std::pair<NodeId, bool>> stack;
+  std::vector<NodeId> children;
+  for (size_t i = 1; i < count; ++i) {
+    const NodeId root(static_cast<RawNodeId>(i));
+    if (m_objects.parent(root) || (m_preorderRanks[root] != kUnrankedNode)) continue;
+
+    stack.emplace_back(root, false);
+    while (!stack.empty()) {
+      const auto [id, done] = stack.back();
+      stack.pop_back();
+      if (done) {
+        m_subtreeLastRanks[id] = static_cast<uint32_t>(m_preorderNodes.size() - 1);
+        continue;
+      }
+      if (m_preorderRanks[id] != kUnrankedNode) continue;
+
+      const uint32_t rank = static_cast<uint32_t>(m_preorderNodes.size());
+      m_preorderRanks[id] = rank;
+      m_preorderNodes.emplace_back(id);
+      m_typeRanks[m_objects.type(id)].emplace_back(rank);
+
+      stack.emplace_back(id, true);
+      children.clear();
+      for (NodeId childId = m_objects.child(id); childId; childId = m_objects.sibling(childId)) {
+        children.emplace_back(childId);
+      }
+      for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        stack.emplace_back(*it, false);
+      }
+    }
+  }
+}
+
+bool FileContent::isIndexed(NodeId parent) const {
+  // A node without children walks its siblings in sl_collect_all, which
+  // the subtree interval does not cover.
+  return (parent < m_preorderRanks.size()) && (m_preorderRanks[parent] != kUnrankedNode) && m_objects.child(parent);
+}
+
+void FileContent::collectIndexed(NodeId parent, VObjectType type, bool first, std::vector<uint32_t>& ranks) const {
+  auto it = m_typeRanks.find(type);
+  if (it == m_typeRanks.end()) return;
+  const std::vector<uint32_t>& all = it->second;
+  const auto begin = std::upper_bound(all.begin(), all.end(), m_preorderRanks[parent]);
+  const auto end = std::upper_bound(begin, all.end(), m_subtreeLastRanks[parent]);
+  if (begin == end) return;
+  if (first) {
+    ranks.emplace_back(*begin);
+  } else {
+    ranks.insert(ranks.end(), begin, end);
+  }
+}
+
+std::vector<NodeId> FileContent::toNodeIds(std::vector<uint32_t>& ranks, bool sort, bool first) const {
+  if (sort) std::sort(ranks.begin(), ranks.end());
+  if (first && (ranks.size() > 1)) ranks.resize(1);
+  std::vector<NodeId> objects;
+  objects.reserve(ranks.size());
+  for (uint32_t rank : ranks) {
+    objects.emplace_back(m_preorderNodes[rank]);
+  }
+  return objects;
+}
+
 bool FileContent::diffTree(NodeId root, const FileContent* oFc, NodeId oroot, std::string* diff_out) const {
   diff_out->clear();
 
-  const VObject& current1 = Object(root);
-  NodeId id1 = current1.m_child;
-  if (!id1) id1 = current1.m_sibling;
+  const VObjectStore& objects1 = m_objects;
+  const VObjectStore& objects2 = oFc->m_objects;
 
-  const VObject& current2 = oFc->Object(oroot);
-  NodeId id2 = current2.m_child;
-  if (!id2) id2 = current2.m_sibling;
+  // The roots come from the caller, Child() and Sibling() check their bounds
+  NodeId id1 = Child(root);
+  if (!id1) id1 = Sibling(root);
+
+  NodeId id2 = oFc->Child(oroot);
+  if (!id2) id2 = oFc->Sibling(oroot);
 
   if ((id1 && (!id2)) || ((!id1) && id2)) return true;
 
@@ -630,18 +757,15 @@ bool FileContent::diffTree(NodeId root, const FileContent* oFc, NodeId oroot, st
     stack1.pop();
     stack2.pop();
 
-    const VObject& current1 = Object(id1);
-    const VObject& current2 = oFc->Object(id2);
-
-    if (current1.m_type != current2.m_type) return true;
-    if ((current1.m_name || current2.m_name) && (Name(id1) != oFc->Name(id2))) {
+    if (objects1.type(id1) != objects2.type(id2)) return true;
+    if ((objects1.name(id1) || objects2.name(id2)) && (Name(id1) != oFc->Name(id2))) {
       return true;
     }
 
-    if (current1.m_sibling) stack1.emplace(current1.m_sibling);
-    if (current1.m_child) stack1.emplace(current1.m_child);
-    if (current2.m_sibling) stack2.emplace(current2.m_sibling);
-    if (current2.m_child) stack2.emplace(current2.m_child);
+    if (const NodeId siblingId = objects1.sibling(id1)) stack1.emplace(siblingId);
+    if (const NodeId childId = objects1.child(id1)) stack1.emplace(childId);
+    if (const NodeId siblingId = objects2.sibling(id2)) stack2.emplace(siblingId);
+    if (const NodeId childId = objects2.child(id2)) stack2.emplace(childId);
   }
   return !stack2.empty();
 }
@@ -664,9 +788,9 @@ void FileContent::populateCoreMembers(NodeId startIndex, NodeId endIndex, uhdm::
   NodeId cacheStartIndex, cacheEndIndex;
   if (startIndex && ((instance->getStartLine() == 0) || force)) {
     if (startIndex < m_objects.size()) {
-      const VObject& object = m_objects[startIndex];
-      instance->setStartLine(object.m_startLine);
-      instance->setStartColumn(object.m_startColumn);
+      const VObjectStore::Location& location = m_objects.location(startIndex);
+      instance->setStartLine(location.m_startLine);
+      instance->setStartColumn(location.m_startColumn);
       cacheStartIndex = startIndex;
     } else {
       m_session->getErrorContainer()->addError(ErrorDefinition::COMP_INTERNAL_ERROR_OUT_OF_BOUND, Location(m_fileId));
@@ -679,16 +803,16 @@ void FileContent::populateCoreMembers(NodeId startIndex, NodeId endIndex, uhdm::
       // For packed/unpacked dimenion, include all ranges!
       if (instance->getUhdmType() != uhdm::UhdmType::Range) {
         NodeId siblingId = endIndex;
-        while (siblingId && ((m_objects[siblingId].m_type == VObjectType::paPacked_dimension) ||
-                             (m_objects[siblingId].m_type == VObjectType::paUnpacked_dimension))) {
+        while (siblingId && ((m_objects.type(siblingId) == VObjectType::paPacked_dimension) ||
+                             (m_objects.type(siblingId) == VObjectType::paUnpacked_dimension))) {
           endIndex = siblingId;
-          siblingId = m_objects[siblingId].m_sibling;
+          siblingId = m_objects.sibling(siblingId);
         }
       }
 
-      const VObject& object = m_objects[endIndex];
-      instance->setEndLine(object.m_endLine);
-      instance->setEndColumn(object.m_endColumn);
+      const VObjectStore::Location& location = m_objects.location(endIndex);
+      instance->setEndLine(location.m_endLine);
+      instance->setEndColumn(location.m_endColumn);
       cacheEndIndex = endIndex;
     } else {
       m_session->getErrorContainer()->addError(ErrorDefinition::COMP_INTERNAL_ERROR_OUT_OF_BOUND, Location(m_fileId));
@@ -715,11 +839,9 @@ void FileContent::populateCoreMembers(NodeId startIndex, NodeId endIndex, uhdm::
     //   }
     // } else
     if (startIndex) {
-      const VObject& object = m_objects[startIndex];
-      fileId = object.m_fileId;
+      fileId = m_objects.fileId(startIndex);
     } else if (endIndex) {
-      const VObject& object = m_objects[endIndex];
-      fileId = object.m_fileId;
+      fileId = m_objects.fileId(endIndex);
     }
 
     if (!fileId) {
@@ -731,12 +853,13 @@ void FileContent::populateCoreMembers(NodeId startIndex, NodeId endIndex, uhdm::
     }
 
     if (cacheStartIndex || cacheEndIndex) {
-      AnyToNodeIdPairCache::const_iterator it = m_anyToNodeIdPairCache.find(instance);
-      if (it != m_anyToNodeIdPairCache.cend()) {
-        if (!cacheStartIndex) cacheStartIndex = it->second.first;
-        if (!cacheEndIndex) cacheEndIndex = it->second.second;
+      // Most objects of the file get an entry, sized for a fraction of the nodes
+      if (m_anyToNodeIdPairCache.empty()) m_anyToNodeIdPairCache.reserve(static_cast<uint32_t>(m_objects.size() / 8));
+      if (const std::pair<NodeId, NodeId>* const nodes = m_anyToNodeIdPairCache.find(instance->getUhdmId())) {
+        if (!cacheStartIndex) cacheStartIndex = nodes->first;
+        if (!cacheEndIndex) cacheEndIndex = nodes->second;
       }
-      m_anyToNodeIdPairCache.insert_or_assign(instance, std::make_pair(cacheStartIndex, cacheEndIndex));
+      m_anyToNodeIdPairCache.insert_or_assign(instance->getUhdmId(), std::make_pair(cacheStartIndex, cacheEndIndex));
     }
   }
 }
@@ -744,24 +867,24 @@ void FileContent::populateCoreMembers(NodeId startIndex, NodeId endIndex, uhdm::
 bool FileContent::validate(NodeId parentId) const {
   if (!parentId) return true;
 
-  const VObject& parentObject = m_objects[(RawNodeId)parentId];
-  if (parentObject.m_type == VObjectType::paNull_rule) return true;
+  const VObjectType parentType = m_objects.type(parentId);
+  if (parentType == VObjectType::paNull_rule) return true;
 
-  if ((parentObject.m_type != VObjectType::paTop_level_rule) && !parentObject.m_parent) {
+  if ((parentType != VObjectType::paTop_level_rule) && !m_objects.parent(parentId)) {
     return false;
   }
 
-  if (parentObject.m_startLine == parentObject.m_endLine) {
-    if (parentObject.m_startColumn > parentObject.m_endColumn) {
+  const VObjectStore::Location& parentLocation = m_objects.location(parentId);
+  if (parentLocation.m_startLine == parentLocation.m_endLine) {
+    if (parentLocation.m_startColumn > parentLocation.m_endColumn) {
       return false;
     }
-  } else if (parentObject.m_startLine > parentObject.m_endLine) {
+  } else if (parentLocation.m_startLine > parentLocation.m_endLine) {
     return false;
   }
 
-  for (NodeId childId = parentObject.m_child; childId; childId = m_objects[(RawNodeId)childId].m_sibling) {
-    const VObject& childObject = m_objects[(RawNodeId)childId];
-    if (childObject.m_parent != parentId) {
+  for (NodeId childId = m_objects.child(parentId); childId; childId = m_objects.sibling(childId)) {
+    if (m_objects.parent(childId) != parentId) {
       return false;
     }
 
@@ -779,7 +902,7 @@ bool FileContent::validate() const {
   } else {
     bool result = true;
     for (size_t i = 0, ni = m_objects.size(); i < ni && result; ++i) {
-      if (m_objects[i].m_type == VObjectType::PREPROC_END) {
+      if (m_objects.type(NodeId(i)) == VObjectType::PREPROC_END) {
         result = result && validate(NodeId(i));
       }
     }
@@ -0,0 +1,121 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+// Times tree walks over the VObjects of a large parsed file: the store
+// backed FileContent accessors against the same walk over an array of
+// VObjects, the layout the store replaced.
+// Usage: FileContent_benchmark [modules] [iterations]
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/VObject.h"
+#include "Surelog/Design/VObjectStore.h"
+#include "Surelog/SourceCompile/ParserHarness.h"
+#include "Surelog/SourceCompile/VObjectTypes.h"
+
+namespace {
+using namespace SURELOG;
+
+std::string makeSource(int32_t modules) {
+  std::string text;
+  for (int32_t m = 0; m < modules; ++m) {
+    const std::string index = std::to_string(m);
+    text += "module m" + index + "(input logic clk, input logic [31:0] a, output logic [31:0] q);\n";
+    text += "  parameter P = " + index + " * 4 + 1;\n";
+    text += "  logic [31:0] r0, r1, r2;\n";
+    text += "  assign r0 = (a + P) ^ (a >> 2);\n";
+    text += "  always_ff @(posedge clk) begin\n";
+    text += "    if (a[0]) r1 <= r0 + 1; else r1 <= r0 - 1;\n";
+    text += "    r2 <= {r1[15:0], r0[31:16]};\n";
+    text += "    q <= r2 & (r1 | 32'hFF);\n";
+    text += "  end\n";
+    text += "endmodule\n";
+  }
+  return text;
+}
+
+// Preorder walk through the FileContent accessors, as the listeners and
+// design compilation do
+uint64_t walkStore(const FileContent* fC, NodeId id) {
+  uint64_t count = 0;
+  for (; id; id = fC->Sibling(id)) {
+    if (fC->Type(id) == VObjectType::paExpression) ++count;
+    count += walkStore(fC, fC->Child(id));
+  }
+  return count;
+}
+
+uint64_t walkArray(const std::vector<VObject>& objects, NodeId id) {
+  uint64_t count = 0;
+  for (; id; id = objects[id].m_sibling) {
+    if (objects[id].m_type == VObjectType::paExpression) ++count;
+    count += walkArray(objects, objects[id].m_child);
+  }
+  return count;
+}
+
+template <typename Walk>
+double timeWalk(int32_t iterations, uint64_t& checksum, Walk walk) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < iterations; ++i) checksum += walk();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+}  // namespace
+
+int main(int argc, const char** argv) {
+  const int32_t modules = (argc > 1) ? std::atoi(argv[1]) : 2000;
+  const int32_t iterations = (argc > 2) ? std::atoi(argv[2]) : 20;
+  if ((modules <= 0) || (iterations <= 0)) return 1;
+
+  Session session;
+  ParserHarness harness(&session);
+  std::unique_ptr<FileContent> fC = harness.parse(makeSource(modules));
+  if (!fC) {
+    std::cerr << "Parse error\n";
+    return 1;
+  }
+  const VObjectStore& store = fC->getVObjects();
+  std::vector<VObject> objects;
+  objects.reserve(store.size());
+  for (RawNodeId i = 0, ni = static_cast<RawNodeId>(store.size()); i < ni; ++i) {
+    objects.emplace_back(store[NodeId(i)]);
+  }
+  const NodeId root = fC->getRootNode();
+
+  uint64_t checksum = 0;
+  const double storeMs = timeWalk(iterations, checksum, [&]() { return walkStore(fC.get(), root); });
+  const double arrayMs = timeWalk(iterations, checksum, [&]() { return walkArray(objects, root); });
+  const double collectMs =
+      timeWalk(iterations, checksum, [&]() { return fC->sl_collect_all(root, VObjectType::paExpression).size(); });
+
+  std::cout << store.size() << " nodes\n"
+            << "  " << (static_cast<double>(store.getMemoryUsage()) / store.size()) << " bytes per node in the store, "
+            << sizeof(VObject) << " per VObject\n"
+            << "  walk through the store: " << storeMs << " ms\n"
+            << "  walk over a VObject array: " << arrayMs << " ms\n"
+            << "  sl_collect_all: " << collectMs << " ms\n"
+            << "  checksum " << checksum << "\n";
+  return 0;
+}
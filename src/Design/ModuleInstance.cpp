@@ -30,6 +30,7 @@
 #include <string_view>
 #include <vector>
 
+#include "Surelog/Common/Session.h"
 #include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/DesignComponent.h"
 #include "Surelog/Design/FileContent.h"
@@ -102,18 +103,19 @@ const uhdm::Constant* resolveFromParamAssign(const uhdm::ParamAssignCollection*
   return nullptr;
 }
 
-Value* ModuleInstance::getValue(std::string_view name, ExprBuilder& exprBuilder) const {
-  if (ValuedComponentI::getComplexValue(name)) {  // Only check current instance level
+Value* ModuleInstance::getValue_(std::string_view name, SymbolId id, ExprBuilder& exprBuilder) const {
+  if (ValuedComponentI::getComplexValue(id)) {  // Only check current instance level
     return nullptr;
   }
 
-  Value* sval = ValuedComponentI::getValue(name);
+  Value* sval = findValue_(name, id, m_session->getSymbolTable());
 
   if (m_definition && (sval == nullptr)) {
     uhdm::ParamAssignCollection* param_assigns = m_definition->getParamAssigns();
     if (param_assigns) {
       std::set<std::string> visited;
-      const uhdm::Constant* res = resolveFromParamAssign(param_assigns, visited, name);
+      const uhdm::Constant* res =
+          resolveFromParamAssign(param_assigns, visited, name.empty() ? getValueName(id) : name);
       if (res) {
         sval = exprBuilder.fromVpiValue(res->getValue(), res->getConstType(), res->getSize());
       }
@@ -124,10 +126,9 @@ Value* ModuleInstance::getValue(std::string_view name, ExprBuilder& exprBuilder)
 }
 
 ModuleInstance* ModuleInstance::getChildByName(std::string_view name) {
-  for (auto child : m_allSubInstances) {
-    if (child->getInstanceName() == name) return child;
-  }
-  return nullptr;
+  // Equal names are kept in insertion order, the first one is the first child
+  ChildrenByNameMap::const_iterator itr = m_childrenByName.lower_bound(name);
+  return ((itr == m_childrenByName.end()) || (itr->first != name)) ? nullptr : itr->second;
 }
 
 std::string ModuleInstance::decompile(char* valueName) {
@@ -149,7 +150,10 @@ ModuleInstance::~ModuleInstance() {
   }
 }
 
-void ModuleInstance::addSubInstance(ModuleInstance* subInstance) { m_allSubInstances.push_back(subInstance); }
+void ModuleInstance::addSubInstance(ModuleInstance* subInstance) {
+  m_allSubInstances.push_back(subInstance);
+  m_childrenByName.emplace(subInstance->getInstanceNameView(), subInstance);
+}
 
 VObjectType ModuleInstance::getType() const { return m_fileContent->Type(m_nodeId); }
 
@@ -209,10 +213,11 @@ uint32_t ModuleInstance::getDepth() const {
   return depth;
 }
 
-std::string ModuleInstance::getInstanceName() const {
+std::string ModuleInstance::getInstanceName() const { return std::string(getInstanceNameView()); }
+
+std::string_view ModuleInstance::getInstanceNameView() const {
   if (m_definition == nullptr) {
-    std::string name = m_instName.substr(m_instName.find("&", 0, 1) + 1, m_instName.size());
-    return name;
+    return std::string_view(m_instName).substr(m_instName.find("&", 0, 1) + 1);
   } else {
     return m_instName;
   }
@@ -0,0 +1,132 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/Design/VObjectStore.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/PathId.h"
+#include "Surelog/Common/SymbolId.h"
+#include "Surelog/Design/VObject.h"
+
+namespace SURELOG {
+
+void VObjectStore::reserve(size_t count) {
+  m_types.reserve(count);
+  m_parents.reserve(count);
+  m_children.reserve(count);
+  m_siblings.reserve(count);
+  m_definitions.reserve(count);
+  m_names.reserve(count);
+  m_fileIndices.reserve(count);
+  m_locations.reserve(count);
+  m_ppLocations.reserve(count);
+}
+
+void VObjectStore::clear() {
+  m_types.clear();
+  m_parents.clear();
+  m_children.clear();
+  m_siblings.clear();
+  m_definitions.clear();
+  m_names.clear();
+  m_fileIndices.clear();
+  m_locations.clear();
+  m_ppLocations.clear();
+  m_files.clear();
+  m_lastFileIndex = 0;
+}
+
+uint32_t VObjectStore::internFileId(PathId fileId) {
+  // Consecutive objects almost always come from the same file
+  auto same = [&fileId](const PathId& other) {
+    return (other.getSymbolTable() == fileId.getSymbolTable()) && ((RawPathId)other == (RawPathId)fileId);
+  };
+  if ((m_lastFileIndex < m_files.size()) && same(m_files[m_lastFileIndex])) return m_lastFileIndex;
+  for (uint32_t i = 0, ni = static_cast<uint32_t>(m_files.size()); i < ni; ++i) {
+    if (same(m_files[i])) return m_lastFileIndex = i;
+  }
+  m_files.emplace_back(fileId);
+  return m_lastFileIndex = static_cast<uint32_t>(m_files.size() - 1);
+}
+
+NodeId VObjectStore::emplace_back(SymbolId name, PathId fileId, VObjectType type, uint32_t startLine,
+                                  uint16_t startColumn, uint32_t endLine, uint16_t endColumn,
+                                  NodeId parent /* = InvalidNodeId */, NodeId definition /* = InvalidNodeId */,
+                                  NodeId child /* = InvalidNodeId */, NodeId sibling /* = InvalidNodeId */) {
+  const NodeId id(static_cast<RawNodeId>(m_types.size()));
+  m_types.emplace_back(type);
+  m_parents.emplace_back(parent);
+  m_children.emplace_back(child);
+  m_siblings.emplace_back(sibling);
+  m_definitions.emplace_back(definition);
+  m_names.emplace_back(name);
+  m_fileIndices.emplace_back(internFileId(fileId));
+  m_locations.push_back({startLine, endLine, startColumn, endColumn});
+  m_ppLocations.emplace_back();
+  return id;
+}
+
+NodeId VObjectStore::push_back(const VObject& object) {
+  const NodeId id = emplace_back(object.m_name, object.m_fileId, object.m_type, object.m_startLine,
+                                 object.m_startColumn, object.m_endLine, object.m_endColumn, object.m_parent,
+                                 object.m_definition, object.m_child, object.m_sibling);
+  m_ppLocations.back() = {object.m_ppStartLine, object.m_ppEndLine, object.m_ppStartColumn, object.m_ppEndColumn};
+  return id;
+}
+
+VObject VObjectStore::operator[](NodeId id) const {
+  const Location& loc = m_locations[id];
+  VObject object(m_names[id], fileId(id), m_types[id], loc.m_startLine, loc.m_startColumn, loc.m_endLine,
+                 loc.m_endColumn, m_parents[id], m_definitions[id], m_children[id], m_siblings[id]);
+  const Location& ppLoc = m_ppLocations[id];
+  object.m_ppStartLine = ppLoc.m_startLine;
+  object.m_ppEndLine = ppLoc.m_endLine;
+  object.m_ppStartColumn = ppLoc.m_startColumn;
+  object.m_ppEndColumn = ppLoc.m_endColumn;
+  return object;
+}
+
+VObjectStore::Reference VObjectStore::mutableObject(NodeId id) {
+  Location& loc = m_locations[id];
+  Location& ppLoc = m_ppLocations[id];
+  return Reference{m_names[id],
+                   m_types[id],
+                   loc.m_startLine,
+                   loc.m_endLine,
+                   loc.m_startColumn,
+                   loc.m_endColumn,
+                   ppLoc.m_startLine,
+                   ppLoc.m_endLine,
+                   ppLoc.m_startColumn,
+                   ppLoc.m_endColumn,
+                   m_parents[id],
+                   m_definitions[id],
+                   m_children[id],
+                   m_siblings[id]};
+}
+
+size_t VObjectStore::getMemoryUsage() const {
+  return (m_types.capacity() * sizeof(VObjectType)) + (m_parents.capacity() * sizeof(NodeId)) +
+         (m_children.capacity() * sizeof(NodeId)) + (m_siblings.capacity() * sizeof(NodeId)) +
+         (m_definitions.capacity() * sizeof(NodeId)) + (m_names.capacity() * sizeof(SymbolId)) +
+         (m_fileIndices.capacity() * sizeof(uint32_t)) + (m_locations.capacity() * sizeof(Location)) +
+         (m_ppLocations.capacity() * sizeof(Location)) + (m_files.capacity() * sizeof(PathId));
+}
+
+}  // namespace SURELOG
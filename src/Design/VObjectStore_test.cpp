@@ -0,0 +1,77 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Design/VObjectStore.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/PathId.h"
+#include "Surelog/Common/SymbolId.h"
+#include "Surelog/Design/VObject.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
+#include "Surelog/SourceCompile/VObjectTypes.h"
+
+namespace SURELOG {
+
+namespace {
+TEST(VObjectStore, RoundTrip) {
+  std::unique_ptr<SymbolTable> symbols(new SymbolTable);
+  const SymbolId name = symbols->registerSymbol("top");
+  const PathId fileA(symbols.get(), symbols->registerSymbol("a.sv"));
+  const PathId fileB(symbols.get(), symbols->registerSymbol("b.sv"));
+
+  VObjectStore store;
+  const NodeId root = store.emplace_back(name, fileA, VObjectType::paTop_level_rule, 1, 2, 30, 4);
+  const NodeId child = store.emplace_back(BadSymbolId, fileA, VObjectType::paDescription, 3, 4, 5, 6, root);
+  store.child(root) = child;
+
+  EXPECT_EQ(store.size(), 2);
+  EXPECT_EQ(store.type(root), VObjectType::paTop_level_rule);
+  EXPECT_EQ(store.child(root), child);
+  EXPECT_EQ(store.parent(child), root);
+  EXPECT_EQ(store.name(root), name);
+  EXPECT_EQ(store.location(child).m_endLine, 5);
+
+  const VObject object = store[child];
+  EXPECT_EQ(object.m_type, VObjectType::paDescription);
+  EXPECT_EQ(object.m_parent, root);
+  EXPECT_EQ(object.m_startColumn, 4);
+  EXPECT_EQ(object.m_fileId, fileA);
+
+  VObjectStore::Reference reference = store.mutableObject(child);
+  reference.m_ppStartLine = 7;
+  reference.m_sibling = root;
+  EXPECT_EQ(store.ppLocation(child).m_startLine, 7);
+  EXPECT_EQ(store.sibling(child), root);
+
+  store.setFileId(child, fileB);
+  EXPECT_EQ(store.fileId(child), fileB);
+  EXPECT_EQ(store.fileId(root), fileA);
+
+  VObjectStore copy;
+  copy.push_back(store[root]);
+  copy.push_back(store[child]);
+  EXPECT_EQ(copy.ppLocation(NodeId(1)).m_startLine, 7);
+  EXPECT_EQ(copy.fileId(NodeId(1)), fileB);
+
+  store.clear();
+  EXPECT_TRUE(store.empty());
+}
+}  // namespace
+}  // namespace SURELOG
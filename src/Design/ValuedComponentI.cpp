@@ -24,85 +24,131 @@
 
 #include <uhdm/expr.h>
 
+#include <algorithm>
 #include <cstdint>
-#include <map>
-#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "Surelog/Common/Session.h"
+#include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/ModuleInstance.h"
 #include "Surelog/Expression/ExprBuilder.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
 #include "Surelog/SourceCompile/VObjectTypes.h"
 
 namespace SURELOG {
-Value* ValuedComponentI::getValue(std::string_view name) const {
-  auto itr = m_paramMap.find(name);
-  if (itr == m_paramMap.end()) {
-    if (m_definition) {
-      itr = m_definition->m_paramMap.find(name);
-      if (itr != m_definition->m_paramMap.end()) {
-        return (*itr).second.first;
-      }
+// A name that is not in the symbol table can't be a key either
+SymbolId ValuedComponentI::getValueId(std::string_view name) const { return m_session->getSymbolTable()->getId(name); }
+
+std::string_view ValuedComponentI::getValueName(SymbolId id) const {
+  return m_session->getSymbolTable()->getSymbol(id);
+}
+
+std::vector<std::pair<std::string_view, const std::pair<Value*, int32_t>*>> ValuedComponentI::getMappedValuesByName()
+    const {
+  std::vector<std::pair<std::string_view, const std::pair<Value*, int32_t>*>> values;
+  values.reserve(m_paramMap.size());
+  for (const auto& [id, value] : m_paramMap) values.emplace_back(getValueName(id), &value);
+  std::sort(values.begin(), values.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  return values;
+}
+
+std::vector<std::string_view> ValuedComponentI::getComplexValueNames() const {
+  std::vector<std::string_view> names;
+  names.reserve(m_complexValues.size());
+  for (const auto& entry : m_complexValues) names.emplace_back(getValueName(entry.first));
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+Value* ValuedComponentI::findValue_(std::string_view name, SymbolId id, const SymbolTable* symbols) const {
+  // Id of the same name in the symbols of another session
+  auto resolve = [&](const SymbolTable* other) {
+    if (name.empty()) name = symbols->getSymbol(id);
+    return other->getId(name);
+  };
+  const ValuedComponentI* component = this;
+  while (component != nullptr) {
+    if (const SymbolTable* const other = component->m_session->getSymbolTable(); other != symbols) {
+      id = resolve(other);
+      symbols = other;
     }
+    if (const std::pair<Value*, int32_t>* const value = component->m_paramMap.find(id)) return value->first;
 
-    if (m_parentScope) {
-      if (const ModuleInstance* inst = valuedcomponenti_cast<ModuleInstance*>(this)) {
-        if (inst->getType() != VObjectType::paModule_instantiation) {
-          return m_parentScope->getValue(name);
-        }
-      } else {
-        return m_parentScope->getValue(name);
-      }
+    if (const ValuedComponentI* const definition = component->m_definition) {
+      // The definition may come from another session, with its own symbols
+      const SymbolTable* const other = definition->m_session->getSymbolTable();
+      const SymbolId defId = (other == symbols) ? id : resolve(other);
+      if (const std::pair<Value*, int32_t>* const value = definition->m_paramMap.find(defId)) return value->first;
     }
-  } else {
-    return (*itr).second.first;
+
+    const ValuedComponentI* const parent = component->m_parentScope;
+    if (const ModuleInstance* inst = valuedcomponenti_cast<ModuleInstance*>(component)) {
+      if (inst->getType() == VObjectType::paModule_instantiation) return nullptr;
+    }
+    component = parent;
   }
   return nullptr;
 }
 
-Value* ValuedComponentI::getValue(std::string_view name, ExprBuilder& exprBuilder) const { return getValue(name); }
+Value* ValuedComponentI::getValue_(std::string_view name, SymbolId id, ExprBuilder& exprBuilder) const {
+  return findValue_(name, id, m_session->getSymbolTable());
+}
 
-void ValuedComponentI::deleteValue(std::string_view name, ExprBuilder& exprBuilder) {
-  std::map<std::string, std::pair<Value*, int32_t>>::iterator itr = m_paramMap.find(name);
-  if (itr != m_paramMap.end()) {
-    exprBuilder.deleteValue((*itr).second.first);
-    m_paramMap.erase(itr);
-  }
+Value* ValuedComponentI::getValue(std::string_view name) const {
+  return findValue_(name, getValueId(name), m_session->getSymbolTable());
 }
 
-void ValuedComponentI::forgetValue(std::string_view name) {
-  std::map<std::string, std::pair<Value*, int32_t>>::iterator itr = m_paramMap.find(name);
-  if (itr != m_paramMap.end()) {
-    m_paramMap.erase(itr);
+Value* ValuedComponentI::getValue(SymbolId id) const { return findValue_({}, id, m_session->getSymbolTable()); }
+
+Value* ValuedComponentI::getValue(std::string_view name, ExprBuilder& exprBuilder) const {
+  return getValue_(name, getValueId(name), exprBuilder);
+}
+
+Value* ValuedComponentI::getValue(SymbolId id, ExprBuilder& exprBuilder) const {
+  return getValue_({}, id, exprBuilder);
+}
+
+void ValuedComponentI::deleteValue(std::string_view name, ExprBuilder& exprBuilder) {
+  const SymbolId id = getValueId(name);
+  if (std::pair<Value*, int32_t>* const value = m_paramMap.find(id)) {
+    exprBuilder.deleteValue(value->first);
+    m_paramMap.erase(id);
   }
 }
 
+void ValuedComponentI::forgetValue(std::string_view name) { m_paramMap.erase(getValueId(name)); }
+
 void ValuedComponentI::setValue(std::string_view name, Value* val,  // NOLINT
                                 ExprBuilder& exprBuilder, int32_t lineNb) {
-  deleteValue(name, exprBuilder);
-  m_paramMap.emplace(name, std::make_pair(exprBuilder.clone(val), lineNb));
-  forgetComplexValue(name);
+  setValue(m_session->getSymbolTable()->registerSymbol(name), val, exprBuilder, lineNb);
+}
+
+void ValuedComponentI::setValue(SymbolId id, Value* val,  // NOLINT
+                                ExprBuilder& exprBuilder, int32_t lineNb) {
+  Value* const clone = exprBuilder.clone(val);
+  // Replaced in place, keeps the position of the parameter
+  std::pair<Value*, int32_t>* const value = m_paramMap.emplace(id, std::make_pair(nullptr, lineNb)).first;
+  if (value->first != nullptr) exprBuilder.deleteValue(value->first);
+  *value = std::make_pair(clone, lineNb);
+  m_complexValues.erase(id);
 }
 
 void ValuedComponentI::setComplexValue(std::string_view name, uhdm::Expr* val) {
-  auto itr = m_complexValues.find(name);
-  if (itr != m_complexValues.end()) m_complexValues.erase(itr);
-  m_complexValues.emplace(name, val);
-  forgetValue(name);
+  const SymbolId id = m_session->getSymbolTable()->registerSymbol(name);
+  *m_complexValues.emplace(id, val).first = val;
+  m_paramMap.erase(id);
 }
 
 uhdm::Expr* ValuedComponentI::getComplexValue(std::string_view name) const {
-  auto itr = m_complexValues.find(name);
-  if (itr != m_complexValues.end()) {
-    return (*itr).second;
-  }
-  return nullptr;
+  return getComplexValue(getValueId(name));
 }
 
-void ValuedComponentI::forgetComplexValue(std::string_view name) {
-  auto itr = m_complexValues.find(name);
-  if (itr != m_complexValues.end()) {
-    m_complexValues.erase(itr);
-  }
+uhdm::Expr* ValuedComponentI::getComplexValue(SymbolId id) const {
+  if (uhdm::Expr* const* const value = m_complexValues.find(id)) return *value;
+  return nullptr;
 }
+
+void ValuedComponentI::forgetComplexValue(std::string_view name) { m_complexValues.erase(getValueId(name)); }
 }  // namespace SURELOG
@@ -26,6 +26,7 @@
 #include "Surelog/CommandLine/CommandLineParser.h"
 #include "Surelog/Common/Containers.h"
 #include "Surelog/Common/FileSystem.h"
+#include "Surelog/Common/NodeId.h"
 #include "Surelog/Common/Session.h"
 #include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/FileContent.h"
@@ -50,8 +51,10 @@
 #include "Surelog/SourceCompile/Compiler.h"
 #include "Surelog/SourceCompile/IncludeFileInfo.h"
 #include "Surelog/SourceCompile/SymbolTable.h"
+#include "Surelog/SourceCompile/VObjectTypes.h"
 #include "Surelog/Testbench/ClassDefinition.h"
 #include "Surelog/Testbench/Program.h"
+#include "Surelog/Utils/Tracer.h"
 
 // UHDM
 #include <uhdm/design.h>
@@ -59,13 +62,16 @@
 #include <uhdm/uhdm_types.h>
 #include <uhdm/vpi_visitor.h>
 
+#include <algorithm>
 #include <climits>
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #ifdef USETBB
@@ -83,6 +89,13 @@ void CompileDesign::lockSerializer() { m_compiler->lockSerializer(); }
 
 void CompileDesign::unlockSerializer() { m_compiler->unlockSerializer(); }
 
+TypespecInterner* CompileDesign::getTypespecInterner() {
+  if (!m_typespecInterner) {
+    m_typespecInterner.reset(new TypespecInterner(getSerializer()));
+  }
+  return m_typespecInterner.get();
+}
+
 bool CompileDesign::compile() {
   // Register UHDM Error callbacks
   FileSystem* const fileSystem = m_session->getFileSystem();
@@ -124,10 +137,13 @@ bool CompileDesign::compile() {
 }
 
 template <class ObjectType, class ObjectMapType, typename FunctorType>
-void CompileDesign::compileMT_(ObjectMapType& objects, int32_t maxThreadCount) {
+void CompileDesign::compileMT_(ObjectMapType& objects, int32_t maxThreadCount, std::string_view name) {
   CommandLineParser* const clp = m_session->getCommandLineParser();
+  Tracer* const tracer = m_session->getTracer();
+  Tracer::Span span(tracer, "phase", name);
   if (maxThreadCount == 0) {
     for (const auto& itr : objects) {
+      Tracer::Span objectSpan(tracer, "design", name, itr.second->getName());
       FunctorType funct(m_session, this, itr.second, m_compiler->getDesign());
       funct.operator()();
     }
@@ -166,6 +182,7 @@ void CompileDesign::compileMT_(ObjectMapType& objects, int32_t maxThreadCount) {
     for (int32_t i = 0; i < maxThreadCount; i++) {
       std::thread* th = new std::thread([=] {
         for (uint32_t j = 0; j < jobArray[i].size(); j++) {
+          Tracer::Span objectSpan(tracer, "design", name, jobArray[i][j]->getName());
           FunctorType funct(m_sessions[i], this, jobArray[i][j], m_compiler->getDesign());
           funct.operator()();
         }
@@ -262,6 +279,190 @@ void CompileDesign::collectObjects_(Design::FileIdDesignContentMap& all_files, D
   }
 }
 
+// "work@top" -> "top", "pkg::cls" -> "cls"
+static std::string_view unqualifiedName(std::string_view name) {
+  std::string_view::size_type pos = name.find('@');
+  if (pos != std::string_view::npos) name.remove_prefix(pos + 1);
+  pos = name.rfind("::");
+  if (pos != std::string_view::npos) name.remove_prefix(pos + 2);
+  return name;
+}
+
+// "work@m::sub" -> "m", "pkg::cls" -> "pkg", "work@top" -> ""
+static std::string_view containerName(std::string_view name) {
+  const std::string_view::size_type pos = name.find("::");
+  if (pos == std::string_view::npos) return std::string_view();
+  return unqualifiedName(name.substr(0, pos));
+}
+
+// "work@m::sub" -> "work", "pkg::cls" -> ""
+static std::string_view libraryName(std::string_view name) {
+  const std::string_view::size_type pos = name.find('@');
+  if ((pos == std::string_view::npos) || (name.substr(0, pos).find("::") != std::string_view::npos)) {
+    return std::string_view();
+  }
+  return name.substr(0, pos);
+}
+
+static std::string_view libraryName(const FileContent* fC) {
+  const Library* const library = fC->getLibrary();
+  return (library == nullptr) ? std::string_view() : std::string_view(library->getName());
+}
+
+void CompileDesign::computeUnreachableComponents_() {
+  CommandLineParser* const clp = m_session->getCommandLineParser();
+  Design* const design = m_compiler->getDesign();
+  m_unreachableComponents.clear();
+
+  // Identifiers are matched against the unqualified component names of the
+  // library they appear in, components without a library (packages, classes)
+  // matching from any library. Only a name no such component has falls back
+  // to the candidates of the other libraries. The package or scope an
+  // identifier resolves to doesn't matter, an ambiguous name keeps all its
+  // candidates.
+  std::vector<const DesignComponent*> components;
+  for (const auto& [name, component] : design->getModuleDefinitions()) components.emplace_back(component);
+  for (const auto& [name, component] : design->getProgramDefinitions()) components.emplace_back(component);
+  for (const auto& [name, packages] : design->getPackageDefinitions()) {
+    components.insert(components.end(), packages.begin(), packages.end());
+  }
+  for (const auto& [name, component] : design->getClassDefinitions()) components.emplace_back(component);
+  std::map<std::string_view, std::vector<const DesignComponent*>> componentsByName;
+  std::map<std::string_view, std::vector<const DesignComponent*>> componentsByContainer;
+  for (const DesignComponent* component : components) {
+    componentsByName[unqualifiedName(component->getName())].emplace_back(component);
+    const std::string_view container = containerName(component->getName());
+    if (!container.empty()) componentsByContainer[container].emplace_back(component);
+  }
+
+  std::set<const DesignComponent*> reachable;
+  std::vector<const DesignComponent*> queue;
+  const auto candidates = [&](std::string_view name, std::string_view library) {
+    std::vector<const DesignComponent*> found;
+    auto itr = componentsByName.find(name);
+    if (itr == componentsByName.end()) return found;
+    for (const DesignComponent* component : itr->second) {
+      const std::string_view componentLibrary = libraryName(component->getName());
+      if (library.empty() || componentLibrary.empty() || (componentLibrary == library)) found.emplace_back(component);
+    }
+    if (found.empty()) found = itr->second;
+    return found;
+  };
+  const auto reach = [&](std::string_view name, std::string_view library) {
+    for (const DesignComponent* component : candidates(name, library)) {
+      if (reachable.emplace(component).second) queue.emplace_back(component);
+    }
+  };
+  // "lib@top" only selects the top of lib
+  for (const std::string& top : clp->getTopLevelModules()) reach(unqualifiedName(top), libraryName(top));
+  // Without any matching top there is nothing to prune against
+  if (queue.empty()) return;
+
+  // Binds are pulled in by any of the names they mention
+  const VObjectTypeUnorderedSet bindTypes = {VObjectType::paBind_directive};
+  std::vector<std::pair<const FileContent*, NodeId>> binds;
+  for (const auto& [fileId, fC] : design->getAllFileContents()) {
+    for (NodeId id : fC->sl_collect_all(fC->getRootNode(), bindTypes)) binds.emplace_back(fC, id);
+  }
+  std::vector<bool> bindsDone(binds.size(), false);
+
+  // Compilation unit items ($unit imports, typedefs...) of the files holding
+  // a reachable component
+  const VObjectTypeUnorderedSet declarationTypes = {
+      VObjectType::paModule_declaration, VObjectType::paPackage_declaration,   VObjectType::paConfig_declaration,
+      VObjectType::paUdp_declaration,    VObjectType::paInterface_declaration, VObjectType::paProgram_declaration,
+      VObjectType::paClass_declaration};
+  const VObjectTypeUnorderedSet identifierTypes = {VObjectType::STRING_CONST};
+  std::set<const FileContent*> scannedFiles;
+
+  // Every file content is compiled, pruned definitions or not, so the
+  // packages of all the $unit imports have to stay
+  const VObjectTypeUnorderedSet importTypes = {VObjectType::paPackage_import_item};
+  for (const auto& [fileId, fC] : design->getAllFileContents()) {
+    for (NodeId id : fC->sl_collect_all(fC->getRootNode(), importTypes, declarationTypes)) {
+      if (const NodeId nameId = fC->Child(id)) reach(fC->SymName(nameId), libraryName(fC));
+    }
+  }
+
+  while (!queue.empty()) {
+    while (!queue.empty()) {
+      const DesignComponent* const component = queue.back();
+      queue.pop_back();
+      for (uint32_t i = 0, n = component->getFileContents().size(); i < n; ++i) {
+        const FileContent* const fC = component->getFileContents()[i];
+        if (fC == nullptr) continue;
+        const std::string_view library = libraryName(fC);
+        for (NodeId id : fC->sl_collect_all(component->getNodeIds()[i], VObjectType::STRING_CONST)) {
+          reach(fC->SymName(id), library);
+        }
+        if (scannedFiles.emplace(fC).second) {
+          for (NodeId id : fC->sl_collect_all(fC->getRootNode(), identifierTypes, declarationTypes)) {
+            reach(fC->SymName(id), library);
+          }
+        }
+      }
+      // Nested components go with their container, and the other way round
+      auto itr = componentsByContainer.find(unqualifiedName(component->getName()));
+      if (itr != componentsByContainer.end()) {
+        for (const DesignComponent* nested : itr->second) {
+          if (reachable.emplace(nested).second) queue.emplace_back(nested);
+        }
+      }
+      const std::string_view container = containerName(component->getName());
+      if (!container.empty()) reach(container, libraryName(component->getName()));
+    }
+    for (uint32_t i = 0, n = binds.size(); i < n; ++i) {
+      if (bindsDone[i]) continue;
+      const FileContent* const fC = binds[i].first;
+      const std::string_view library = libraryName(fC);
+      const std::vector<NodeId> ids = fC->sl_collect_all(binds[i].second, VObjectType::STRING_CONST);
+      const bool bound = std::any_of(ids.begin(), ids.end(), [&](NodeId id) {
+        const std::vector<const DesignComponent*> found = candidates(fC->SymName(id), library);
+        return std::any_of(found.begin(), found.end(),
+                           [&](const DesignComponent* component) { return reachable.count(component) != 0; });
+      });
+      if (!bound) continue;
+      bindsDone[i] = true;
+      for (NodeId id : ids) reach(fC->SymName(id), library);
+    }
+  }
+
+  for (const DesignComponent* component : components) {
+    // Built-in primitives have no source
+    if (component->getFileContents().empty()) continue;
+    if (reachable.find(component) == reachable.end()) m_unreachableComponents.emplace(component);
+  }
+}
+
+void CompileDesign::pruneUnreachableComponents_() {
+  if (m_unreachableComponents.empty()) return;
+  Design* const design = m_compiler->getDesign();
+  const auto unreachable = [this](const DesignComponent* component) {
+    return m_unreachableComponents.find(component) != m_unreachableComponents.end();
+  };
+  const auto prune = [&unreachable](auto& definitions) {
+    std::vector<SymbolId> ids;
+    for (const auto& [id, definition] : definitions) {
+      if (unreachable(definition)) ids.emplace_back(id);
+    }
+    for (SymbolId id : ids) definitions.erase(id);
+  };
+  prune(design->getModuleDefinitions());
+  prune(design->getProgramDefinitions());
+  prune(design->getClassDefinitions());
+  Design::PackageDefinitionMap& packageDefinitions = design->getPackageDefinitions();
+  std::vector<SymbolId> unreachablePackages;
+  for (auto& [id, packages] : packageDefinitions) {
+    packages.erase(std::remove_if(packages.begin(), packages.end(), unreachable), packages.end());
+    if (packages.empty()) unreachablePackages.emplace_back(id);
+  }
+  for (SymbolId id : unreachablePackages) packageDefinitions.erase(id);
+  // Still referenced by the file contents and libraries
+  for (const DesignComponent* component : m_unreachableComponents) design->addPrunedComponent(component);
+  PackageDefinitionVec& packages = design->getOrderedPackageDefinitions();
+  packages.erase(std::remove_if(packages.begin(), packages.end(), unreachable), packages.end());
+}
+
 bool CompileDesign::compilation_() {
   CommandLineParser* const clp = m_session->getCommandLineParser();
   Design* const design = m_compiler->getDesign();
@@ -279,7 +480,8 @@ bool CompileDesign::compilation_() {
   for (int32_t i = 0; i < maxThreadCount; ++i) {
     SymbolTable* const symbols = m_session->getSymbolTable()->CreateSnapshot();
     m_sessions.emplace_back(new Session(m_session->getFileSystem(), symbols, m_session->getLogListener(), nullptr,
-                                        m_session->getCommandLineParser(), m_session->getPrecompiled()));
+                                        m_session->getCommandLineParser(), m_session->getPrecompiled(),
+                                        m_session->getCacheWriter(), m_session->getTracer()));
   }
 
   for (auto& file : all_files) {
@@ -288,30 +490,47 @@ bool CompileDesign::compilation_() {
     }
   }
 
-  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorCreateLookup>(all_files, maxThreadCount);
+  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorCreateLookup>(all_files, maxThreadCount,
+                                                                               "Create lookup");
 
-  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorResolve>(all_files, maxThreadCount);
+  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorResolve>(all_files, maxThreadCount,
+                                                                          "Resolve symbols");
 
-  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorCompileFileContentDecl>(all_files, maxThreadCount);
+  // Trees are final past symbol resolution, index them for the
+  // sl_collect_all queries of the compilation steps
+  for (auto& file : all_files) {
+    file.second->buildSubtreeIndex();
+  }
+
+  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorCompileFileContentDecl>(all_files, maxThreadCount,
+                                                                                         "Compile file declarations");
 
   collectObjects_(all_files, design, false);
   m_compiler->getDesign()->orderPackages();
+  if (clp->topOnly()) {
+    computeUnreachableComponents_();
+    pruneUnreachableComponents_();
+  }
 
   // Compile packages in strict order
+  Tracer::Span packagesSpan(m_session->getTracer(), "phase", "Compile packages");
   for (auto itr : m_compiler->getDesign()->getOrderedPackageDefinitions()) {
+    Tracer::Span packageSpan(m_session->getTracer(), "design", "Compile packages", itr->getName());
     FunctorCompilePackage funct(m_session, this, itr, m_compiler->getDesign());
     funct.operator()();
   }
+  packagesSpan.end();
 
-  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorCompileFileContent>(all_files, maxThreadCount);
+  compileMT_<FileContent, Design::FileIdDesignContentMap, FunctorCompileFileContent>(all_files, maxThreadCount,
+                                                                                     "Compile files");
 
-  // Compile modules
-  compileMT_<ModuleDefinition, ModuleNameModuleDefinitionMap, FunctorCompileModule>(
-      m_compiler->getDesign()->getModuleDefinitions(), maxThreadCount);
+  // Compile modules, programs and classes in name order, the order of the
+  // errors and of the UHDM objects depends on it
+  auto modules = design->sortedByName(design->getModuleDefinitions());
+  compileMT_<ModuleDefinition, decltype(modules), FunctorCompileModule>(modules, maxThreadCount, "Compile modules");
 
-  // Compile programs
-  compileMT_<Program, ProgramNameProgramDefinitionMap, FunctorCompileProgram>(
-      m_compiler->getDesign()->getProgramDefinitions(), maxThreadCount);
+  auto programs = design->sortedByName(design->getProgramDefinitions());
+  compileMT_<Program, decltype(programs), FunctorCompileProgram>(programs, maxThreadCount, "Compile programs");
 
   if (clp->parseBuiltIn()) {
     Builtin builtin(m_session, this, design);
@@ -319,14 +538,20 @@ bool CompileDesign::compilation_() {
     builtin.addBuiltinClasses();
   }
 
-  // Compile classes
-  compileMT_<ClassDefinition, ClassNameClassDefinitionMultiMap, FunctorCompileClass>(
-      m_compiler->getDesign()->getClassDefinitions(), maxThreadCount);
+  auto classes = design->sortedByName(design->getClassDefinitions());
+  compileMT_<ClassDefinition, decltype(classes), FunctorCompileClass>(classes, maxThreadCount, "Compile classes");
+
+  // About 16 bytes per node, not worth keeping for the few queries of
+  // elaboration
+  for (auto& file : all_files) {
+    file.second->clearSubtreeIndex();
+  }
   design->clearContainers();
 
   collectObjects_(all_files, design, true);
 
   m_compiler->getDesign()->orderPackages();
+  pruneUnreachableComponents_();
 
   ErrorContainer* const errors = m_session->getErrorContainer();
   for (Session* session : m_sessions) {
@@ -359,13 +584,13 @@ void decompile(Session* session, ValuedComponentI* instance) {
         std::cout << "Mod: " << inst->getModuleName() << " "
                   << fileSystem->toPath(component->getFileContents()[0]->getFileId()) << "\n";
 
-        for (const auto& ps : inst->getMappedValues()) {
-          const std::string& name = ps.first;
-          Value* val = ps.second.first;
+        for (const auto& ps : inst->getMappedValuesByName()) {
+          const std::string name(ps.first);
+          Value* val = ps.second->first;
           std::cout << std::string("    " + name + " = " + val->uhdmValue() + "\n");
         }
-        for (const auto& ps : inst->getComplexValues()) {
-          const std::string& name = ps.first;
+        for (std::string_view complexName : inst->getComplexValueNames()) {
+          const std::string name(complexName);
           std::cout << std::string("    " + name + " =  complex\n");
         }
         inst = inst->getParent();
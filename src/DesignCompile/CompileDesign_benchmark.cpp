@@ -0,0 +1,119 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+// Times full compilations of a class heavy design. Without files, compiles a
+// generated package of classes that extend each other, each with its own
+// typedefs, members, functions and tasks. Otherwise the arguments are the
+// source files and options, e.g. for the UVM package:
+//   CompileDesign_benchmark 5 third_party/UVM/1800.2-2017-1.0/pp_output/uvm_pkg.sv
+// Add -trace to see where the time goes.
+// Usage: CompileDesign_benchmark [iterations] [files and options]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "Surelog/Common/Session.h"
+#include "Surelog/SourceCompile/Compiler.h"
+
+namespace {
+namespace fs = std::filesystem;
+
+std::string makeSource(int32_t classes) {
+  std::string text = "package bench_pkg;\n  typedef int unsigned count_t;\n";
+  for (int32_t c = 0; c < classes; ++c) {
+    const std::string n = std::to_string(c);
+    text += "  class c" + n + ((c > 0) ? " extends c" + std::to_string(c - 1) : std::string()) + ";\n";
+    text += "    typedef logic [7:0] byte" + n + "_t;\n";
+    text += "    byte" + n + "_t m_data" + n + ";\n";
+    text += "    count_t m_count" + n + ";\n";
+    text += "    int m_values" + n + "[4];\n";
+    text += "    function void set" + n + "(byte" + n + "_t data);\n";
+    text += "      m_data" + n + " = data;\n";
+    text += "      m_count" + n + " = m_count" + n + " + 1;\n";
+    if (c > 0) text += "      set" + std::to_string(c - 1) + "(data);\n";
+    text += "    endfunction\n";
+    text += "    function count_t count" + n + "();\n";
+    text += "      return m_count" + n + " + m_values" + n + "[0];\n";
+    text += "    endfunction\n";
+    text += "    task run" + n + "();\n";
+    text += "      set" + n + "(m_data" + n + ");\n";
+    text += "      m_values" + n + "[1] = count" + n + "();\n";
+    text += "    endtask\n";
+    text += "  endclass\n";
+  }
+  const std::string last = std::to_string(classes - 1);
+  text += "endpackage\n";
+  text += "module top;\n  import bench_pkg::*;\n  c" + last + " obj;\n";
+  text += "  initial begin\n    obj = new;\n    obj.run" + last + "();\n  end\nendmodule\n";
+  return text;
+}
+}  // namespace
+
+int main(int argc, const char** argv) {
+  using namespace SURELOG;
+  const int32_t iterations = (argc > 1) ? std::atoi(argv[1]) : 5;
+  if (iterations <= 0) return 1;
+
+  const fs::path dir = fs::temp_directory_path() / "surelog_compiledesign_benchmark";
+  std::error_code ec;
+  fs::remove_all(dir, ec);
+  fs::create_directories(dir, ec);
+  const std::string outputDir = (dir / "out").string();
+
+  std::vector<std::string> args = {"surelog", "-nostdout", "-parse", "-nocache", "-o", outputDir};
+  if (argc > 2) {
+    for (int32_t i = 2; i < argc; ++i) args.emplace_back(argv[i]);
+  } else {
+    const fs::path sourceFile = dir / "bench.sv";
+    std::ofstream strm(sourceFile);
+    strm << makeSource(1000);
+    args.emplace_back(sourceFile.string());
+  }
+  std::vector<const char*> cargs;
+  for (const std::string& arg : args) cargs.emplace_back(arg.c_str());
+
+  double minMs = std::numeric_limits<double>::max();
+  double totalMs = 0;
+  for (int32_t i = 0; i < iterations; ++i) {
+    Session session;
+    session.parseCommandLine(static_cast<int32_t>(cargs.size()), cargs.data(), false, false);
+    Compiler compiler(&session);
+    const auto start = std::chrono::steady_clock::now();
+    const bool success = compiler.compile();
+    const auto end = std::chrono::steady_clock::now();
+    if (!success) {
+      std::cerr << "Compilation failed\n";
+      return 1;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    minMs = std::min(minMs, ms);
+    totalMs += ms;
+  }
+  fs::remove_all(dir, ec);
+
+  std::cout << iterations << " compilations\n"
+            << "  fastest: " << minMs << " ms\n"
+            << "  average: " << (totalMs / iterations) << " ms\n";
+  return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/DesignCompile/CompileDesign.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <uhdm/Serializer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/Design/Design.h"
+#include "Surelog/Design/FileContent.h"
+#include "Surelog/ErrorReporting/Error.h"
+#include "Surelog/ErrorReporting/ErrorContainer.h"
+#include "Surelog/ErrorReporting/ErrorDefinition.h"
+#include "Surelog/Package/Package.h"
+#include "Surelog/SourceCompile/Compiler.h"
+#include "Surelog/SourceCompile/ParserHarness.h"
+#include "Surelog/SourceCompile/VObjectTypes.h"
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+namespace {
+TEST(OrderPackagesTest, SkipsOccurrencesPastTheDefinitions) {
+  Session session;
+  ParserHarness harness(&session);
+  std::unique_ptr<FileContent> fC = harness.parse(
+      "package a; endpackage\n"
+      "package b; endpackage\n");
+  ASSERT_NE(fC, nullptr);
+  const std::vector<NodeId> declarations = fC->sl_collect_all(fC->getRootNode(), VObjectType::paPackage_declaration);
+  ASSERT_EQ(declarations.size(), 2);
+
+  uhdm::Serializer serializer;
+  Package* const a = new Package(&session, "a", nullptr, fC.get(), declarations[0], serializer);
+  Package* const b = new Package(&session, "b", nullptr, fC.get(), declarations[1], serializer);
+  {
+    // Owns the ordered packages
+    Design design(&session, serializer, nullptr, nullptr);
+    design.addPackageDefinition("a", a);
+    design.addPackageDefinition("b", b);
+    // As for a package found in two chunks, appended into one definition
+    design.addOrderedPackage("a");
+    design.addOrderedPackage("b");
+    design.addOrderedPackage("a");
+    design.addOrderedPackage("missing");
+    design.orderPackages();
+    EXPECT_THAT(design.getOrderedPackageDefinitions(), ElementsAre(a, b));
+
+    // Ordering again starts over
+    design.orderPackages();
+    EXPECT_THAT(design.getOrderedPackageDefinitions(), ElementsAre(a, b));
+  }
+}
+
+TEST(DesignDefinitionsTest, LookupsAndNameOrder) {
+  Session session;
+  ParserHarness harness(&session);
+  std::unique_ptr<FileContent> fC = harness.parse(
+      "package b; endpackage\n"
+      "package a; endpackage\n"
+      "package b; endpackage\n");
+  ASSERT_NE(fC, nullptr);
+  const std::vector<NodeId> declarations = fC->sl_collect_all(fC->getRootNode(), VObjectType::paPackage_declaration);
+  ASSERT_EQ(declarations.size(), 3);
+
+  uhdm::Serializer serializer;
+  Package* const b1 = new Package(&session, "b", nullptr, fC.get(), declarations[0], serializer);
+  Package* const a = new Package(&session, "a", nullptr, fC.get(), declarations[1], serializer);
+  Package* const b2 = new Package(&session, "b", nullptr, fC.get(), declarations[2], serializer);
+  {
+    Design design(&session, serializer, nullptr, nullptr);
+    EXPECT_EQ(design.addPackageDefinition("b", b1), b1);
+    EXPECT_EQ(design.addPackageDefinition("a", a), a);
+    // Not from a split file, kept as a second definition
+    EXPECT_EQ(design.addPackageDefinition("b", b2), b2);
+    EXPECT_EQ(design.getPackage("a"), a);
+    EXPECT_EQ(design.getPackage("b"), b1);
+    EXPECT_EQ(design.getPackage("c"), nullptr);
+    EXPECT_EQ(design.getPackage("a_name_never_seen"), nullptr);
+
+    std::vector<std::string_view> names;
+    std::vector<Package*> packages;
+    for (const auto& [name, definitions] : design.sortedByName(design.getPackageDefinitions())) {
+      names.emplace_back(name);
+      packages.insert(packages.end(), definitions.begin(), definitions.end());
+    }
+    EXPECT_THAT(names, ElementsAre("a", "b"));
+    EXPECT_THAT(packages, ElementsAre(a, b1, b2));
+
+    // Owns the ordered packages
+    design.addOrderedPackage("b");
+    design.addOrderedPackage("a");
+    design.addOrderedPackage("b");
+    design.orderPackages();
+    EXPECT_THAT(design.getOrderedPackageDefinitions(), ElementsAre(b1, a, b2));
+  }
+}
+
+class TopOnlyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_dir = fs::temp_directory_path() / "surelog_toponly_test";
+    std::error_code ec;
+    fs::remove_all(m_dir, ec);
+    fs::create_directories(m_dir, ec);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    fs::remove_all(m_dir, ec);
+  }
+
+  // Compiles text and the other files with -toponly -top top, returns the
+  // names of the modules and packages left in the design
+  std::vector<std::string> compile(std::string_view text, const std::vector<std::string_view>& otherTexts = {}) {
+    std::vector<std::string> sources;
+    for (size_t i = 0; i <= otherTexts.size(); ++i) {
+      const fs::path sourceFile = m_dir / ((i == 0) ? std::string("top.sv") : "other" + std::to_string(i) + ".sv");
+      std::ofstream strm(sourceFile);
+      strm << ((i == 0) ? text : otherTexts[i - 1]);
+      sources.emplace_back(sourceFile.string());
+    }
+    const std::string outputDir = (m_dir / "out").string();
+    std::vector<const char*> args = {"surelog",  "-nostdout", "-nobuiltin", "-nocache", "-parse",
+                                     "-toponly", "-top",      "top",        "-o",       outputDir.c_str()};
+    for (const std::string& source : sources) args.emplace_back(source.c_str());
+    Session session;
+    session.parseCommandLine(static_cast<int32_t>(args.size()), args.data(), false, false);
+    Compiler compiler(&session);
+    EXPECT_TRUE(compiler.compile());
+    for (const Error& error : session.getErrorContainer()->getErrors()) {
+      EXPECT_NE(error.getType(), ErrorDefinition::COMP_UNDEFINED_PACKAGE);
+    }
+
+    std::vector<std::string> names;
+    Design* const design = compiler.getDesign();
+    for (const auto& [name, module] : design->sortedByName(design->getModuleDefinitions())) names.emplace_back(name);
+    for (const auto& [name, packages] : design->sortedByName(design->getPackageDefinitions())) {
+      names.insert(names.end(), packages.size(), std::string(name));
+    }
+    return names;
+  }
+
+ protected:
+  fs::path m_dir;
+};
+
+TEST_F(TopOnlyTest, PrunesUnreachableModules) {
+  EXPECT_THAT(compile("package pkg; parameter int W = 4; endpackage\n"
+                      "package unused_pkg; endpackage\n"
+                      "module child(input logic [pkg::W-1:0] a);\n"
+                      "endmodule\n"
+                      "module unused;\n"
+                      "  child c(.a(4'h0));\n"
+                      "endmodule\n"
+                      "module top;\n"
+                      "  child c(.a(4'h1));\n"
+                      "endmodule\n"),
+              UnorderedElementsAre("work@top", "work@child", "pkg"));
+}
+
+TEST_F(TopOnlyTest, KeepsPackagesImportedInUnit) {
+  // other1.sv holds no reachable definition, its $unit import is still
+  // compiled
+  EXPECT_THAT(compile("module top;\n"
+                      "endmodule\n",
+                      {"package unit_pkg; parameter int W = 4; endpackage\n"
+                       "import unit_pkg::*;\n"
+                       "module unused;\n"
+                       "endmodule\n"}),
+              UnorderedElementsAre("work@top", "unit_pkg"));
+}
+}  // namespace
+}  // namespace SURELOG
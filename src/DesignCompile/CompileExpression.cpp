@@ -41,6 +41,7 @@
 #include "Surelog/Common/NodeId.h"
 #include "Surelog/Common/PathId.h"
 #include "Surelog/Common/Session.h"
+#include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/DataType.h"
 #include "Surelog/Design/Enum.h"
 #include "Surelog/Design/FileContent.h"
@@ -120,29 +121,85 @@ bool CompileHelper::substituteAssignedValue(const uhdm::Any *oper) {
   return substitute;
 }
 
+template <typename Collection, typename NameOf>
+void CompileHelper::indexNames_(NameIndex &index, const Collection &collection, NameOf nameOf) {
+  SymbolTable *const symbols = m_session->getSymbolTable();
+  for (uint32_t i = index.m_elements.size(), n = collection.size(); i < n; ++i) {
+    const std::string_view itemName = nameOf(collection[i]);
+    if (!itemName.empty()) index.m_positions.emplace(symbols->registerSymbol(itemName), i);
+    index.m_elements.emplace_back(collection[i]);
+  }
+}
+
+template <typename Collection, typename NameOf>
+int32_t CompileHelper::findName_(NameIndex &index, const Collection &collection, std::string_view name, SymbolId &id,
+                                 NameOf nameOf) {
+  const SymbolTable *const symbols = m_session->getSymbolTable();
+  const uint32_t size = collection.size();
+  if (size < index.m_elements.size()) {
+    index.m_elements.clear();
+    index.m_positions.clear();
+  }
+  if (size > index.m_elements.size()) {
+    indexNames_(index, collection, nameOf);
+    // The new names may include this one
+    if (id == BadSymbolId) id = symbols->getId(name);
+  }
+  if (id == BadSymbolId) return -1;
+  const uint32_t *position = index.m_positions.find(id);
+  if (position == nullptr) return -1;
+  // Still the first declaration unless an element up to it was replaced in
+  // place since it was indexed
+  if (std::equal(index.m_elements.cbegin(), index.m_elements.cbegin() + *position + 1, collection.begin())) {
+    return *position;
+  }
+  index.m_elements.clear();
+  index.m_positions.clear();
+  indexNames_(index, collection, nameOf);
+  position = index.m_positions.find(id);
+  return (position == nullptr) ? -1 : static_cast<int32_t>(*position);
+}
+
+static std::string_view getParamAssignName(const ParamAssign *pass) {
+  const uhdm::ParamAssign *const p = pass->getUhdmParamAssign();
+  return (p == nullptr) ? std::string_view() : p->getLhs()->getName();
+}
+
+uhdm::Any *CompileHelper::getParamAssignValue_(ComponentNames &names, const std::vector<ParamAssign *> &passigns,
+                                               std::string_view name, SymbolId &id) {
+  const int32_t position = findName_(names.m_paramAssigns, passigns, name, id, getParamAssignName);
+  if (position < 0) return nullptr;
+  // The next assignments of the name only matter when the first one is not substituted
+  for (uint32_t i = position, n = passigns.size(); i < n; ++i) {
+    if (getParamAssignName(passigns[i]) == name) {
+      uhdm::ParamAssign *const p = passigns[i]->getUhdmParamAssign();
+      if (substituteAssignedValue(p->getRhs())) return p->getRhs();
+    }
+  }
+  return nullptr;
+}
+
 uhdm::Any *CompileHelper::getObject(std::string_view name, DesignComponent *component, ValuedComponentI *instance,
                                     const uhdm::Any *pexpr) {
   Design *const design = m_compileDesign->getCompiler()->getDesign();
+  const auto nameOf = [](const auto *object) -> std::string_view { return object->getName(); };
+  // Not interned here, the indexes intern the names they find. Stays
+  // BadSymbolId until an index has the name.
+  SymbolId id = m_session->getSymbolTable()->getId(name);
   uhdm::Any *result = nullptr;
   while (pexpr) {
     if (const uhdm::Scope *s = any_cast<uhdm::Scope>(pexpr)) {
       if ((result == nullptr) && s->getVariables()) {
-        for (auto o : *s->getVariables()) {
-          if (o->getName() == name) {
-            result = o;
-            break;
-          }
-        }
+        const uhdm::VariableCollection &vars = *s->getVariables();
+        const int32_t position = findName_(m_scopeNames[s->getUhdmId()].m_variables, vars, name, id, nameOf);
+        if (position >= 0) result = vars[position];
       }
     }
     if (const uhdm::TaskFunc *s = any_cast<uhdm::TaskFunc>(pexpr)) {
       if ((result == nullptr) && s->getIODecls()) {
-        for (auto o : *s->getIODecls()) {
-          if (o->getName() == name) {
-            result = o;
-            break;
-          }
-        }
+        const uhdm::IODeclCollection &decls = *s->getIODecls();
+        const int32_t position = findName_(m_scopeNames[s->getUhdmId()].m_ioDecls, decls, name, id, nameOf);
+        if (position >= 0) result = decls[position];
       }
     }
     if (result) break;
@@ -150,10 +207,11 @@ uhdm::Any *CompileHelper::getObject(std::string_view name, DesignComponent *comp
   }
   if ((result == nullptr) && instance) {
     if (ModuleInstance *inst = valuedcomponenti_cast<ModuleInstance *>(instance)) {
+      const SymbolId valueId = instance->getValueId(name);
       while (inst) {
         if ((result == nullptr) || (result && (result->getUhdmType() != uhdm::UhdmType::Constant) &&
                                     (result->getUhdmType() != uhdm::UhdmType::ParamAssign))) {
-          if (uhdm::Expr *complex = instance->getComplexValue(name)) {
+          if (uhdm::Expr *complex = instance->getComplexValue(valueId)) {
             result = complex;
           }
         }
@@ -184,17 +242,8 @@ uhdm::Any *CompileHelper::getObject(std::string_view name, DesignComponent *comp
   }
   // Instance component or package component
   if ((result == nullptr) && component) {
-    for (ParamAssign *pass : component->getParamAssignVec()) {
-      if (uhdm::ParamAssign *p = pass->getUhdmParamAssign()) {
-        const std::string_view pname = p->getLhs()->getName();
-        if (pname == name) {
-          if (substituteAssignedValue(p->getRhs())) {
-            result = p->getRhs();
-            break;
-          }
-        }
-      }
-    }
+    ComponentNames &componentNames = m_componentNames[component];
+    result = getParamAssignValue_(componentNames, component->getParamAssignVec(), name, id);
     const DataType *dtype = component->getDataType(design, name);
     if ((result == nullptr) && dtype) {
       dtype = dtype->getActual();
@@ -202,19 +251,14 @@ uhdm::Any *CompileHelper::getObject(std::string_view name, DesignComponent *comp
     }
 
     Signal *sig = nullptr;
-    for (auto s : component->getPorts()) {
-      if (s->getName() == name) {
-        sig = s;
-        break;
-      }
-    }
-    if (sig == nullptr) {
-      for (auto s : component->getSignals()) {
-        if (s->getName() == name) {
-          sig = s;
-          break;
-        }
-      }
+    const std::vector<Signal *> &ports = component->getPorts();
+    const int32_t portPosition = findName_(componentNames.m_ports, ports, name, id, nameOf);
+    if (portPosition >= 0) {
+      sig = ports[portPosition];
+    } else {
+      const std::vector<Signal *> &signals = component->getSignals();
+      const int32_t signalPosition = findName_(componentNames.m_signals, signals, name, id, nameOf);
+      if (signalPosition >= 0) sig = signals[signalPosition];
     }
     if (sig) {
       if (sig->getTypespecId()) {
@@ -228,17 +272,7 @@ uhdm::Any *CompileHelper::getObject(std::string_view name, DesignComponent *comp
     if (ModuleInstance *inst = valuedcomponenti_cast<ModuleInstance *>(instance)) {
       // Instance component
       if (DesignComponent *comp = inst->getDefinition()) {
-        for (ParamAssign *pass : comp->getParamAssignVec()) {
-          if (uhdm::ParamAssign *p = pass->getUhdmParamAssign()) {
-            const std::string_view pname = p->getLhs()->getName();
-            if (pname == name) {
-              if (substituteAssignedValue(p->getRhs())) {
-                result = p->getRhs();
-                break;
-              }
-            }
-          }
-        }
+        result = getParamAssignValue_(m_componentNames[comp], comp->getParamAssignVec(), name, id);
 
         const DataType *dtype = comp->getDataType(design, name);
         if ((result == nullptr) && dtype) {
@@ -428,6 +462,7 @@ static bool largeInt(std::string_view str) {
 
 uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child, uhdm::Serializer &s,
                                             uhdm::Any *pscope) {
+  TypespecInterner *const interner = m_compileDesign->getTypespecInterner();
   VObjectType objtype = fC->Type(child);
   uhdm::Constant *result = nullptr;
   switch (objtype) {
@@ -469,7 +504,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
         } else {
           v = value;
           size = "";
-          tps = s.make<uhdm::LongIntTypespec>();
+          tps = interner->get(uhdm::UhdmType::LongIntTypespec, pscope);
         }
         v = StringUtils::replaceAll(v, "#", "");
         v = StringUtils::replaceAll(v, "_", "");
@@ -490,9 +525,9 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
             c->setConstType(vpiHexConst);
             if (!tps) {
               if (large) {
-                tps = s.make<uhdm::LongIntTypespec>();
+                tps = interner->get(uhdm::UhdmType::LongIntTypespec, pscope);
               } else {
-                tps = s.make<uhdm::IntTypespec>();
+                tps = interner->get(uhdm::UhdmType::IntTypespec, pscope);
               }
             }
             break;
@@ -500,7 +535,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
           case 'b':
           case 'B': {
             c->setConstType(vpiBinaryConst);
-            tps = s.make<uhdm::LogicTypespec>();
+            tps = interner->get(uhdm::UhdmType::LogicTypespec, pscope);
             break;
           }
           case 'o':
@@ -508,9 +543,9 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
             c->setConstType(vpiOctConst);
             if (!tps) {
               if (large) {
-                tps = s.make<uhdm::LongIntTypespec>();
+                tps = interner->get(uhdm::UhdmType::LongIntTypespec, pscope);
               } else {
-                tps = s.make<uhdm::IntTypespec>();
+                tps = interner->get(uhdm::UhdmType::IntTypespec, pscope);
               }
             }
             break;
@@ -520,20 +555,16 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
             c->setConstType(vpiDecConst);
             if (!tps) {
               if (large) {
-                uhdm::LongIntTypespec *t = s.make<uhdm::LongIntTypespec>();
-                t->setSigned(true);
-                tps = t;
+                tps = interner->get(uhdm::UhdmType::LongIntTypespec, pscope, true);
               } else {
-                uhdm::IntTypespec *t = s.make<uhdm::IntTypespec>();
-                t->setSigned(true);
-                tps = t;
+                tps = interner->get(uhdm::UhdmType::IntTypespec, pscope, true);
               }
             }
             break;
           }
           default: {
             c->setConstType(vpiBinaryConst);
-            tps = s.make<uhdm::LogicTypespec>();
+            tps = interner->get(uhdm::UhdmType::LogicTypespec, pscope);
             break;
           }
         }
@@ -543,13 +574,9 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
           c->setConstType(vpiIntConst);
           if (!tps) {
             if (large) {
-              uhdm::LongIntTypespec *t = s.make<uhdm::LongIntTypespec>();
-              t->setSigned(true);
-              tps = t;
+              tps = interner->get(uhdm::UhdmType::LongIntTypespec, pscope, true);
             } else {
-              uhdm::IntTypespec *t = s.make<uhdm::IntTypespec>();
-              t->setSigned(true);
-              tps = t;
+              tps = interner->get(uhdm::UhdmType::IntTypespec, pscope, true);
             }
           }
         } else {
@@ -557,19 +584,14 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
           v = StringUtils::replaceAll(v, "#", "");
           if (!tps) {
             if (large) {
-              uhdm::LongIntTypespec *t = s.make<uhdm::LongIntTypespec>();
-              t->setSigned(true);
-              tps = t;
+              tps = interner->get(uhdm::UhdmType::LongIntTypespec, pscope, true);
             } else {
-              uhdm::IntTypespec *t = s.make<uhdm::IntTypespec>();
-              t->setSigned(true);
-              tps = t;
+              tps = interner->get(uhdm::UhdmType::IntTypespec, pscope, true);
             }
           }
         }
         c->setSize(64);
       }
-      tps->setParent(pscope);
       rt->setActual(tps);
       c->setValue(v);
       result = c;
@@ -590,8 +612,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::RealTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::RealTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -617,8 +638,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::BitTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::BitTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -640,8 +660,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::BitTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::BitTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -661,8 +680,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::BitTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::BitTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -688,8 +706,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::BitTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::BitTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -712,8 +729,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::BitTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::BitTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -733,8 +749,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::BitTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::BitTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -754,8 +769,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::LogicTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::LogicTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -775,8 +789,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::LogicTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::LogicTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -803,8 +816,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::LogicTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::LogicTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -859,8 +871,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::TimeTypespec *tps = s.make<uhdm::TimeTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::TimeTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -882,8 +893,7 @@ uhdm::Constant *CompileHelper::compileConst(const FileContent *fC, NodeId child,
       c->setTypespec(rt);
       fC->populateCoreMembers(child, child, rt);
 
-      uhdm::Typespec *tps = s.make<uhdm::StringTypespec>();
-      tps->setParent(pscope);
+      uhdm::Typespec *tps = interner->get(uhdm::UhdmType::StringTypespec, pscope);
       rt->setActual(tps);
 
       result = c;
@@ -929,7 +939,8 @@ uhdm::Any *CompileHelper::getValue(std::string_view name, DesignComponent *compo
       const std::string_view packName = res[0];
       const std::string_view varName = res[1];
       if (Package *pack = design->getPackage(packName)) {
-        if (uhdm::Expr *val = pack->getComplexValue(varName)) {
+        const SymbolId varId = pack->getValueId(varName);
+        if (uhdm::Expr *val = pack->getComplexValue(varId)) {
           result = val;
           if (result && (result->getUhdmType() == uhdm::UhdmType::Operation)) {
             uhdm::Operation *op = (uhdm::Operation *)result;
@@ -946,7 +957,7 @@ uhdm::Any *CompileHelper::getValue(std::string_view name, DesignComponent *compo
           }
         }
         if (result == nullptr) {
-          if (Value *const sval = pack->getValue(varName)) {
+          if (Value *const sval = pack->getValue(varId)) {
             uhdm::Constant *c = constantFromValue(sval, pexpr);
             fC->populateCoreMembers(nodeId, nodeId, c->getTypespec());
             setRange(c, sval);
@@ -957,18 +968,19 @@ uhdm::Any *CompileHelper::getValue(std::string_view name, DesignComponent *compo
     }
   }
 
+  const SymbolId instanceId = (instance != nullptr) ? instance->getValueId(name) : BadSymbolId;
   if ((result == nullptr) && instance) {
-    if (uhdm::Expr *val = instance->getComplexValue(name)) {
+    if (uhdm::Expr *val = instance->getComplexValue(instanceId)) {
       result = val;
       if (result->getUhdmType() == uhdm::UhdmType::Constant) {
-        sval = instance->getValue(name);
+        sval = instance->getValue(instanceId);
         if (sval && sval->isValid()) {
           setRange((uhdm::Constant *)result, sval);
         }
       }
     }
     if (result == nullptr) {
-      sval = instance->getValue(name);
+      sval = instance->getValue(instanceId);
       if (sval && sval->isValid()) {
         uhdm::Constant *c = constantFromValue(sval, pexpr);
         fC->populateCoreMembers(nodeId, nodeId, c->getTypespec());
@@ -980,11 +992,11 @@ uhdm::Any *CompileHelper::getValue(std::string_view name, DesignComponent *compo
 
   if (result == nullptr) {
     if (instance) {
-      if (uhdm::Expr *val = instance->getComplexValue(name)) {
+      if (uhdm::Expr *val = instance->getComplexValue(instanceId)) {
         result = val;
       }
       if (result == nullptr) {
-        sval = instance->getValue(name);
+        sval = instance->getValue(instanceId);
         if (sval && sval->isValid()) {
           uhdm::Constant *c = constantFromValue(sval, pexpr);
           fC->populateCoreMembers(nodeId, nodeId, c->getTypespec());
@@ -996,11 +1008,12 @@ uhdm::Any *CompileHelper::getValue(std::string_view name, DesignComponent *compo
   }
 
   if (component && (result == nullptr)) {
-    if (uhdm::Expr *val = component->getComplexValue(name)) {
+    const SymbolId componentId = component->getValueId(name);
+    if (uhdm::Expr *val = component->getComplexValue(componentId)) {
       result = val;
     }
     if (result == nullptr) {
-      sval = component->getValue(name);
+      sval = component->getValue(componentId);
       if (sval && sval->isValid()) {
         uhdm::Constant *c = constantFromValue(sval, pexpr);
         fC->populateCoreMembers(nodeId, nodeId, c->getTypespec());
@@ -1046,7 +1059,7 @@ uhdm::Any *CompileHelper::getValue(std::string_view name, DesignComponent *compo
     }
   }
   if (component && (result == nullptr)) {
-    for (const auto &tp : component->getTypeDefMap()) {
+    for (const auto &tp : component->sortedByName(component->getTypeDefMap())) {
       TypeDef *tpd = tp.second;
       uhdm::Typespec *tps = tpd->getTypespec();
       if (tps && tps->getUhdmType() == uhdm::UhdmType::EnumTypespec) {
@@ -2358,18 +2371,9 @@ uhdm::Any *CompileHelper::compileExpression(DesignComponent *component, const Fi
             rt->setParent(c);
             c->setTypespec(rt);
 
-            uhdm::Typespec *ts = nullptr;
-            if (sval->getSize() > 32) {
-              uhdm::LongIntTypespec *lit = s.make<uhdm::LongIntTypespec>();
-              lit->setSigned(sval->isSigned());
-              ts = lit;
-            } else {
-              uhdm::IntTypespec *it = s.make<uhdm::IntTypespec>();
-              it->setSigned(sval->isSigned());
-              ts = it;
-            }
-            ts->setParent(pexpr);
-            rt->setActual(ts);
+            const uhdm::UhdmType tsType =
+                (sval->getSize() > 32) ? uhdm::UhdmType::LongIntTypespec : uhdm::UhdmType::IntTypespec;
+            rt->setActual(m_compileDesign->getTypespecInterner()->get(tsType, pexpr, sval->isSigned()));
 
             result = c;
           }
@@ -3195,13 +3199,13 @@ bool CompileHelper::errorOnNegativeConstant(DesignComponent *component, std::str
           std::cout << "Mod: " << inst->getModuleName() << " "
                     << fileSystem->toPath(component->getFileContents()[0]->getFileId()) << "\n";
 
-          for (const auto &ps : inst->getMappedValues()) {
-            const std::string &name = ps.first;
-            Value *val = ps.second.first;
+          for (const auto &ps : inst->getMappedValuesByName()) {
+            const std::string name(ps.first);
+            Value *val = ps.second->first;
             std::cout << std::string("    " + name + " = " + val->uhdmValue() + "\n");
           }
-          for (const auto &ps : inst->getComplexValues()) {
-            const std::string &name = ps.first;
+          for (std::string_view complexName : inst->getComplexValueNames()) {
+            const std::string name(complexName);
             std::cout << std::string("    " + name + " =  complex\n");
           }
           inst = inst->getParent();
@@ -17,15 +17,27 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
+#include "Surelog/CommandLine/CommandLineParser.h"
+#include "Surelog/Common/NodeId.h"
 #include "Surelog/Common/Session.h"
+#include "Surelog/Design/Design.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/ModuleDefinition.h"
+#include "Surelog/Design/ParamAssign.h"
 #include "Surelog/DesignCompile/CompileDesign.h"
 #include "Surelog/DesignCompile/CompileHelper.h"
 #include "Surelog/DesignCompile/CompilerHarness.h"
+#include "Surelog/SourceCompile/Compiler.h"
 #include "Surelog/SourceCompile/ParserHarness.h"
 #include "Surelog/SourceCompile/PreprocessHarness.h"
 #include "Surelog/SourceCompile/VObjectTypes.h"
@@ -34,9 +46,13 @@
 #include <uhdm/ExprEval.h>
 #include <uhdm/expr.h>
 #include <uhdm/module.h>
+#include <uhdm/uhdm.h>
+#include <uhdm/variable.h>
+#include <uhdm/vpi_user.h>
 
 namespace SURELOG {
 
+namespace fs = std::filesystem;
 using ::testing::ElementsAre;
 
 namespace {
@@ -201,5 +217,152 @@ TEST(CompileExpression, ExprFromPpTree) {
     }
   }
 }
+
+TEST(CompileExpression, GetObjectFromScopeVariables) {
+  Session session;
+  CompilerHarness charness(&session);
+  std::unique_ptr<CompileDesign> compileDesign = charness.createCompileDesign();
+  CompileHelper helper(&session, compileDesign.get());
+  uhdm::Serializer &serializer = compileDesign->getSerializer();
+  uhdm::Module *const module = serializer.make<uhdm::Module>();
+  uhdm::VariableCollection *const vars = module->getVariables(true);
+  for (std::string_view name : {"a", "b", "a"}) {
+    uhdm::Variable *const var = serializer.make<uhdm::Variable>();
+    var->setName(name);
+    vars->emplace_back(var);
+  }
+  // First declaration wins
+  EXPECT_EQ(helper.getObject("a", nullptr, nullptr, module), (*vars)[0]);
+  EXPECT_EQ(helper.getObject("b", nullptr, nullptr, module), (*vars)[1]);
+  EXPECT_EQ(helper.getObject("c", nullptr, nullptr, module), nullptr);
+
+  // Names declared after a lookup are found
+  uhdm::Variable *const c = serializer.make<uhdm::Variable>();
+  c->setName("c");
+  vars->emplace_back(c);
+  EXPECT_EQ(helper.getObject("c", nullptr, nullptr, module), c);
+}
+
+TEST(CompileExpression, GetObjectFromIODecls) {
+  Session session;
+  CompilerHarness charness(&session);
+  std::unique_ptr<CompileDesign> compileDesign = charness.createCompileDesign();
+  CompileHelper helper(&session, compileDesign.get());
+  uhdm::Serializer &serializer = compileDesign->getSerializer();
+  uhdm::Module *const module = serializer.make<uhdm::Module>();
+  uhdm::Variable *const m = serializer.make<uhdm::Variable>();
+  m->setName("m");
+  module->getVariables(true)->emplace_back(m);
+  uhdm::Function *const func = serializer.make<uhdm::Function>();
+  func->setParent(module);
+  uhdm::IODeclCollection *const decls = func->getIODecls(true);
+  for (std::string_view name : {"x", "y"}) {
+    uhdm::IODecl *const decl = serializer.make<uhdm::IODecl>();
+    decl->setName(name);
+    decls->emplace_back(decl);
+  }
+  EXPECT_EQ(helper.getObject("x", nullptr, nullptr, func), (*decls)[0]);
+  EXPECT_EQ(helper.getObject("y", nullptr, nullptr, func), (*decls)[1]);
+  // Then the enclosing scopes
+  EXPECT_EQ(helper.getObject("m", nullptr, nullptr, func), m);
+
+  // A declaration replaced in place ahead of a hit is the first one
+  uhdm::IODecl *const y = serializer.make<uhdm::IODecl>();
+  y->setName("y");
+  (*decls)[0] = y;
+  EXPECT_EQ(helper.getObject("y", nullptr, nullptr, func), y);
+  EXPECT_EQ(helper.getObject("x", nullptr, nullptr, func), nullptr);
+
+  // Names are indexed again once the declarations shrank
+  decls->pop_back();
+  EXPECT_EQ(helper.getObject("y", nullptr, nullptr, func), y);
+  decls->clear();
+  EXPECT_EQ(helper.getObject("y", nullptr, nullptr, func), nullptr);
+}
+
+TEST(CompileExpression, GetObjectFromParamAssigns) {
+  Session session;
+  session.getCommandLineParser()->setParametersSubstitution(false);
+  ParserHarness pharness(&session);
+  CompilerHarness charness(&session);
+  std::unique_ptr<CompileDesign> compileDesign = charness.createCompileDesign();
+  CompileHelper helper(&session, compileDesign.get());
+  uhdm::Serializer &serializer = compileDesign->getSerializer();
+  std::unique_ptr<FileContent> fC = pharness.parse("module top; endmodule");
+  ASSERT_NE(fC, nullptr);
+  const NodeId moduleId = fC->sl_collect(fC->getRootNode(), VObjectType::paModule_declaration);
+  ModuleDefinition module(&session, "work@top", fC.get(), moduleId, serializer);
+
+  const auto addParamAssign = [&](std::string_view name, uhdm::Expr *rhs) {
+    uhdm::Parameter *const param = serializer.make<uhdm::Parameter>();
+    param->setName(name);
+    uhdm::ParamAssign *const passign = serializer.make<uhdm::ParamAssign>();
+    passign->setLhs(param);
+    passign->setRhs(rhs);
+    ParamAssign *const assign = new ParamAssign(fC.get(), InvalidNodeId, InvalidNodeId, false, false);
+    assign->setUhdmParamAssign(passign);
+    module.addParamAssign(assign);
+  };
+  // Without parameter substitution, a concatenation is not substituted
+  const auto makeConcat = [&]() {
+    uhdm::Operation *const op = serializer.make<uhdm::Operation>();
+    op->setOpType(vpiConcatOp);
+    op->getOperands(true)->emplace_back(serializer.make<uhdm::Constant>());
+    return op;
+  };
+  uhdm::Constant *const p = serializer.make<uhdm::Constant>();
+  uhdm::Constant *const r = serializer.make<uhdm::Constant>();
+  addParamAssign("P", makeConcat());
+  addParamAssign("Q", makeConcat());
+  addParamAssign("R", r);
+  addParamAssign("P", p);
+  addParamAssign("R", makeConcat());
+
+  // The first substituted assignment of a name
+  EXPECT_EQ(helper.getObject("P", &module, nullptr, nullptr), p);
+  EXPECT_EQ(helper.getObject("Q", &module, nullptr, nullptr), nullptr);
+  EXPECT_EQ(helper.getObject("R", &module, nullptr, nullptr), r);
+  EXPECT_EQ(helper.getObject("S", &module, nullptr, nullptr), nullptr);
+
+  // Assignments added after a lookup are found
+  uhdm::Constant *const s = serializer.make<uhdm::Constant>();
+  addParamAssign("S", s);
+  EXPECT_EQ(helper.getObject("S", &module, nullptr, nullptr), s);
+}
+
+TEST(CompileExpression, GetObjectFromPortsAndSignals) {
+  const fs::path dir = fs::temp_directory_path() / "surelog_compileexpression_test";
+  std::error_code ec;
+  fs::remove_all(dir, ec);
+  fs::create_directories(dir, ec);
+  const std::string source = (dir / "top.sv").string();
+  {
+    std::ofstream strm(source);
+    strm << "module top(input logic [3:0] a);\n"
+            "  int b;\n"
+            "endmodule\n";
+  }
+  const std::string outputDir = (dir / "out").string();
+  const char *const args[] = {"surelog",      "-nostdout", "-nobuiltin",      "-nocache", "-parse",
+                              source.c_str(), "-o",        outputDir.c_str()};
+  Session session;
+  session.parseCommandLine(static_cast<int32_t>(std::size(args)), args, false, false);
+  Compiler compiler(&session);
+  ASSERT_TRUE(compiler.compile());
+  ModuleDefinition *const module = compiler.getDesign()->getModuleDefinition("work@top");
+  ASSERT_NE(module, nullptr);
+  CompileHelper helper(&session, compiler.getCompileDesign());
+
+  // A port, also listed with the signals
+  const uhdm::Any *const a = helper.getObject("a", module, nullptr, nullptr);
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(a->getUhdmType(), uhdm::UhdmType::LogicTypespec);
+  // A signal only
+  const uhdm::Any *const b = helper.getObject("b", module, nullptr, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(b->getUhdmType(), uhdm::UhdmType::IntTypespec);
+  EXPECT_EQ(helper.getObject("c", module, nullptr, nullptr), nullptr);
+  fs::remove_all(dir, ec);
+}
 }  // namespace
 }  // namespace SURELOG
@@ -44,6 +44,7 @@
 #include "Surelog/Design/VObject.h"
 #include "Surelog/Design/ValuedComponentI.h"
 #include "Surelog/DesignCompile/CompileDesign.h"
+#include "Surelog/DesignCompile/TypespecInterner.h"
 #include "Surelog/DesignCompile/UhdmWriter.h"
 #include "Surelog/ErrorReporting/ErrorContainer.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
@@ -147,6 +148,7 @@ bool CompileHelper::importPackage(DesignComponent* scope, Design* design, const
 
 uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
   uhdm::Serializer& s = m_compileDesign->getSerializer();
+  TypespecInterner* const interner = m_compileDesign->getTypespecInterner();
   Value::Type valueType = val->getType();
   uhdm::Constant* c = nullptr;
   uhdm::Typespec* tps = nullptr;
@@ -157,7 +159,7 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
       c->setValue(val->uhdmValue());
       c->setDecompile(val->decompiledValue());
       c->setSize(1);
-      tps = s.make<uhdm::LogicTypespec>();
+      tps = interner->get(uhdm::UhdmType::LogicTypespec, pexpr);
       break;
     }
     case Value::Type::Binary: {
@@ -166,7 +168,7 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
       c->setValue(val->uhdmValue());
       c->setDecompile(val->decompiledValue());
       c->setSize(val->getSize());
-      tps = s.make<uhdm::LogicTypespec>();
+      tps = interner->get(uhdm::UhdmType::LogicTypespec, pexpr);
       break;
     }
     case Value::Type::Hexadecimal: {
@@ -175,7 +177,7 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
       c->setValue(val->uhdmValue());
       c->setDecompile(val->decompiledValue());
       c->setSize(val->getSize());
-      tps = s.make<uhdm::IntTypespec>();
+      tps = interner->get(uhdm::UhdmType::IntTypespec, pexpr);
       break;
     }
     case Value::Type::Octal: {
@@ -184,7 +186,7 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
       c->setValue(val->uhdmValue());
       c->setDecompile(val->decompiledValue());
       c->setSize(val->getSize());
-      tps = s.make<uhdm::IntTypespec>();
+      tps = interner->get(uhdm::UhdmType::IntTypespec, pexpr);
       break;
     }
     case Value::Type::Unsigned:
@@ -193,14 +195,9 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
       c->setValue(val->uhdmValue());
       c->setDecompile(val->decompiledValue());
       c->setSize(val->getSize());
-      uhdm::IntTypespec* t = s.make<uhdm::IntTypespec>();
-      if (valueType == Value::Type::Integer) {
-        t->setSigned(true);
-        c->setConstType(vpiIntConst);
-      } else {
-        c->setConstType(vpiUIntConst);
-      }
-      tps = t;
+      const bool isSigned = (valueType == Value::Type::Integer);
+      c->setConstType(isSigned ? vpiIntConst : vpiUIntConst);
+      tps = interner->get(uhdm::UhdmType::IntTypespec, pexpr, isSigned);
       break;
     }
     case Value::Type::Double: {
@@ -209,7 +206,7 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
       c->setValue(val->uhdmValue());
       c->setDecompile(val->decompiledValue());
       c->setSize(val->getSize());
-      tps = s.make<uhdm::RealTypespec>();
+      tps = interner->get(uhdm::UhdmType::RealTypespec, pexpr);
       break;
     }
     case Value::Type::String: {
@@ -218,7 +215,7 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
       c->setValue(val->uhdmValue());
       c->setDecompile(val->decompiledValue());
       c->setSize(val->getSize());
-      tps = s.make<uhdm::StringTypespec>();
+      tps = interner->get(uhdm::UhdmType::StringTypespec, pexpr);
       break;
     }
     case Value::Type::None:
@@ -231,10 +228,7 @@ uhdm::Constant* CompileHelper::constantFromValue(Value* val, uhdm::Any* pexpr) {
     rt->setParent(c);
     c->setParent(pexpr);
     c->setTypespec(rt);
-    if (tps != nullptr) {
-      tps->setParent(pexpr);
-      rt->setActual(tps);
-    }
+    if (tps != nullptr) rt->setActual(tps);
   }
   return c;
 }
@@ -505,14 +499,6 @@ const DataType* CompileHelper::compileTypeDef(DesignComponent* scope, const File
       newTypeDef->setTypespec(typedefTypespec);
     }
 
-    if (scope) {
-      DesignComponent::DataTypeMap dmap = scope->getDataTypeMap();
-      DesignComponent::DataTypeMap::iterator itr = dmap.find(name);
-      if (itr != dmap.end()) {
-        dmap.erase(itr);
-      }
-    }
-
     type->setDefinition(newTypeDef);
     if (scope) scope->insertTypeDef(newTypeDef);
     newType = newTypeDef;
@@ -3529,7 +3515,7 @@ bool CompileHelper::compileParameterDeclaration(DesignComponent* component, cons
         if (fC->Type(Signage) == VObjectType::paSigning_Signed) isSigned = true;
         if (fC->Type(Signage) == VObjectType::paSigning_Unsigned) isSigned = false;
       }
-      if (ts != nullptr) uhdm::setSigned(ts, isSigned);
+      if (ts != nullptr) ts = m_compileDesign->getTypespecInterner()->setSigned(ts, isSigned);
 
       uhdm::Parameter* param = s.make<uhdm::Parameter>();
       param->setParent(pany);
@@ -3699,10 +3685,43 @@ std::string twosComplement(std::string_view bin) {
   return twos;
 }
 
+uhdm::Constant* CompileHelper::cloneConstant_(uhdm::Constant* c) {
+  uhdm::Serializer& s = m_compileDesign->getSerializer();
+  uhdm::RefTypespec* const rt = c->getTypespec();
+  uhdm::Typespec* const actual = (rt != nullptr) ? rt->getActual() : nullptr;
+  if (!m_compileDesign->getTypespecInterner()->isInterned(actual)) {
+    uhdm::Elaborator elaborator(&s, false, true);
+    return elaborator.clone<>(c, nullptr);
+  }
+
+  // The Elaborator would copy the shared typespec along
+  uhdm::Constant* const clone = s.make<uhdm::Constant>();
+  clone->setParent(c->getParent());
+  clone->setValue(c->getValue());
+  clone->setDecompile(c->getDecompile());
+  clone->setSize(c->getSize());
+  clone->setConstType(c->getConstType());
+  clone->setFile(c->getFile());
+  clone->setStartLine(c->getStartLine());
+  clone->setStartColumn(c->getStartColumn());
+  clone->setEndLine(c->getEndLine());
+  clone->setEndColumn(c->getEndColumn());
+
+  uhdm::RefTypespec* const crt = s.make<uhdm::RefTypespec>();
+  crt->setParent(clone);
+  crt->setActual(actual);
+  crt->setFile(rt->getFile());
+  crt->setStartLine(rt->getStartLine());
+  crt->setStartColumn(rt->getStartColumn());
+  crt->setEndLine(rt->getEndLine());
+  crt->setEndColumn(rt->getEndColumn());
+  clone->setTypespec(crt);
+  return clone;
+}
+
 uhdm::Constant* CompileHelper::adjustSize(const uhdm::Typespec* ts, DesignComponent* component, const FileContent* fC,
                                           NodeId nodeId, ValuedComponentI* instance, uhdm::Constant* c, bool uniquify,
                                           bool sizeMode) {
-  uhdm::Serializer& s = m_compileDesign->getSerializer();
   uhdm::Constant* result = c;
   if (ts == nullptr) {
     return result;
@@ -3727,8 +3746,7 @@ uhdm::Constant* CompileHelper::adjustSize(const uhdm::Typespec* ts, DesignCompon
     uint64_t uval = (uint64_t)val;
     uval = uval & mask;
     if (uniquify) {
-      uhdm::Elaborator elaborator(&s, false, true);
-      c = elaborator.clone<>(c, nullptr);
+      c = cloneConstant_(c);
       result = c;
     }
     c->setValue(std::to_string(uval));
@@ -3744,7 +3762,8 @@ uhdm::Constant* CompileHelper::adjustSize(const uhdm::Typespec* ts, DesignCompon
             constantIsSigned = true;
           }
           if (!signedLhs) {
-            itps->setSigned(false);
+            tstmp = m_compileDesign->getTypespecInterner()->setSigned(itps, false);
+            const_cast<uhdm::RefTypespec*>(tstmp_rt)->setActual(const_cast<uhdm::Typespec*>(tstmp));
           }
         }
         ts = tstmp;
@@ -3784,8 +3803,7 @@ uhdm::Constant* CompileHelper::adjustSize(const uhdm::Typespec* ts, DesignCompon
               val = std::strtoll(v.c_str(), nullptr, 2);
             }
             if (uniquify) {
-              uhdm::Elaborator elaborator(&s, false, true);
-              c = elaborator.clone<>(c, nullptr);
+              c = cloneConstant_(c);
               result = c;
             }
             c->setValue(std::to_string(val));
@@ -3794,8 +3812,7 @@ uhdm::Constant* CompileHelper::adjustSize(const uhdm::Typespec* ts, DesignCompon
           } else if ((orig_size == 1) && (val == 1)) {
             uint64_t mask = NumUtils::getMask(size);
             if (uniquify) {
-              uhdm::Elaborator elaborator(&s, false, true);
-              c = elaborator.clone<>(c, nullptr);
+              c = cloneConstant_(c);
               result = c;
             }
             c->setValue(std::to_string(mask));
@@ -3806,8 +3823,7 @@ uhdm::Constant* CompileHelper::adjustSize(const uhdm::Typespec* ts, DesignCompon
           if ((orig_size == -1) && (val == 1)) {
             uint64_t mask = NumUtils::getMask(size);
             if (uniquify) {
-              uhdm::Elaborator elaborator(&s, false, true);
-              c = elaborator.clone<>(c, nullptr);
+              c = cloneConstant_(c);
               result = c;
             }
             c->setValue(std::to_string(mask));
@@ -3823,8 +3839,7 @@ uhdm::Constant* CompileHelper::adjustSize(const uhdm::Typespec* ts, DesignCompon
       uint64_t uval = (uint64_t)val;
       if (uval == 1) {
         if (uniquify) {
-          uhdm::Elaborator elaborator(&s, false, true);
-          c = elaborator.clone<>(c, nullptr);
+          c = cloneConstant_(c);
           result = c;
         }
         if (size <= 64) {
@@ -4947,37 +4962,7 @@ void CompileHelper::setRange(uhdm::Constant* c, Value* val) {
     uhdm::RefTypespec* crt = s.make<uhdm::RefTypespec>();
     crt->setParent(c);
     c->setTypespec(crt);
-
-    uhdm::LogicTypespec* ts = s.make<uhdm::LogicTypespec>();
-    ts->setParent(c);
-    crt->setActual(ts);
-
-    uhdm::Range* r = s.make<uhdm::Range>();
-    r->setParent(ts);
-    ts->getRanges(true)->emplace_back(r);
-
-    uhdm::Constant* lc = s.make<uhdm::Constant>();
-    lc->setValue(std::to_string(lr));
-    r->setLeftExpr(lc);
-    lc->setConstType(vpiUIntConst);
-    lc->setSize(64);
-    uhdm::RefTypespec* lcrt = s.make<uhdm::RefTypespec>();
-    lcrt->setParent(lc);
-    lc->setTypespec(lcrt);
-
-    uhdm::Constant* rc = s.make<uhdm::Constant>();
-    rc->setValue(std::to_string(rr));
-    r->setRightExpr(rc);
-    rc->setConstType(vpiUIntConst);
-    rc->setSize(64);
-    uhdm::RefTypespec* rcrt = s.make<uhdm::RefTypespec>();
-    rcrt->setParent(lc);
-    rc->setTypespec(rcrt);
-
-    uhdm::IntTypespec* lts = s.make<uhdm::IntTypespec>();
-    lts->setParent(c);
-    lcrt->setActual(lts);
-    rcrt->setActual(lts);
+    crt->setActual(m_compileDesign->getTypespecInterner()->getRanged(lr, rr, c->getParent()));
   }
 }
 
@@ -39,6 +39,7 @@
 #include "Surelog/Design/ValuedComponentI.h"
 #include "Surelog/DesignCompile/CompileDesign.h"
 #include "Surelog/DesignCompile/CompileHelper.h"
+#include "Surelog/DesignCompile/TypespecInterner.h"
 #include "Surelog/DesignCompile/UhdmWriter.h"
 #include "Surelog/ErrorReporting/Error.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
@@ -454,7 +455,7 @@ uhdm::Any* CompileHelper::compileSignals(DesignComponent* component, Signal* sig
       dtype = dtype->getDefinition();
     }
   }
-  if (tps != nullptr) uhdm::setSigned(tps, sig->isSigned());
+  if (tps != nullptr) tps = m_compileDesign->getTypespecInterner()->setSigned(tps, sig->isSigned());
   obj = compileVariable(component, fC, signalId, subnettype, typespecId, tps, pscope);
   if (SimpleExpr* const se = any_cast<SimpleExpr>(obj)) {
     if (uhdm::AttributeCollection* const attributes = sig->attributes()) {
@@ -561,6 +562,8 @@ uhdm::Typespec* CompileHelper::compileTypeParameter(DesignComponent* component,
   }
 
   if (override_spec) {
+    // Re-parented below
+    override_spec = m_compileDesign->getTypespecInterner()->unshare(override_spec);
     if (type_param) {
       uhdm::TypeParameter* tparam = (uhdm::TypeParameter*)uparam;
       if (tparam->getTypespec() == nullptr) {
@@ -584,8 +587,16 @@ uhdm::Typespec* CompileHelper::compileTypeParameter(DesignComponent* component,
   return spec;
 }
 
+// Shared typespecs are immutable, only the others are cloned
+static const uhdm::Typespec* cloneTypespec(const uhdm::Typespec* typespec, TypespecInterner* interner,
+                                           uhdm::Serializer& s) {
+  if ((typespec == nullptr) || interner->isInterned(typespec)) return typespec;
+  uhdm::Elaborator elaborator(&s, false, true);
+  return elaborator.clone<>(typespec, nullptr);
+}
+
 const uhdm::Typespec* bindTypespec(Design* design, std::string_view name, SURELOG::ValuedComponentI* instance,
-                                   uhdm::Serializer& s) {
+                                   TypespecInterner* interner, uhdm::Serializer& s) {
   const uhdm::Typespec* result = nullptr;
   ModuleInstance* modInst = valuedcomponenti_cast<ModuleInstance*>(instance);
   while (modInst) {
@@ -597,8 +608,7 @@ const uhdm::Typespec* bindTypespec(Design* design, std::string_view name, SURELO
             if (const uhdm::RefTypespec* rt = tparam->getTypespec()) {
               result = rt->getActual();
             }
-            uhdm::Elaborator elaborator(&s, false, true);
-            result = elaborator.clone<>(result, nullptr);
+            result = cloneTypespec(result, interner, s);
           }
         }
         break;
@@ -612,16 +622,13 @@ const uhdm::Typespec* bindTypespec(Design* design, std::string_view name, SURELO
               if (const uhdm::RefTypespec* rt = tparam->getTypespec()) {
                 result = rt->getActual();
               }
-              uhdm::Elaborator elaborator(&s, false, true);
-              result = elaborator.clone<>(result, nullptr);
+              result = cloneTypespec(result, interner, s);
             }
           }
         }
         if (const DataType* dt = mod->getDataType(design, name)) {
           dt = dt->getActual();
-          result = dt->getTypespec();
-          uhdm::Elaborator elaborator(&s, false, true);
-          result = elaborator.clone<>(result, nullptr);
+          result = cloneTypespec(dt->getTypespec(), interner, s);
         }
       }
     }
@@ -817,6 +824,8 @@ uhdm::Typespec* CompileHelper::compileUpdatedTypespec(DesignComponent* component
   if (ts && (ts->getUhdmType() == uhdm::UhdmType::LogicTypespec)) {
     uhdm::LogicTypespec* lts = (uhdm::LogicTypespec*)ts;
     if ((packedDimensions != nullptr) && !packedDimensions->empty()) {
+      lts = (uhdm::LogicTypespec*)m_compileDesign->getTypespecInterner()->unshare(lts);
+      lts->setParent(pstmt);
       lts->setRanges(packedDimensions);
       for (uhdm::Range* r : *packedDimensions) r->setParent(lts, true);
     }
@@ -1183,7 +1192,7 @@ uhdm::Typespec* CompileHelper::compileTypespec(DesignComponent* component, const
       }
       if (instance) {
         const std::string_view name = fC->SymName(Name);
-        result = (uhdm::Typespec*)bindTypespec(design, name, instance, s);
+        result = (uhdm::Typespec*)bindTypespec(design, name, instance, m_compileDesign->getTypespecInterner(), s);
       }
       break;
     }
@@ -1600,11 +1609,12 @@ uhdm::Typespec* CompileHelper::compileTypespec(DesignComponent* component, const
       break;
   };
 
-  if (result != nullptr) {
+  TypespecInterner* const interner = m_compileDesign->getTypespecInterner();
+  if ((result != nullptr) && !interner->isInterned(result)) {
     result->setParent(pstmt);
   }
   result = compileUpdatedTypespec(component, fC, id, Packed_dimension, unpackedDimId, pstmt, result);
-  if (result != nullptr) {
+  if ((result != nullptr) && !interner->isInterned(result)) {
     result->setParent(pstmt);
   }
 
@@ -1201,7 +1201,7 @@ const uhdm::Any* ObjectBinder::find(std::string_view name, RefType refType, cons
     const auto& fileContents = dc->getFileContents();
     if (!fileContents.empty()) {
       if (const FileContent* const fC = fileContents.front()) {
-        for (const auto& td : fC->getTypeDefMap()) {
+        for (const auto& td : fC->sortedByName(fC->getTypeDefMap())) {
           const DataType* dt = td.second;
           while (dt != nullptr) {
             if (const uhdm::Typespec* const ts = dt->getTypespec()) {
@@ -195,8 +195,6 @@ void ResolveSymbols::createFastLookup() {
 
 VObject ResolveSymbols::Object(NodeId index) const { return m_fileContent->Object(index); }
 
-VObject* ResolveSymbols::MutableObject(NodeId index) { return m_fileContent->MutableObject(index); }
-
 NodeId ResolveSymbols::UniqueId(NodeId index) const { return m_fileContent->UniqueId(index); }
 
 SymbolId ResolveSymbols::Name(NodeId index) const { return m_fileContent->Name(index); }
@@ -209,7 +207,7 @@ NodeId ResolveSymbols::Definition(NodeId index) const { return m_fileContent->De
 
 bool ResolveSymbols::SetDefinition(NodeId index, NodeId def) {
   if (!index) return false;
-  MutableObject(index)->m_definition = def;
+  m_fileContent->SetDefinition(index, def);
   return true;
 }
 
@@ -219,7 +217,7 @@ VObjectType ResolveSymbols::Type(NodeId index) const { return m_fileContent->Typ
 
 bool ResolveSymbols::SetType(NodeId index, VObjectType type) {
   if (!index) return false;
-  MutableObject(index)->m_type = type;
+  m_fileContent->SetType(index, type);
   return true;
 }
 
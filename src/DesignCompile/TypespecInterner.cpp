@@ -0,0 +1,137 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/DesignCompile/TypespecInterner.h"
+
+// UHDM
+#include <uhdm/Serializer.h>
+#include <uhdm/Utils.h>
+#include <uhdm/sv_vpi_user.h>
+#include <uhdm/uhdm.h>
+#include <uhdm/vpi_user.h>
+
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace SURELOG {
+
+bool TypespecInterner::Key::operator<(const Key& rhs) const {
+  return std::tie(parent, type, isSigned, ranged, left, right) <
+         std::tie(rhs.parent, rhs.type, rhs.isSigned, rhs.ranged, rhs.left, rhs.right);
+}
+
+uhdm::Typespec* TypespecInterner::get(uhdm::UhdmType type, uhdm::Any* parent, bool isSigned) {
+  Key key;
+  key.parent = parent;
+  key.type = type;
+  key.isSigned = isSigned;
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  return intern_(key);
+}
+
+uhdm::Typespec* TypespecInterner::getRanged(uint16_t left, uint16_t right, uhdm::Any* parent, bool isSigned) {
+  Key key;
+  key.parent = parent;
+  key.type = uhdm::UhdmType::LogicTypespec;
+  key.isSigned = isSigned;
+  key.ranged = true;
+  key.left = left;
+  key.right = right;
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  return intern_(key);
+}
+
+uhdm::Typespec* TypespecInterner::intern_(const Key& key) {
+  auto [itr, inserted] = m_typespecs.emplace(key, nullptr);
+  if (!inserted) return itr->second;
+
+  uhdm::Typespec* const typespec = make_(key);
+  if (typespec == nullptr) {
+    m_typespecs.erase(itr);
+    return nullptr;
+  }
+  typespec->setParent(key.parent);
+  itr->second = typespec;
+  m_interned.emplace(typespec, key);
+  return typespec;
+}
+
+uhdm::Typespec* TypespecInterner::make_(const Key& key) {
+  uhdm::Typespec* typespec = nullptr;
+  switch (key.type) {
+    case uhdm::UhdmType::BitTypespec: typespec = m_serializer.make<uhdm::BitTypespec>(); break;
+    case uhdm::UhdmType::IntTypespec: typespec = m_serializer.make<uhdm::IntTypespec>(); break;
+    case uhdm::UhdmType::LogicTypespec: typespec = m_serializer.make<uhdm::LogicTypespec>(); break;
+    case uhdm::UhdmType::LongIntTypespec: typespec = m_serializer.make<uhdm::LongIntTypespec>(); break;
+    case uhdm::UhdmType::RealTypespec: typespec = m_serializer.make<uhdm::RealTypespec>(); break;
+    case uhdm::UhdmType::StringTypespec: typespec = m_serializer.make<uhdm::StringTypespec>(); break;
+    case uhdm::UhdmType::TimeTypespec: typespec = m_serializer.make<uhdm::TimeTypespec>(); break;
+    default: return nullptr;
+  }
+  if (key.isSigned) uhdm::setSigned(typespec, true);
+  if (!key.ranged) return typespec;
+
+  uhdm::LogicTypespec* const lts = static_cast<uhdm::LogicTypespec*>(typespec);
+  uhdm::Range* const r = m_serializer.make<uhdm::Range>();
+  r->setParent(lts);
+  lts->getRanges(true)->emplace_back(r);
+
+  // The bounds share the unsigned int typespec of the scope
+  Key boundKey;
+  boundKey.parent = key.parent;
+  uhdm::Typespec* const boundTypespec = intern_(boundKey);
+  auto makeBound = [&](uint16_t bound) {
+    uhdm::Constant* const c = m_serializer.make<uhdm::Constant>();
+    c->setParent(r);
+    c->setValue(std::to_string(bound));
+    c->setConstType(vpiUIntConst);
+    c->setSize(64);
+    uhdm::RefTypespec* const rt = m_serializer.make<uhdm::RefTypespec>();
+    rt->setParent(c);
+    rt->setActual(boundTypespec);
+    c->setTypespec(rt);
+    return c;
+  };
+  r->setLeftExpr(makeBound(key.left));
+  r->setRightExpr(makeBound(key.right));
+  return typespec;
+}
+
+uhdm::Typespec* TypespecInterner::setSigned(uhdm::Typespec* typespec, bool isSigned) {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  if (auto itr = m_interned.find(typespec); itr != m_interned.end()) {
+    Key key = itr->second;
+    key.isSigned = isSigned;
+    return intern_(key);
+  }
+  uhdm::setSigned(typespec, isSigned);
+  return typespec;
+}
+
+uhdm::Typespec* TypespecInterner::unshare(uhdm::Typespec* typespec) {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  auto itr = m_interned.find(typespec);
+  if (itr == m_interned.end()) return typespec;
+  return make_(itr->second);
+}
+
+bool TypespecInterner::isInterned(const uhdm::Typespec* typespec) const {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  return m_interned.find(typespec) != m_interned.end();
+}
+
+}  // namespace SURELOG
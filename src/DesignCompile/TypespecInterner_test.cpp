@@ -0,0 +1,129 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/DesignCompile/TypespecInterner.h"
+
+#include <gtest/gtest.h>
+#include <uhdm/Serializer.h>
+#include <uhdm/Utils.h>
+#include <uhdm/uhdm.h>
+
+namespace SURELOG {
+
+namespace {
+TEST(TypespecInternerTest, SharesLeafTypespecsPerScope) {
+  uhdm::Serializer s;
+  uhdm::Module* const module = s.make<uhdm::Module>();
+  TypespecInterner interner(s);
+
+  uhdm::Typespec* const signedInt = interner.get(uhdm::UhdmType::IntTypespec, module, true);
+  ASSERT_NE(signedInt, nullptr);
+  EXPECT_EQ(signedInt, interner.get(uhdm::UhdmType::IntTypespec, module, true));
+  EXPECT_EQ(signedInt->getParent(), module);
+  EXPECT_TRUE(uhdm::getSigned(signedInt));
+  EXPECT_TRUE(interner.isInterned(signedInt));
+
+  uhdm::Typespec* const unsignedInt = interner.get(uhdm::UhdmType::IntTypespec, module);
+  EXPECT_NE(signedInt, unsignedInt);
+  EXPECT_NE(signedInt, interner.get(uhdm::UhdmType::LogicTypespec, module));
+
+  // Each scope has typespecs of its own
+  uhdm::Module* const other = s.make<uhdm::Module>();
+  uhdm::Typespec* const otherInt = interner.get(uhdm::UhdmType::IntTypespec, other, true);
+  EXPECT_NE(signedInt, otherInt);
+  EXPECT_EQ(otherInt->getParent(), other);
+
+  // Typespecs with a shape of their own are not interned
+  EXPECT_EQ(interner.get(uhdm::UhdmType::ArrayTypespec, module), nullptr);
+  EXPECT_EQ(interner.get(uhdm::UhdmType::ArrayTypespec, module), nullptr);
+}
+
+TEST(TypespecInternerTest, SharesConstantRanges) {
+  uhdm::Serializer s;
+  uhdm::Module* const module = s.make<uhdm::Module>();
+  TypespecInterner interner(s);
+
+  uhdm::Typespec* const word = interner.getRanged(31, 0, module);
+  ASSERT_NE(word, nullptr);
+  EXPECT_EQ(word, interner.getRanged(31, 0, module));
+  EXPECT_NE(word, interner.getRanged(7, 0, module));
+  EXPECT_NE(word, interner.get(uhdm::UhdmType::LogicTypespec, module));
+  EXPECT_EQ(word->getParent(), module);
+  EXPECT_TRUE(interner.isInterned(word));
+
+  const uhdm::LogicTypespec* const lts = uhdm::any_cast<uhdm::LogicTypespec>(word);
+  ASSERT_NE(lts, nullptr);
+  ASSERT_NE(lts->getRanges(), nullptr);
+  ASSERT_EQ(lts->getRanges()->size(), 1U);
+  const uhdm::Range* const r = lts->getRanges()->front();
+  const uhdm::Constant* const left = uhdm::any_cast<uhdm::Constant>(r->getLeftExpr());
+  const uhdm::Constant* const right = uhdm::any_cast<uhdm::Constant>(r->getRightExpr());
+  ASSERT_NE(left, nullptr);
+  ASSERT_NE(right, nullptr);
+  EXPECT_EQ(left->getValue(), "31");
+  EXPECT_EQ(right->getValue(), "0");
+  // The bounds share the int typespec of the scope
+  EXPECT_EQ(left->getTypespec()->getActual(), interner.get(uhdm::UhdmType::IntTypespec, module));
+  EXPECT_EQ(right->getTypespec()->getActual(), left->getTypespec()->getActual());
+
+  // Switching the signedness keeps the range
+  uhdm::Typespec* const signedWord = interner.setSigned(word, true);
+  EXPECT_EQ(signedWord, interner.getRanged(31, 0, module, true));
+  EXPECT_NE(signedWord, word);
+}
+
+TEST(TypespecInternerTest, SetSignedLeavesSharedTypespecsUntouched) {
+  uhdm::Serializer s;
+  uhdm::Module* const module = s.make<uhdm::Module>();
+  TypespecInterner interner(s);
+
+  uhdm::Typespec* const signedInt = interner.get(uhdm::UhdmType::IntTypespec, module, true);
+  EXPECT_EQ(interner.setSigned(signedInt, false), interner.get(uhdm::UhdmType::IntTypespec, module));
+  EXPECT_TRUE(uhdm::getSigned(signedInt));
+
+  uhdm::IntTypespec* const owned = s.make<uhdm::IntTypespec>();
+  EXPECT_EQ(interner.setSigned(owned, true), owned);
+  EXPECT_TRUE(owned->getSigned());
+  EXPECT_FALSE(interner.isInterned(owned));
+}
+
+TEST(TypespecInternerTest, UnshareCopiesSharedTypespecs) {
+  uhdm::Serializer s;
+  uhdm::Module* const module = s.make<uhdm::Module>();
+  TypespecInterner interner(s);
+
+  uhdm::Typespec* const signedInt = interner.get(uhdm::UhdmType::IntTypespec, module, true);
+  uhdm::Typespec* const copy = interner.unshare(signedInt);
+  ASSERT_NE(copy, nullptr);
+  EXPECT_NE(copy, signedInt);
+  EXPECT_EQ(copy->getUhdmType(), uhdm::UhdmType::IntTypespec);
+  EXPECT_TRUE(uhdm::getSigned(copy));
+  EXPECT_FALSE(interner.isInterned(copy));
+  EXPECT_EQ(copy->getParent(), nullptr);
+  EXPECT_EQ(signedInt->getParent(), module);
+
+  // A private typespec is modified in place
+  EXPECT_EQ(interner.unshare(copy), copy);
+
+  // The copy of a ranged typespec has a range of its own
+  uhdm::Typespec* const word = interner.getRanged(31, 0, module);
+  const uhdm::LogicTypespec* const wordCopy = uhdm::any_cast<uhdm::LogicTypespec>(interner.unshare(word));
+  ASSERT_NE(wordCopy, nullptr);
+  ASSERT_NE(wordCopy->getRanges(), nullptr);
+  EXPECT_NE(wordCopy->getRanges()->front(), uhdm::any_cast<uhdm::LogicTypespec>(word)->getRanges()->front());
+}
+}  // namespace
+}  // namespace SURELOG
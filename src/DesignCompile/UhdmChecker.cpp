@@ -599,10 +599,11 @@ bool UhdmChecker::check(PathId uhdmFileId) {
   for (ModuleInstance* top : m_design->getTopLevelModuleInstances()) {
     collectUsedFileContents(files, moduleNames, top);
   }
-  for (const auto& packInfo : m_design->getPackageDefinitions()) {
-    Package* pack = packInfo.second;
-    for (auto file : pack->getFileContents()) {
-      if (file) files.insert(file);
+  for (const auto& [id, packages] : m_design->getPackageDefinitions()) {
+    for (Package* pack : packages) {
+      for (auto file : pack->getFileContents()) {
+        if (file) files.insert(file);
+      }
     }
   }
 
@@ -28,6 +28,7 @@
 #include <uhdm/import_typespec.h>
 #include <uhdm/uhdm_types.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
 #include <iostream>
@@ -35,6 +36,8 @@
 #include <queue>
 #include <set>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -66,6 +69,7 @@
 #include "Surelog/Testbench/Program.h"
 #include "Surelog/Testbench/Variable.h"
 #include "Surelog/Utils/StringUtils.h"
+#include "Surelog/Utils/Tracer.h"
 
 // UHDM
 #include <uhdm/ExprEval.h>
@@ -430,11 +434,11 @@ void UhdmWriter::writePorts(const std::vector<Signal*>& orig_ports, uhdm::BaseCl
   }
 }
 
-void UhdmWriter::writeDataTypes(const DesignComponent::DataTypeMap& datatypeMap, uhdm::BaseClass* parent,
+void UhdmWriter::writeDataTypes(const DesignComponent* component, uhdm::BaseClass* parent,
                                 uhdm::TypespecCollection* dest_typespecs, uhdm::Serializer& s, bool setParent) {
   std::set<uint64_t> ids;
   for (const uhdm::Typespec* t : *dest_typespecs) ids.emplace(t->getUhdmId());
-  for (const auto& entry : datatypeMap) {
+  for (const auto& entry : component->sortedByName(component->getDataTypeMap())) {
     const DataType* dtype = entry.second;
     if (dtype->getCategory() == DataType::Category::REF) {
       dtype = dtype->getDefinition();
@@ -571,7 +575,7 @@ void UhdmWriter::writeClass(ClassDefinition* classDef, uhdm::Serializer& s, uhdm
 
     // Typepecs
     uhdm::TypespecCollection* typespecs = c->getTypespecs(true);
-    writeDataTypes(classDef->getDataTypeMap(), c, typespecs, s, true);
+    writeDataTypes(classDef, c, typespecs, s, true);
 
     // Variables
     // Already bound in TestbenchElaboration
@@ -642,9 +646,8 @@ void UhdmWriter::writeClasses(ClassNameClassDefinitionMultiMap& orig_classes, uh
   }
 }
 
-void UhdmWriter::writeVariables(const DesignComponent::VariableMap& orig_vars, uhdm::BaseClass* parent,
-                                uhdm::Serializer& s) {
-  for (auto& orig_var : orig_vars) {
+void UhdmWriter::writeVariables(const DesignComponent* component, uhdm::BaseClass* parent, uhdm::Serializer& s) {
+  for (const auto& orig_var : component->sortedByName(component->getVariables())) {
     Variable* var = orig_var.second;
     const DataType* dtype = var->getDataType();
     const ClassDefinition* classdef = datatype_cast<ClassDefinition>(dtype);
@@ -823,7 +826,7 @@ void UhdmWriter::writeModule(ModuleDefinition* mod, uhdm::Module* m, uhdm::Seria
 
   // Let decls
   if (!mod->getLetStmts().empty()) {
-    for (auto& stmt : mod->getLetStmts()) {
+    for (const auto& stmt : mod->sortedByName(mod->getLetStmts())) {
       const_cast<uhdm::LetDecl*>(stmt.second->getDecl())->setParent(m);
     }
   }
@@ -959,7 +962,7 @@ void UhdmWriter::writeInterface(ModuleDefinition* mod, uhdm::Interface* m, uhdm:
   // Let decls
   if (!mod->getLetStmts().empty()) {
     uhdm::LetDeclCollection* decls = m->getLetDecls(true);
-    for (auto stmt : mod->getLetStmts()) {
+    for (const auto& stmt : mod->sortedByName(mod->getLetStmts())) {
       decls->emplace_back((uhdm::LetDecl*)stmt.second->getDecl());
     }
   }
@@ -982,7 +985,7 @@ void UhdmWriter::writeInterface(ModuleDefinition* mod, uhdm::Interface* m, uhdm:
 
   // Typepecs
   uhdm::TypespecCollection* typespecs = m->getTypespecs(true);
-  writeDataTypes(mod->getDataTypeMap(), m, typespecs, s, true);
+  writeDataTypes(mod, m, typespecs, s, true);
 
   // Ports
   const std::vector<Signal*>& orig_ports = mod->getPorts();
@@ -1064,7 +1067,7 @@ void UhdmWriter::writeProgram(Program* mod, uhdm::Program* m, uhdm::Serializer&
 
   // Typepecs
   uhdm::TypespecCollection* typespecs = m->getTypespecs(true);
-  writeDataTypes(mod->getDataTypeMap(), m, typespecs, s, true);
+  writeDataTypes(mod, m, typespecs, s, true);
 
   // Ports
   const std::vector<Signal*>& orig_ports = mod->getPorts();
@@ -1087,8 +1090,7 @@ void UhdmWriter::writeProgram(Program* mod, uhdm::Program* m, uhdm::Serializer&
   writeClasses(orig_classes, s, m);
 
   // Variables
-  const DesignComponent::VariableMap& orig_vars = mod->getVariables();
-  writeVariables(orig_vars, m, s);
+  writeVariables(mod, m, s);
 
   // Cont assigns
   if (mod->getContAssigns()) {
@@ -1264,13 +1266,18 @@ bool UhdmWriter::write(PathId uhdmFileId) {
   errors->addError(err);
   errors->printMessages(clp->muteStdout());
 
+  Tracer* const tracer = m_session->getTracer();
+
   // Compute list of design components that are part of the instance tree
   std::set<DesignComponent*> designComponents;
   {
+    Tracer::Span span(tracer, "uhdm", "Collect design components");
     std::queue<ModuleInstance*> queue;
-    for (const auto& pack : m_design->getPackageDefinitions()) {
-      if (!pack.second->getFileContents().empty()) {
-        if (pack.second->getFileContents()[0] != nullptr) designComponents.insert(pack.second);
+    for (const auto& [id, packages] : m_design->getPackageDefinitions()) {
+      for (Package* pack : packages) {
+        if (!pack->getFileContents().empty()) {
+          if (pack->getFileContents()[0] != nullptr) designComponents.insert(pack);
+        }
       }
     }
     for (auto instance : m_design->getTopLevelModuleInstances()) {
@@ -1311,17 +1318,15 @@ bool UhdmWriter::write(PathId uhdmFileId) {
 
     // Packages
     SURELOG::PackageDefinitionVec packages = m_design->getOrderedPackageDefinitions();
-    for (auto& pack : m_design->getPackageDefinitions()) {
-      if (pack.first == "builtin") {
-        pack.second->getUhdmModel()->setParent(d);
-        if (Typespec* const ts = pack.second->getUhdmTypespecModel()) {
-          ts->setParent(d);
-        }
-        if (pack.second) packages.insert(packages.begin(), pack.second);
-        break;
+    if (Package* const builtin = m_design->getPackage("builtin")) {
+      builtin->getUhdmModel()->setParent(d);
+      if (Typespec* const ts = builtin->getUhdmTypespecModel()) {
+        ts->setParent(d);
       }
+      packages.insert(packages.begin(), builtin);
     }
 
+    Tracer::Span packagesSpan(tracer, "uhdm", "Write packages");
     for (Package* pack : packages) {
       if (!pack) continue;
       if (!pack->getFileContents().empty() && pack->getType() == VObjectType::paPackage_declaration) {
@@ -1347,8 +1352,11 @@ bool UhdmWriter::write(PathId uhdmFileId) {
       }
     }
 
+    packagesSpan.end();
+
     // Programs
-    const auto& programs = m_design->getProgramDefinitions();
+    Tracer::Span programsSpan(tracer, "uhdm", "Write programs");
+    const auto programs = m_design->sortedByName(m_design->getProgramDefinitions());
     for (const auto& progNamePair : programs) {
       Program* prog = progNamePair.second;
       if (!prog->getFileContents().empty() && prog->getType() == VObjectType::paProgram_declaration) {
@@ -1372,8 +1380,11 @@ bool UhdmWriter::write(PathId uhdmFileId) {
       }
     }
 
+    programsSpan.end();
+
     // Interfaces
-    const auto& modules = m_design->getModuleDefinitions();
+    Tracer::Span interfacesSpan(tracer, "uhdm", "Write interfaces");
+    const auto modules = m_design->sortedByName(m_design->getModuleDefinitions());
     for (const auto& modNamePair : modules) {
       ModuleDefinition* mod = modNamePair.second;
       if (mod->getFileContents().empty()) {
@@ -1399,7 +1410,10 @@ bool UhdmWriter::write(PathId uhdmFileId) {
       }
     }
 
+    interfacesSpan.end();
+
     // Modules & Udps
+    Tracer::Span modulesSpan(tracer, "uhdm", "Write modules");
     for (const auto& modNamePair : modules) {
       ModuleDefinition* mod = modNamePair.second;
       if (mod->getFileContents().empty()) {
@@ -1474,8 +1488,11 @@ bool UhdmWriter::write(PathId uhdmFileId) {
       }
     }
 
+    modulesSpan.end();
+
     // Classes
-    const auto& classes = m_design->getClassDefinitions();
+    Tracer::Span classesSpan(tracer, "uhdm", "Write classes");
+    const auto classes = m_design->sortedByName(m_design->getClassDefinitions());
     for (const auto& classNamePair : classes) {
       ClassDefinition* classDef = classNamePair.second;
       if (!classDef->getFileContents().empty() && classDef->getType() == VObjectType::paClass_declaration) {
@@ -1490,7 +1507,9 @@ bool UhdmWriter::write(PathId uhdmFileId) {
     s.printStats(std::cerr, "Non-Elaborated Model");
   }
 
+  Tracer::Span bindSpan(tracer, "uhdm", "Bind");
   bind(s, designs);
+  bindSpan.end();
 
   // Purge obsolete typespecs
   for (auto o : m_compileDesign->getSwapedObjects()) {
@@ -1499,49 +1518,74 @@ bool UhdmWriter::write(PathId uhdmFileId) {
     if (tps != orig) s.erase(orig);
   }
 
+  // Binding and typespec purging above are the last mutations of the model.
+  // From here on the serializer is frozen: the integrity checker and the debug
+  // visitor only read the model, so they can overlap with the save. Garbage
+  // collection deletes unreachable objects while saving, and the checker
+  // follows parent links into them, so that combination stays sequential.
+  auto checkModel = [&]() {
+    Tracer::Span checkSpan(tracer, "uhdm", "Check model");
+    if (IntegrityChecker* const checker = new IntegrityChecker(m_session)) {
+      for (auto h : designs) {
+        const uhdm::Design* const d = UhdmDesignFromVpiHandle(h);
+        checker->check(d);
+      }
+
+      delete checker;
+      errors->printMessages(clp->muteStdout());
+    }
+
+    // if (clp->getDebugUhdm() || clp->getCoverUhdm()) {
+    //   // Check before restore
+    //   Location loc(fileSystem->getCheckerHtmlFile(uhdmFileId, symbols));
+    //   Error err(ErrorDefinition::UHDM_WRITE_HTML_COVERAGE, loc);
+    //   errors->addError(err);
+    //   errors->printMessages(clp->muteStdout());
+    //
+    //   if (UhdmChecker* uhdmchecker =
+    //           new UhdmChecker(m_session, m_compileDesign, m_design)) {
+    //     uhdmchecker->check(uhdmFileId);
+    //     delete uhdmchecker;
+    //   }
+    // }
+
+    if (clp->getDebugUhdm()) {
+      Location loc(symbols->registerSymbol("in-memory uhdm"));
+      Error err2(ErrorDefinition::UHDM_VISITOR, loc);
+      errors->addError(err2);
+      errors->printMessages(clp->muteStdout());
+      std::cout << "====== UHDM =======\n";
+      vpi_show_ids(clp->showVpiIds());
+      visit_designs(designs, std::cout);
+      std::cout << "===================\n";
+    }
+  };
+
   const fs::path uhdmFile = fileSystem->toPlatformAbsPath(uhdmFileId);
   if (clp->writeUhdm()) {
     Error err(ErrorDefinition::UHDM_WRITE_DB, loc);
     errors->addError(err);
     errors->printMessages(clp->muteStdout());
     s.setGCEnabled(clp->gc());
-    s.save(uhdmFile);
-  }
-
-  if (IntegrityChecker* const checker = new IntegrityChecker(m_session)) {
-    for (auto h : designs) {
-      const uhdm::Design* const d = UhdmDesignFromVpiHandle(h);
-      checker->check(d);
+    if (clp->gc() || (clp->getMaxTreads() == 0)) {
+      {
+        Tracer::Span saveSpan(tracer, "uhdm", "Save");
+        s.save(uhdmFile);
+      }
+      checkModel();
+    } else {
+      // The checker thread owns the error container until it is joined
+      std::thread checkerThread(checkModel);
+      {
+        Tracer::Span saveSpan(tracer, "uhdm", "Save");
+        s.save(uhdmFile);
+      }
+      checkerThread.join();
     }
-
-    delete checker;
-    errors->printMessages(clp->muteStdout());
+  } else {
+    checkModel();
   }
 
-  // if (clp->getDebugUhdm() || clp->getCoverUhdm()) {
-  //   // Check before restore
-  //   Location loc(fileSystem->getCheckerHtmlFile(uhdmFileId, symbols));
-  //   Error err(ErrorDefinition::UHDM_WRITE_HTML_COVERAGE, loc);
-  //   errors->addError(err);
-  //   errors->printMessages(clp->muteStdout());
-  //
-  //   if (UhdmChecker* uhdmchecker =
-  //           new UhdmChecker(m_session, m_compileDesign, m_design)) {
-  //     uhdmchecker->check(uhdmFileId);
-  //     delete uhdmchecker;
-  //   }
-  // }
-
-  if (clp->getDebugUhdm()) {
-    Location loc(symbols->registerSymbol("in-memory uhdm"));
-    Error err2(ErrorDefinition::UHDM_VISITOR, loc);
-    errors->addError(err2);
-    errors->printMessages(clp->muteStdout());
-    std::cout << "====== UHDM =======\n";
-    vpi_show_ids(clp->showVpiIds());
-    visit_designs(designs, std::cout);
-    std::cout << "===================\n";
-  }
   errors->printMessages(clp->muteStdout());
   for (vpiHandle vh : designs) vpi_release_handle(vh);
   designs.clear();
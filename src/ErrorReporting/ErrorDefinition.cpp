@@ -157,6 +157,10 @@ bool ErrorDefinition::init() {
   rec(CMD_WD_MISSING_DIR, WARNING, CMD, "Working directory option \"%s\" is missing directory");
   rec(CMD_CD_MISSING_DIR, WARNING, CMD, "Current directory option \"%s\" is missing directory");
   rec(CMD_REMAP_MISSING_DIRS, WARNING, CMD, "Remapping option \"%s\" expects two absolute directory entries");
+  rec(CMD_CACHE_MISSING_SIZE, FATAL, CMD, "Missing cache size");
+  rec(CMD_TRACE_MISSING_FILE, ERROR, CMD, "Trace file option \"%s\" is missing the path name");
+  rec(CMD_MEMSTATS_MISSING_FILE, ERROR, CMD, "Memory stats file option \"%s\" is missing the path name");
+  rec(CMD_CANNOT_WRITE_CACHE_FILE, WARNING, CMD, "Cannot write cache file \"%s\", turning off cache");
   rec(PP_CANNOT_OPEN_FILE, ERROR, PP, "Cannot open file \"%s\"");
   rec(PP_CANNOT_OPEN_INCLUDE_FILE, ERROR, PP, "Cannot open include file \"%s\"");
   rec(PP_UNKOWN_MACRO, ERROR, PP, "Unknown macro \"%s\"");
@@ -23,12 +23,16 @@
 #include "Surelog/Expression/ExprBuilder.h"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <map>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "Surelog/Common/Session.h"
+#include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/Design.h"
 #include "Surelog/Design/FileContent.h"
 #include "Surelog/ErrorReporting/Error.h"
@@ -62,6 +66,148 @@ Value* ExprBuilder::clone(Value* val) {
   return clone;
 }
 
+ExprBuilder::~ExprBuilder() { clearMemo(); }
+
+void ExprBuilder::deleteReads_(std::vector<ParameterRead>& reads) {
+  for (ParameterRead& read : reads) m_valueFactory.deleteValue(read.m_value);
+  reads.clear();
+}
+
+void ExprBuilder::clearMemo() {
+  for (auto& [key, entries] : m_memo) {
+    for (MemoEntry& entry : entries) {
+      deleteReads_(entry.m_reads);
+      m_valueFactory.deleteValue(entry.m_result);
+    }
+  }
+  m_memo.clear();
+}
+
+// Same value, down to the representation: the result of an evaluation may
+// depend on any of these.
+static bool sameValue(const Value* lhs, const Value* rhs) {
+  if ((lhs == nullptr) || (rhs == nullptr)) return lhs == rhs;
+  if ((lhs->getType() != rhs->getType()) || (lhs->isLValue() != rhs->isLValue()) ||
+      (lhs->isValid() != rhs->isValid()) || (lhs->isSigned() != rhs->isSigned()) ||
+      (lhs->isNegative() != rhs->isNegative()) || (lhs->getNbWords() != rhs->getNbWords()) ||
+      (lhs->getSize() != rhs->getSize()) || (lhs->getLRange() != rhs->getLRange()) ||
+      (lhs->getRRange() != rhs->getRRange()) || (lhs->getTypespec() != rhs->getTypespec())) {
+    return false;
+  }
+  if ((value_cast<const StValue*>(lhs) != nullptr) || (value_cast<const StValue*>(rhs) != nullptr)) {
+    return lhs->getValueS() == rhs->getValueS();
+  }
+  for (uint16_t i = 0; i < lhs->getNbWords(); ++i) {
+    if ((lhs->getSize(i) != rhs->getSize(i)) || (lhs->getValueUL(i) != rhs->getValueUL(i))) return false;
+  }
+  return true;
+}
+
+Value* ExprBuilder::findParameter_(ValuedComponentI* instance, std::string_view packageName, std::string_view name,
+                                   bool& complex) const {
+  complex = false;
+  if (!packageName.empty()) {
+    if (m_design) {
+      if (Package* pack = m_design->getPackage(packageName)) {
+        const SymbolId id = pack->getValueId(name);
+        if (pack->getComplexValue(id)) {
+          complex = true;
+        } else {
+          return pack->getValue(id);
+        }
+      }
+    }
+  } else if (instance) {
+    const SymbolId id = instance->getValueId(name);
+    if (instance->getComplexValue(id)) {
+      complex = true;
+    } else {
+      return instance->getValue(id);
+    }
+  }
+  return nullptr;
+}
+
+Value* ExprBuilder::lookupParameter_(ValuedComponentI* instance, std::string_view packageName, std::string_view name,
+                                     bool withBuilder, bool& complex) {
+  Value* value = findParameter_(instance, packageName, name, complex);
+  if ((value == nullptr) && !complex && withBuilder && (instance != nullptr)) {
+    // Built from the parameter assignments of the definition, if any
+    if ((value = instance->getValue(name, *this)) != nullptr) {
+      m_builtValues.emplace_back(value);
+      if (m_reads != nullptr) m_reads->m_comparable = false;
+    }
+  }
+  if ((m_reads != nullptr) && m_reads->m_comparable) {
+    ParameterRead& read = m_reads->m_reads.emplace_back();
+    read.m_packageName = packageName;
+    read.m_name = name;
+    read.m_complex = complex;
+    if (value != nullptr) read.m_value = clone(value);
+  }
+  return value;
+}
+
+bool ExprBuilder::sameReads_(const std::vector<ParameterRead>& reads, ValuedComponentI* instance) const {
+  for (const ParameterRead& read : reads) {
+    bool complex = false;
+    const Value* const value = findParameter_(instance, read.m_packageName, read.m_name, complex);
+    if ((complex != read.m_complex) || !sameValue(value, read.m_value)) return false;
+  }
+  return true;
+}
+
+Value* ExprBuilder::evalExpr(const FileContent* fC, NodeId parent, ValuedComponentI* instance, bool muteErrors) {
+  // Sub-expressions are part of the evaluation in progress
+  if (m_evaluating) return evalExpr_(fC, parent, instance, muteErrors);
+
+  m_evaluating = true;
+  Value* const value = m_memoEnabled ? evalMemoized_(fC, parent, instance, muteErrors)
+                                     : evalExpr_(fC, parent, instance, muteErrors);
+  m_evaluating = false;
+  for (Value* built : m_builtValues) m_valueFactory.deleteValue(built);
+  m_builtValues.clear();
+  return value;
+}
+
+Value* ExprBuilder::evalMemoized_(const FileContent* fC, NodeId parent, ValuedComponentI* instance, bool muteErrors) {
+  const MemoKey key(fC, parent, muteErrors);
+  std::map<MemoKey, std::vector<MemoEntry>>::iterator itr = m_memo.find(key);
+  if (itr == m_memo.end()) {
+    // Most expressions are evaluated once, only remember this one was
+    if (m_memo.size() >= MaxMemoExprs) clearMemo();
+    m_memo.emplace(key, std::vector<MemoEntry>());
+    return evalExpr_(fC, parent, instance, muteErrors);
+  }
+  for (const MemoEntry& entry : itr->second) {
+    if (sameReads_(entry.m_reads, instance)) return clone(entry.m_result);
+  }
+
+  const ErrorContainer* const errors = m_session->getErrorContainer();
+  const size_t errorCount = errors->getErrors().size();
+  Reads reads;
+  m_reads = &reads;
+  Value* const value = evalExpr_(fC, parent, instance, muteErrors);
+  m_reads = nullptr;
+
+  // Errors are reported by each evaluation, never reused. An expression
+  // that reads no parameter is as cheap to evaluate again.
+  if (reads.m_reads.empty() || !reads.m_comparable || (errors->getErrors().size() != errorCount)) {
+    deleteReads_(reads.m_reads);
+    return value;
+  }
+  std::vector<MemoEntry>& entries = itr->second;
+  if (entries.size() == MaxMemoEntriesPerExpr) {
+    deleteReads_(entries.front().m_reads);
+    m_valueFactory.deleteValue(entries.front().m_result);
+    entries.erase(entries.begin());
+  }
+  MemoEntry& entry = entries.emplace_back();
+  entry.m_reads = std::move(reads.m_reads);
+  entry.m_result = clone(value);
+  return value;
+}
+
 // Often, there are assignments to muteErrors here, that are never read.
 // It seems like there is a (future?) intention here. So for now, disable
 // warnings from clang-tidy.
@@ -69,7 +215,7 @@ Value* ExprBuilder::clone(Value* val) {
 //              and fix the intended places.
 //
 // NOLINTBEGIN(*.DeadStores)
-Value* ExprBuilder::evalExpr(const FileContent* fC, NodeId parent, ValuedComponentI* instance, bool muteErrors) {
+Value* ExprBuilder::evalExpr_(const FileContent* fC, NodeId parent, ValuedComponentI* instance, bool muteErrors) {
   SymbolTable* const symbols = m_session->getSymbolTable();
   ErrorContainer* const errors = m_session->getErrorContainer();
   Value* value = m_valueFactory.newLValue();
@@ -77,20 +223,14 @@ Value* ExprBuilder::evalExpr(const FileContent* fC, NodeId parent, ValuedCompone
   VObjectType type = fC->Type(parent);
   switch (type) {
     case VObjectType::paPackage_scope: {
-      Value* sval = nullptr;
       const std::string_view packageName = fC->SymName(child);
       const std::string_view name = fC->SymName(fC->Sibling(parent));
-      if (m_design) {
-        Package* pack = m_design->getPackage(packageName);
-        if (pack) {
-          if (pack->getComplexValue(name)) {
-            muteErrors = true;
-            value->setInvalid();
-            break;
-          } else {
-            sval = pack->getValue(name);
-          }
-        }
+      bool complex = false;
+      Value* sval = lookupParameter_(instance, packageName, name, false, complex);
+      if (complex) {
+        muteErrors = true;
+        value->setInvalid();
+        break;
       }
       std::string fullName;
       if (sval == nullptr) fullName = StrCat(packageName, "::", name);
@@ -509,29 +649,22 @@ Value* ExprBuilder::evalExpr(const FileContent* fC, NodeId parent, ValuedCompone
         if (childType == VObjectType::paPackage_scope) {
           const std::string_view packageName = fC->SymName(fC->Child(child));
           const std::string_view name = fC->SymName(fC->Sibling(child));
-          if (m_design) {
-            Package* pack = m_design->getPackage(packageName);
-            if (pack) {
-              if (pack->getComplexValue(name)) {
-                muteErrors = true;
-                value->setInvalid();
-                break;
-              } else {
-                sval = pack->getValue(name);
-              }
-            }
+          bool complex = false;
+          sval = lookupParameter_(instance, packageName, name, false, complex);
+          if (complex) {
+            muteErrors = true;
+            value->setInvalid();
+            break;
           }
           if (sval == nullptr) fullName = StrCat(packageName, "::", name);
         } else {
           const std::string_view name = fC->SymName(child);
-          if (instance) {
-            if (instance->getComplexValue(name)) {
-              muteErrors = true;
-              value->setInvalid();
-              break;
-            } else {
-              sval = instance->getValue(name, *this);
-            }
+          bool complex = false;
+          sval = lookupParameter_(instance, {}, name, true, complex);
+          if (complex) {
+            muteErrors = true;
+            value->setInvalid();
+            break;
           }
           if (sval == nullptr) fullName = name;
         }
@@ -742,14 +875,12 @@ Value* ExprBuilder::evalExpr(const FileContent* fC, NodeId parent, ValuedCompone
         Value* sval = nullptr;
         std::string fullName;
         const std::string_view name = fC->SymName(parent);
-        if (instance) {
-          if (instance->getComplexValue(name)) {
-            muteErrors = true;
-            value->setInvalid();
-            break;
-          } else {
-            sval = instance->getValue(name, *this);
-          }
+        bool complex = false;
+        sval = lookupParameter_(instance, {}, name, true, complex);
+        if (complex) {
+          muteErrors = true;
+          value->setInvalid();
+          break;
         }
         if (sval == nullptr) fullName = name;
 
@@ -864,14 +995,13 @@ Value* ExprBuilder::evalExpr(const FileContent* fC, NodeId parent, ValuedCompone
       }
       case VObjectType::paIncDec_PlusPlus: {
         const std::string_view name = fC->SymName(fC->Sibling(parent));
-        Value* sval = nullptr;
         if (instance) {
-          if (instance->getComplexValue(name)) {
+          bool complex = false;
+          Value* sval = lookupParameter_(instance, {}, name, false, complex);
+          if (complex) {
             muteErrors = true;
             value->setInvalid();
             break;
-          } else {
-            sval = instance->getValue(name);
           }
           value->u_plus(sval);
           value->incr();
@@ -881,14 +1011,13 @@ Value* ExprBuilder::evalExpr(const FileContent* fC, NodeId parent, ValuedCompone
       }
       case VObjectType::paIncDec_MinusMinus: {
         const std::string_view name = fC->SymName(fC->Sibling(parent));
-        Value* sval = nullptr;
         if (instance) {
-          if (instance->getComplexValue(name)) {
+          bool complex = false;
+          Value* sval = lookupParameter_(instance, {}, name, false, complex);
+          if (complex) {
             muteErrors = true;
             value->setInvalid();
             break;
-          } else {
-            sval = instance->getValue(name);
           }
           value->u_plus(sval);
           value->decr();
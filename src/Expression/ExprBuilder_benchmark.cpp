@@ -0,0 +1,96 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+// Times ExprBuilder::evalExpr on typical parameter expressions and counts
+// the heap allocations it makes.
+// Usage: ExprBuilder_benchmark [iterations]
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/Design/FileContent.h"
+#include "Surelog/Expression/ExprBuilder.h"
+#include "Surelog/Expression/Value.h"
+#include "Surelog/SourceCompile/ParserHarness.h"
+#include "Surelog/SourceCompile/VObjectTypes.h"
+
+static std::atomic<uint64_t> allocationCount{0};
+
+void* operator new(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* const ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+int main(int argc, const char** argv) {
+  using namespace SURELOG;
+  const int32_t iterations = (argc > 1) ? std::atoi(argv[1]) : 100000;
+
+  Session session;
+  ExprBuilder builder(&session);
+  // Every pass evaluates the same expressions, the memo would answer them
+  builder.setMemoEnabled(false);
+  ParserHarness harness;
+  std::unique_ptr<FileContent> fC = harness.parse(
+      "module top();"
+      "parameter p1 = 5 + 5;"
+      "parameter p2 = (1 << 8) >> 4;"
+      "parameter p3 = (16 * 4) / 4 - 3 % 2;"
+      "parameter p4 = (32 - 16) == 16 ? 8'hFF & 8'h0F : 0;"
+      "parameter p5 = 64'hFFFF_FFFF_FFFF_FFFF ^ 64'h1;"
+      "parameter p6 = 2.5 * 4.0 + 1.0;"
+      "endmodule");
+  if (!fC) {
+    std::cerr << "Parse error\n";
+    return 1;
+  }
+  std::vector<NodeId> exprs;
+  for (NodeId assign : fC->sl_collect_all(fC->getRootNode(), VObjectType::paParam_assignment)) {
+    exprs.emplace_back(fC->Sibling(fC->Child(assign)));
+  }
+
+  const uint64_t allocationsBefore = allocationCount.load();
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t checksum = 0;
+  for (int32_t i = 0; i < iterations; ++i) {
+    for (NodeId expr : exprs) {
+      Value* const value = builder.evalExpr(fC.get(), expr);
+      checksum += value->getValueUL();
+      builder.deleteValue(value);
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const uint64_t allocations = allocationCount.load() - allocationsBefore;
+
+  const uint64_t evaluations = static_cast<uint64_t>(iterations) * exprs.size();
+  if (evaluations == 0) return 1;
+  const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  std::cout << evaluations << " evaluations of " << exprs.size() << " expressions\n"
+            << "  " << (ns / evaluations) << " ns per evaluation\n"
+            << "  " << (static_cast<double>(allocations) / evaluations) << " allocations per evaluation\n"
+            << "  checksum " << checksum << "\n";
+  return 0;
+}
@@ -24,6 +24,7 @@
 
 #include "Surelog/Common/Session.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/ValuedComponentI.h"
 #include "Surelog/Expression/Value.h"
 #include "Surelog/SourceCompile/ParserHarness.h"
 #include "Surelog/SourceCompile/VObjectTypes.h"
@@ -73,6 +74,23 @@ TEST(ExprBuilderTest, BasicValueOp) {
     EXPECT_EQ(v0->uhdmValue(), "BLAH");
   }
 }
+TEST(ExprBuilderTest, ValueFactoryReuse) {
+  ValueFactory factory;
+  Value* v0 = factory.newLValue();
+  v0->set((int64_t)-1);
+  factory.deleteValue(v0);
+
+  // Released values are reset when handed out again
+  Value* v1 = factory.newLValue();
+  EXPECT_EQ(v0, v1);
+  EXPECT_FALSE(v1->isValid());
+  EXPECT_EQ(v1->getNbWords(), 0);
+
+  LValue v2(Value::Type::Unsigned, new SValue[3], 3);
+  std::unique_ptr<Value> v3(factory.newValue(v2));
+  EXPECT_EQ(v3->getNbWords(), 3);
+  factory.deleteValue(v1);
+}
 TEST(ExprBuilderTest, BuildFrom) {
   {
     Session session;
@@ -139,4 +157,101 @@ TEST(ExprBuilderTest, ExprFromParseTree2) {
     EXPECT_EQ(val->getValueUL(), 16);
   }
 }
+TEST(ExprBuilderTest, MemoizedPerParameterValues) {
+  Session session;
+  ExprBuilder builder(&session);
+  ParserHarness harness;
+  auto fC = harness.parse(
+      "module top();"
+      "parameter p1 = W * 2;"
+      "endmodule");
+  std::vector<NodeId> assigns = fC->sl_collect_all(fC->getRootNode(), VObjectType::paParam_assignment);
+  ASSERT_EQ(assigns.size(), 1);
+  NodeId rhs = fC->Sibling(fC->Child(assigns[0]));
+
+  LValue w4, w5;
+  w4.set((int64_t)4);
+  w5.set((int64_t)5);
+  ValuedComponentI inst1(&session, nullptr, nullptr);
+  ValuedComponentI inst2(&session, nullptr, nullptr);
+  ValuedComponentI inst3(&session, nullptr, nullptr);
+  inst1.setValue("W", &w4, builder);
+  inst2.setValue("W", &w4, builder);
+  inst3.setValue("W", &w5, builder);
+
+  std::unique_ptr<Value> val1(builder.evalExpr(fC.get(), rhs, &inst1));
+  std::unique_ptr<Value> val2(builder.evalExpr(fC.get(), rhs, &inst2));
+  std::unique_ptr<Value> val3(builder.evalExpr(fC.get(), rhs, &inst3));
+  EXPECT_EQ(val1->getValueL(), 8);
+  EXPECT_EQ(val2->getValueL(), 8);
+  EXPECT_EQ(val3->getValueL(), 10);
+
+  // Not reused once the parameter changes
+  inst1.setValue("W", &w5, builder);
+  std::unique_ptr<Value> val4(builder.evalExpr(fC.get(), rhs, &inst1));
+  EXPECT_EQ(val4->getValueL(), 10);
+
+  // Nor without the parameter
+  std::unique_ptr<Value> val5(builder.evalExpr(fC.get(), rhs, nullptr, true));
+  EXPECT_FALSE(val5->isValid());
+}
+TEST(ExprBuilderTest, MemoizedPerFileContent) {
+  Session session;
+  ExprBuilder builder(&session);
+  // Two contents of the same file with the same node ids, as the chunks of
+  // a split file
+  ParserHarness harness1;
+  ParserHarness harness2;
+  auto fC1 = harness1.parse(
+      "module top();"
+      "parameter p1 = W * 2;"
+      "endmodule");
+  auto fC2 = harness2.parse(
+      "module top();"
+      "parameter p1 = W + 2;"
+      "endmodule");
+  ASSERT_EQ(fC1->getFileId(), fC2->getFileId());
+  std::vector<NodeId> assigns1 = fC1->sl_collect_all(fC1->getRootNode(), VObjectType::paParam_assignment);
+  std::vector<NodeId> assigns2 = fC2->sl_collect_all(fC2->getRootNode(), VObjectType::paParam_assignment);
+  ASSERT_EQ(assigns1.size(), 1);
+  ASSERT_EQ(assigns2.size(), 1);
+  NodeId rhs1 = fC1->Sibling(fC1->Child(assigns1[0]));
+  NodeId rhs2 = fC2->Sibling(fC2->Child(assigns2[0]));
+  ASSERT_EQ(rhs1, rhs2);
+
+  LValue w;
+  w.set((int64_t)4);
+  ValuedComponentI inst(&session, nullptr, nullptr);
+  inst.setValue("W", &w, builder);
+
+  // Twice each, the second evaluation of an expression is memoized
+  for (int32_t i = 0; i < 2; ++i) {
+    std::unique_ptr<Value> val1(builder.evalExpr(fC1.get(), rhs1, &inst));
+    std::unique_ptr<Value> val2(builder.evalExpr(fC2.get(), rhs2, &inst));
+    EXPECT_EQ(val1->getValueL(), 8);
+    EXPECT_EQ(val2->getValueL(), 6);
+  }
+}
+TEST(ExprBuilderTest, MemoDisabled) {
+  Session session;
+  ExprBuilder builder(&session);
+  builder.setMemoEnabled(false);
+  ParserHarness harness;
+  auto fC = harness.parse(
+      "module top();"
+      "parameter p1 = W + 1;"
+      "endmodule");
+  std::vector<NodeId> assigns = fC->sl_collect_all(fC->getRootNode(), VObjectType::paParam_assignment);
+  ASSERT_EQ(assigns.size(), 1);
+  NodeId rhs = fC->Sibling(fC->Child(assigns[0]));
+
+  LValue w;
+  ValuedComponentI inst(&session, nullptr, nullptr);
+  for (int64_t i = 0; i < 3; ++i) {
+    w.set(i);
+    inst.setValue("W", &w, builder);
+    std::unique_ptr<Value> val(builder.evalExpr(fC.get(), rhs, &inst));
+    EXPECT_EQ(val->getValueL(), i + 1);
+  }
+}
 }}  // namespace SURELOG
@@ -43,7 +43,17 @@ uint32_t Value::nbWords_(uint32_t size) {
 
 SValue::~SValue() = default;
 
-LValue::~LValue() { delete[] m_valueArray; }
+LValue::~LValue() { releaseWords_(); }
+
+void LValue::allocateWords_(uint16_t nbWords) {
+  releaseWords_();
+  m_valueArray = (nbWords <= InlineWordCount) ? m_inlineWords : new SValue[nbWords];
+}
+
+void LValue::releaseWords_() {
+  if (m_valueArray != m_inlineWords) delete[] m_valueArray;
+  m_valueArray = nullptr;
+}
 
 StValue::~StValue() = default;
 
@@ -78,34 +88,31 @@ bool LValue::operator==(const Value& rhs) const {
   return true;
 }
 
-ValueFactory::ValueFactory() : m_headFree(nullptr), m_headInUse(nullptr) {}
+ValueFactory::~ValueFactory() {
+  for (LValue* value : m_freeLValues) delete value;
+}
+
+LValue* ValueFactory::recycledLValue_() {
+  if (m_freeLValues.empty()) return nullptr;
+  LValue* const value = m_freeLValues.back();
+  m_freeLValues.pop_back();
+  return value;
+}
 
 Value* ValueFactory::newSValue() { return new SValue(); }
 
 Value* ValueFactory::newStValue() { return new StValue(); }
 
 Value* ValueFactory::newLValue() {
-  // if (m_headFree == nullptr) {
-  LValue* val = new LValue();
-  val->setValueFactory(this);
-  return val;
-  /*
+  LValue* val = recycledLValue_();
+  if (val == nullptr) {
+    val = new LValue();
   } else {
-    LValue* ret = m_headFree;
-    LValue* next = m_headFree->m_next;
-    LValue* prev = m_headFree->m_prev;
-    m_headFree = next;
-    if (prev == next) {
-      m_headFree = nullptr;
-    } else {
-      next->m_prev = prev;
-      prev->m_next = next;
-    }
-    ret->m_prev = nullptr;
-    ret->m_next = nullptr;
-    return ret;
+    *val = LValue();
+    val->releaseWords_();
   }
-  */
+  val->setValueFactory(this);
+  return val;
 }
 
 Value* ValueFactory::newValue(SValue& initVal) { return new SValue(initVal); }
@@ -113,57 +120,23 @@ Value* ValueFactory::newValue(SValue& initVal) { return new SValue(initVal); }
 Value* ValueFactory::newValue(StValue& initVal) { return new StValue(initVal); }
 
 Value* ValueFactory::newValue(LValue& initVal) {
-  // if (m_headFree == nullptr) {
-  LValue* val = new LValue(initVal);
+  LValue* val = recycledLValue_();
+  if (val == nullptr) {
+    val = new LValue(initVal);
+  } else {
+    *val = initVal;
+  }
   val->setValueFactory(this);
   return val;
-  /* } else {
-     LValue* ret = m_headFree;
-     LValue* next = m_headFree->m_next;
-     LValue* prev = m_headFree->m_prev;
-     m_headFree = next;
-     if (prev == next) {
-       m_headFree = nullptr;
-     } else {
-       next->m_prev = prev;
-       prev->m_next = next;
-     }
-     ret->m_prev = nullptr;
-     ret->m_next = nullptr;
-     ret->adjust(&initVal);
-     for (uint32_t i = 0; i < ret->m_nbWords; i++) {
-       if (initVal.m_valueArray)
-         ret->m_valueArray[i] = initVal.m_valueArray[i];
-     }
-
-     return ret;
-   }
-   */
 }
 
 void ValueFactory::deleteValue(Value* value) {
-  delete value;
-  /*
-  if (value->getType() == Value::Type::String) {
-    // TODO: investigate memory corruption
-    // delete (StValue*) value;
+  if ((value != nullptr) && value->isLValue() && (m_freeLValues.size() < MaxFreeLValues)) {
+    // Whichever factory created it, the value now belongs to this one
+    m_freeLValues.emplace_back(static_cast<LValue*>(value));
     return;
   }
-  */
-  /*
-  LValue* val = (LValue*)value;
-  const Value* prev = value->m_valueFactory->m_headFree;
-  if (prev == nullptr) {
-    value->m_valueFactory->m_headFree = (LValue*)val;
-    value->m_valueFactory->m_headFree->m_next =
-  value->m_valueFactory->m_headFree; value->m_valueFactory->m_headFree->m_prev =
-  value->m_valueFactory->m_headFree; } else { LValue* next1 =
-  value->m_valueFactory->m_headFree; LValue* prev1 =
-  value->m_valueFactory->m_headFree->m_prev; next1->m_prev = val; prev1->m_next
-  = val; val->m_next = next1; val->m_prev = prev1;
-    value->m_valueFactory->m_headFree = val;
-  }
-  */
+  delete value;
 }
 
 void SValue::set(uint64_t val) {
@@ -861,16 +834,21 @@ int32_t LValue::vpiValType() {
   return 0;
 }
 
-LValue::LValue(const LValue& val)  // NOLINT(bugprone-copy-constructor-init)
-    : m_type(val.m_type),
-      m_nbWords(val.m_nbWords),
-      m_valueArray(new SValue[val.m_nbWords ? val.m_nbWords : 1]),
-      m_valid(val.isValid()),
-      m_negative(val.isNegative()),
-      m_lrange(val.getLRange()),
-      m_rrange(val.getRRange()),
-      m_signed(val.isSigned()),
-      m_typespec(val.getTypespec()) {
+LValue::LValue(const LValue& val) {  // NOLINT(bugprone-copy-constructor-init)
+  *this = val;
+}
+
+LValue& LValue::operator=(const LValue& val) {
+  if (this == &val) return *this;
+  m_type = val.m_type;
+  m_nbWords = val.m_nbWords;
+  allocateWords_(val.m_nbWords ? val.m_nbWords : 1);
+  m_valid = val.isValid();
+  m_negative = val.isNegative();
+  m_lrange = val.getLRange();
+  m_rrange = val.getRRange();
+  m_signed = val.isSigned();
+  m_typespec = val.getTypespec();
   m_valueArray[0].m_size = 0;
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.u_int = 0;
@@ -878,12 +856,12 @@ LValue::LValue(const LValue& val)  // NOLINT(bugprone-copy-constructor-init)
   m_valueArray[0].m_lrange = 0;
   m_valueArray[0].m_rrange = 0;
   for (int32_t i = 0; i < val.m_nbWords; i++) {
-    m_valueArray[i].m_size = 0;
     m_valueArray[i] = val.m_valueArray[i];
   }
+  return *this;
 }
 
-LValue::LValue(uint64_t val) : m_type(Type::Unsigned), m_nbWords(1), m_valueArray(new SValue[1]), m_valid(1) {
+LValue::LValue(uint64_t val) : m_type(Type::Unsigned), m_nbWords(1), m_valueArray(m_inlineWords), m_valid(1) {
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.u_int = val;
   m_valueArray[0].m_size = 64;
@@ -897,7 +875,7 @@ LValue::LValue(uint64_t val) : m_type(Type::Unsigned), m_nbWords(1), m_valueArra
   m_typespec = nullptr;
 }
 
-LValue::LValue(int64_t val) : m_type(Type::Integer), m_nbWords(1), m_valueArray(new SValue[1]), m_valid(1) {
+LValue::LValue(int64_t val) : m_type(Type::Integer), m_nbWords(1), m_valueArray(m_inlineWords), m_valid(1) {
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.s_int = val;
   m_valueArray[0].m_size = 64;
@@ -911,7 +889,7 @@ LValue::LValue(int64_t val) : m_type(Type::Integer), m_nbWords(1), m_valueArray(
   m_typespec = nullptr;
 }
 
-LValue::LValue(double val) : m_type(Type::Double), m_nbWords(1), m_valueArray(new SValue[1]), m_valid(1) {
+LValue::LValue(double val) : m_type(Type::Double), m_nbWords(1), m_valueArray(m_inlineWords), m_valid(1) {
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.d_int = val;
   m_valueArray[0].m_size = 64;
@@ -926,7 +904,7 @@ LValue::LValue(double val) : m_type(Type::Double), m_nbWords(1), m_valueArray(ne
 }
 
 LValue::LValue(int64_t val, Type type, int16_t size)
-    : m_type(type), m_nbWords(1), m_valueArray(new SValue[1]), m_valid(1) {
+    : m_type(type), m_nbWords(1), m_valueArray(m_inlineWords), m_valid(1) {
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.s_int = val;
   m_valueArray[0].m_size = size;
@@ -943,7 +921,7 @@ LValue::LValue(int64_t val, Type type, int16_t size)
 void LValue::set(uint64_t val) {
   m_type = Type::Unsigned;
   m_nbWords = 1;
-  if (!m_valueArray) m_valueArray = new SValue[1];
+  if (!m_valueArray) allocateWords_(1);
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.u_int = val;
   m_valueArray[0].m_size = 64;
@@ -960,7 +938,7 @@ void LValue::set(uint64_t val) {
 void LValue::set(int64_t val) {
   m_type = Type::Integer;
   m_nbWords = 1;
-  if (!m_valueArray) m_valueArray = new SValue[1];
+  if (!m_valueArray) allocateWords_(1);
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.s_int = val;
   m_valueArray[0].m_size = 64;
@@ -977,7 +955,7 @@ void LValue::set(int64_t val) {
 void LValue::set(double val) {
   double intpart;
   m_nbWords = 1;
-  if (!m_valueArray) m_valueArray = new SValue[1];
+  if (!m_valueArray) allocateWords_(1);
   if (modf(val, &intpart) == 0.0) {
     if (val < 0) {
       m_type = Type::Integer;
@@ -1005,7 +983,7 @@ void LValue::set(double val) {
 void LValue::set(uint64_t val, Type type, int32_t size) {
   m_type = type;
   m_nbWords = 1;
-  if (!m_valueArray) m_valueArray = new SValue[1];
+  if (!m_valueArray) allocateWords_(1);
   m_valueArray[0].m_type = m_type;
   m_valueArray[0].m_value.u_int = val;
   m_valueArray[0].m_size = size;
@@ -1022,18 +1000,15 @@ void LValue::set(uint64_t val, Type type, int32_t size) {
 void LValue::adjust(const Value* a) {
   m_type = a->getType();
   if (a->getNbWords() != getNbWords()) {
-    if (m_nbWords && m_valueArray) {
-      delete[] m_valueArray;
-      m_valueArray = nullptr;
-    }
+    releaseWords_();
     m_nbWords = a->getNbWords();
     if (m_nbWords) {
-      m_valueArray = new SValue[m_nbWords];
+      allocateWords_(m_nbWords);
       m_valueArray[0].m_size = 0;
     }
   }
   if (m_valueArray == nullptr) {
-    m_valueArray = new SValue[1];
+    allocateWords_(1);
     m_nbWords = 1;
     m_valueArray[0].m_size = 0;
   }
@@ -90,9 +90,8 @@ const DataType* Package::getDataType(Design* design, std::string_view name) cons
 
 void Package::append(Package* package) {
   DesignComponent::append(package);
-  for (auto& type : package->m_dataTypes) insertDataType(type.first, type.second);
-  for (auto& param : package->getMappedValues())
-    setValue(param.first, param.second.first, m_exprBuilder, param.second.second);
+  for (const auto& param : package->getMappedValuesByName())
+    setValue(param.first, param.second->first, m_exprBuilder, param.second->second);
   for (auto& classDef : package->m_classDefinitions) {
     addClassDefinition(classDef.first, classDef.second);
     classDef.second->setContainer(this);
@@ -23,9 +23,10 @@
 
 #include "Surelog/SourceCompile/AnalyzeFile.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cstdint>
-#include <iostream>
-#include <regex>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -46,45 +47,89 @@
 #include "Surelog/Utils/StringUtils.h"
 
 namespace SURELOG {
+namespace {
+// Unless -split gives an explicit threshold, files are cut in as many chunks
+// as there are threads, each being at least this long.
+constexpr uint32_t kMinLinesPerChunk = 20000;
+
+bool isIdentifierStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || (c == '_'); }
+
+bool isIdentifierChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || (c == '_') || (c == '$'); }
+
+// Whether rest, the remainder of a line following an import keyword, reads
+// " pkg::item ;" (same as matching "import[ ]+[a-zA-Z_0-9:\*]+[ ]*;").
+bool isImportStatement(std::string_view rest) {
+  size_t i = 0;
+  while ((i < rest.size()) && (rest[i] == ' ')) ++i;
+  if (i == 0) return false;
+  const size_t nameStart = i;
+  while ((i < rest.size()) && (std::isalnum(static_cast<unsigned char>(rest[i])) || (rest[i] == '_') ||
+                               (rest[i] == ':') || (rest[i] == '*'))) {
+    ++i;
+  }
+  if (i == nameStart) return false;
+  while ((i < rest.size()) && (rest[i] == ' ')) ++i;
+  return (i < rest.size()) && (rest[i] == ';');
+}
+
+// Splits text into lines without copying them, same as std::getline would
+// (trailing '\r' removed, no empty line after a final '\n').
+void splitLines(std::string_view text, std::vector<std::string_view>& lines) {
+  size_t start = 0;
+  while (start < text.size()) {
+    size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) end = text.size();
+    std::string_view line = text.substr(start, end - start);
+    while (!line.empty() && (line.back() == '\r')) line.remove_suffix(1);
+    lines.emplace_back(line);
+    start = end + 1;
+  }
+}
+}  // namespace
+
 void AnalyzeFile::checkSLlineDirective_(std::string_view line, uint32_t lineNb) {
+  // Called for every line written to a chunk, reject the others cheaply.
+  line = StringUtils::ltrim(line);
+  if (!StringUtils::startsWith(line, "SLline")) return;
+
+  std::vector<std::string_view> tokens;
+  std::vector<std::string_view> words;
+  for (std::string_view token : StringUtils::tokenize(line, " \t", tokens)) {
+    if (!token.empty()) words.emplace_back(token);
+  }
+  if ((words.size() < 3) || (words[0] != "SLline")) return;
+
   SymbolTable* const symbols = m_session->getSymbolTable();
   FileSystem* const fileSystem = m_session->getFileSystem();
 
-  std::stringstream ss((std::string(line))); /* Storing the whole string into string stream */
-  std::string keyword;
-  ss >> keyword;
-  if (keyword == "SLline") {
-    IncludeFileInfo info(IncludeFileInfo::Context::None, IncludeFileInfo::Action::None, BadPathId, 0, 0, 0, 0,
-                         BadSymbolId, 0, 0);
-    ss >> info.m_sectionLine;
-    std::string text;
-    ss >> text;
-    text = StringUtils::unquoted(text);
-    std::vector<std::string_view> parts;
-    StringUtils::tokenize(text, "^", parts);
-    std::string_view symbol = StringUtils::unquoted(parts[0]);
-    std::string_view file = StringUtils::unquoted(parts[1]);
-    info.m_symbolId = symbols->registerSymbol(symbol);
-    info.m_sectionFileId = fileSystem->toPathId(file, symbols);
-    uint32_t action = 0;
-    ss >> action;
-
-    if (static_cast<IncludeFileInfo::Action>(action) == IncludeFileInfo::Action::Push) {
-      // Push
-      info.m_sectionLine = lineNb;
-      info.m_action = IncludeFileInfo::Action::Push;
-      m_includeFileInfo.push(info);
-    } else if (static_cast<IncludeFileInfo::Action>(action) == IncludeFileInfo::Action::Pop) {
-      // Pop
-      if (!m_includeFileInfo.empty()) m_includeFileInfo.pop();
-      if (!m_includeFileInfo.empty()) {
-        IncludeFileInfo& top = m_includeFileInfo.top();
-        top.m_symbolId = info.m_symbolId;
-        top.m_sectionFileId = info.m_sectionFileId;
-        top.m_sourceLine = lineNb;
-        top.m_sectionLine = info.m_sectionLine - 1;
-        top.m_action = IncludeFileInfo::Action::Pop;
-      }
+  IncludeFileInfo info(IncludeFileInfo::Context::None, IncludeFileInfo::Action::None, BadPathId, 0, 0, 0, 0,
+                       BadSymbolId, 0, 0);
+  info.m_sectionLine = static_cast<uint32_t>(std::strtoul(std::string(words[1]).c_str(), nullptr, 10));
+  std::vector<std::string_view> parts;
+  StringUtils::tokenize(StringUtils::unquoted(words[2]), "^", parts);
+  if (parts.size() < 2) return;
+  std::string_view symbol = StringUtils::unquoted(parts[0]);
+  std::string_view file = StringUtils::unquoted(parts[1]);
+  info.m_symbolId = symbols->registerSymbol(symbol);
+  info.m_sectionFileId = fileSystem->toPathId(file, symbols);
+  uint32_t action = 0;
+  if (words.size() > 3) action = static_cast<uint32_t>(std::strtoul(std::string(words[3]).c_str(), nullptr, 10));
+
+  if (static_cast<IncludeFileInfo::Action>(action) == IncludeFileInfo::Action::Push) {
+    // Push
+    info.m_sectionLine = lineNb;
+    info.m_action = IncludeFileInfo::Action::Push;
+    m_includeFileInfo.push(info);
+  } else if (static_cast<IncludeFileInfo::Action>(action) == IncludeFileInfo::Action::Pop) {
+    // Pop
+    if (!m_includeFileInfo.empty()) m_includeFileInfo.pop();
+    if (!m_includeFileInfo.empty()) {
+      IncludeFileInfo& top = m_includeFileInfo.top();
+      top.m_symbolId = info.m_symbolId;
+      top.m_sectionFileId = info.m_sectionFileId;
+      top.m_sourceLine = lineNb;
+      top.m_sectionLine = info.m_sectionLine - 1;
+      top.m_action = IncludeFileInfo::Action::Pop;
     }
   }
 }
@@ -111,24 +156,19 @@ void AnalyzeFile::analyze() {
   ErrorContainer* const errors = m_session->getErrorContainer();
   CommandLineParser* const clp = m_session->getCommandLineParser();
 
-  std::vector<std::string> allLines;
-  allLines.emplace_back("FILLER LINE");
+  // The preprocessed text is read once, lines are views into it.
+  std::string buffer;
+  std::string_view text = m_text;
   if (m_text.empty()) {
-    fileSystem->readLines(m_ppFileId, allLines);
-  } else {
-    std::string line;
-    std::stringstream ss(m_text);
-    while (std::getline(ss, line)) {
-      while (!line.empty() && ((line.back() == '\r') || (line.back() == '\n'))) {
-        line.pop_back();
-      }
-      allLines.emplace_back(line);
-    }
+    fileSystem->readContent(m_ppFileId, buffer);
+    text = buffer;
   }
-  if (allLines.empty()) return;
+  std::vector<std::string_view> allLines;
+  allLines.emplace_back("FILLER LINE");
+  splitLines(text, allLines);
 
-  uint32_t minNbLineForPartitioning = clp->getLinesForFileSpliting();
-  std::vector<FileChunk> fileChunks;
+  std::vector<FileChunk>& fileChunks = m_fileChunks;
+  fileChunks.clear();
   bool inPackage = false;
   int32_t inClass = 0;
   int32_t inModule = 0;
@@ -137,77 +177,86 @@ void AnalyzeFile::analyze() {
   bool inConfig = false;
   bool inChecker = false;
   bool inPrimitive = false;
-  // int32_t  inFunction  = false;
-  // int32_t  inTask      = false;
   bool inComment = false;
   bool inString = false;
+  bool expectPackageName = false;
+  bool interfaceOpened = false;  // Previous token opened an interface
+  int32_t parenDepth = 0;
   uint32_t lineNb = 0;
-  uint32_t charNb = 0;
   uint32_t startLine = 0;
   uint32_t startChar = 0;
   uint32_t indexPackage = 0;
   uint32_t indexModule = 0;
-  std::string prev_keyword;
-  std::string prev_prev_keyword;
-  const std::regex import_regex("import[ ]+[a-zA-Z_0-9:\\*]+[ ]*;");
-  std::smatch pieces_match;
+  std::string_view prevKeyword;
+  std::vector<uint32_t> importLines;  // Lines holding an import statement
   std::string fileLevelImportSection;
-  // Parse the file
-  for (const auto& line : allLines) {
-    bool inLineComment = false;
-    lineNb++;
-    char c = 0;
-    char cp = 0;
-    std::string keyword;
-    for (uint32_t i = 0; i < line.size(); i++) {
-      charNb++;
-      c = line[i];
-      if (cp == '/' && c == '*') {
-        if (!inLineComment) inComment = true;
-      } else if (cp == '/' && c == '/') {
-        if ((!inComment) && (!inString)) inLineComment = true;
-      } else if (cp == '*' && c == '/') {
+  // Scan the file, one token at a time: comments, strings, macro usages and
+  // system calls are skipped so that only actual keywords delimit units.
+  for (lineNb = 1; lineNb < allLines.size(); ++lineNb) {
+    const std::string_view line = allLines[lineNb];
+    const uint32_t lineStart = line.data() - text.data();
+    const size_t size = line.size();
+    bool hasImport = false;
+    size_t i = 0;
+    while (i < size) {
+      const char c = line[i];
+      if (inComment) {
+        const size_t end = line.find("*/", i);
+        if (end == std::string_view::npos) break;
         inComment = false;
-      } else if (cp != '\\' && c == '\"') {
-        if ((!inLineComment) && (!inComment)) inString = !inString;
-      }
-      if ((!inComment) && (!inLineComment) && (!inString)) {
-        if ((islower(c) || isupper(c) || c == '_') && (i != (line.size() - 1))) {
-          keyword += c;
+        i = end + 2;
+      } else if (inString) {
+        if (c == '\\') {
+          i += 2;
         } else {
-          if ((islower(c) || isupper(c) || c == '_') && (i == (line.size() - 1))) {
-            keyword += c;
-          }
-
-          if (keyword == "package") {
-            std::string packageName;
-            if (line[i] == ' ') {
-              for (uint32_t j = i + 1; j < line.size(); j++) {
-                if (line[j] == ';') break;
-                if (line[j] == ':') break;
-                if (line[j] != ' ') packageName += line[j];
-              }
-            }
-            if (!packageName.empty()) m_design->addOrderedPackage(packageName);
+          if (c == '"') inString = false;
+          ++i;
+        }
+      } else if ((c == '/') && (i + 1 < size) && (line[i + 1] == '/')) {
+        break;
+      } else if ((c == '/') && (i + 1 < size) && (line[i + 1] == '*')) {
+        inComment = true;
+        i += 2;
+      } else if (c == '"') {
+        inString = true;
+        ++i;
+      } else if (c == '\\') {
+        // Escaped identifier
+        while ((i < size) && !std::isspace(static_cast<unsigned char>(line[i]))) ++i;
+        prevKeyword = std::string_view();
+      } else if ((c == '`') || (c == '$') || std::isdigit(static_cast<unsigned char>(c))) {
+        // Macro usage, system task or number (1step...)
+        ++i;
+        while ((i < size) && isIdentifierChar(line[i])) ++i;
+      } else if (isIdentifierStart(c)) {
+        const size_t tokenStart = i;
+        while ((i < size) && isIdentifierChar(line[i])) ++i;
+        const std::string_view keyword = line.substr(tokenStart, i - tokenStart);
+        const uint32_t charNb = lineStart + i;
+        const bool afterInterface = interfaceOpened;
+        interfaceOpened = false;
+        if (expectPackageName && (keyword != "automatic") && (keyword != "static")) {
+          m_design->addOrderedPackage(keyword);
+          expectPackageName = false;
+        }
+        // All the keywords of interest are 5 to 12 characters long
+        if ((keyword.size() >= 5) && (keyword.size() <= 12)) {
+          if ((keyword == "import") && isImportStatement(line.substr(i))) {
+            hasImport = true;
+          } else if (keyword == "package") {
+            expectPackageName = true;
             inPackage = true;
             startLine = lineNb;
             startChar = charNb;
             fileChunks.emplace_back(DesignElement::ElemType::Package, startLine, 0, startChar, 0);
             indexPackage = fileChunks.size() - 1;
-          }
-          if (keyword == "endpackage") {
+          } else if (keyword == "endpackage") {
             if (inPackage) {
               fileChunks[indexPackage].m_toLine = lineNb;
               fileChunks[indexPackage].m_endChar = charNb;
             }
             inPackage = false;
-            // std::cout << "PACKAGE:" <<
-            // allLines[fileChunks[indexPackage].m_fromLine] << " f:" <<
-            // fileChunks[indexPackage].m_fromLine
-            //        << " t:" << fileChunks[indexPackage].m_toLine <<
-            //        std::endl;
-          }
-          if (keyword == "module") {
+          } else if (keyword == "module") {
             if (inModule == 0) {
               startLine = lineNb;
               startChar = charNb;
@@ -215,153 +264,122 @@ void AnalyzeFile::analyze() {
               indexModule = fileChunks.size() - 1;
             }
             inModule++;
-          }
-          if (keyword == "endmodule") {
+          } else if (keyword == "endmodule") {
             if (inModule == 1) {
               fileChunks[indexModule].m_toLine = lineNb;
               fileChunks[indexModule].m_endChar = charNb;
             }
             inModule--;
-          }
-          /*
-          if (keyword == "function" && (prev_keyword != "context") &&
-          (prev_prev_keyword != "import"))
-            {
-              if ((inClass == 0) && (inInterface == 0) && (inModule == 0))
-                {
-                  if (inFunction == false)
-                    {
-                      startLine = lineNb;
-                      startChar = charNb;
-                    }
-                  inFunction = true;
-                }
-            }
-          if (keyword == "endfunction")
-            {
-               if (inFunction == true)
-                 {
-                   FileChunk chunk (DesignElement::ElemType::Function,
-          startLine, lineNb, startChar, charNb); fileChunks.push_back (chunk);
-                   nbFunction++;
-                 }
-              inFunction = false;
-            }
-          if (keyword == "task")
-            {
-              if ((inClass == 0) && (inInterface == 0) && (inModule == 0))
-                {
-                  if (inTask == false)
-                    {
-                      startLine = lineNb;
-                      startChar = charNb;
-                    }
-                  inTask = true;
-                }
-            }
-          if (keyword == "endtask")
-            {
-               if (inTask == true)
-                 {
-                   FileChunk chunk (DesignElement::ElemType::Task, startLine,
-          lineNb, startChar, charNb); fileChunks.push_back (chunk); nbTask++;
-                 }
-              inTask = false;
-            }
-           */
-          if (keyword == "class" && (prev_keyword != "typedef")) {
+          } else if ((keyword == "class") && (prevKeyword != "typedef")) {
+            // "interface class" opened a class, not an interface
+            if (afterInterface) inInterface--;
             if (inClass == 0) {
               startLine = lineNb;
               startChar = charNb;
             }
             inClass++;
-          }
-          if (keyword == "endclass") {
+          } else if (keyword == "endclass") {
             if (inClass == 1) {
               fileChunks.emplace_back(DesignElement::ElemType::Class, startLine, lineNb, startChar, charNb);
             }
             inClass--;
-          }
-          if (keyword == "interface") {
+          } else if ((keyword == "interface") && (prevKeyword != "virtual") && (parenDepth == 0)) {
+            // Neither a virtual interface nor a generic interface port
             if (inInterface == 0) {
               startLine = lineNb;
               startChar = charNb;
             }
             inInterface++;
-          }
-          if (keyword == "endinterface") {
+            interfaceOpened = true;
+          } else if (keyword == "endinterface") {
             if (inInterface == 1) {
               fileChunks.emplace_back(DesignElement::ElemType::Interface, startLine, lineNb, startChar, charNb);
             }
             inInterface--;
-          }
-          if (keyword == "config") {
+          } else if (keyword == "config") {
             startLine = lineNb;
             startChar = charNb;
             inConfig = true;
-          }
-          if (keyword == "endconfig") {
+          } else if (keyword == "endconfig") {
             if (inConfig) {
               fileChunks.emplace_back(DesignElement::ElemType::Config, startLine, lineNb, startChar, charNb);
             }
             inConfig = false;
-          }
-          if (keyword == "checker") {
+          } else if (keyword == "checker") {
             startLine = lineNb;
             startChar = charNb;
             inChecker = true;
-          }
-          if (keyword == "endchecker") {
+          } else if (keyword == "endchecker") {
             if (inChecker) {
               fileChunks.emplace_back(DesignElement::ElemType::Checker, startLine, lineNb, startChar, charNb);
             }
             inChecker = false;
-          }
-          if (keyword == "program") {
+          } else if (keyword == "program") {
             startLine = lineNb;
             startChar = charNb;
             inProgram = true;
-          }
-          if (keyword == "endprogram") {
+          } else if (keyword == "endprogram") {
             if (inProgram) {
               fileChunks.emplace_back(DesignElement::ElemType::Program, startLine, lineNb, startChar, charNb);
             }
             inProgram = false;
-          }
-          if (keyword == "primitive") {
+          } else if (keyword == "primitive") {
             startLine = lineNb;
             startChar = charNb;
             inPrimitive = true;
-          }
-          if (keyword == "endprimitive") {
+          } else if (keyword == "endprimitive") {
             if (inPrimitive) {
               fileChunks.emplace_back(DesignElement::ElemType::Primitive, startLine, lineNb, startChar, charNb);
             }
             inPrimitive = false;
           }
-          if (!keyword.empty()) {
-            if (!prev_keyword.empty()) {
-              prev_prev_keyword = prev_keyword;
-            }
-            prev_keyword = keyword;
-          }
-          keyword.clear();
         }
+        prevKeyword = keyword;
+      } else {
+        if (c == '(') {
+          parenDepth++;
+        } else if ((c == ')') && (parenDepth > 0)) {
+          parenDepth--;
+        } else if (c == ';') {
+          parenDepth = 0;
+        }
+        ++i;
       }
-      cp = c;
     }
+    // Strings do not span lines unless the new line is escaped
+    if (inString && (line.empty() || (line.back() != '\\'))) inString = false;
 
-    if ((!inPackage) && (!inClass) && (!inModule) && (!inProgram) && (!inInterface) && (!inConfig) && (!inChecker) &&
-        (!inPrimitive) && (!inComment) && (!inString)) {
-      if (std::regex_search(line, pieces_match, import_regex)) {
+    if (hasImport) {
+      importLines.emplace_back(lineNb);
+      if ((!inPackage) && (!inClass) && (!inModule) && (!inProgram) && (!inInterface) && (!inConfig) && (!inChecker) &&
+          (!inPrimitive) && (!inComment)) {
         fileLevelImportSection += line;
       }
     }
   }
 
+  // Import statements of the lines [fromLine, toLine)
+  auto importSectionOf = [&](uint32_t fromLine, uint32_t toLine) {
+    std::string importSection;
+    for (auto it = std::lower_bound(importLines.begin(), importLines.end(), fromLine);
+         (it != importLines.end()) && (*it < toLine); ++it) {
+      StrAppend(&importSection, allLines[*it]);
+    }
+    return importSection;
+  };
+
   uint32_t lineSize = lineNb;
 
-  if (clp->getMaxProcesses() || (lineSize < minNbLineForPartitioning) || (m_nbChunks < 2)) {
+  // Without an explicit -split threshold, the chunk count follows the thread
+  // count, as long as chunks remain large enough to be worth a thread.
+  uint32_t nbChunks = m_nbChunks;
+  const uint32_t minNbLineForPartitioning = clp->getLinesForFileSpliting();
+  if (minNbLineForPartitioning == 0) {
+    nbChunks = std::min(nbChunks, lineSize / kMinLinesPerChunk);
+  } else if (lineSize < minNbLineForPartitioning) {
+    nbChunks = 1;
+  }
+  if (clp->getMaxProcesses() || (m_nbChunks <= 0) || (nbChunks < 2)) {
     m_splitFiles.emplace_back(m_ppFileId);
     m_lineOffsets.push_back(0);
     return;
@@ -379,7 +397,7 @@ void AnalyzeFile::analyze() {
 
   // Split the file
 
-  uint32_t chunkSize = lineSize / m_nbChunks;
+  uint32_t chunkSize = lineSize / nbChunks;
   int32_t chunkNb = 0;
 
   uint32_t fromLine = 1;
@@ -392,16 +410,9 @@ void AnalyzeFile::analyze() {
 
     // The case of a package or a module
     if (chunkType == DesignElement::ElemType::Package || chunkType == DesignElement::ElemType::Module) {
-      std::string packageDeclaration;
-      std::string importSection;
-      uint32_t packagelastLine = fileChunks[i].m_toLine;
-      packageDeclaration = allLines[fileChunks[i].m_fromLine];
-      for (uint32_t hi = fileChunks[i].m_fromLine; hi < fileChunks[i].m_toLine; hi++) {
-        std::string header = allLines[hi];
-        if (std::regex_search(header, pieces_match, import_regex)) {
-          importSection += header;
-        }
-      }
+      const uint32_t packagelastLine = fileChunks[i].m_toLine;
+      const std::string_view packageDeclaration = allLines[fileChunks[i].m_fromLine];
+      const std::string importSection = importSectionOf(fileChunks[i].m_fromLine, fileChunks[i].m_toLine);
       // Break up package or module
       if ((fileChunks[i].m_toLine - fileChunks[i].m_fromLine) > chunkSize) {
         bool splitted = false;
@@ -451,17 +462,10 @@ void AnalyzeFile::analyze() {
             content = sllineInfo;
           }
 
-          bool inString = false;
-          bool inComment = false;
-
           m_lineOffsets.push_back(linesWriten);
 
-          // Detect end of package or end of module
           for (uint32_t l = fromLine; l < toLine; l++) {
-            const std::string& line = allLines[l];
-            checkSLlineDirective_(line, l);
-
-            bool inLineComment = false;
+            checkSLlineDirective_(allLines[l], l);
             StrAppend(&content, allLines[l]);
             if (l == fileChunks[i].m_fromLine) {
               StrAppend(&content, "  ", importSection);
@@ -470,30 +474,10 @@ void AnalyzeFile::analyze() {
               StrAppend(&content, "\n");
             }
             linesWriten++;
-
             actualContent = true;
-            char cp = 0;
-            std::string keyword;
-            for (char c : line) {
-              if (cp == '/' && c == '*') {
-                if (!inLineComment) inComment = true;
-              } else if (cp == '/' && c == '/') {
-                if (!inComment) inLineComment = true;
-              } else if (cp == '*' && c == '/') {
-                inComment = false;
-              } else if (cp != '\\' && c == '\"') {
-                if ((!inLineComment) && (!inComment)) inString = !inString;
-              }
-              if ((!inComment) && (!inLineComment) && (!inString)) {
-                if (std::isalpha(static_cast<unsigned char>(c)) || (c == '_')) {
-                  keyword += c;
-                }
-              }
-              cp = c;
-            }
-            if ((chunkType == DesignElement::Package) && (keyword == "endpackage")) endPackageDetected = true;
-            if ((chunkType == DesignElement::Module) && (keyword == "endmodule")) endPackageDetected = true;
           }
+          // The endpackage/endmodule keyword was located while scanning
+          if ((packagelastLine >= fromLine) && (packagelastLine < toLine)) endPackageDetected = true;
 
           if (actualContent) {
             splitted = true;
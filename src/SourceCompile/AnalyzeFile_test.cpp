@@ -0,0 +1,175 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/SourceCompile/AnalyzeFile.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <uhdm/Serializer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "Surelog/Common/FileSystem.h"
+#include "Surelog/Common/PathId.h"
+#include "Surelog/Common/Session.h"
+#include "Surelog/Design/Design.h"
+#include "Surelog/Design/DesignElement.h"
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+using ::testing::ElementsAre;
+
+namespace {
+struct Chunk final {
+  DesignElement::ElemType m_type;
+  uint64_t m_fromLine;
+  uint64_t m_toLine;
+  bool operator==(const Chunk& rhs) const {
+    return (m_type == rhs.m_type) && (m_fromLine == rhs.m_fromLine) && (m_toLine == rhs.m_toLine);
+  }
+};
+
+std::vector<Chunk> chunksOf(const AnalyzeFile& analyzer) {
+  std::vector<Chunk> chunks;
+  for (const AnalyzeFile::FileChunk& chunk : analyzer.getFileChunks()) {
+    chunks.push_back({chunk.m_chunkType, chunk.m_fromLine, chunk.m_toLine});
+  }
+  return chunks;
+}
+
+size_t countOf(std::string_view text, std::string_view word) {
+  size_t count = 0;
+  for (size_t pos = text.find(word); pos != std::string_view::npos; pos = text.find(word, pos + word.size())) {
+    ++count;
+  }
+  return count;
+}
+
+// modules modules of lines lines each, "module", "endmodule" included
+std::string makeModules(int32_t modules, int32_t lines) {
+  std::string text;
+  for (int32_t m = 0; m < modules; ++m) {
+    text += "module m" + std::to_string(m) + ";\n";
+    for (int32_t l = 2; l < lines; ++l) text += "  logic s" + std::to_string(l) + ";\n";
+    text += "endmodule\n";
+  }
+  return text;
+}
+
+class AnalyzeFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_dir = fs::temp_directory_path() / "surelog_analyzefile_test";
+    std::error_code ec;
+    fs::remove_all(m_dir, ec);
+    fs::create_directories(m_dir, ec);
+    m_ppFileId = m_session.getFileSystem()->toPathId((m_dir / "top.sv").string(), m_session.getSymbolTable());
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    fs::remove_all(m_dir, ec);
+  }
+
+ protected:
+  Session m_session;
+  uhdm::Serializer m_serializer;
+  Design m_design{&m_session, m_serializer, nullptr, nullptr};
+  fs::path m_dir;
+  PathId m_ppFileId;
+};
+
+TEST_F(AnalyzeFileTest, InterfaceKinds) {
+  AnalyzeFile analyzer(&m_session, &m_design, m_ppFileId, m_ppFileId, 1,
+                       "interface bus_if(input logic clk);\n"
+                       "  logic valid;\n"
+                       "endinterface\n"
+                       "module top(interface port, input logic clk);\n"
+                       "  virtual bus_if v1;\n"
+                       "  virtual interface bus_if v2;\n"
+                       "endmodule\n"
+                       "interface class listener;\n"
+                       "  pure virtual function void notify();\n"
+                       "endclass\n");
+  analyzer.analyze();
+  // Neither the generic interface port nor the virtual interfaces open an
+  // interface, the interface class is a class
+  EXPECT_THAT(chunksOf(analyzer), ElementsAre(Chunk{DesignElement::ElemType::Interface, 1, 3},
+                                              Chunk{DesignElement::ElemType::Module, 4, 7},
+                                              Chunk{DesignElement::ElemType::Class, 8, 10}));
+}
+
+TEST_F(AnalyzeFileTest, SkipsStringsAndComments) {
+  AnalyzeFile analyzer(&m_session, &m_design, m_ppFileId, m_ppFileId, 1,
+                       "// module commented_out;\n"
+                       "/* package hidden;\n"
+                       "   endpackage */\n"
+                       "module top;\n"
+                       "  string s = \"endmodule \\\"module\\\" package\";\n"
+                       "  initial $display(\"interface\"); /* endmodule */ // endmodule\n"
+                       "endmodule\n"
+                       "package real_pkg;\n"
+                       "endpackage\n");
+  analyzer.analyze();
+  EXPECT_THAT(chunksOf(analyzer),
+              ElementsAre(Chunk{DesignElement::ElemType::Module, 4, 7}, Chunk{DesignElement::ElemType::Package, 8, 9}));
+  EXPECT_THAT(m_design.getOrderedPackageNames(), ElementsAre("real_pkg"));
+}
+
+TEST_F(AnalyzeFileTest, ChunkBoundaries) {
+  FileSystem* const fileSystem = m_session.getFileSystem();
+  {
+    // With the default -split of 0, files shorter than two chunks of the
+    // minimum size are left whole whatever the thread count
+    AnalyzeFile analyzer(&m_session, &m_design, m_ppFileId, m_ppFileId, 4, makeModules(4, 4000));
+    analyzer.analyze();
+    EXPECT_THAT(analyzer.getSplitFiles(), ElementsAre(m_ppFileId));
+    EXPECT_THAT(analyzer.getLineOffsets(), ElementsAre(0));
+  }
+  {
+    // Long enough for two chunks, every module starts a chunk of its own
+    AnalyzeFile analyzer(&m_session, &m_design, m_ppFileId, m_ppFileId, 4, makeModules(4, 12000));
+    analyzer.analyze();
+    EXPECT_EQ(analyzer.getFileChunks().size(), 4);
+    ASSERT_EQ(analyzer.getSplitFiles().size(), 4);
+    EXPECT_THAT(analyzer.getLineOffsets(), ElementsAre(0, 12000, 24000, 36000));
+    for (int32_t i = 0; i < 4; ++i) {
+      std::string content;
+      ASSERT_TRUE(fileSystem->readContent(analyzer.getSplitFiles()[i], content));
+      EXPECT_EQ(countOf(content, "module m" + std::to_string(i) + ";"), 1);
+      EXPECT_EQ(countOf(content, "endmodule"), 1);
+    }
+  }
+}
+
+TEST_F(AnalyzeFileTest, ExplicitSplitThreshold) {
+  const char* const args[] = {"surelog", "-nostdout", "-split", "100000"};
+  m_session.parseCommandLine(static_cast<int32_t>(std::size(args)), args, false, false);
+
+  AnalyzeFile analyzer(&m_session, &m_design, m_ppFileId, m_ppFileId, 4, makeModules(4, 12000));
+  analyzer.analyze();
+  EXPECT_THAT(analyzer.getSplitFiles(), ElementsAre(m_ppFileId));
+}
+}  // namespace
+}  // namespace SURELOG
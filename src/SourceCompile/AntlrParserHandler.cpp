@@ -28,6 +28,7 @@
 #include <parser/SV3_1aParser.h>
 
 #include "Surelog/SourceCompile/AntlrParserErrorListener.h"
+#include "Surelog/SourceCompile/SV3_1aFastLexer.h"
 
 namespace SURELOG {
 
@@ -36,12 +37,13 @@ AntlrParserHandler::~AntlrParserHandler() {
   // ParseTree is deleted in antlr4::ParseTreeTracker
   // delete m_tree; // INVALID MEMORY READ can be seen in AdvancedDebug
   if (m_clearAntlrCache) {
-    m_lexer->getInterpreter<antlr4::atn::LexerATNSimulator>()->clearDFA();
+    if (m_lexer != nullptr) m_lexer->getInterpreter<antlr4::atn::LexerATNSimulator>()->clearDFA();
     m_parser->getInterpreter<antlr4::atn::ParserATNSimulator>()->clearDFA();
   }
   delete m_parser;
   delete m_tokens;
   delete m_lexer;
+  delete m_fastLexer;
   delete m_inputStream;
 }
 }  // namespace SURELOG
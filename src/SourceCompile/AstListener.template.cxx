@@ -25,7 +25,7 @@
 
 #include <Surelog/Common/FileSystem.h>
 #include <Surelog/Common/Session.h>
-#include <Surelog/Design/VObject.h>
+#include <Surelog/Design/VObjectStore.h>
 #include <Surelog/SourceCompile/AstListener.h>
 #include <Surelog/SourceCompile/SymbolTable.h>
 
@@ -35,36 +35,37 @@
 #include <vector>
 
 namespace SURELOG {
-AstListener::AstListener(const AstListener& rhs)
-    : m_session(rhs.m_session), m_objects(rhs.m_objects), m_count(rhs.m_count) {}
+AstListener::AstListener(const AstListener& rhs) : m_session(rhs.m_session), m_objects(rhs.m_objects) {}
 
 VObjectType AstListener::getNodeType(const AstNode& node) const {
-  return node ? node.m_object->m_type : VObjectType::_INVALID_;
+  return node ? m_objects->type(node.m_index) : VObjectType::_INVALID_;
 }
 
 AstNode AstListener::getRootNode() const {
-  int32_t index = static_cast<int32_t>(m_count);
+  if (m_objects == nullptr) return AstNode();
+  int32_t index = static_cast<int32_t>(m_objects->size());
   while (--index >= 0) {
-    if ((m_objects[index].m_type == VObjectType::ppTop_level_rule) ||
-        (m_objects[index].m_type == VObjectType::paTop_level_rule) ||
-        (m_objects[index].m_type == VObjectType::paTop_level_library_rule)) {
-      return AstNode(NodeId(index), &m_objects[index]);
+    const NodeId id(index);
+    if ((m_objects->type(id) == VObjectType::ppTop_level_rule) ||
+        (m_objects->type(id) == VObjectType::paTop_level_rule) ||
+        (m_objects->type(id) == VObjectType::paTop_level_library_rule)) {
+      return AstNode(id, m_objects);
     }
   }
   return AstNode();
 }
 
 bool AstListener::getNodeText(const AstNode& node, std::string& text) const {
-  if (node && node.m_object->m_name) {
-    text = m_session->getSymbolTable()->getSymbol(node.m_object->m_name);
+  if (node && m_objects->name(node.m_index)) {
+    text = m_session->getSymbolTable()->getSymbol(m_objects->name(node.m_index));
     return true;
   }
   return false;
 }
 
 bool AstListener::getNodeText(const AstNode& node, std::string_view& text) const {
-  if (node && node.m_object->m_name) {
-    text = m_session->getSymbolTable()->getSymbol(node.m_object->m_name);
+  if (node && m_objects->name(node.m_index)) {
+    text = m_session->getSymbolTable()->getSymbol(m_objects->name(node.m_index));
     return true;
   }
   return false;
@@ -72,7 +73,7 @@ bool AstListener::getNodeText(const AstNode& node, std::string_view& text) const
 
 bool AstListener::getNodeFileId(const AstNode& node, PathId& fileId) const {
   if (node) {
-    fileId = node.m_object->m_fileId;
+    fileId = m_objects->fileId(node.m_index);
     return true;
   }
   return false;
@@ -81,10 +82,11 @@ bool AstListener::getNodeFileId(const AstNode& node, PathId& fileId) const {
 bool AstListener::getNodeLocation(const AstNode& node, int32_t& startLine, int32_t& startColumn, int32_t& endLine,
                                   int32_t& endColumn) const {
   if (node) {
-    startLine = node.m_object->m_startLine;
-    startColumn = node.m_object->m_startColumn;
-    endLine = node.m_object->m_endLine;
-    endColumn = node.m_object->m_endColumn;
+    const VObjectStore::Location& location = m_objects->location(node.m_index);
+    startLine = location.m_startLine;
+    startColumn = location.m_startColumn;
+    endLine = location.m_endLine;
+    endColumn = location.m_endColumn;
     return true;
   }
   return false;
@@ -101,17 +103,17 @@ bool AstListener::getNodeEndLocation(const AstNode& node, int32_t& line, int32_t
 }
 
 AstNode AstListener::getNodeParent(const AstNode& node) const {
-  if (node && node.m_object->m_parent) {
-    return AstNode(node.m_object->m_parent, &m_objects[node.m_object->m_parent]);
+  if (node && m_objects->parent(node.m_index)) {
+    return AstNode(m_objects->parent(node.m_index), m_objects);
   }
   return AstNode();
 }
 
 AstNode AstListener::getNodeParent(const AstNode& node, VObjectType type) const {
   if (node) {
-    for (NodeId parentId = m_objects[node.m_index].m_parent; parentId; parentId = m_objects[parentId].m_parent) {
-      if (m_objects[parentId].m_type == type) {
-        return AstNode(parentId, &m_objects[parentId]);
+    for (NodeId parentId = m_objects->parent(node.m_index); parentId; parentId = m_objects->parent(parentId)) {
+      if (m_objects->type(parentId) == type) {
+        return AstNode(parentId, m_objects);
       }
     }
   }
@@ -120,9 +122,9 @@ AstNode AstListener::getNodeParent(const AstNode& node, VObjectType type) const
 
 AstNode AstListener::getNodeParent(const AstNode& node, const std::set<VObjectType>& types) const {
   if (node) {
-    for (NodeId parentId = m_objects[node.m_index].m_parent; parentId; parentId = m_objects[parentId].m_parent) {
-      if (types.find(m_objects[parentId].m_type) != types.cend()) {
-        return AstNode(parentId, &m_objects[parentId]);
+    for (NodeId parentId = m_objects->parent(node.m_index); parentId; parentId = m_objects->parent(parentId)) {
+      if (types.find(m_objects->type(parentId)) != types.cend()) {
+        return AstNode(parentId, m_objects);
       }
     }
   }
@@ -130,45 +132,45 @@ AstNode AstListener::getNodeParent(const AstNode& node, const std::set<VObjectTy
 }
 
 AstNode AstListener::getNodePrevSibling(const AstNode& node) const {
-  if (node && node.m_object->m_parent) {
-    NodeId id = m_objects[node.m_object->m_parent].m_child;
+  if (node && m_objects->parent(node.m_index)) {
+    NodeId id = m_objects->child(m_objects->parent(node.m_index));
     NodeId pid;
     while (id && (id != node.m_index)) {
       pid = id;
-      id = m_objects[id].m_sibling;
+      id = m_objects->sibling(id);
     }
     if (pid && (id == node.m_index)) {
-      return AstNode(pid, &m_objects[pid]);
+      return AstNode(pid, m_objects);
     }
   }
   return AstNode();
 }
 
 AstNode AstListener::getNodePrevSibling(const AstNode& node, VObjectType type) const {
-  if (node && node.m_object->m_parent) {
-    NodeId id = m_objects[node.m_object->m_parent].m_child;
+  if (node && m_objects->parent(node.m_index)) {
+    NodeId id = m_objects->child(m_objects->parent(node.m_index));
     NodeId pid;
     while (id && (id != node.m_index)) {
-      if (m_objects[id].m_type == type) pid = id;
-      id = m_objects[id].m_sibling;
+      if (m_objects->type(id) == type) pid = id;
+      id = m_objects->sibling(id);
     }
     if (pid && (id == node.m_index)) {
-      return AstNode(pid, &m_objects[pid]);
+      return AstNode(pid, m_objects);
     }
   }
   return AstNode();
 }
 
 AstNode AstListener::getNodePrevSibling(const AstNode& node, const std::set<VObjectType>& types) const {
-  if (node && node.m_object->m_parent) {
-    NodeId id = m_objects[node.m_object->m_parent].m_child;
+  if (node && m_objects->parent(node.m_index)) {
+    NodeId id = m_objects->child(m_objects->parent(node.m_index));
     NodeId pid;
     while (id && (id != node.m_index)) {
-      if (types.find(m_objects[id].m_type) != types.cend()) pid = id;
-      id = m_objects[id].m_sibling;
+      if (types.find(m_objects->type(id)) != types.cend()) pid = id;
+      id = m_objects->sibling(id);
     }
     if (pid && (id == node.m_index)) {
-      return AstNode(pid, &m_objects[pid]);
+      return AstNode(pid, m_objects);
     }
   }
   return AstNode();
@@ -176,18 +178,18 @@ AstNode AstListener::getNodePrevSibling(const AstNode& node, const std::set<VObj
 
 AstNode AstListener::getNodeNextSibling(const AstNode& node) const {
   if (node) {
-    if (NodeId nid = m_objects[node.m_index].m_sibling) {
-      return AstNode(nid, &m_objects[nid]);
+    if (NodeId nid = m_objects->sibling(node.m_index)) {
+      return AstNode(nid, m_objects);
     }
   }
   return AstNode();
 }
 
 AstNode AstListener::getNodeNextSibling(const AstNode& node, VObjectType type) const {
-  if (node && node.m_object->m_sibling) {
-    for (NodeId siblingId = m_objects[node.m_index].m_sibling; siblingId; siblingId = m_objects[siblingId].m_sibling) {
-      if (m_objects[siblingId].m_type == type) {
-        return AstNode(siblingId, &m_objects[siblingId]);
+  if (node && m_objects->sibling(node.m_index)) {
+    for (NodeId siblingId = m_objects->sibling(node.m_index); siblingId; siblingId = m_objects->sibling(siblingId)) {
+      if (m_objects->type(siblingId) == type) {
+        return AstNode(siblingId, m_objects);
       }
     }
   }
@@ -195,10 +197,10 @@ AstNode AstListener::getNodeNextSibling(const AstNode& node, VObjectType type) c
 }
 
 AstNode AstListener::getNodeNextSibling(const AstNode& node, const std::set<VObjectType>& types) const {
-  if (node && node.m_object->m_sibling) {
-    for (NodeId siblingId = m_objects[node.m_index].m_sibling; siblingId; siblingId = m_objects[siblingId].m_sibling) {
-      if (types.find(m_objects[siblingId].m_type) != types.cend()) {
-        return AstNode(siblingId, &m_objects[siblingId]);
+  if (node && m_objects->sibling(node.m_index)) {
+    for (NodeId siblingId = m_objects->sibling(node.m_index); siblingId; siblingId = m_objects->sibling(siblingId)) {
+      if (types.find(m_objects->type(siblingId)) != types.cend()) {
+        return AstNode(siblingId, m_objects);
       }
     }
   }
@@ -207,10 +209,10 @@ AstNode AstListener::getNodeNextSibling(const AstNode& node, const std::set<VObj
 
 bool AstListener::getNodeChildren(const AstNode& node, astnode_vector_t& children) const {
   if (!node) return false;
-  if (!node.m_object->m_child) return true;
+  if (!m_objects->child(node.m_index)) return true;
 
-  for (NodeId id = node.m_object->m_child; id; id = m_objects[id].m_sibling) {
-    children.emplace_back(id, &m_objects[id]);
+  for (NodeId id = m_objects->child(node.m_index); id; id = m_objects->sibling(id)) {
+    children.emplace_back(id, m_objects);
   }
 
   return true;
@@ -218,13 +220,12 @@ bool AstListener::getNodeChildren(const AstNode& node, astnode_vector_t& childre
 
 bool AstListener::getNodeSiblings(const AstNode& node, astnode_vector_t& siblings) const {
   if (!node) return false;
-  if (!node.m_object->m_parent) return true;
+  if (!m_objects->parent(node.m_index)) return true;
 
-  const VObject& parent = m_objects[node.m_object->m_parent];
 
-  for (NodeId id = parent.m_child; id; id = m_objects[id].m_sibling) {
+  for (NodeId id = m_objects->child(m_objects->parent(node.m_index)); id; id = m_objects->sibling(id)) {
     if (id != node.m_index) {
-      siblings.emplace_back(id, &m_objects[id]);
+      siblings.emplace_back(id, m_objects);
     }
   }
 
@@ -238,12 +239,12 @@ AstNode AstListener::getNodeOfTypeInTree(const AstNode& node, VObjectType type,
   while (!queue.empty()) {
     const auto& [nodeId, nodeDepth] = queue.front();
 
-    if (m_objects[nodeId].m_type == type) {
-      return AstNode(nodeId, &m_objects[nodeId]);
+    if (m_objects->type(nodeId) == type) {
+      return AstNode(nodeId, m_objects);
     }
 
     if (nodeDepth < depth) {
-      for (NodeId childId = m_objects[nodeId].m_child; childId; childId = m_objects[childId].m_sibling) {
+      for (NodeId childId = m_objects->child(nodeId); childId; childId = m_objects->sibling(childId)) {
         queue.emplace_back(childId, nodeDepth + 1);
       }
     }
@@ -261,12 +262,12 @@ AstNode AstListener::getNodeOfTypeInTree(const AstNode& node, const std::set<VOb
   while (!queue.empty()) {
     const auto& [nodeId, nodeDepth] = queue.front();
 
-    if (types.find(m_objects[nodeId].m_type) != types.cend()) {
-      return AstNode(nodeId, &m_objects[nodeId]);
+    if (types.find(m_objects->type(nodeId)) != types.cend()) {
+      return AstNode(nodeId, m_objects);
     }
 
     if (nodeDepth < depth) {
-      for (NodeId childId = m_objects[nodeId].m_child; childId; childId = m_objects[childId].m_sibling) {
+      for (NodeId childId = m_objects->child(nodeId); childId; childId = m_objects->sibling(childId)) {
         queue.emplace_back(childId, nodeDepth + 1);
       }
     }
@@ -277,17 +278,17 @@ AstNode AstListener::getNodeOfTypeInTree(const AstNode& node, const std::set<VOb
 }
 
 AstNode AstListener::getNodeChild(const AstNode& node) const {
-  if (node && node.m_object->m_child) {
-    return AstNode(node.m_object->m_child, &m_objects[node.m_object->m_child]);
+  if (node && m_objects->child(node.m_index)) {
+    return AstNode(m_objects->child(node.m_index), m_objects);
   }
   return AstNode();
 }
 
 AstNode AstListener::getNodeChild(const AstNode& node, VObjectType type) const {
-  if (node && node.m_object->m_child) {
-    for (NodeId childId = m_objects[node.m_index].m_child; childId; childId = m_objects[childId].m_sibling) {
-      if (m_objects[childId].m_type == type) {
-        return AstNode(childId, &m_objects[childId]);
+  if (node && m_objects->child(node.m_index)) {
+    for (NodeId childId = m_objects->child(node.m_index); childId; childId = m_objects->sibling(childId)) {
+      if (m_objects->type(childId) == type) {
+        return AstNode(childId, m_objects);
       }
     }
   }
@@ -295,10 +296,10 @@ AstNode AstListener::getNodeChild(const AstNode& node, VObjectType type) const {
 }
 
 AstNode AstListener::getNodeChild(const AstNode& node, const std::set<VObjectType>& types) const {
-  if (node && node.m_object->m_child) {
-    for (NodeId childId = m_objects[node.m_index].m_child; childId; childId = m_objects[childId].m_sibling) {
-      if (types.find(m_objects[childId].m_type) != types.cend()) {
-        return AstNode(childId, &m_objects[childId]);
+  if (node && m_objects->child(node.m_index)) {
+    for (NodeId childId = m_objects->child(node.m_index); childId; childId = m_objects->sibling(childId)) {
+      if (types.find(m_objects->type(childId)) != types.cend()) {
+        return AstNode(childId, m_objects);
       }
     }
   }
@@ -307,8 +308,8 @@ AstNode AstListener::getNodeChild(const AstNode& node, const std::set<VObjectTyp
 
 size_t AstListener::getNodeChildCount(const AstNode& node) const {
   size_t count = 0;
-  if (node && node.m_object->m_child) {
-    for (NodeId childId = m_objects[node.m_index].m_child; childId; childId = m_objects[childId].m_sibling) {
+  if (node && m_objects->child(node.m_index)) {
+    for (NodeId childId = m_objects->child(node.m_index); childId; childId = m_objects->sibling(childId)) {
       ++count;
     }
   }
@@ -317,9 +318,9 @@ size_t AstListener::getNodeChildCount(const AstNode& node) const {
 
 size_t AstListener::getNodeChildCount(const AstNode& node, VObjectType type) const {
   size_t count = 0;
-  if (node && node.m_object->m_child) {
-    for (NodeId childId = m_objects[node.m_index].m_child; childId; childId = m_objects[childId].m_sibling) {
-      if (m_objects[childId].m_type == type) ++count;
+  if (node && m_objects->child(node.m_index)) {
+    for (NodeId childId = m_objects->child(node.m_index); childId; childId = m_objects->sibling(childId)) {
+      if (m_objects->type(childId) == type) ++count;
     }
   }
   return count;
@@ -327,29 +328,29 @@ size_t AstListener::getNodeChildCount(const AstNode& node, VObjectType type) con
 
 size_t AstListener::getNodeChildCount(const AstNode& node, const std::set<VObjectType>& types) const {
   size_t count = 0;
-  if (node && node.m_object->m_child) {
-    for (NodeId childId = m_objects[node.m_index].m_child; childId; childId = m_objects[childId].m_sibling) {
-      if (types.find(m_objects[childId].m_type) != types.cend()) ++count;
+  if (node && m_objects->child(node.m_index)) {
+    for (NodeId childId = m_objects->child(node.m_index); childId; childId = m_objects->sibling(childId)) {
+      if (types.find(m_objects->type(childId)) != types.cend()) ++count;
     }
   }
   return count;
 }
 
 size_t AstListener::getNodeSiblingCount(const AstNode& node) const {
-  return (node && node.m_object->m_parent)
-             ? (getNodeChildCount(AstNode(node.m_object->m_parent, &m_objects[node.m_object->m_parent])) - 1)
+  return (node && m_objects->parent(node.m_index))
+             ? (getNodeChildCount(AstNode(m_objects->parent(node.m_index), m_objects)) - 1)
              : 0;
 }
 
 size_t AstListener::getNodeSiblingCount(const AstNode& node, VObjectType type) const {
-  return (node && node.m_object->m_parent)
-             ? (getNodeChildCount(AstNode(node.m_object->m_parent, &m_objects[node.m_object->m_parent]), type) - 1)
+  return (node && m_objects->parent(node.m_index))
+             ? (getNodeChildCount(AstNode(m_objects->parent(node.m_index), m_objects), type) - 1)
              : 0;
 }
 
 size_t AstListener::getNodeSiblingCount(const AstNode& node, const std::set<VObjectType>& types) const {
-  return (node && node.m_object->m_parent)
-             ? (getNodeChildCount(AstNode(node.m_object->m_parent, &m_objects[node.m_object->m_parent]), types) - 1)
+  return (node && m_objects->parent(node.m_index))
+             ? (getNodeChildCount(AstNode(m_objects->parent(node.m_index), m_objects), types) - 1)
              : 0;
 }
 
@@ -357,7 +358,7 @@ size_t AstListener::getNodeCountInTree(const NodeId& id) const {
   size_t count = 0;
   if (id) {
     count += 1;
-    for (NodeId childId = m_objects[id].m_child; childId; childId = m_objects[childId].m_sibling) {
+    for (NodeId childId = m_objects->child(id); childId; childId = m_objects->sibling(childId)) {
       count += getNodeCountInTree(childId);
     }
   }
@@ -366,8 +367,8 @@ size_t AstListener::getNodeCountInTree(const NodeId& id) const {
 size_t AstListener::getNodeCountInTree(const NodeId& id, VObjectType type) const {
   size_t count = 0;
   if (id) {
-    if (m_objects[id].m_type == type) count += 1;
-    for (NodeId childId = m_objects[id].m_child; childId; childId = m_objects[childId].m_sibling) {
+    if (m_objects->type(id) == type) count += 1;
+    for (NodeId childId = m_objects->child(id); childId; childId = m_objects->sibling(childId)) {
       count += getNodeCountInTree(childId, type);
     }
   }
@@ -376,8 +377,8 @@ size_t AstListener::getNodeCountInTree(const NodeId& id, VObjectType type) const
 size_t AstListener::getNodeCountInTree(const NodeId& id, const std::set<VObjectType>& types) const {
   size_t count = 0;
   if (id) {
-    if (types.find(m_objects[id].m_type) != types.cend()) count += 1;
-    for (NodeId childId = m_objects[id].m_child; childId; childId = m_objects[childId].m_sibling) {
+    if (types.find(m_objects->type(id)) != types.cend()) count += 1;
+    for (NodeId childId = m_objects->child(id); childId; childId = m_objects->sibling(childId)) {
       count += getNodeCountInTree(childId, types);
     }
   }
@@ -397,11 +398,10 @@ void AstListener::enterSourceFile(Session* session, PathId fileId, const std::st
   m_session = session;
 }
 
-void AstListener::listen(Session* session, PathId fileId, const std::string& sourceText, const VObject* objects,
-                         size_t count) {
+void AstListener::listen(Session* session, PathId fileId, const std::string& sourceText,
+                         const VObjectStore& objects) {
   m_session = session;
-  m_objects = objects;
-  m_count = count;
+  m_objects = &objects;
 
   enterSourceFile(session, fileId, sourceText);
   if (const AstNode rootNode = getRootNode()) {
@@ -411,35 +411,34 @@ void AstListener::listen(Session* session, PathId fileId, const std::string& sou
 }
 
 void AstListener::listenChildren(const AstNode& node) {
-  if (!node || !node.m_object->m_child) return;
+  if (!node || !m_objects->child(node.m_index)) return;
 
-  for (NodeId id = node.m_object->m_child; id; id = m_objects[id].m_sibling) {
-    const AstNode childNode(id, &m_objects[id]);
+  for (NodeId id = m_objects->child(node.m_index); id; id = m_objects->sibling(id)) {
+    const AstNode childNode(id, m_objects);
     listen(childNode);
   }
 }
 
 void AstListener::listenSiblings(const AstNode& node) {
-  if (!node || !node.m_object->m_parent) return;
+  if (!node || !m_objects->parent(node.m_index)) return;
 
-  const VObject& parent = m_objects[node.m_object->m_parent];
 
-  for (NodeId id = parent.m_child; id; id = m_objects[id].m_sibling) {
+  for (NodeId id = m_objects->child(m_objects->parent(node.m_index)); id; id = m_objects->sibling(id)) {
     if (id != node.m_index) {
-      const AstNode siblingNode(id, &m_objects[id]);
+      const AstNode siblingNode(id, m_objects);
       listen(siblingNode);
     }
   }
 }
 
 inline size_t AstListener::markVisited(const NodeId& id) {
-  return id ? (m_visited.emplace(id).second ? 1 : 0) + markVisited(m_objects[id].m_child) +
-                  markVisited(m_objects[id].m_sibling)
+  return id ? (m_visited.emplace(id).second ? 1 : 0) + markVisited(m_objects->child(id)) +
+                  markVisited(m_objects->sibling(id))
             : 0;
 }
 
 inline size_t AstListener::clearVisited(const NodeId& id) {
-  return id ? m_visited.erase(id) + clearVisited(m_objects[id].m_child) + clearVisited(m_objects[id].m_sibling) : 0;
+  return id ? m_visited.erase(id) + clearVisited(m_objects->child(id)) + clearVisited(m_objects->sibling(id)) : 0;
 }
 
 size_t AstListener::markVisited(const AstNode& node, bool includeSubTree) {
@@ -455,8 +454,8 @@ size_t AstListener::clearVisited(const AstNode& node, bool includeSubTree) {
 
 size_t AstListener::markChildrenVisited(const AstNode& node, bool includeSubTree) {
   size_t count = 0;
-  if (node && node.m_object->m_child) {
-    for (NodeId childId = m_objects[node.m_index].m_child; childId; childId = m_objects[childId].m_sibling) {
+  if (node && m_objects->child(node.m_index)) {
+    for (NodeId childId = m_objects->child(node.m_index); childId; childId = m_objects->sibling(childId)) {
       count += includeSubTree ? markVisited(childId) : (m_visited.emplace(childId).second ? 1 : 0);
     }
   }
@@ -464,8 +463,8 @@ size_t AstListener::markChildrenVisited(const AstNode& node, bool includeSubTree
 }
 size_t AstListener::clearVisitedChildren(const AstNode& node, bool includeSubTree) {
   size_t count = 0;
-  if (node && node.m_object->m_child) {
-    for (NodeId childId = m_objects[node.m_index].m_child; childId; childId = m_objects[childId].m_sibling) {
+  if (node && m_objects->child(node.m_index)) {
+    for (NodeId childId = m_objects->child(node.m_index); childId; childId = m_objects->sibling(childId)) {
       count += includeSubTree ? clearVisited(childId) : m_visited.erase(childId);
     }
   }
@@ -482,7 +481,7 @@ void AstListener::listen(const AstNode& node) {
   }
 
   // clang-format off
-  switch (node.m_object->m_type) {
+  switch (m_objects->type(node.m_index)) {
 //<LISTEN_CASE_STATEMENTS>
     default: break;
   };
@@ -69,7 +69,7 @@ bool CheckCompile::mergeSymbolTables_() {
 
     fileSystem->copy(fileContent->getFileId(), symbols);
     for (NodeId id : fileContent->getNodeIds()) {
-      *fileContent->getMutableFileId(id) = fileSystem->copy(fileContent->getFileId(id), symbols);
+      fileContent->setFileId(id, fileSystem->copy(fileContent->getFileId(id), symbols));
     }
     for (DesignElement* elem : fileContent->getDesignElements()) {
       elem->m_name = symbols->registerSymbol(fileContentSymbols->getSymbol(elem->m_name));
@@ -33,6 +33,8 @@
 #include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/DesignElement.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/VObject.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/SourceCompile/VObjectTypes.h"
 #include "Surelog/Utils/StringUtils.h"
 
@@ -55,22 +57,22 @@ NodeId CommonListenerHelper::NodeIdFromContext(const ParseTree* tree) const {
   return (found == m_contextToObjectMap.end()) ? InvalidNodeId : found->second;
 }
 
-const VObject& CommonListenerHelper::Object(NodeId index) { return m_fileContent->Object(index); }
+VObject CommonListenerHelper::Object(NodeId index) { return m_fileContent->Object(index); }
 
 NodeId CommonListenerHelper::UniqueId(NodeId index) const { return index; }
 
 SymbolId CommonListenerHelper::Name(NodeId index) const { return m_fileContent->Name(index); }
 
 NodeId CommonListenerHelper::Child(NodeId index) const { return m_fileContent->Child(index); }
-NodeId& CommonListenerHelper::MutableChild(NodeId index) { return m_fileContent->MutableObject(index)->m_child; }
+NodeId& CommonListenerHelper::MutableChild(NodeId index) { return m_fileContent->MutableObject(index).m_child; }
 
 NodeId CommonListenerHelper::Sibling(NodeId index) const { return m_fileContent->Sibling(index); }
-NodeId& CommonListenerHelper::MutableSibling(NodeId index) { return m_fileContent->MutableObject(index)->m_sibling; }
+NodeId& CommonListenerHelper::MutableSibling(NodeId index) { return m_fileContent->MutableObject(index).m_sibling; }
 
 NodeId CommonListenerHelper::Definition(NodeId index) const { return m_fileContent->Definition(index); }
 
 NodeId CommonListenerHelper::Parent(NodeId index) const { return m_fileContent->Parent(index); }
-NodeId& CommonListenerHelper::MutableParent(NodeId index) { return m_fileContent->MutableObject(index)->m_parent; }
+NodeId& CommonListenerHelper::MutableParent(NodeId index) { return m_fileContent->MutableObject(index).m_parent; }
 
 VObjectType CommonListenerHelper::Type(NodeId index) const { return m_fileContent->Type(index); }
 
@@ -83,10 +85,10 @@ NodeId CommonListenerHelper::addVObject(ParseTree* tree, SymbolId sym, VObjectTy
   auto [fid, sl, sc, el, ec] = getFileLine(tree, nullptr);
 
   NodeId objectIndex = m_fileContent->addObject(sym, fid, objtype, sl, sc, el, ec);
-  VObject* const inserted = m_fileContent->MutableObject(objectIndex);
+  VObjectStore::Reference inserted = m_fileContent->MutableObject(objectIndex);
   PathId ppFileId;
-  std::tie(ppFileId, inserted->m_ppStartLine, inserted->m_ppStartColumn, inserted->m_ppEndLine,
-           inserted->m_ppEndColumn) = getPPFileLine(tree, nullptr);
+  std::tie(ppFileId, inserted.m_ppStartLine, inserted.m_ppStartColumn, inserted.m_ppEndLine,
+           inserted.m_ppEndColumn) = getPPFileLine(tree, nullptr);
   addNodeIdForContext(tree, objectIndex);
   if (!skipParenting) addParentChildRelations(tree, objectIndex);
   std::vector<SURELOG::DesignElement*>& delements = m_fileContent->getDesignElements();
@@ -94,9 +96,9 @@ NodeId CommonListenerHelper::addVObject(ParseTree* tree, SymbolId sym, VObjectTy
     if ((*it)->m_context == tree) {
       // Use the file and line number of the design object (package, module),
       // true file/line when splitting
-      inserted->m_fileId = (*it)->m_fileId;
-      inserted->m_startLine = (*it)->m_startLine;
-      inserted->m_endLine = (*it)->m_endLine;
+      m_fileContent->setFileId(objectIndex, (*it)->m_fileId);
+      inserted.m_startLine = (*it)->m_startLine;
+      inserted.m_endLine = (*it)->m_endLine;
       (*it)->m_node = NodeId(objectIndex);
       break;
     }
@@ -116,34 +118,43 @@ NodeId CommonListenerHelper::addVObject(ParseTree* tree, VObjectType objtype, bo
 void CommonListenerHelper::addNodeIdForContext(const ParseTree* tree, NodeId nodeId) {
   auto [it, succeeded] = m_contextToObjectMap.emplace(tree, nodeId);
   if (!succeeded) {
-    std::vector<VObject>& objects = *m_fileContent->mutableVObjects();
+    VObjectStore& objects = *m_fileContent->mutableVObjects();
     NodeId tid = it->second;
-    while (tid && objects[tid].m_sibling) {
-      tid = objects[tid].m_sibling;
+    while (tid && objects.sibling(tid)) {
+      tid = objects.sibling(tid);
     }
-    objects[tid].m_sibling = nodeId;
+    objects.sibling(tid) = nodeId;
   }
 }
 
 void CommonListenerHelper::addParentChildRelations(const ParseTree* tree, NodeId parentId) {
-  std::vector<VObject>& objects = *m_fileContent->mutableVObjects();
-  VObject& parent = objects[parentId];
+  VObjectStore& objects = *m_fileContent->mutableVObjects();
 
   NodeId tailId = parentId;
   for (ParseTree* subtree : tree->children) {
     NodeId childId = NodeIdFromContext(subtree);
     while (childId) {
-      VObject& child = objects[childId];
-      child.m_parent = parentId;
+      objects.parent(childId) = parentId;
       if (parentId == tailId) {
-        parent.m_child = childId;
+        objects.child(parentId) = childId;
       } else {
-        VObject& tail = objects[tailId];
-        tail.m_sibling = childId;
+        objects.sibling(tailId) = childId;
       }
       tailId = childId;
-      childId = child.m_sibling;
+      childId = objects.sibling(childId);
     }
   }
 }
+
+void CommonListenerHelper::releaseSubTree(ParseTree* tree) {
+  std::vector<ParseTree*> stack(tree->children.cbegin(), tree->children.cend());
+  std::vector<ParseTree*>().swap(tree->children);
+  while (!stack.empty()) {
+    ParseTree* const subtree = stack.back();
+    stack.pop_back();
+    m_contextToObjectMap.erase(subtree);
+    stack.insert(stack.end(), subtree->children.cbegin(), subtree->children.cend());
+    std::vector<ParseTree*>().swap(subtree->children);
+  }
+}
 }  // namespace SURELOG
@@ -22,6 +22,8 @@
  */
 #include "Surelog/SourceCompile/CompilationUnit.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 #include <vector>
@@ -53,10 +55,14 @@ void CompilationUnit::registerMacroInfo(MacroInfo* macro) { m_macros.emplace_bac
 void CompilationUnit::recordTimeInfo(TimeInfo& info) { m_timeInfo.emplace_back(info); }
 
 TimeInfo& CompilationUnit::getTimeInfo(PathId fileId, uint32_t line) {
+  return getTimeInfo(fileId, line, m_timeInfo.size());
+}
+
+TimeInfo& CompilationUnit::getTimeInfo(PathId fileId, uint32_t line, size_t count) {
   if (m_timeInfo.empty()) {
     return m_noTimeInfo;
   }
-  for (int32_t i = (int32_t)m_timeInfo.size() - 1; i >= 0; i--) {
+  for (int32_t i = (int32_t)std::min(count, m_timeInfo.size()) - 1; i >= 0; i--) {
     TimeInfo& info = m_timeInfo[i];
     if (info.m_fileId == fileId) {
       if (line >= info.m_line) {
@@ -70,10 +76,14 @@ TimeInfo& CompilationUnit::getTimeInfo(PathId fileId, uint32_t line) {
 void CompilationUnit::recordDefaultNetType(NetTypeInfo& info) { m_defaultNetTypes.emplace_back(info); }
 
 VObjectType CompilationUnit::getDefaultNetType(PathId fileId, uint32_t line) {
+  return getDefaultNetType(fileId, line, m_defaultNetTypes.size());
+}
+
+VObjectType CompilationUnit::getDefaultNetType(PathId fileId, uint32_t line, size_t count) {
   if (m_defaultNetTypes.empty()) {
     return VObjectType::paNetType_Wire;
   }
-  for (int32_t i = (int32_t)m_defaultNetTypes.size() - 1; i >= 0; i--) {
+  for (int32_t i = (int32_t)std::min(count, m_defaultNetTypes.size()) - 1; i >= 0; i--) {
     NetTypeInfo& info = m_defaultNetTypes[i];
     if (info.m_fileId == fileId) {
       if (line >= info.m_line) {
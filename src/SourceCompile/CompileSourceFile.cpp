@@ -23,6 +23,11 @@
 
 #include "Surelog/SourceCompile/CompileSourceFile.h"
 
+#include <antlr4-runtime.h>
+
+#include <cstdint>
+#include <vector>
+
 #include "Surelog/CommandLine/CommandLineParser.h"
 #include "Surelog/Common/Containers.h"
 #include "Surelog/Common/FileSystem.h"
@@ -36,9 +41,11 @@
 #include "Surelog/Library/Library.h"
 #include "Surelog/Package/Precompiled.h"
 #include "Surelog/SourceCompile/AnalyzeFile.h"
+#include "Surelog/SourceCompile/AntlrParserHandler.h"
 #include "Surelog/SourceCompile/Compiler.h"
 #include "Surelog/SourceCompile/ParseFile.h"
 #include "Surelog/SourceCompile/SymbolTable.h"
+#include "Surelog/Utils/Tracer.h"
 
 #ifdef SURELOG_WITH_PYTHON
 #include <Python.h>
@@ -52,9 +59,20 @@
 #endif
 
 #include <iostream>
+#include <string_view>
 
 namespace SURELOG {
 
+static std::string_view getActionName(CompileSourceFile::Action action) {
+  switch (action) {
+    case CompileSourceFile::Action::Preprocess: return "Preprocess";
+    case CompileSourceFile::Action::PostPreprocess: return "Post preprocess";
+    case CompileSourceFile::Action::Parse: return "Parse";
+    case CompileSourceFile::Action::PythonAPI: return "Python API";
+  }
+  return "";
+}
+
 CompileSourceFile::CompileSourceFile(Session* session, PathId fileId, Compiler* compiler,
                                      CompilationUnit* compilationUnit, Library* library, std::string_view text)
     : m_session(session),
@@ -101,6 +119,10 @@ bool CompileSourceFile::compile(Action action) {
     }
   }
 
+  // Chunks are told apart by their preprocessed file
+  const PathId tracedFileId = m_ppResultFileId ? m_ppResultFileId : m_fileId;
+  Tracer::Span span(m_session->getTracer(), "file", getActionName(m_action),
+                    m_session->getFileSystem()->toPath(tracedFileId));
   switch (m_action) {
     case Action::Preprocess: return preprocess_();
     case Action::PostPreprocess: return postPreprocess_();
@@ -147,6 +169,58 @@ uint64_t CompileSourceFile::getJobSize(Action action) const {
   return 0;
 }
 
+static uint64_t getStreamsMemoryUsage(antlr4::ANTLRInputStream* input, antlr4::CommonTokenStream* tokens) {
+  uint64_t bytes = 0;
+  // The input stream holds UTF-32 characters
+  if (input != nullptr) bytes += input->size() * sizeof(char32_t);
+  if (tokens != nullptr) bytes += tokens->size() * (sizeof(antlr4::CommonToken) + sizeof(void*));
+  return bytes;
+}
+
+uint64_t CompileSourceFile::getAntlrMemoryUsage(const PreprocessFile::AntlrParserHandler* handler) {
+  return getStreamsMemoryUsage(handler->m_inputStream, handler->m_pptokens);
+}
+
+uint64_t CompileSourceFile::getAntlrMemoryUsage() const {
+  uint64_t bytes = 0;
+  for (const auto& [id, handler] : m_antlrPpMacroMap) bytes += getAntlrMemoryUsage(handler);
+  for (const auto& [id, handler] : m_antlrPpFileMap) bytes += getAntlrMemoryUsage(handler);
+  if (m_parser != nullptr) {
+    if (const AntlrParserHandler* const handler = m_parser->getAntlrParserHandler()) {
+      bytes += getStreamsMemoryUsage(handler->m_inputStream, handler->m_tokens);
+    }
+  }
+  return bytes;
+}
+
+// Rule contexts are counted at their base size, the generated subclasses
+// only add a few pointers.
+static uint64_t getParseTreeMemoryUsage(antlr4::tree::ParseTree* tree) {
+  uint64_t bytes = 0;
+  std::vector<antlr4::tree::ParseTree*> stack;
+  if (tree != nullptr) stack.emplace_back(tree);
+  while (!stack.empty()) {
+    antlr4::tree::ParseTree* const node = stack.back();
+    stack.pop_back();
+    bytes += (node->getTreeType() == antlr4::tree::ParseTreeType::RULE) ? sizeof(antlr4::ParserRuleContext)
+                                                                         : sizeof(antlr4::tree::TerminalNodeImpl);
+    bytes += node->children.capacity() * sizeof(antlr4::tree::ParseTree*);
+    stack.insert(stack.end(), node->children.cbegin(), node->children.cend());
+  }
+  return bytes;
+}
+
+uint64_t CompileSourceFile::getAntlrTreeMemoryUsage(const PreprocessFile::AntlrParserHandler* handler) {
+  return getParseTreeMemoryUsage(handler->m_pptree);
+}
+
+uint64_t CompileSourceFile::getAntlrTreeMemoryUsage() const {
+  uint64_t bytes = 0;
+  for (const auto& [id, handler] : m_antlrPpMacroMap) bytes += getAntlrTreeMemoryUsage(handler);
+  for (const auto& [id, handler] : m_antlrPpFileMap) bytes += getAntlrTreeMemoryUsage(handler);
+  return bytes;
+}
+
 bool CompileSourceFile::pythonAPI_() {
 #ifdef SURELOG_WITH_PYTHON
   if (m_session->pythonListener()) {
@@ -221,6 +295,7 @@ bool CompileSourceFile::preprocess_() {
   Precompiled* prec = m_session->getPrecompiled();
   if ((!clp->createCache()) && prec->isFilePrecompiled(m_fileId)) return true;
 
+  Tracer::Span span(m_session->getTracer(), "cache", "Save preprocessor cache");
   m_pp->saveCache();
   return true;
 }
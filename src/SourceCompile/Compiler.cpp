@@ -35,10 +35,16 @@
 #include <iostream>
 #include <map>
 #include <nlohmann/json.hpp>
+#include <set>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "Surelog/Cache/AntlrDFACache.h"
+#include "Surelog/Cache/CacheStore.h"
+#include "Surelog/Cache/CacheWriter.h"
 #include "Surelog/CommandLine/CommandLineParser.h"
 #include "Surelog/Common/Containers.h"
 #include "Surelog/Common/FileSystem.h"
@@ -48,8 +54,13 @@
 #include "Surelog/Config/ConfigSet.h"
 #include "Surelog/Design/Design.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/DesignCompile/Builtin.h"
 #include "Surelog/DesignCompile/CompileDesign.h"
+#include "Surelog/ErrorReporting/Error.h"
+#include "Surelog/ErrorReporting/ErrorContainer.h"
+#include "Surelog/ErrorReporting/ErrorDefinition.h"
+#include "Surelog/ErrorReporting/Location.h"
 #include "Surelog/Library/Library.h"
 #include "Surelog/Library/LibrarySet.h"
 #include "Surelog/Library/ParseLibraryDef.h"
@@ -60,8 +71,10 @@
 #include "Surelog/SourceCompile/CompileSourceFile.h"
 #include "Surelog/SourceCompile/ParseFile.h"
 #include "Surelog/SourceCompile/SymbolTable.h"
+#include "Surelog/Utils/MemoryStats.h"
 #include "Surelog/Utils/StringUtils.h"
 #include "Surelog/Utils/Timer.h"
+#include "Surelog/Utils/Tracer.h"
 
 #if defined(_MSC_VER)
 #include <direct.h>
@@ -169,7 +182,8 @@ bool Compiler::ppinit_() {
     sourceFiles.insert(sourceFileId);
 
     Session* const session = new Session(m_session->getFileSystem(), symbols, m_session->getLogListener(), nullptr,
-                                         m_session->getCommandLineParser(), nullptr);
+                                         m_session->getCommandLineParser(), nullptr, m_session->getCacheWriter(),
+                                         m_session->getTracer());
     m_sessions.emplace_back(session);
 
     if (clp->fileUnit() && clp->parseBuiltIn()) {
@@ -257,7 +271,8 @@ bool Compiler::ppinit_() {
         symbols = symbols->CreateSnapshot();
       }
       Session* const session = new Session(m_session->getFileSystem(), symbols, m_session->getLogListener(), nullptr,
-                                           m_session->getCommandLineParser(), nullptr);
+                                           m_session->getCommandLineParser(), nullptr, m_session->getCacheWriter(),
+                                           m_session->getTracer());
       m_sessions.emplace_back(session);
 
       CompileSourceFile* compiler = new CompileSourceFile(session, id, this, comp_unit, &lib);
@@ -367,6 +382,9 @@ bool Compiler::createMultiProcessParser_() {
     return true;
   }
 
+  // The child processes read the caches written so far
+  drainCacheWriter_();
+
   SymbolTable* const symbols = m_session->getSymbolTable();
   FileSystem* const fileSystem = m_session->getFileSystem();
 
@@ -543,6 +561,9 @@ bool Compiler::createMultiProcessPreProcessor_() {
     return true;
   }
 
+  // The child processes read the caches written so far
+  drainCacheWriter_();
+
   FileSystem* const fileSystem = m_session->getFileSystem();
   SymbolTable* const symbols = m_session->getSymbolTable();
 
@@ -679,7 +700,8 @@ bool Compiler::parseinit_() {
       }
 
       Session* const session = new Session(m_session->getFileSystem(), symbols, m_session->getLogListener(), nullptr,
-                                           m_session->getCommandLineParser(), nullptr);
+                                           m_session->getCommandLineParser(), nullptr, m_session->getCacheWriter(),
+                                           m_session->getTracer());
       m_sessions.emplace_back(session);
       compiler->getParser()->setFileContent(new FileContent(session, compiler->getParser()->getFileId(0),
                                                             compiler->getParser()->getLibrary(), nullptr, BadPathId));
@@ -688,7 +710,8 @@ bool Compiler::parseinit_() {
       for (const auto& ppId : fileAnalyzer->getSplitFiles()) {
         SymbolTable* symbols = m_session->getSymbolTable()->CreateSnapshot();
         Session* const session = new Session(m_session->getFileSystem(), symbols, m_session->getLogListener(), nullptr,
-                                             m_session->getCommandLineParser(), nullptr);
+                                             m_session->getCommandLineParser(), nullptr, m_session->getCacheWriter(),
+                                             m_session->getTracer());
         m_sessions.emplace_back(session);
         CompileSourceFile* chunkCompiler =
             new CompileSourceFile(session, compiler, ppId, fileAnalyzer->getLineOffsets()[j]);
@@ -707,7 +730,8 @@ bool Compiler::parseinit_() {
         SymbolTable* symbols = m_session->getSymbolTable()->CreateSnapshot();
 
         Session* const session = new Session(m_session->getFileSystem(), symbols, m_session->getLogListener(), nullptr,
-                                             m_session->getCommandLineParser(), nullptr);
+                                             m_session->getCommandLineParser(), nullptr, m_session->getCacheWriter(),
+                                             m_session->getTracer());
         m_sessions.emplace_back(session);
 
         compiler->setSession(session);
@@ -902,7 +926,7 @@ void Compiler::writeUhdmSourceFiles() {
     Session* const session = sourceFile->getSession();
     FileSystem* const fileSystem = session->getFileSystem();
     SymbolTable* const symbolTable = session->getSymbolTable();
-    const std::vector<VObject>& objects = fileContent->getVObjects();
+    const VObjectStore& objects = fileContent->getVObjects();
 
     // TODO(HS): Macro definitions should include arguments & tokens
     // TODO(HS): Macro instances should include arguments & compiled text
@@ -992,21 +1016,22 @@ void Compiler::writeUhdmSourceFiles() {
           const IncludeFileInfo& oifi = includeFileInfos[cifi.m_indexOpposite];
 
           for (size_t i = 0, ni = objects.size(); i < ni; ++i) {
-            const VObject& object = objects[i];
-            if (object.m_ppStartLine < oifi.m_sourceLine) continue;
-            if (object.m_ppEndLine > cifi.m_sourceLine) break;
+            const VObjectStore::Location& ppLocation = objects.ppLocation(NodeId(static_cast<RawNodeId>(i)));
+            if (ppLocation.m_startLine < oifi.m_sourceLine) continue;
+            if (ppLocation.m_endLine > cifi.m_sourceLine) break;
             if (macroInstances[i] != nullptr) continue;
 
-            if ((object.m_ppStartLine == oifi.m_sourceLine) && (object.m_ppEndLine == cifi.m_sourceLine)) {
-              if ((object.m_ppStartColumn >= oifi.m_sourceColumn) && (object.m_ppEndColumn <= cifi.m_sourceColumn)) {
+            if ((ppLocation.m_startLine == oifi.m_sourceLine) && (ppLocation.m_endLine == cifi.m_sourceLine)) {
+              if ((ppLocation.m_startColumn >= oifi.m_sourceColumn) &&
+                  (ppLocation.m_endColumn <= cifi.m_sourceColumn)) {
                 macroInstances[i] = macroInstanceStack.back();
               }
-            } else if (object.m_ppStartLine == oifi.m_sourceLine) {
-              if (object.m_ppStartColumn >= oifi.m_sourceColumn) {
+            } else if (ppLocation.m_startLine == oifi.m_sourceLine) {
+              if (ppLocation.m_startColumn >= oifi.m_sourceColumn) {
                 macroInstances[i] = macroInstanceStack.back();
               }
-            } else if (object.m_ppEndLine == cifi.m_sourceLine) {
-              if (object.m_ppEndColumn <= cifi.m_sourceColumn) {
+            } else if (ppLocation.m_endLine == cifi.m_sourceLine) {
+              if (ppLocation.m_endColumn <= cifi.m_sourceColumn) {
                 macroInstances[i] = macroInstanceStack.back();
               }
             } else {
@@ -1035,34 +1060,34 @@ void Compiler::writePreprocMacroInstances() {
     const FileContent* const fileContent = parseFile->getFileContent();
     Session* const session = sourceFile->getSession();
     FileSystem* const fileSystem = session->getFileSystem();
-    const std::vector<VObject>& objects = fileContent->getVObjects();
+    const VObjectStore& objects = fileContent->getVObjects();
     const FileContent::AnyToNodeIdPairCache& anyToNodeIdPairCache = fileContent->getAnyToNodeIdPairCache();
     std::vector<uhdm::PreprocMacroInstance*>& pmis = sourceFile->getPreprocMacroInstances();
 
     for (const auto& [any, id] : anys) {
       if (any->getFile() != fileSystem->toPath(sourceFile->getFileId())) continue;
 
-      FileContent::AnyToNodeIdPairCache::const_iterator it = anyToNodeIdPairCache.find(any);
+      const std::pair<NodeId, NodeId>* const nodes = anyToNodeIdPairCache.find(any->getUhdmId());
       // TODO(hs): No cache entry! Based on the parent of this any
       // try and walk the objects tree to find an appropriate
       // start/end index. Make sure to use ppStart/ppEnd and not
       // start/end of the object.
-      if (it == anyToNodeIdPairCache.end()) continue;
+      if (nodes == nullptr) continue;
 
-      const NodeId& startIndex = it->second.first;
-      const NodeId& endIndex = it->second.second;
+      const NodeId& startIndex = nodes->first;
+      const NodeId& endIndex = nodes->second;
 
       if (startIndex && (pmis[startIndex] != nullptr)) {
-        const VObject& object = objects[startIndex];
-        if ((object.m_startLine == any->getStartLine()) && (object.m_startColumn == any->getStartColumn())) {
+        const VObjectStore::Location& location = objects.location(startIndex);
+        if ((location.m_startLine == any->getStartLine()) && (location.m_startColumn == any->getStartColumn())) {
           pmis[startIndex]->getObjects(true)->emplace_back(const_cast<uhdm::Any*>(any));
           allPpMIs.emplace(pmis[startIndex]);
         }
       }
 
       if (endIndex && (pmis[endIndex] != nullptr)) {
-        const VObject& object = objects[startIndex];
-        if ((object.m_endLine == any->getEndLine()) && (object.m_endColumn == any->getEndColumn())) {
+        const VObjectStore::Location& location = objects.location(startIndex);
+        if ((location.m_endLine == any->getEndLine()) && (location.m_endColumn == any->getEndColumn())) {
           pmis[endIndex]->getObjects(true)->emplace_back(const_cast<uhdm::Any*>(any));
           allPpMIs.emplace(pmis[endIndex]);
         }
@@ -1080,12 +1105,95 @@ void Compiler::writePreprocMacroInstances() {
   }
 }
 
+MemoryStats::Counts Compiler::getMemoryCounts_() const {
+  // Per file sessions own a copy of the symbol table and an error container
+  std::set<SymbolTable*> symbolTables;
+  std::set<const ErrorContainer*> errorContainers;
+  symbolTables.emplace(m_session->getSymbolTable());
+  errorContainers.emplace(m_session->getErrorContainer());
+  for (Session* session : m_sessions) {
+    symbolTables.emplace(session->getSymbolTable());
+    errorContainers.emplace(session->getErrorContainer());
+  }
+
+  uint64_t antlrBytes = 0;
+  for (const std::vector<CompileSourceFile*>* compilers : {&m_compilers, &m_compilersParentFiles}) {
+    for (const CompileSourceFile* compiler : *compilers) antlrBytes += compiler->getAntlrMemoryUsage();
+  }
+  for (const auto& [id, handler] : m_antlrPpMap) antlrBytes += CompileSourceFile::getAntlrMemoryUsage(handler);
+
+  uint64_t antlrTreeBytes = 0;
+  for (const std::vector<CompileSourceFile*>* compilers : {&m_compilers, &m_compilersParentFiles}) {
+    for (const CompileSourceFile* compiler : *compilers) antlrTreeBytes += compiler->getAntlrTreeMemoryUsage();
+  }
+  for (const auto& [id, handler] : m_antlrPpMap) {
+    antlrTreeBytes += CompileSourceFile::getAntlrTreeMemoryUsage(handler);
+  }
+
+  uint64_t vobjectBytes = 0;
+  for (const auto& [fileId, fC] : m_design->getAllFileContents()) vobjectBytes += fC->getVObjects().getMemoryUsage();
+  for (const auto& [fileId, fC] : m_design->getAllPPFileContents()) vobjectBytes += fC->getVObjects().getMemoryUsage();
+
+  // The symbol payloads and their index entries
+  uint64_t symbolBytes = 0;
+  for (SymbolTable* symbolTable : symbolTables) {
+    for (std::string_view symbol : symbolTable->getSymbols()) {
+      symbolBytes += symbol.size() + 1 + 2 * sizeof(std::string_view);
+    }
+  }
+
+  uint64_t errorBytes = 0;
+  for (const ErrorContainer* errorContainer : errorContainers) {
+    errorBytes += errorContainer->getErrors().capacity() * sizeof(Error);
+  }
+
+  return {{"antlr_streams", antlrBytes},
+          {"antlr_trees", antlrTreeBytes},
+          {"vobjects", vobjectBytes},
+          {"symbols", symbolBytes},
+          {"errors", errorBytes}};
+}
+
+void Compiler::drainCacheWriter_() {
+  SymbolTable* const symbols = m_session->getSymbolTable();
+  ErrorContainer* const errors = m_session->getErrorContainer();
+  for (const std::filesystem::path& filepath : m_session->getCacheWriter()->drain()) {
+    Location loc(symbols->registerSymbol(filepath.string()));
+    errors->addError(ErrorDefinition::CMD_CANNOT_WRITE_CACHE_FILE, loc);
+  }
+}
+
+void Compiler::recordMemoryStats_(std::string_view phase) {
+  FileSystem* const fileSystem = m_session->getFileSystem();
+  ErrorContainer* const errors = m_session->getErrorContainer();
+  CommandLineParser* const clp = m_session->getCommandLineParser();
+  const PathId fileId = clp->memoryStatsFileId();
+  if (!fileId) return;
+
+  const std::string msg = MemoryStats::toString(m_memoryStats.addPhase(phase, getMemoryCounts_()));
+  if (!clp->muteStdout()) std::cout << msg << std::flush;
+  errors->printToLogFile(msg);
+
+  // Rewritten at every phase, so that a failed or killed run still has it
+  std::ostream& ofs = fileSystem->openForWrite(fileId);
+  if (ofs.good()) {
+    ofs << m_memoryStats.toJson() << std::endl;
+    fileSystem->close(ofs);
+  } else {
+    std::cerr << "Could not create memory stats file: " << PathIdPP(fileId, fileSystem) << std::endl;
+  }
+}
+
 bool Compiler::compile() {
   std::string profile;
   Timer tmr;
   Timer tmrTotal;
+  Tracer* const tracer = m_session->getTracer();
   // Scan the libraries definition
+  Tracer::Span librariesSpan(tracer, "phase", "Scan libraries");
   if (!parseLibrariesDef_()) return false;
+  librariesSpan.end();
+  recordMemoryStats_("Scan libraries");
 
   SymbolTable* const symbols = m_session->getSymbolTable();
   FileSystem* const fileSystem = m_session->getFileSystem();
@@ -1098,7 +1206,12 @@ bool Compiler::compile() {
     tmr.reset();
   }
 
+  // Warm up the preprocessor and parser prediction DFAs from earlier runs
+  AntlrDFACache dfaCache(m_session);
+  dfaCache.restore();
+
   // Preprocess
+  Tracer::Span ppSpan(tracer, "phase", "Preprocess");
   ppinit_();
   createMultiProcessPreProcessor_();
   if (!compileFileSet_(CompileSourceFile::Action::Preprocess, clp->fileUnit(), m_compilers)) {
@@ -1108,6 +1221,8 @@ bool Compiler::compile() {
   if (!compileFileSet_(CompileSourceFile::Action::PostPreprocess, false, m_compilers)) {
     return false;
   }
+  ppSpan.end();
+  recordMemoryStats_("Preprocess");
 
   if (clp->profile()) {
     std::string msg = "Preprocessing took " + std::to_string(tmr.elapsed()) + "ms\n";
@@ -1120,6 +1235,7 @@ bool Compiler::compile() {
   }
 
   // Parse
+  Tracer::Span parseSpan(tracer, "phase", "Parse");
   bool parserInitialized = false;
   if (clp->parse() || clp->pythonListener() || clp->pythonEvalScriptPerFile() || clp->pythonEvalScript()) {
     parseinit_();
@@ -1132,11 +1248,18 @@ bool Compiler::compile() {
     if (!compileFileSet_(CompileSourceFile::Action::Parse, true, m_compilersParentFiles)) {
       return false;  // Recombine chunks
     }
+    dfaCache.save();
+    // Once every entry of this run is on disk, so that none is evicted
+    // before being written
+    drainCacheWriter_();
+    CacheStore(m_session).evict();
   } else {
     createFileList_();
   }
 
   writeUhdmSourceFiles();
+  parseSpan.end();
+  recordMemoryStats_("Parse");
 
   if (clp->profile()) {
     std::string msg = "Parsing took " + std::to_string(tmr.elapsed()) + "ms\n";
@@ -1153,16 +1276,22 @@ bool Compiler::compile() {
   }
 
   // Check Parsing
+  Tracer::Span checkSpan(tracer, "phase", "Check parsing");
   CheckCompile* checkComp = new CheckCompile(m_session, this);
   bool parseOk = checkComp->check();
   delete checkComp;
+  checkSpan.end();
+  recordMemoryStats_("Check parsing");
   errors->printMessages(clp->muteStdout());
 
   // Python Listener
   if (parseOk && (clp->pythonListener() || clp->pythonEvalScriptPerFile())) {
+    Tracer::Span pythonSpan(tracer, "phase", "Python API");
     if (!parserInitialized) pythoninit_();
     if (!compileFileSet_(CompileSourceFile::Action::PythonAPI, true, m_compilers)) return false;
     if (!compileFileSet_(CompileSourceFile::Action::PythonAPI, true, m_compilersParentFiles)) return false;
+    pythonSpan.end();
+    recordMemoryStats_("Python API");
 
     if (clp->profile()) {
       std::string msg = "Python file processing took " + std::to_string(tmr.elapsed()) + "ms\n";
@@ -1174,8 +1303,11 @@ bool Compiler::compile() {
 
   if (parseOk && clp->compile()) {
     // Compile Design, has its own thread management
+    Tracer::Span compileSpan(tracer, "phase", "Compile design");
     m_compileDesign = new CompileDesign(m_session, this);
     m_compileDesign->compile();
+    compileSpan.end();
+    recordMemoryStats_("Compile design");
     errors->printMessages(clp->muteStdout());
 
     if (clp->profile()) {
@@ -1187,9 +1319,13 @@ bool Compiler::compile() {
 
     writePreprocMacroInstances();
     m_compileDesign->purgeParsers();
+    recordMemoryStats_("Purge parsers");
 
     PathId uhdmFileId = fileSystem->getOutputUhdmFile(clp->fileUnit(), symbols);
+    Tracer::Span uhdmSpan(tracer, "phase", "Write UHDM");
     m_compileDesign->writeUHDM(uhdmFileId);
+    uhdmSpan.end();
+    recordMemoryStats_("Write UHDM");
     // Do not delete as now UHDM has to live past the compilation step
     // delete compileDesign;
   }
@@ -27,11 +27,15 @@
 #include <parser/SV3_1aLexer.h>
 #include <parser/SV3_1aParser.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <exception>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 #include "Surelog/Cache/ParseCache.h"
 #include "Surelog/CommandLine/CommandLineParser.h"
@@ -40,6 +44,7 @@
 #include "Surelog/Common/Session.h"
 #include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/TimeInfo.h"
 #include "Surelog/ErrorReporting/Error.h"
 #include "Surelog/ErrorReporting/ErrorContainer.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
@@ -47,15 +52,171 @@
 #include "Surelog/Package/Precompiled.h"
 #include "Surelog/SourceCompile/AntlrParserErrorListener.h"
 #include "Surelog/SourceCompile/AntlrParserHandler.h"
+#include "Surelog/SourceCompile/CommonListenerHelper.h"
+#include "Surelog/SourceCompile/CompilationUnit.h"
 #include "Surelog/SourceCompile/CompileSourceFile.h"
 #include "Surelog/SourceCompile/IncludeFileInfo.h"
+#include "Surelog/SourceCompile/SV3_1aFastLexer.h"
 #include "Surelog/SourceCompile/SV3_1aParserTreeListener.h"
 #include "Surelog/SourceCompile/SV3_1aTreeShapeListener.h"
 #include "Surelog/SourceCompile/SymbolTable.h"
 #include "Surelog/Utils/StringUtils.h"
 #include "Surelog/Utils/Timer.h"
+#include "Surelog/Utils/Tracer.h"
 
 namespace SURELOG {
+namespace {
+// Attached to the parser as a parse listener: replays the events of
+// top_level_rule and source_text to the tree listener as the parser reaches
+// them and walks every child of these two rules (descriptions) as soon as
+// the parser exits it. The tree listener sees the exact event sequence of a
+// full tree walk, but each description is converted, and its subtree
+// released, while the rest of the file is still being parsed.
+class StreamingTreeWalker final : public antlr4::tree::ParseTreeListener {
+ public:
+  StreamingTreeWalker(antlr4::tree::ParseTreeListener* listener, CommonListenerHelper* helper)
+      : m_listener(listener), m_helper(helper) {}
+
+  void enterEveryRule(antlr4::ParserRuleContext* ctx) final {
+    if (!isTopLevel(ctx)) return;
+    m_listener->enterEveryRule(ctx);
+    ctx->enterRule(m_listener);
+  }
+
+  void exitEveryRule(antlr4::ParserRuleContext* ctx) final {
+    // Rules exited while a bailing SLL parse unwinds are parsed again
+    if (std::uncaught_exceptions() > 0) return;
+    if (isTopLevel(ctx)) {
+      ctx->exitRule(m_listener);
+      m_listener->exitEveryRule(ctx);
+    } else if (isTopLevel(ctx->parent)) {
+      antlr4::tree::ParseTreeWalker::DEFAULT.walk(m_listener, ctx);
+      m_helper->releaseSubTree(ctx);
+    }
+  }
+
+  void visitTerminal(antlr4::tree::TerminalNode* node) final {
+    if (isTopLevel(node->parent)) m_listener->visitTerminal(node);
+  }
+
+  void visitErrorNode(antlr4::tree::ErrorNode* node) final {
+    if (isTopLevel(node->parent)) m_listener->visitErrorNode(node);
+  }
+
+ private:
+  static bool isTopLevel(const antlr4::tree::ParseTree* tree) {
+    const antlr4::ParserRuleContext* const ctx = dynamic_cast<const antlr4::ParserRuleContext*>(tree);
+    if (ctx == nullptr) return false;
+    const size_t ruleIndex = ctx->getRuleIndex();
+    return (ruleIndex == SV3_1aParser::RuleTop_level_rule) || (ruleIndex == SV3_1aParser::RuleSource_text);
+  }
+
+  antlr4::tree::ParseTreeListener* const m_listener = nullptr;
+  CommonListenerHelper* const m_helper = nullptr;
+};
+
+// BailErrorStrategy remembering the rule the SLL parse failed in, so that
+// the parse can resume at the enclosing description.
+class DescriptionBailErrorStrategy final : public antlr4::BailErrorStrategy {
+ public:
+  void recover(antlr4::Parser* recognizer, std::exception_ptr e) final {
+    m_failedContext = recognizer->getContext();
+    antlr4::BailErrorStrategy::recover(recognizer, e);
+  }
+
+  antlr4::Token* recoverInline(antlr4::Parser* recognizer) final {
+    m_failedContext = recognizer->getContext();
+    return antlr4::BailErrorStrategy::recoverInline(recognizer);
+  }
+
+  antlr4::ParserRuleContext* getFailedContext() const { return m_failedContext; }
+
+ private:
+  antlr4::ParserRuleContext* m_failedContext = nullptr;
+};
+
+struct DescriptionFallback final {
+  uint32_t m_descriptions = 0;  // Descriptions re-parsed in LL mode
+  size_t m_chars = 0;           // Characters covered by these descriptions
+};
+
+// Resumes a bailed out SLL parse at the start of the description it failed
+// in. That description is re-parsed in LL mode, then SLL parsing carries on
+// with the next one, keeping everything SLL parsed so far. Returns the
+// top_level_rule context, or nullptr if the failure is not inside a
+// description or the LL re-parse has syntax errors; the whole file then has
+// to be re-parsed in LL mode with error reporting.
+antlr4::ParserRuleContext* resumeAtFailedDescription(SV3_1aParser* parser, antlr4::CommonTokenStream* tokens,
+                                                     const std::shared_ptr<DescriptionBailErrorStrategy>& bail,
+                                                     StreamingTreeWalker* streamer, DescriptionFallback* fallback) {
+  antlr4::ParserRuleContext* description = bail->getFailedContext();
+  while ((description != nullptr) && (description->parent != nullptr) &&
+         (static_cast<antlr4::ParserRuleContext*>(description->parent)->getRuleIndex() !=
+          SV3_1aParser::RuleSource_text)) {
+    description = static_cast<antlr4::ParserRuleContext*>(description->parent);
+  }
+  if ((description == nullptr) || (description->parent == nullptr) ||
+      (description->getRuleIndex() != SV3_1aParser::RuleDescription)) {
+    return nullptr;
+  }
+  antlr4::ParserRuleContext* const sourceText = static_cast<antlr4::ParserRuleContext*>(description->parent);
+  antlr4::ParserRuleContext* const topLevel = static_cast<antlr4::ParserRuleContext*>(sourceText->parent);
+  if ((topLevel == nullptr) || (topLevel->getRuleIndex() != SV3_1aParser::RuleTop_level_rule) ||
+      sourceText->children.empty() || (sourceText->children.back() != description)) {
+    return nullptr;
+  }
+
+  antlr4::atn::ParserATNSimulator* const interpreter = parser->getInterpreter<antlr4::atn::ParserATNSimulator>();
+  std::shared_ptr<antlr4::DefaultErrorStrategy> recovery = std::make_shared<antlr4::DefaultErrorStrategy>();
+  const size_t invokingState = description->invokingState;
+  size_t startIndex = description->getStart()->getTokenIndex();
+  bool useLL = true;
+  while (true) {
+    // Drop the partial description and clear the failure up the chain
+    sourceText->children.pop_back();
+    sourceText->exception = nullptr;
+    topLevel->exception = nullptr;
+    tokens->seek(startIndex);
+
+    while (useLL || (tokens->LA(1) != antlr4::Token::EOF)) {
+      startIndex = tokens->index();
+      parser->setContext(sourceText);
+      parser->setState(invokingState);
+      if (useLL) {
+        interpreter->setPredictionMode(antlr4::atn::PredictionMode::LL);
+        parser->setErrorHandler(recovery);
+        const size_t syntaxErrors = parser->getNumberOfSyntaxErrors();
+        parser->description();
+        if ((parser->getNumberOfSyntaxErrors() != syntaxErrors) || (tokens->index() == startIndex)) return nullptr;
+        ++fallback->m_descriptions;
+        fallback->m_chars += tokens->LT(-1)->getStopIndex() + 1 - tokens->get(startIndex)->getStartIndex();
+        interpreter->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+        parser->setErrorHandler(bail);
+        useLL = false;
+      } else {
+        try {
+          parser->description();
+        } catch (antlr4::ParseCancellationException&) {
+          useLL = true;
+          break;
+        }
+      }
+    }
+    if (!useLL) break;
+  }
+
+  // Close source_text and match EOF as top_level_rule would have
+  sourceText->stop = tokens->LT(-1);
+  if (streamer != nullptr) streamer->exitEveryRule(sourceText);
+  parser->setContext(topLevel);
+  parser->match(antlr4::Token::EOF);
+  topLevel->stop = tokens->LT(1);
+  if (streamer != nullptr) streamer->exitEveryRule(topLevel);
+  parser->setContext(nullptr);
+  return topLevel;
+}
+}  // namespace
+
 ParseFile::ParseFile(Session* session, PathId fileId)
     : m_session(session),
       m_fileId(fileId),
@@ -144,6 +305,33 @@ std::string_view ParseFile::getSymbol(SymbolId id) const { return m_session->get
 
 void ParseFile::addError(Error& error) { m_session->getErrorContainer()->addError(error); }
 
+void ParseFile::recordTimeInfo(TimeInfo& info) {
+  // A chunk had its records added ahead of the walk
+  if (m_timeInfoCount >= 0) {
+    ++m_timeInfoCount;
+  } else {
+    m_compilationUnit->recordTimeInfo(info);
+  }
+}
+
+TimeInfo& ParseFile::getTimeInfo(PathId fileId, uint32_t line) {
+  if (m_timeInfoCount >= 0) return m_compilationUnit->getTimeInfo(fileId, line, m_timeInfoCount);
+  return m_compilationUnit->getTimeInfo(fileId, line);
+}
+
+void ParseFile::recordDefaultNetType(NetTypeInfo& info) {
+  if (m_netTypeCount >= 0) {
+    ++m_netTypeCount;
+  } else {
+    m_compilationUnit->recordDefaultNetType(info);
+  }
+}
+
+VObjectType ParseFile::getDefaultNetType(PathId fileId, uint32_t line) {
+  if (m_netTypeCount >= 0) return m_compilationUnit->getDefaultNetType(fileId, line, m_netTypeCount);
+  return m_compilationUnit->getDefaultNetType(fileId, line);
+}
+
 PathId ParseFile::getFileId(uint32_t line) {
   if ((line == 0) || !getCompileSourceFile()) return m_fileId;
 
@@ -439,27 +627,37 @@ bool ParseFile::parseOneFile_(PathId fileId, uint32_t lineOffset) {
   }
 
   m_antlrParserHandler->m_errorListener = new AntlrParserErrorListener(m_session, this, false, lineOffset, fileId);
-  m_antlrParserHandler->m_lexer = new SV3_1aLexer(m_antlrParserHandler->m_inputStream);
   VerilogVersion version = VerilogVersion::SystemVerilog;
   if (pp) version = pp->getVerilogVersion();
+  bool sverilog = true;
   if (version != VerilogVersion::NoVersion) {
     switch (version) {
       case VerilogVersion::NoVersion: break;
-      case VerilogVersion::Verilog1995: m_antlrParserHandler->m_lexer->sverilog = false; break;
-      case VerilogVersion::Verilog2001: m_antlrParserHandler->m_lexer->sverilog = false; break;
-      case VerilogVersion::Verilog2005: m_antlrParserHandler->m_lexer->sverilog = false; break;
-      case VerilogVersion::SVerilog2005: m_antlrParserHandler->m_lexer->sverilog = true; break;
-      case VerilogVersion::Verilog2009: m_antlrParserHandler->m_lexer->sverilog = true; break;
-      case VerilogVersion::SystemVerilog: m_antlrParserHandler->m_lexer->sverilog = true; break;
+      case VerilogVersion::Verilog1995: sverilog = false; break;
+      case VerilogVersion::Verilog2001: sverilog = false; break;
+      case VerilogVersion::Verilog2005: sverilog = false; break;
+      case VerilogVersion::SVerilog2005: sverilog = true; break;
+      case VerilogVersion::Verilog2009: sverilog = true; break;
+      case VerilogVersion::SystemVerilog: sverilog = true; break;
     }
   } else {
     std::string_view type = std::get<1>(fileSystem->getType(fileId, symbols));
-    m_antlrParserHandler->m_lexer->sverilog = (type == ".sv") || clp->fullSVMode() || clp->isSVFile(fileId);
+    sverilog = (type == ".sv") || clp->fullSVMode() || clp->isSVFile(fileId);
   }
 
-  m_antlrParserHandler->m_lexer->removeErrorListeners();
-  m_antlrParserHandler->m_lexer->addErrorListener(m_antlrParserHandler->m_errorListener);
-  m_antlrParserHandler->m_tokens = new antlr4::CommonTokenStream(m_antlrParserHandler->m_lexer);
+  if (clp->fastLexer()) {
+    // Token for token identical to SV3_1aLexer, which never reports errors
+    // either since its ANY rule matches every character.
+    m_antlrParserHandler->m_fastLexer = new SV3_1aFastLexer(m_antlrParserHandler->m_inputStream);
+    m_antlrParserHandler->m_fastLexer->setSVerilog(sverilog);
+    m_antlrParserHandler->m_tokens = new antlr4::CommonTokenStream(m_antlrParserHandler->m_fastLexer);
+  } else {
+    m_antlrParserHandler->m_lexer = new SV3_1aLexer(m_antlrParserHandler->m_inputStream);
+    m_antlrParserHandler->m_lexer->sverilog = sverilog;
+    m_antlrParserHandler->m_lexer->removeErrorListeners();
+    m_antlrParserHandler->m_lexer->addErrorListener(m_antlrParserHandler->m_errorListener);
+    m_antlrParserHandler->m_tokens = new antlr4::CommonTokenStream(m_antlrParserHandler->m_lexer);
+  }
   m_antlrParserHandler->m_tokens->fill();
 
   if (clp->profile()) {
@@ -486,8 +684,23 @@ bool ParseFile::parseOneFile_(PathId fileId, uint32_t lineOffset) {
   m_antlrParserHandler->m_parser->getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(
       antlr4::atn::PredictionMode::SLL);
   m_antlrParserHandler->m_parser->removeErrorListeners();
-  m_antlrParserHandler->m_parser->setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+  std::shared_ptr<DescriptionBailErrorStrategy> bail = std::make_shared<DescriptionBailErrorStrategy>();
+  m_antlrParserHandler->m_parser->setErrorHandler(bail);
+
+  // With -streamparse the file content is built from the parser events, see
+  // StreamingTreeWalker. m_tree is then only kept for the tracker reset.
+  std::unique_ptr<StreamingTreeWalker> streamer;
+  // Chunks are walked after the parse, once the directives of the chunks
+  // before them are known
+  if (clp->streamParse() && (m_parent == nullptr)) {
+    CommonListenerHelper* const helper = createListener_();
+    streamer = std::make_unique<StreamingTreeWalker>(m_listener, helper);
+    m_antlrParserHandler->m_parser->addParseListener(streamer.get());
+  }
 
+  Tracer* const tracer = m_session->getTracer();
+  bool sllFailed = false;
+  Tracer::Span sllSpan(tracer, "parse", "SLL parse", fileSystem->toPath(fileId));
   try {
     m_antlrParserHandler->m_tree = m_antlrParserHandler->m_parser->top_level_rule();
 
@@ -498,8 +711,36 @@ bool ParseFile::parseOneFile_(PathId fileId, uint32_t lineOffset) {
       profileParser();
     }
   } catch (antlr4::ParseCancellationException&) {
+    sllFailed = true;
+  }
+  sllSpan.end();
+
+  DescriptionFallback fallback;
+  if (sllFailed) {
+    Tracer::Span fallbackSpan(tracer, "parse", "LL fallback parse", fileSystem->toPath(fileId));
+    m_antlrParserHandler->m_tree = resumeAtFailedDescription(
+        m_antlrParserHandler->m_parser, m_antlrParserHandler->m_tokens, bail, streamer.get(), &fallback);
+    if ((m_antlrParserHandler->m_tree != nullptr) && clp->profile()) {
+      StrAppend(&m_profileInfo, "SLL/LL Parsing: ", std::to_string(tmr.elapsed()), "ms, ",
+                std::to_string(fallback.m_descriptions), " LL fallback(s), ", std::to_string(fallback.m_chars),
+                " chars re-parsed ", fileSystem->toPath(fileId), "\n");
+      tmr.reset();
+      profileParser();
+    }
+  }
+
+  if (sllFailed && (m_antlrParserHandler->m_tree == nullptr)) {
+    Tracer::Span llSpan(tracer, "parse", "LL parse", fileSystem->toPath(fileId));
     m_antlrParserHandler->m_tokens->reset();
     m_antlrParserHandler->m_parser->reset();
+    if (streamer) {
+      // Throw away what the SLL attempt streamed out so far
+      m_antlrParserHandler->m_parser->removeParseListeners();
+      if (m_fileContent != nullptr) m_fileContent->clearParsedContent();
+      CommonListenerHelper* const helper = createListener_();
+      streamer = std::make_unique<StreamingTreeWalker>(m_listener, helper);
+      m_antlrParserHandler->m_parser->addParseListener(streamer.get());
+    }
     m_antlrParserHandler->m_parser->removeErrorListeners();
     if (clp->profile()) {
       m_antlrParserHandler->m_parser->setProfile(true);
@@ -511,11 +752,15 @@ bool ParseFile::parseOneFile_(PathId fileId, uint32_t lineOffset) {
     m_antlrParserHandler->m_tree = m_antlrParserHandler->m_parser->top_level_rule();
 
     if (clp->profile()) {
-      StrAppend(&m_profileInfo, "LL Parsing: ", std::to_string(tmr.elapsed()), "ms ", fileSystem->toPath(fileId), "\n");
+      StrAppend(&m_profileInfo, "LL Parsing: ", std::to_string(tmr.elapsed()), "ms, whole file after ",
+                std::to_string(fallback.m_descriptions), " LL fallback(s), ",
+                std::to_string(m_antlrParserHandler->m_inputStream->size()), " chars re-parsed ",
+                fileSystem->toPath(fileId), "\n");
       tmr.reset();
       profileParser();
     }
   }
+  if (streamer) m_antlrParserHandler->m_parser->removeParseListeners();
   /* Failed attempt to minimize memory usage:
      m_antlrParserHandler->m_parser->getInterpreter<antlr4::atn::ParserATNSimulator>()->clearDFA();
      SV3_1aParser::_sharedContextCache.clear();
@@ -564,14 +809,66 @@ std::string ParseFile::getProfileInfo() const {
   return profile;
 }
 
+CommonListenerHelper* ParseFile::createListener_() {
+  delete m_listener;
+  if (m_session->getCommandLineParser()->parseTree()) {
+    FileContent* const ppFileContent = getCompileSourceFile()->getPreprocessor()->getFileContent();
+    SV3_1aParserTreeListener* const listener =
+        new SV3_1aParserTreeListener(m_session, this, m_antlrParserHandler->m_tokens, m_offsetLine, ppFileContent);
+    m_listener = listener;
+    return listener;
+  }
+  SV3_1aTreeShapeListener* const listener =
+      new SV3_1aTreeShapeListener(m_session, this, m_antlrParserHandler->m_tokens, m_offsetLine);
+  m_listener = listener;
+  return listener;
+}
+
+void ParseFile::recordChunkDirectives_() {
+  m_timeInfoCount = static_cast<int32_t>(m_compilationUnit->getTimeInfo().size());
+  m_netTypeCount = static_cast<int32_t>(m_compilationUnit->getDefaultNetType().size());
+  // Directives are descriptions of the top level only
+  auto* const topLevel = dynamic_cast<SV3_1aParser::Top_level_ruleContext*>(m_antlrParserHandler->m_tree);
+  if ((topLevel == nullptr) || (topLevel->source_text() == nullptr)) return;
+  for (SV3_1aParser::DescriptionContext* description : topLevel->source_text()->description()) {
+    SV3_1aParser::Top_directivesContext* const directive = description->top_directives();
+    if (directive == nullptr) continue;
+    if (SV3_1aParser::Timescale_directiveContext* const ctx = directive->timescale_directive()) {
+      TimeInfo info = SV3_1aTreeShapeHelper::getTimescaleInfo(this, ctx, nullptr);
+      m_compilationUnit->recordTimeInfo(info);
+    } else if (SV3_1aParser::Default_nettype_directiveContext* const ctx = directive->default_nettype_directive()) {
+      NetTypeInfo info = SV3_1aTreeShapeHelper::getDefaultNetTypeInfo(this, m_antlrParserHandler->m_tokens, ctx);
+      m_compilationUnit->recordDefaultNetType(info);
+    }
+  }
+}
+
+bool ParseFile::walkChunk_(bool saveCache) {
+  Tracer* const tracer = m_session->getTracer();
+  const std::string_view filepath = m_session->getFileSystem()->toPath(m_ppFileId);
+  Tracer::Span walkSpan(tracer, "parse", "Tree walk", filepath);
+  createListener_();
+  antlr4::tree::ParseTreeWalker::DEFAULT.walk(m_listener, m_antlrParserHandler->m_tree);
+  walkSpan.end();
+  m_antlrParserHandler->m_parser->getTreeTracker().reset();
+
+  if (!saveCache) return true;
+  Tracer::Span cacheSpan(tracer, "cache", "Save parser cache", filepath);
+  ParseCache cache(m_session, this);
+  return cache.save();
+}
+
 bool ParseFile::parse() {
   FileSystem* const fileSystem = m_session->getFileSystem();
   CommandLineParser* const clp = m_session->getCommandLineParser();
 
+  Tracer* const tracer = m_session->getTracer();
   if (m_children.empty()) {
     ParseCache cache(m_session, this);
-
-    if (cache.restore()) {
+    Tracer::Span cacheSpan(tracer, "cache", "Restore parser cache", fileSystem->toPath(m_ppFileId));
+    const bool restored = cache.restore();
+    cacheSpan.end();
+    if (restored) {
       m_usingCachedVersion = true;
       if (debug_AstModel && m_fileId) {
         m_fileContent->printTree(std::cout);
@@ -584,9 +881,11 @@ bool ParseFile::parse() {
   } else {
     bool ok = true;
     for (ParseFile* child : m_children) {
-      ParseCache cache(m_session, child);
-
-      if (cache.restore()) {
+      ParseCache cache(child->m_session, child);
+      Tracer::Span cacheSpan(tracer, "cache", "Restore parser cache", fileSystem->toPath(child->m_ppFileId));
+      const bool restored = cache.restore();
+      cacheSpan.end();
+      if (restored) {
         child->m_fileContent->setParent(m_fileContent);
         m_usingCachedVersion = true;
         if (debug_AstModel && m_fileId) {
@@ -624,15 +923,11 @@ bool ParseFile::parse() {
     if ((m_parent == nullptr) && (m_children.empty())) {
       Timer tmr;
 
-      if (clp->parseTree()) {
-        FileContent* const ppFileContent = getCompileSourceFile()->getPreprocessor()->getFileContent();
-        m_listener =
-            new SV3_1aParserTreeListener(m_session, this, m_antlrParserHandler->m_tokens, m_offsetLine, ppFileContent);
-      } else {
-        m_listener = new SV3_1aTreeShapeListener(m_session, this, m_antlrParserHandler->m_tokens, m_offsetLine);
+      if (m_listener == nullptr) {
+        Tracer::Span walkSpan(tracer, "parse", "Tree walk", fileSystem->toPath(m_ppFileId));
+        createListener_();
+        antlr4::tree::ParseTreeWalker::DEFAULT.walk(m_listener, m_antlrParserHandler->m_tree);
       }
-
-      antlr4::tree::ParseTreeWalker::DEFAULT.walk(m_listener, m_antlrParserHandler->m_tree);
       m_antlrParserHandler->m_parser->getTreeTracker().reset();
 
       if (!m_fileContent->validate()) {
@@ -653,9 +948,11 @@ bool ParseFile::parse() {
 
       ParseCache cache(m_session, this);
       if (clp->link()) return true;
+      Tracer::Span cacheSpan(tracer, "cache", "Save parser cache", fileSystem->toPath(m_ppFileId));
       if (!cache.save()) {
         return false;
       }
+      cacheSpan.end();
 
       if (clp->profile()) {
         m_profileInfo += "Cache saving: " + std::to_string(tmr.elapsed()) + "ms\n";
@@ -665,42 +962,68 @@ bool ParseFile::parse() {
     }
 
     if (!m_children.empty()) {
+      // Only visit the chunks that got re-parsed
+      // TODO: Incrementally regenerate the FileContent
+      std::vector<ParseFile*> chunks;
       for (ParseFile* child : m_children) {
         if (child->m_antlrParserHandler) {
-          // Only visit the chunks that got re-parsed
-          // TODO: Incrementally regenerate the FileContent
           child->m_fileContent->setParent(m_fileContent);
-          if (clp->parseTree()) {
-            FileContent* const ppFileContent = child->getCompileSourceFile()->getPreprocessor()->getFileContent();
-            child->m_listener = new SV3_1aParserTreeListener(m_session, child, child->m_antlrParserHandler->m_tokens,
-                                                             child->m_offsetLine, ppFileContent);
-          } else {
-            child->m_listener = new SV3_1aTreeShapeListener(m_session, child, child->m_antlrParserHandler->m_tokens,
-                                                            child->m_offsetLine);
-          }
-
-          Timer tmr;
-          antlr4::tree::ParseTreeWalker::DEFAULT.walk(child->m_listener, child->m_antlrParserHandler->m_tree);
-          child->m_antlrParserHandler->m_parser->getTreeTracker().reset();
+          chunks.emplace_back(child);
+        }
+      }
 
-          if (clp->profile()) {
-            // m_profileInfo += "For file " + getSymbol
-            // (child->m_ppFileId) + ", AST Walking took" +
-            // std::to_string (tmr.elapsed()) + "ms\n";
-            tmr.reset();
-          }
+      // Every chunk has its own session, file content and parse tree. The
+      // walks still share the compilation unit: a chunk sees the `timescale
+      // and `default_nettype of the chunks before it. Those are recorded
+      // here, in chunk order, and the walks only read them.
+      for (ParseFile* child : chunks) {
+        child->recordChunkDirectives_();
+      }
+      Timer tmr;
+      const bool saveCache = !clp->link();
+      std::vector<char> results(chunks.size(), 1);
+      const uint32_t maxThreadCount = std::min<uint32_t>(clp->getMaxTreads(), chunks.size());
+      if (maxThreadCount < 2) {
+        for (size_t i = 0, ni = chunks.size(); i < ni; ++i) {
+          results[i] = chunks[i]->walkChunk_(saveCache);
+        }
+      } else {
+        std::vector<std::thread*> threads;
+        for (uint32_t t = 0; t < maxThreadCount; ++t) {
+          std::thread* th = new std::thread([=, &chunks, &results] {
+            for (size_t i = t, ni = chunks.size(); i < ni; i += maxThreadCount) {
+              results[i] = chunks[i]->walkChunk_(saveCache);
+            }
+          });
+          threads.emplace_back(th);
+        }
+        for (auto* thread : threads) {  // sync
+          thread->join();
+        }
+        for (auto* thread : threads) {  // delete
+          delete thread;
+        }
+      }
 
-          if (debug_AstModel && m_fileId) {
-            child->m_fileContent->printTree(std::cout);
-          }
+      if (clp->profile()) {
+        m_profileInfo += "Chunks walking and cache saving: " + std::to_string(tmr.elapsed()) + "ms\n";
+        tmr.reset();
+      }
 
-          ParseCache cache(m_session, child);
-          if (clp->link()) return true;
-          if (!cache.save()) {
-            return false;
-          }
+      // Merge back in chunk order so the reports are deterministic
+      ErrorContainer* const errors = m_session->getErrorContainer();
+      bool status = true;
+      for (size_t i = 0, ni = chunks.size(); i < ni; ++i) {
+        ParseFile* const child = chunks[i];
+        if (debug_AstModel && m_fileId) {
+          child->m_fileContent->printTree(std::cout);
+        }
+        if (child->m_session != m_session) {
+          errors->appendErrors(*child->m_session->getErrorContainer());
         }
+        if (!results[i]) status = false;
       }
+      return status;
     }
   }
   return true;
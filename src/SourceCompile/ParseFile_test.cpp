@@ -16,7 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include <string_view>
+#include <vector>
+
+#include "Surelog/CommandLine/CommandLineParser.h"
 #include "Surelog/Common/NodeId.h"
+#include "Surelog/Common/Session.h"
 #include "Surelog/Design/FileContent.h"
 #include "Surelog/SourceCompile/ParserHarness.h"
 #include "Surelog/SourceCompile/VObjectTypes.h"
@@ -54,4 +59,105 @@ TEST(ParserTest, BasicParse) {
     EXPECT_EQ(fC->Type(Unary_Not), VObjectType::paUnary_Not);
   }
 }
+
+TEST(ParserTest, SubtreeIndex) {
+  ParserHarness harness;
+  auto fC = harness.parse(
+      "module top(); assign a = !b; assign c = d & e;"
+      " always @(posedge clk) begin x <= y; end endmodule"
+      " module other(); assign f = g; endmodule");
+  const NodeId root = fC->getRootNode();
+  const VObjectTypeUnorderedSet types = {VObjectType::paContinuous_assign, VObjectType::paExpression,
+                                         VObjectType::paNet_lvalue};
+  const VObjectTypeUnorderedSet stops = {VObjectType::paModule_declaration};
+
+  std::vector<std::vector<NodeId>> walked;
+  for (NodeId id = root; id; id = fC->Child(id)) {
+    walked.emplace_back(fC->sl_collect_all(id, VObjectType::paExpression));
+    walked.emplace_back(fC->sl_collect_all(id, types));
+    walked.emplace_back(fC->sl_collect_all(id, types, true));
+    walked.emplace_back(fC->sl_collect_all(id, types, stops));
+  }
+  EXPECT_FALSE(fC->hasSubtreeIndex());
+
+  fC->buildSubtreeIndex();
+  EXPECT_TRUE(fC->hasSubtreeIndex());
+
+  std::vector<std::vector<NodeId>> indexed;
+  for (NodeId id = root; id; id = fC->Child(id)) {
+    indexed.emplace_back(fC->sl_collect_all(id, VObjectType::paExpression));
+    indexed.emplace_back(fC->sl_collect_all(id, types));
+    indexed.emplace_back(fC->sl_collect_all(id, types, true));
+    indexed.emplace_back(fC->sl_collect_all(id, types, stops));
+  }
+  EXPECT_EQ(walked, indexed);
+  EXPECT_FALSE(indexed.front().empty());
+
+  fC->SetType(root, fC->Type(root));
+  EXPECT_FALSE(fC->hasSubtreeIndex());
+}
+
+TEST(ParserTest, StreamParse) {
+  constexpr std::string_view kSource =
+      "package pkg; parameter P = 2; endpackage // trailing\n"
+      "module top(input a, output b); /* block */ assign b = !a; endmodule\n"
+      "class C; int x; function new(); x = 1; endfunction endclass\n";
+
+  ParserHarness treeHarness;
+  auto treeFC = treeHarness.parse(kSource);
+
+  Session session;
+  session.getCommandLineParser()->setStreamParse(true);
+  ParserHarness streamHarness(&session);
+  auto streamFC = streamHarness.parse(kSource);
+
+  ASSERT_NE(treeFC, nullptr);
+  ASSERT_NE(streamFC, nullptr);
+  ASSERT_EQ(treeFC->getSize(), streamFC->getSize());
+  for (RawNodeId i = 0; i < treeFC->getSize(); ++i) {
+    const NodeId id(i);
+    EXPECT_EQ(treeFC->Type(id), streamFC->Type(id));
+    EXPECT_EQ(treeFC->Parent(id), streamFC->Parent(id));
+    EXPECT_EQ(treeFC->Child(id), streamFC->Child(id));
+    EXPECT_EQ(treeFC->Sibling(id), streamFC->Sibling(id));
+    EXPECT_EQ(treeFC->Line(id), streamFC->Line(id));
+    EXPECT_EQ(treeFC->Column(id), streamFC->Column(id));
+    EXPECT_EQ(treeFC->SymName(id), streamFC->SymName(id));
+  }
+  EXPECT_EQ(treeFC->getDesignElements().size(), streamFC->getDesignElements().size());
+}
+
+TEST(ParserTest, StreamParseWholeFileFallback) {
+  // The syntax error fails the LL re-parse of the description too, the whole
+  // file is then parsed again in LL mode from a cleared file content.
+  constexpr std::string_view kSource =
+      "module ok(); endmodule\n"
+      "module top(); assign b = ; endmodule\n"
+      "module other(input a); endmodule\n";
+
+  ParserHarness treeHarness;
+  auto treeFC = treeHarness.parse(kSource);
+
+  Session session;
+  session.getCommandLineParser()->setStreamParse(true);
+  ParserHarness streamHarness(&session);
+  auto streamFC = streamHarness.parse(kSource);
+
+  ASSERT_NE(treeFC, nullptr);
+  ASSERT_NE(streamFC, nullptr);
+  EXPECT_EQ(streamFC->Type(InvalidNodeId), VObjectType::_INVALID_);
+  const NodeId root = streamFC->getRootNode();
+  EXPECT_TRUE(root);
+  EXPECT_EQ(root, treeFC->getRootNode());
+  EXPECT_EQ(streamFC->Type(root), VObjectType::paTop_level_rule);
+  ASSERT_EQ(treeFC->getSize(), streamFC->getSize());
+  for (RawNodeId i = 0; i < treeFC->getSize(); ++i) {
+    const NodeId id(i);
+    EXPECT_EQ(treeFC->Type(id), streamFC->Type(id));
+    EXPECT_EQ(treeFC->Parent(id), streamFC->Parent(id));
+    EXPECT_EQ(treeFC->Child(id), streamFC->Child(id));
+    EXPECT_EQ(treeFC->Sibling(id), streamFC->Sibling(id));
+  }
+  EXPECT_FALSE(streamFC->sl_collect_all(root, VObjectType::paModule_declaration).empty());
+}
 }}  // namespace SURELOG
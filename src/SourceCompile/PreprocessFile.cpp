@@ -63,6 +63,7 @@
 #include "Surelog/SourceCompile/SymbolTable.h"
 #include "Surelog/Utils/StringUtils.h"
 #include "Surelog/Utils/Timer.h"
+#include "Surelog/Utils/Tracer.h"
 
 namespace SURELOG {
 
@@ -331,7 +332,11 @@ bool PreprocessFile::preprocess() {
   SymbolId macroSignatureId;
   if (m_macroBody.empty()) {
     PPCache cache(m_session, this);
-    if (cache.restore(clp->lowMem() || clp->noCacheHash())) {
+    Tracer::Span cacheSpan(m_session->getTracer(), "cache", "Restore preprocessor cache",
+                           fileSystem->toPath(m_fileId));
+    const bool restored = cache.restore(clp->lowMem() || clp->noCacheHash());
+    cacheSpan.end();
+    if (restored) {
       m_usingCachedVersion = true;
       getCompilationUnit()->setCurrentTimeInfo(getFileId(0));
       if (m_debugAstModel && !isPrecompiled && m_macroBody.empty()) {
@@ -356,6 +361,9 @@ bool PreprocessFile::preprocess() {
   m_antlrParserHandler = m_macroBody.empty() ? getCompileSourceFile()->getAntlrPpHandlerForId(m_fileId)
                                              : getCompileSourceFile()->getAntlrPpHandlerForId(macroSignatureId);
 
+  // Macro bodies are too many and too small to be traced
+  Tracer* const tracer = m_macroBody.empty() ? m_session->getTracer() : nullptr;
+  Tracer::Span parseSpan(tracer, "pp", "Preprocessor parse", fileSystem->toPath(m_fileId));
   if (m_antlrParserHandler == nullptr) {
     m_antlrParserHandler = new AntlrParserHandler();
     m_antlrParserHandler->m_clearAntlrCache = clp->lowMem();
@@ -511,6 +519,9 @@ bool PreprocessFile::preprocess() {
       getCompileSourceFile()->registerAntlrPpHandlerForId(macroSignatureId, m_antlrParserHandler);
     }
   }
+  parseSpan.end();
+
+  Tracer::Span walkSpan(tracer, "pp", "Preprocessor walk", fileSystem->toPath(m_fileId));
   m_result.clear();
   m_lineCount = 0;
   delete m_listener;
@@ -542,6 +553,7 @@ bool PreprocessFile::preprocess() {
 
   if (m_macroBody.empty() && (m_includer == nullptr)) {
     m_antlrParserHandler->m_ppparser->getTreeTracker().reset();
+    m_antlrParserHandler->m_pptree = nullptr;
 
     const auto [lastLine, lastColumn] = getCurrentPosition();
     getSourceFile()->addIncludeFileInfo(
@@ -0,0 +1,1005 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/SourceCompile/SV3_1aFastLexer.h"
+
+#include <antlr4-runtime.h>
+#include <parser/SV3_1aLexer.h>
+
+// MSVC does not define __SSE2__, SSE2 is part of its x64 baseline
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define SURELOG_FASTLEXER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SURELOG {
+namespace {
+enum CharClass : uint8_t {
+  kIdentifierStart = 1 << 0,  // [a-zA-Z_]
+  kIdentifierPart = 1 << 1,   // [a-zA-Z0-9_$]
+  kDigit = 1 << 2,            // [0-9]
+  kWhiteSpace = 1 << 3,       // [ \t\n\r]
+};
+
+constexpr std::array<uint8_t, 128> makeCharClasses() {
+  std::array<uint8_t, 128> classes{};
+  for (uint32_t c = 0; c < 128; ++c) {
+    const bool alpha = ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'));
+    const bool digit = (c >= '0') && (c <= '9');
+    uint8_t value = 0;
+    if (alpha || (c == '_')) value |= kIdentifierStart;
+    if (alpha || digit || (c == '_') || (c == '$')) value |= kIdentifierPart;
+    if (digit) value |= kDigit;
+    if ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r')) value |= kWhiteSpace;
+    classes[c] = value;
+  }
+  return classes;
+}
+
+constexpr std::array<uint8_t, 128> kCharClasses = makeCharClasses();
+
+inline bool isA(uint32_t c, uint8_t charClass) { return (c < 128) && ((kCharClasses[c] & charClass) != 0); }
+
+inline bool isDigit(uint32_t c) { return (c >= '0') && (c <= '9'); }
+
+// x_digit | z_digit, z_digit including '?'
+inline bool isXZDigit(uint32_t c) { return (c == 'x') || (c == 'X') || (c == 'z') || (c == 'Z') || (c == '?'); }
+
+// Digit of a based value, base being one of 'b', 'o' or 'h'
+inline bool isBaseDigit(uint32_t c, uint32_t base) {
+  if (isXZDigit(c)) return true;
+  switch (base) {
+    case 'b': return (c == '0') || (c == '1');
+    case 'o': return (c >= '0') && (c <= '7');
+    default: return isDigit(c) || ((c >= 'a') && (c <= 'f')) || ((c >= 'A') && (c <= 'F'));
+  }
+}
+
+// Literal rules whose text is an identifier, in alphabetical order.
+// Rules with a { sverilog }? predicate are only recognized in SystemVerilog
+// mode, otherwise the text is a SIMPLE_IDENTIFIER.
+struct Keyword final {
+  std::string_view m_text;
+  size_t m_type;
+  bool m_sverilogOnly;
+};
+
+// clang-format off
+const Keyword kKeywords[] = {
+    {"PATHPULSE", SV3_1aLexer::PATHPULSE, false},
+    {"accept_on", SV3_1aLexer::ACCEPT_ON, false},
+    {"alias", SV3_1aLexer::ALIAS, false},
+    {"always", SV3_1aLexer::ALWAYS, false},
+    {"always_comb", SV3_1aLexer::ALWAYS_COMB, false},
+    {"always_ff", SV3_1aLexer::ALWAYS_FF, false},
+    {"always_latch", SV3_1aLexer::ALWAYS_LATCH, false},
+    {"and", SV3_1aLexer::AND, false},
+    {"assert", SV3_1aLexer::ASSERT, false},
+    {"assign", SV3_1aLexer::ASSIGN, false},
+    {"assume", SV3_1aLexer::ASSUME, false},
+    {"automatic", SV3_1aLexer::AUTOMATIC, false},
+    {"before", SV3_1aLexer::BEFORE, false},
+    {"begin", SV3_1aLexer::BEGIN, false},
+    {"bind", SV3_1aLexer::BIND, false},
+    {"bins", SV3_1aLexer::BINS, false},
+    {"binsof", SV3_1aLexer::BINSOF, false},
+    {"bit", SV3_1aLexer::BIT, true},
+    {"break", SV3_1aLexer::BREAK, false},
+    {"buf", SV3_1aLexer::BUF, false},
+    {"bufif0", SV3_1aLexer::BUFIF0, false},
+    {"bufif1", SV3_1aLexer::BUFIF1, false},
+    {"byte", SV3_1aLexer::BYTE, true},
+    {"case", SV3_1aLexer::CASE, false},
+    {"casex", SV3_1aLexer::CASEX, false},
+    {"casez", SV3_1aLexer::CASEZ, false},
+    {"cell", SV3_1aLexer::CELL, false},
+    {"chandle", SV3_1aLexer::CHANDLE, false},
+    {"checker", SV3_1aLexer::CHECKER, false},
+    {"class", SV3_1aLexer::CLASS, false},
+    {"clocking", SV3_1aLexer::CLOCKING, false},
+    {"cmos", SV3_1aLexer::CMOS, false},
+    {"config", SV3_1aLexer::CONFIG, false},
+    {"const", SV3_1aLexer::CONST, false},
+    {"constraint", SV3_1aLexer::CONSTRAINT, false},
+    {"context", SV3_1aLexer::CONTEXT, true},
+    {"continue", SV3_1aLexer::CONTINUE, false},
+    {"cover", SV3_1aLexer::COVER, false},
+    {"covergroup", SV3_1aLexer::COVERGROUP, false},
+    {"coverpoint", SV3_1aLexer::COVERPOINT, false},
+    {"cross", SV3_1aLexer::CROSS, false},
+    {"deassign", SV3_1aLexer::DEASSIGN, false},
+    {"default", SV3_1aLexer::DEFAULT, false},
+    {"defparam", SV3_1aLexer::DEFPARAM, false},
+    {"design", SV3_1aLexer::DESIGN, false},
+    {"disable", SV3_1aLexer::DISABLE, false},
+    {"dist", SV3_1aLexer::DIST, false},
+    {"do", SV3_1aLexer::DO, true},
+    {"edge", SV3_1aLexer::EDGE, false},
+    {"else", SV3_1aLexer::ELSE, false},
+    {"end", SV3_1aLexer::END, false},
+    {"endcase", SV3_1aLexer::ENDCASE, false},
+    {"endchecker", SV3_1aLexer::ENDCHECKER, false},
+    {"endclass", SV3_1aLexer::ENDCLASS, false},
+    {"endclocking", SV3_1aLexer::ENDCLOCKING, false},
+    {"endconfig", SV3_1aLexer::ENDCONFIG, false},
+    {"endfunction", SV3_1aLexer::ENDFUNCTION, false},
+    {"endgenerate", SV3_1aLexer::ENDGENERATE, false},
+    {"endgroup", SV3_1aLexer::ENDGROUP, false},
+    {"endinterface", SV3_1aLexer::ENDINTERFACE, false},
+    {"endmodule", SV3_1aLexer::ENDMODULE, false},
+    {"endpackage", SV3_1aLexer::ENDPACKAGE, false},
+    {"endprimitive", SV3_1aLexer::ENDPRIMITIVE, false},
+    {"endprogram", SV3_1aLexer::ENDPROGRAM, false},
+    {"endproperty", SV3_1aLexer::ENDPROPERTY, false},
+    {"endsequence", SV3_1aLexer::ENDSEQUENCE, false},
+    {"endspecify", SV3_1aLexer::ENDSPECIFY, false},
+    {"endtable", SV3_1aLexer::ENDTABLE, false},
+    {"endtask", SV3_1aLexer::ENDTASK, false},
+    {"enum", SV3_1aLexer::ENUM, false},
+    {"event", SV3_1aLexer::EVENT, false},
+    {"eventually", SV3_1aLexer::EVENTUALLY, false},
+    {"expect", SV3_1aLexer::EXPECT, true},
+    {"export", SV3_1aLexer::EXPORT, false},
+    {"extends", SV3_1aLexer::EXTENDS, false},
+    {"extern", SV3_1aLexer::EXTERN, false},
+    {"final", SV3_1aLexer::FINAL, true},
+    {"first_match", SV3_1aLexer::FIRST_MATCH, false},
+    {"for", SV3_1aLexer::FOR, false},
+    {"force", SV3_1aLexer::FORCE, false},
+    {"foreach", SV3_1aLexer::FOREACH, false},
+    {"forever", SV3_1aLexer::FOREVER, false},
+    {"fork", SV3_1aLexer::FORK, false},
+    {"forkjoin", SV3_1aLexer::FORKJOIN, false},
+    {"function", SV3_1aLexer::FUNCTION, false},
+    {"generate", SV3_1aLexer::GENERATE, false},
+    {"genvar", SV3_1aLexer::GENVAR, false},
+    {"global", SV3_1aLexer::GLOBAL, true},
+    {"highz0", SV3_1aLexer::HIGHZ0, false},
+    {"highz1", SV3_1aLexer::HIGHZ1, false},
+    {"if", SV3_1aLexer::IF, false},
+    {"iff", SV3_1aLexer::IFF, false},
+    {"ifnone", SV3_1aLexer::IFNONE, false},
+    {"ignore_bins", SV3_1aLexer::IGNORE_BINS, false},
+    {"illegal_bins", SV3_1aLexer::ILLEGAL_BINS, false},
+    {"implements", SV3_1aLexer::IMPLEMENTS, false},
+    {"implies", SV3_1aLexer::IMPLIES, false},
+    {"import", SV3_1aLexer::IMPORT, false},
+    {"include", SV3_1aLexer::INCLUDE, false},
+    {"initial", SV3_1aLexer::INITIAL, false},
+    {"inout", SV3_1aLexer::INOUT, false},
+    {"input", SV3_1aLexer::INPUT, false},
+    {"inside", SV3_1aLexer::INSIDE, false},
+    {"instance", SV3_1aLexer::INSTANCE, false},
+    {"int", SV3_1aLexer::INT, false},
+    {"integer", SV3_1aLexer::INTEGER, false},
+    {"interconnect", SV3_1aLexer::INTERCONNECT, false},
+    {"interface", SV3_1aLexer::INTERFACE, false},
+    {"intersect", SV3_1aLexer::INTERSECT, false},
+    {"join", SV3_1aLexer::JOIN, false},
+    {"join_any", SV3_1aLexer::JOIN_ANY, false},
+    {"join_none", SV3_1aLexer::JOIN_NONE, false},
+    {"let", SV3_1aLexer::LET, false},
+    {"liblist", SV3_1aLexer::LIBLIST, false},
+    {"library", SV3_1aLexer::LIBRARY, false},
+    {"local", SV3_1aLexer::LOCAL, false},
+    {"localparam", SV3_1aLexer::LOCALPARAM, false},
+    {"logic", SV3_1aLexer::LOGIC, true},
+    {"longint", SV3_1aLexer::LONGINT, false},
+    {"macromodule", SV3_1aLexer::MACROMODULE, false},
+    {"matches", SV3_1aLexer::MATCHES, false},
+    {"modport", SV3_1aLexer::MODPORT, false},
+    {"module", SV3_1aLexer::MODULE, false},
+    {"nand", SV3_1aLexer::NAND, false},
+    {"negedge", SV3_1aLexer::NEGEDGE, false},
+    {"nettype", SV3_1aLexer::NETTYPE, false},
+    {"new", SV3_1aLexer::NEW, true},
+    {"nexttime", SV3_1aLexer::NEXTTIME, false},
+    {"nmos", SV3_1aLexer::NMOS, false},
+    {"nor", SV3_1aLexer::NOR, false},
+    {"noshowcancelled", SV3_1aLexer::NOSHOWCANCELLED, false},
+    {"not", SV3_1aLexer::NOT, false},
+    {"notif0", SV3_1aLexer::NOTIF0, false},
+    {"notif1", SV3_1aLexer::NOTIF1, false},
+    {"null", SV3_1aLexer::NULL_KEYWORD, false},
+    {"or", SV3_1aLexer::OR, false},
+    {"output", SV3_1aLexer::OUTPUT, false},
+    {"package", SV3_1aLexer::PACKAGE, false},
+    {"packed", SV3_1aLexer::PACKED, false},
+    {"parameter", SV3_1aLexer::PARAMETER, false},
+    {"pmos", SV3_1aLexer::PMOS, false},
+    {"posedge", SV3_1aLexer::POSEDGE, false},
+    {"primitive", SV3_1aLexer::PRIMITIVE, false},
+    {"priority", SV3_1aLexer::PRIORITY, false},
+    {"program", SV3_1aLexer::PROGRAM, false},
+    {"property", SV3_1aLexer::PROPERTY, false},
+    {"protected", SV3_1aLexer::PROTECTED, false},
+    {"pull0", SV3_1aLexer::PULL0, false},
+    {"pull1", SV3_1aLexer::PULL1, false},
+    {"pulldown", SV3_1aLexer::PULLDOWN, false},
+    {"pullup", SV3_1aLexer::PULLUP, false},
+    {"pulsestyle_ondetect", SV3_1aLexer::PULSESTYLE_ONDETECT, false},
+    {"pulsestyle_onevent", SV3_1aLexer::PULSESTYLE_ONEVENT, false},
+    {"pure", SV3_1aLexer::PURE, false},
+    {"rand", SV3_1aLexer::RAND, false},
+    {"randc", SV3_1aLexer::RANDC, false},
+    {"randcase", SV3_1aLexer::RANDCASE, false},
+    {"randomize", SV3_1aLexer::RANDOMIZE, true},
+    {"randsequence", SV3_1aLexer::RANDSEQUENCE, false},
+    {"rcmos", SV3_1aLexer::RCMOS, false},
+    {"real", SV3_1aLexer::REAL, false},
+    {"realtime", SV3_1aLexer::REALTIME, false},
+    {"ref", SV3_1aLexer::REF, true},
+    {"reg", SV3_1aLexer::REG, false},
+    {"reject_on", SV3_1aLexer::REJECT_ON, false},
+    {"release", SV3_1aLexer::RELEASE, false},
+    {"repeat", SV3_1aLexer::REPEAT, false},
+    {"restrict", SV3_1aLexer::RESTRICT, false},
+    {"return", SV3_1aLexer::RETURN, false},
+    {"rnmos", SV3_1aLexer::RNMOS, false},
+    {"rpmos", SV3_1aLexer::RPMOS, false},
+    {"rtran", SV3_1aLexer::RTRAN, false},
+    {"rtranif0", SV3_1aLexer::RTRANIF0, false},
+    {"rtranif1", SV3_1aLexer::RTRANIF1, false},
+    {"s_always", SV3_1aLexer::S_ALWAYS, false},
+    {"s_eventually", SV3_1aLexer::S_EVENTUALLY, false},
+    {"s_nexttime", SV3_1aLexer::S_NEXTTIME, false},
+    {"s_until", SV3_1aLexer::S_UNTIL, false},
+    {"s_until_with", SV3_1aLexer::S_UNTIL_WITH, false},
+    {"sample", SV3_1aLexer::SAMPLE, true},
+    {"scalared", SV3_1aLexer::SCALARED, false},
+    {"sequence", SV3_1aLexer::SEQUENCE, false},
+    {"shortint", SV3_1aLexer::SHORTINT, false},
+    {"shortreal", SV3_1aLexer::SHORTREAL, false},
+    {"showcancelled", SV3_1aLexer::SHOWCANCELLED, false},
+    {"signed", SV3_1aLexer::SIGNED, false},
+    {"soft", SV3_1aLexer::SOFT, true},
+    {"solve", SV3_1aLexer::SOLVE, false},
+    {"specify", SV3_1aLexer::SPECIFY, false},
+    {"specparam", SV3_1aLexer::SPECPARAM, false},
+    {"static", SV3_1aLexer::STATIC, false},
+    {"string", SV3_1aLexer::STRING, false},
+    {"strong", SV3_1aLexer::STRONG, false},
+    {"strong0", SV3_1aLexer::STRONG0, false},
+    {"strong1", SV3_1aLexer::STRONG1, false},
+    {"struct", SV3_1aLexer::STRUCT, false},
+    {"super", SV3_1aLexer::SUPER, false},
+    {"supply0", SV3_1aLexer::SUPPLY0, false},
+    {"supply1", SV3_1aLexer::SUPPLY1, false},
+    {"sync_accept_on", SV3_1aLexer::SYNC_ACCEPT_ON, false},
+    {"sync_reject_on", SV3_1aLexer::SYNC_REJECT_ON, false},
+    {"table", SV3_1aLexer::TABLE, false},
+    {"tagged", SV3_1aLexer::TAGGED, false},
+    {"task", SV3_1aLexer::TASK, false},
+    {"this", SV3_1aLexer::THIS, true},
+    {"throughout", SV3_1aLexer::THROUGHOUT, false},
+    {"time", SV3_1aLexer::TIME, false},
+    {"timeprecision", SV3_1aLexer::TIMEPRECISION, false},
+    {"timeunit", SV3_1aLexer::TIMEUNIT, false},
+    {"tran", SV3_1aLexer::TRAN, false},
+    {"tranif0", SV3_1aLexer::TRANIF0, false},
+    {"tranif1", SV3_1aLexer::TRANIF1, false},
+    {"tri", SV3_1aLexer::TRI, false},
+    {"tri0", SV3_1aLexer::TRI0, false},
+    {"tri1", SV3_1aLexer::TRI1, false},
+    {"triand", SV3_1aLexer::TRIAND, false},
+    {"trior", SV3_1aLexer::TRIOR, false},
+    {"trireg", SV3_1aLexer::TRIREG, false},
+    {"type", SV3_1aLexer::TYPE, true},
+    {"typedef", SV3_1aLexer::TYPEDEF, false},
+    {"union", SV3_1aLexer::UNION, false},
+    {"unique", SV3_1aLexer::UNIQUE, false},
+    {"unique0", SV3_1aLexer::UNIQUE0, false},
+    {"unsigned", SV3_1aLexer::UNSIGNED, false},
+    {"until", SV3_1aLexer::UNTIL, false},
+    {"until_with", SV3_1aLexer::UNTIL_WITH, false},
+    {"untyped", SV3_1aLexer::UNTYPED, false},
+    {"use", SV3_1aLexer::USE, false},
+    {"uwire", SV3_1aLexer::UWIRE, false},
+    {"var", SV3_1aLexer::VAR, true},
+    {"vectored", SV3_1aLexer::VECTORED, false},
+    {"virtual", SV3_1aLexer::VIRTUAL, false},
+    {"void", SV3_1aLexer::VOID, false},
+    {"wait", SV3_1aLexer::WAIT, false},
+    {"wait_order", SV3_1aLexer::WAIT_ORDER, false},
+    {"wand", SV3_1aLexer::WAND, false},
+    {"weak", SV3_1aLexer::WEAK, false},
+    {"weak0", SV3_1aLexer::WEAK0, false},
+    {"weak1", SV3_1aLexer::WEAK1, false},
+    {"while", SV3_1aLexer::WHILE, false},
+    {"wildcard", SV3_1aLexer::WILDCARD, false},
+    {"wire", SV3_1aLexer::WIRE, false},
+    {"with", SV3_1aLexer::WITH, false},
+    {"within", SV3_1aLexer::WITHIN, false},
+    {"wor", SV3_1aLexer::WOR, false},
+    {"xnor", SV3_1aLexer::XNOR, false},
+    {"xor", SV3_1aLexer::XOR, false},
+};
+
+// All other literal rules, grouped by first character, longest first.
+// DOLLAR_UNIT, DOLLAR_ROOT, OPTION_DOT and TYPE_OPTION_DOT are fixed text
+// too and so are listed here.
+struct Literal final {
+  std::string_view m_text;
+  size_t m_type;
+};
+
+const Literal kLiterals[] = {
+    {"!==", SV3_1aLexer::FOUR_STATE_LOGIC_NOTEQUAL},
+    {"!=?", SV3_1aLexer::BINARY_WILDCARD_NOTEQUAL},
+    {"!?=", SV3_1aLexer::WILD_NOTEQUAL_OP},
+    {"!=", SV3_1aLexer::NOTEQUAL},
+    {"!", SV3_1aLexer::BANG},
+    {"#-#", SV3_1aLexer::OVERLAPPED},
+    {"#=#", SV3_1aLexer::NONOVERLAPPED},
+    {"##", SV3_1aLexer::POUNDPOUND},
+    {"#", SV3_1aLexer::POUND},
+    {"$root", SV3_1aLexer::DOLLAR_ROOT},
+    {"$unit", SV3_1aLexer::DOLLAR_UNIT},
+    {"$", SV3_1aLexer::DOLLAR},
+    {"%=", SV3_1aLexer::MODULO_ASSIGN},
+    {"%", SV3_1aLexer::PERCENT},
+    {"&&&", SV3_1aLexer::COND_PRED_OP},
+    {"&&", SV3_1aLexer::LOGICAL_AND},
+    {"&=", SV3_1aLexer::BITW_AND_ASSIGN},
+    {"&", SV3_1aLexer::BITW_AND},
+    {"'B0", SV3_1aLexer::TICK_B0},
+    {"'B1", SV3_1aLexer::TICK_B1},
+    {"'b0", SV3_1aLexer::TICK_b0},
+    {"'b1", SV3_1aLexer::TICK_b1},
+    {"'0", SV3_1aLexer::TICK_0},
+    {"'1", SV3_1aLexer::TICK_1},
+    {"'", SV3_1aLexer::TICK},
+    {"(medium)", SV3_1aLexer::MEDIUM},
+    {"(large)", SV3_1aLexer::LARGE},
+    {"(small)", SV3_1aLexer::SMALL},
+    {"(*", SV3_1aLexer::OPEN_PARENS_STAR},
+    {"(", SV3_1aLexer::OPEN_PARENS},
+    {")", SV3_1aLexer::CLOSE_PARENS},
+    {"*::*", SV3_1aLexer::STARCOLONCOLONSTAR},
+    {"*)", SV3_1aLexer::STAR_CLOSE_PARENS},
+    {"**", SV3_1aLexer::STARSTAR},
+    {"*=", SV3_1aLexer::MULT_ASSIGN},
+    {"*>", SV3_1aLexer::FULL_CONN_OP},
+    {"*", SV3_1aLexer::STAR},
+    {"++", SV3_1aLexer::PLUSPLUS},
+    {"+:", SV3_1aLexer::INC_PART_SELECT_OP},
+    {"+=", SV3_1aLexer::ADD_ASSIGN},
+    {"+", SV3_1aLexer::PLUS},
+    {",", SV3_1aLexer::COMMA},
+    {"-incdir", SV3_1aLexer::INCDIR},
+    {"->>", SV3_1aLexer::NON_BLOCKING_TRIGGER_EVENT_OP},
+    {"--", SV3_1aLexer::MINUSMINUS},
+    {"-:", SV3_1aLexer::DEC_PART_SELECT_OP},
+    {"-=", SV3_1aLexer::SUB_ASSIGN},
+    {"->", SV3_1aLexer::IMPLY},
+    {"-", SV3_1aLexer::MINUS},
+    {".*", SV3_1aLexer::DOTSTAR},
+    {".", SV3_1aLexer::DOT},
+    {"/=", SV3_1aLexer::DIV_ASSIGN},
+    {"/", SV3_1aLexer::DIV},
+    {"1step", SV3_1aLexer::ONESTEP},
+    {"1'B0", SV3_1aLexer::ONE_TICK_B0},
+    {"1'B1", SV3_1aLexer::ONE_TICK_B1},
+    {"1'BX", SV3_1aLexer::ONE_TICK_BX},
+    {"1'Bx", SV3_1aLexer::ONE_TICK_Bx},
+    {"1'b0", SV3_1aLexer::ONE_TICK_b0},
+    {"1'b1", SV3_1aLexer::ONE_TICK_b1},
+    {"1'bX", SV3_1aLexer::ONE_TICK_bX},
+    {"1'bx", SV3_1aLexer::ONE_TICK_bx},
+    {"::", SV3_1aLexer::COLONCOLON},
+    {":=", SV3_1aLexer::ASSIGN_VALUE},
+    {":", SV3_1aLexer::COLON},
+    {";", SV3_1aLexer::SEMICOLON},
+    {"<<<=", SV3_1aLexer::ARITH_SHIFT_LEFT_ASSIGN},
+    {"<->", SV3_1aLexer::EQUIVALENCE},
+    {"<<<", SV3_1aLexer::ARITH_SHIFT_LEFT},
+    {"<<=", SV3_1aLexer::BITW_LEFT_SHIFT_ASSIGN},
+    {"<<", SV3_1aLexer::SHIFT_LEFT},
+    {"<=", SV3_1aLexer::LESS_EQUAL},
+    {"<", SV3_1aLexer::LESS},
+    {"===", SV3_1aLexer::FOUR_STATE_LOGIC_EQUAL},
+    {"==?", SV3_1aLexer::BINARY_WILDCARD_EQUAL},
+    {"=?=", SV3_1aLexer::WILD_EQUAL_OP},
+    {"==", SV3_1aLexer::EQUIV},
+    {"=>", SV3_1aLexer::TRANSITION_OP},
+    {"=", SV3_1aLexer::ASSIGN_OP},
+    {">>>=", SV3_1aLexer::ARITH_SHIFT_RIGHT_ASSIGN},
+    {">>=", SV3_1aLexer::BITW_RIGHT_SHIFT_ASSIGN},
+    {">>>", SV3_1aLexer::ARITH_SHIFT_RIGHT},
+    {">=", SV3_1aLexer::GREATER_EQUAL},
+    {">>", SV3_1aLexer::SHIFT_RIGHT},
+    {">", SV3_1aLexer::GREATER},
+    {"?", SV3_1aLexer::QMARK},
+    {"@@", SV3_1aLexer::ATAT},
+    {"@", SV3_1aLexer::AT},
+    {"[->", SV3_1aLexer::GOTO_REP},
+    {"[*", SV3_1aLexer::CONSECUTIVE_REP},
+    {"[=", SV3_1aLexer::NON_CONSECUTIVE_REP},
+    {"[", SV3_1aLexer::OPEN_BRACKET},
+    {"]", SV3_1aLexer::CLOSE_BRACKET},
+    {"^=", SV3_1aLexer::BITW_XOR_ASSIGN},
+    {"^~", SV3_1aLexer::REDUCTION_XNOR1},
+    {"^", SV3_1aLexer::BITW_XOR},
+    {"`default_trireg_strength", SV3_1aLexer::TICK_DEFAULT_TRIREG_STRENGTH},
+    {"`delay_mode_distributed", SV3_1aLexer::TICK_DELAY_MODE_DISTRIBUTED},
+    {"`autoexpand_vectornets", SV3_1aLexer::TICK_AUTOEXPAND_VECTORNETS},
+    {"`noexpand_vectornets", SV3_1aLexer::TICK_NOEXPAND_VECTORNETS},
+    {"`nounconnected_drive", SV3_1aLexer::TICK_NOUNCONNECTED_DRIVE},
+    {"`default_decay_time", SV3_1aLexer::TICK_DEFAULT_DECAY_TIME},
+    {"`disable_portfaults", SV3_1aLexer::TICK_DISABLE_PORTFAULTS},
+    {"`noremove_gatenames", SV3_1aLexer::TICK_NOREMOVE_GATENAMES},
+    {"`enable_portfaults", SV3_1aLexer::TICK_ENABLE_PORTFAULTS},
+    {"`expand_vectornets", SV3_1aLexer::TICK_EXPAND_VECTORNETS},
+    {"`noremove_netnames", SV3_1aLexer::TICK_NOREMOVE_NETNAMES},
+    {"`nosuppress_faults", SV3_1aLexer::TICK_NOSUPPRESS_FAULTS},
+    {"`unconnected_drive", SV3_1aLexer::TICK_UNCONNECTED_DRIVE},
+    {"`default_nettype", SV3_1aLexer::TICK_DEFAULT_NETTYPE},
+    {"`delay_mode_path", SV3_1aLexer::TICK_DELAY_MODE_PATH},
+    {"`delay_mode_unit", SV3_1aLexer::TICK_DELAY_MODE_UNIT},
+    {"`delay_mode_zero", SV3_1aLexer::TICK_DELAY_MODE_ZERO},
+    {"`remove_gatename", SV3_1aLexer::TICK_REMOVE_GATENAME},
+    {"`suppress_faults", SV3_1aLexer::TICK_SUPPRESS_FAULTS},
+    {"`begin_keywords", SV3_1aLexer::TICK_BEGIN_KEYWORDS},
+    {"`remove_netname", SV3_1aLexer::TICK_REMOVE_NETNAME},
+    {"`endcelldefine", SV3_1aLexer::TICK_ENDCELLDEFINE},
+    {"`end_keywords", SV3_1aLexer::TICK_END_KEYWORDS},
+    {"`endprotected", SV3_1aLexer::TICK_ENDPROTECTED},
+    {"`noaccelerate", SV3_1aLexer::TICK_NOACCELERATE},
+    {"`accelerate", SV3_1aLexer::TICK_ACCELERATE},
+    {"`celldefine", SV3_1aLexer::TICK_CELLDEFINE},
+    {"`endprotect", SV3_1aLexer::TICK_ENDPROTECT},
+    {"`protected", SV3_1aLexer::TICK_PROTECTED},
+    {"`timescale", SV3_1aLexer::TICK_TIMESCALE},
+    {"`unsigned", SV3_1aLexer::TICK_UNSIGNED},
+    {"`protect", SV3_1aLexer::TICK_PROTECT},
+    {"`pragma", SV3_1aLexer::TICK_PRAGMA},
+    {"`signed", SV3_1aLexer::TICK_SIGNED},
+    {"`uselib", SV3_1aLexer::TICK_USELIB},
+    {"`line", SV3_1aLexer::TICK_LINE},
+    {"`", SV3_1aLexer::BACK_TICK},
+    {"option.", SV3_1aLexer::OPTION_DOT},
+    {"type_option.", SV3_1aLexer::TYPE_OPTION_DOT},
+    {"{", SV3_1aLexer::OPEN_CURLY},
+    {"|->", SV3_1aLexer::OVERLAP_IMPLY},
+    {"|=>", SV3_1aLexer::NON_OVERLAP_IMPLY},
+    {"|=", SV3_1aLexer::BITW_OR_ASSIGN},
+    {"||", SV3_1aLexer::LOGICAL_OR},
+    {"|", SV3_1aLexer::BITW_OR},
+    {"}", SV3_1aLexer::CLOSE_CURLY},
+    {"~&", SV3_1aLexer::REDUCTION_NAND},
+    {"~^", SV3_1aLexer::REDUCTION_XNOR2},
+    {"~|", SV3_1aLexer::REDUCTION_NOR},
+    {"~", SV3_1aLexer::TILDA},
+};
+// clang-format on
+
+// Two level perfect hash over kKeywords (hash and displace): the first hash
+// selects a bucket, the bucket's displacement seeds the second hash which
+// gives a slot that holds at most one keyword. A lookup is always two hashes
+// and a single comparison.
+class KeywordTable final {
+ public:
+  KeywordTable() {
+    std::vector<std::vector<uint16_t>> buckets(kBucketCount);
+    for (uint16_t i = 0, ni = static_cast<uint16_t>(std::size(kKeywords)); i < ni; ++i) {
+      const std::string_view text = kKeywords[i].m_text;
+      buckets[hash(text.data(), text.size(), 0) % kBucketCount].emplace_back(i);
+      m_maxLength = std::max(m_maxLength, text.size());
+    }
+
+    std::vector<uint32_t> order(kBucketCount);
+    for (uint32_t i = 0; i < kBucketCount; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&buckets](uint32_t lhs, uint32_t rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+    m_slots.fill(kEmptySlot);
+    std::vector<uint32_t> slots;
+    for (uint32_t bucket : order) {
+      const std::vector<uint16_t>& keywords = buckets[bucket];
+      if (keywords.empty()) break;
+      for (uint32_t displacement = 1;; ++displacement) {
+        slots.clear();
+        for (uint16_t keyword : keywords) {
+          const std::string_view text = kKeywords[keyword].m_text;
+          const uint32_t slot = hash(text.data(), text.size(), displacement) % kSlotCount;
+          if ((m_slots[slot] != kEmptySlot) || (std::find(slots.begin(), slots.end(), slot) != slots.end())) break;
+          slots.emplace_back(slot);
+        }
+        if (slots.size() != keywords.size()) continue;
+        for (size_t i = 0; i < keywords.size(); ++i) m_slots[slots[i]] = keywords[i];
+        m_displacements[bucket] = displacement;
+        break;
+      }
+    }
+  }
+
+  const Keyword* find(const char32_t* text, size_t length) const {
+    if (length > m_maxLength) return nullptr;
+    const uint32_t displacement = m_displacements[hash(text, length, 0) % kBucketCount];
+    if (displacement == 0) return nullptr;
+    const uint16_t slot = m_slots[hash(text, length, displacement) % kSlotCount];
+    if (slot == kEmptySlot) return nullptr;
+    const Keyword& keyword = kKeywords[slot];
+    if (keyword.m_text.size() != length) return nullptr;
+    for (size_t i = 0; i < length; ++i) {
+      if (static_cast<uint32_t>(keyword.m_text[i]) != static_cast<uint32_t>(text[i])) return nullptr;
+    }
+    return &keyword;
+  }
+
+ private:
+  static constexpr uint32_t kBucketCount = 128;
+  static constexpr uint32_t kSlotCount = 512;
+  static constexpr uint16_t kEmptySlot = 0xFFFF;
+
+  template <typename CharType>
+  static uint32_t hash(const CharType* text, size_t length, uint32_t seed) {
+    uint32_t value = 2166136261u ^ (seed * 0x9E3779B9u) ^ static_cast<uint32_t>(length);
+    for (size_t i = 0; i < length; ++i) {
+      value ^= static_cast<uint32_t>(text[i]);
+      value *= 16777619u;
+    }
+    return value ^ (value >> 15);
+  }
+
+  std::array<uint32_t, kBucketCount> m_displacements{};
+  std::array<uint16_t, kSlotCount> m_slots{};
+  size_t m_maxLength = 0;
+};
+
+const KeywordTable& getKeywordTable() {
+  static const KeywordTable table;
+  return table;
+}
+
+// [begin, end) range of kLiterals per (ASCII) first character
+using LiteralRanges = std::array<std::pair<uint16_t, uint16_t>, 128>;
+
+const LiteralRanges& getLiteralRanges() {
+  static const LiteralRanges ranges = [] {
+    LiteralRanges result{};
+    for (uint16_t i = 0, ni = static_cast<uint16_t>(std::size(kLiterals)); i < ni; ++i) {
+      std::pair<uint16_t, uint16_t>& range = result[static_cast<unsigned char>(kLiterals[i].m_text.front())];
+      if (range.first == range.second) range.first = i;
+      range.second = i + 1;
+    }
+    return result;
+  }();
+  return ranges;
+}
+
+template <typename StringType>
+bool startsWith(const std::u32string& text, size_t index, const StringType& prefix) {
+  if ((index + prefix.size()) > text.size()) return false;
+  for (size_t i = 0; i < prefix.size(); ++i) {
+    if (static_cast<uint32_t>(text[index + i]) != static_cast<uint32_t>(prefix[i])) return false;
+  }
+  return true;
+}
+
+#if defined(SURELOG_FASTLEXER_SSE2)
+// Lane of the lowest set bit of a non zero _mm_movemask_epi8 result over
+// 32 bit lanes.
+inline int firstSetLane(int mask) {
+#if defined(_MSC_VER)
+  unsigned long bit = 0;
+  _BitScanForward(&bit, static_cast<unsigned long>(mask));
+  return static_cast<int>(bit) / 4;
+#else
+  return __builtin_ctz(static_cast<unsigned>(mask)) / 4;
+#endif
+}
+#endif
+}  // namespace
+
+SV3_1aFastLexer::SV3_1aFastLexer(antlr4::CharStream* input) : m_input(input), m_sourcePair(this, input) {
+  // The token start/stop indices are code point indices in the stream, so
+  // scan the decoded code points rather than the original UTF-8 text.
+  const size_t size = input->size();
+  const size_t mark = input->index();
+  input->seek(0);
+  m_text.reserve(size);
+  for (size_t i = 1; i <= size; ++i) {
+    m_text.push_back(static_cast<char32_t>(input->LA(static_cast<ssize_t>(i))));
+  }
+  input->seek(mark);
+}
+
+antlr4::TokenFactory<antlr4::CommonToken>* SV3_1aFastLexer::getTokenFactory() {
+  return antlr4::CommonTokenFactory::DEFAULT.get();
+}
+
+size_t SV3_1aFastLexer::matchLiteral(size_t index, size_t* type) const {
+  const uint32_t c = at(index);
+  if (c >= 128) return 0;
+  const std::pair<uint16_t, uint16_t>& range = getLiteralRanges()[c];
+  for (uint16_t i = range.first; i < range.second; ++i) {
+    const Literal& literal = kLiterals[i];
+    if (startsWith(m_text, index, literal.m_text)) {
+      *type = literal.m_type;
+      return literal.m_text.size();
+    }
+  }
+  return 0;
+}
+
+size_t SV3_1aFastLexer::matchIdentifier(size_t index) const {
+  if (!isA(at(index), kIdentifierStart)) return 0;
+  size_t i = index + 1;
+  while (isA(at(i), kIdentifierPart)) ++i;
+  return i - index;
+}
+
+size_t SV3_1aFastLexer::identifierType(size_t index, size_t length) const {
+  const Keyword* const keyword = getKeywordTable().find(m_text.data() + index, length);
+  if ((keyword != nullptr) && (m_sverilog || !keyword->m_sverilogOnly)) return keyword->m_type;
+  return SV3_1aLexer::SIMPLE_IDENTIFIER;
+}
+
+// Unsigned_number: Decimal_digit ('_' | Decimal_digit)*
+size_t SV3_1aFastLexer::matchUnsignedNumber(size_t index) const {
+  if (!isDigit(at(index))) return 0;
+  size_t i = index + 1;
+  while (isDigit(at(i)) || (at(i) == '_')) ++i;
+  return i - index;
+}
+
+// Decimal_base ' '* (Unsigned_number | X_digit '_'* | Z_digit '_'*)
+// | (Binary_base | Octal_base | Hex_base) ' '* '_'* digit ('_' | digit)*
+size_t SV3_1aFastLexer::matchBasedNumber(size_t index) const {
+  if (at(index) != '\'') return 0;
+  size_t i = index + 1;
+  if ((at(i) == 's') || (at(i) == 'S')) ++i;
+  uint32_t base = at(i);
+  if ((base >= 'A') && (base <= 'Z')) base += 'a' - 'A';
+  if ((base != 'd') && (base != 'b') && (base != 'o') && (base != 'h')) return 0;
+  i = skipBlanks(i + 1);
+  if (base == 'd') {
+    if (const size_t length = matchUnsignedNumber(i)) return i + length - index;
+    if (!isXZDigit(at(i))) return 0;
+    ++i;
+    while (at(i) == '_') ++i;
+    return i - index;
+  }
+  while (at(i) == '_') ++i;
+  if (!isBaseDigit(at(i), base)) return 0;
+  ++i;
+  while (isBaseDigit(at(i), base) || (at(i) == '_')) ++i;
+  return i - index;
+}
+
+// INTEGRAL_NUMBER, the optional size is a Non_zero_unsigned_number followed
+// by blanks.
+size_t SV3_1aFastLexer::matchIntegralNumber(size_t index) const {
+  if (at(index) == '\'') return matchBasedNumber(index);
+  const size_t length = matchUnsignedNumber(index);
+  if ((length == 0) || (at(index) == '0')) return length;
+  const size_t base = skipBlanks(index + length);
+  if (const size_t based = matchBasedNumber(base)) return base + based - index;
+  return length;
+}
+
+// REAL_NUMBER: Unsigned_number '.' Unsigned_number
+// | Unsigned_number ('.' Unsigned_number)? [eE] [+-]? Unsigned_number
+size_t SV3_1aFastLexer::matchRealNumber(size_t index) const {
+  const size_t length = matchUnsignedNumber(index);
+  if (length == 0) return 0;
+  size_t i = index + length;
+  size_t result = 0;
+  if ((at(i) == '.') && isDigit(at(i + 1))) {
+    i += 1 + matchUnsignedNumber(i + 1);
+    result = i - index;
+  }
+  if ((at(i) == 'e') || (at(i) == 'E')) {
+    size_t exponent = i + 1;
+    if ((at(exponent) == '+') || (at(exponent) == '-')) ++exponent;
+    if (const size_t digits = matchUnsignedNumber(exponent)) result = exponent + digits - index;
+  }
+  return result;
+}
+
+// POUND_DELAY and POUND_POUND_DELAY: '#'{pounds} ' '* [0-9] [0-9_.]*
+size_t SV3_1aFastLexer::matchDelay(size_t index, size_t pounds) const {
+  size_t i = index;
+  for (size_t p = 0; p < pounds; ++p, ++i) {
+    if (at(i) != '#') return 0;
+  }
+  while (at(i) == ' ') ++i;
+  if (!isDigit(at(i))) return 0;
+  ++i;
+  while (isDigit(at(i)) || (at(i) == '_') || (at(i) == '.')) ++i;
+  return i - index;
+}
+
+// '"' ('\\' ~'\r' | ~[\\"\r\n])* '"'
+size_t SV3_1aFastLexer::matchQuotedString(size_t index) const {
+  size_t i = index + 1;
+  while (true) {
+    const uint32_t c = at(i);
+    if (c == '"') return i + 1 - index;
+    if ((c == kEndOfInput) || (c == '\r') || (c == '\n')) return 0;
+    if (c == '\\') {
+      const uint32_t escaped = at(i + 1);
+      if ((escaped == kEndOfInput) || (escaped == '\r')) return 0;
+      i += 2;
+    } else {
+      ++i;
+    }
+  }
+}
+
+// open .*? close, that is up to the first close past open.
+size_t SV3_1aFastLexer::matchDelimited(size_t index, std::u32string_view open, std::u32string_view close) const {
+  if (!startsWith(m_text, index, open)) return 0;
+  const size_t end = m_text.find(close.data(), index + open.size(), close.size());
+  return (end == std::u32string::npos) ? 0 : (end + close.size() - index);
+}
+
+// '//' .*? '\r'? ('\n' | EOF)
+size_t SV3_1aFastLexer::matchLineComment(size_t index) const {
+  if ((at(index) != '/') || (at(index + 1) != '/')) return 0;
+  const size_t newline = findNewline(index + 2);
+  return (newline == std::u32string::npos) ? (m_text.size() - index) : (newline + 1 - index);
+}
+
+// PREPROC_BEGIN: '{!< ' Decimal_digit+ ' !}'
+// PREPROC_END: '{! ' Decimal_digit+ ' >!}'
+size_t SV3_1aFastLexer::matchPreprocMarker(size_t index, size_t* type) const {
+  std::u32string_view close;
+  size_t i = index;
+  if (startsWith(m_text, index, std::u32string_view(U"{!< "))) {
+    i += 4;
+    close = U" !}";
+    *type = SV3_1aLexer::PREPROC_BEGIN;
+  } else if (startsWith(m_text, index, std::u32string_view(U"{! "))) {
+    i += 3;
+    close = U" >!}";
+    *type = SV3_1aLexer::PREPROC_END;
+  } else {
+    return 0;
+  }
+  const size_t digits = i;
+  while (isDigit(at(i))) ++i;
+  if ((i == digits) || !startsWith(m_text, i, close)) return 0;
+  return i + close.size() - index;
+}
+
+// ATSTAR: '@' ' '? '*'
+// AT_PARENS_STAR: '@' ' '? '(' ' '? '*' ' '? ')'
+size_t SV3_1aFastLexer::matchAtStar(size_t index, size_t* type) const {
+  size_t i = index + 1;
+  if (at(i) == ' ') ++i;
+  if (at(i) == '*') {
+    *type = SV3_1aLexer::ATSTAR;
+    return i + 1 - index;
+  }
+  if (at(i) != '(') return 0;
+  ++i;
+  if (at(i) == ' ') ++i;
+  if (at(i) != '*') return 0;
+  ++i;
+  if (at(i) == ' ') ++i;
+  if (at(i) != ')') return 0;
+  *type = SV3_1aLexer::AT_PARENS_STAR;
+  return i + 1 - index;
+}
+
+// PREPROC_IDENTIFIER: '@~#' Decimal_digit+
+size_t SV3_1aFastLexer::matchPreprocIdentifier(size_t index) const {
+  if (!startsWith(m_text, index, std::u32string_view(U"@~#"))) return 0;
+  size_t i = index + 3;
+  while (isDigit(at(i))) ++i;
+  return (i == (index + 3)) ? 0 : (i - index);
+}
+
+// ASSOCIATIVE_UNSPECIFIED: '[' [ ]* '*' [ ]* ']'
+size_t SV3_1aFastLexer::matchAssociativeUnspecified(size_t index) const {
+  size_t i = index + 1;
+  while (at(i) == ' ') ++i;
+  if (at(i) != '*') return 0;
+  ++i;
+  while (at(i) == ' ') ++i;
+  return (at(i) == ']') ? (i + 1 - index) : 0;
+}
+
+// SURELOG_MACRO_NOT_DEFINED: 'SURELOG_MACRO_NOT_DEFINED:' SIMPLE_IDENTIFIER '!!!'
+size_t SV3_1aFastLexer::matchMacroNotDefined(size_t index) const {
+  static constexpr std::u32string_view kPrefix = U"SURELOG_MACRO_NOT_DEFINED:";
+  if (!startsWith(m_text, index, kPrefix)) return 0;
+  const size_t name = index + kPrefix.size();
+  const size_t length = matchIdentifier(name);
+  if ((length == 0) || !startsWith(m_text, name + length, std::u32string_view(U"!!!"))) return 0;
+  return name + length + 3 - index;
+}
+
+// Index of the first character past a run of ' '.
+size_t SV3_1aFastLexer::skipBlanks(size_t index) const {
+  while (at(index) == ' ') ++index;
+  return index;
+}
+
+// Index of the first character past a run of [ \t\n\r].
+size_t SV3_1aFastLexer::skipWhiteSpace(size_t index) const {
+  const char32_t* const data = m_text.data();
+  const size_t size = m_text.size();
+#if defined(SURELOG_FASTLEXER_SSE2)
+  // Indentation makes for long runs, test 4 code points at once
+  const __m128i space = _mm_set1_epi32(' ');
+  const __m128i tab = _mm_set1_epi32('\t');
+  const __m128i newline = _mm_set1_epi32('\n');
+  const __m128i carriageReturn = _mm_set1_epi32('\r');
+  for (; (index + 4) <= size; index += 4) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+    const __m128i spaceOrTab = _mm_or_si128(_mm_cmpeq_epi32(chunk, space), _mm_cmpeq_epi32(chunk, tab));
+    const __m128i lineBreak = _mm_or_si128(_mm_cmpeq_epi32(chunk, newline), _mm_cmpeq_epi32(chunk, carriageReturn));
+    const __m128i blank = _mm_or_si128(spaceOrTab, lineBreak);
+    const int mask = _mm_movemask_epi8(blank);
+    if (mask != 0xFFFF) return index + firstSetLane(~mask & 0xFFFF);
+  }
+#endif
+  while ((index < size) && isA(data[index], kWhiteSpace)) ++index;
+  return index;
+}
+
+// Index of the first '\n' at or after index, npos if none.
+size_t SV3_1aFastLexer::findNewline(size_t index) const {
+  const char32_t* const data = m_text.data();
+  const size_t size = m_text.size();
+#if defined(SURELOG_FASTLEXER_SSE2)
+  const __m128i newline = _mm_set1_epi32('\n');
+  for (; (index + 4) <= size; index += 4) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(chunk, newline));
+    if (mask != 0) return index + firstSetLane(mask);
+  }
+#endif
+  for (; index < size; ++index) {
+    if (data[index] == '\n') return index;
+  }
+  return std::u32string::npos;
+}
+
+std::pair<size_t, size_t> SV3_1aFastLexer::recognize() const {
+  const size_t index = m_index;
+  const uint32_t c = at(index);
+
+  // Longest match wins, the first rule of the grammar on a tie. ANY, the
+  // last rule, always matches one character.
+  size_t bestType = SV3_1aLexer::ANY;
+  size_t bestLength = 1;
+  auto consider = [&bestType, &bestLength](size_t type, size_t length) {
+    if ((length > bestLength) || ((length == bestLength) && (type < bestType))) {
+      bestType = type;
+      bestLength = length;
+    }
+  };
+
+  if (isA(c, kWhiteSpace)) {
+    return {SV3_1aLexer::WHITE_SPACE, skipWhiteSpace(index) - index};
+  }
+
+  size_t type = 0;
+  if (const size_t length = matchLiteral(index, &type)) consider(type, length);
+
+  if (isA(c, kIdentifierStart)) {
+    const size_t length = matchIdentifier(index);
+    consider(identifierType(index, length), length);
+    if (c == 'S') consider(SV3_1aLexer::SURELOG_MACRO_NOT_DEFINED, matchMacroNotDefined(index));
+    return {bestType, bestLength};
+  }
+
+  switch (c) {
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      consider(SV3_1aLexer::INTEGRAL_NUMBER, matchIntegralNumber(index));
+      consider(SV3_1aLexer::REAL_NUMBER, matchRealNumber(index));
+      break;
+    case '\'': consider(SV3_1aLexer::INTEGRAL_NUMBER, matchBasedNumber(index)); break;
+    case '"': consider(SV3_1aLexer::QUOTED_STRING, matchQuotedString(index)); break;
+    case '/':
+      consider(SV3_1aLexer::LINE_COMMENT, matchLineComment(index));
+      consider(SV3_1aLexer::BLOCK_COMMENT, matchDelimited(index, U"/*", U"*/"));
+      break;
+    case '#':
+      consider(SV3_1aLexer::POUND_POUND_DELAY, matchDelay(index, 2));
+      consider(SV3_1aLexer::POUND_DELAY, matchDelay(index, 1));
+      consider(SV3_1aLexer::ESCAPED_IDENTIFIER, matchDelimited(index, U"#~@", U"#~@"));
+      break;
+    case '@':
+      if (const size_t length = matchAtStar(index, &type)) consider(type, length);
+      consider(SV3_1aLexer::PREPROC_IDENTIFIER, matchPreprocIdentifier(index));
+      break;
+    case '[': consider(SV3_1aLexer::ASSOCIATIVE_UNSPECIFIED, matchAssociativeUnspecified(index)); break;
+    case '{':
+      if (const size_t length = matchPreprocMarker(index, &type)) consider(type, length);
+      break;
+    default: break;
+  }
+  return {bestType, bestLength};
+}
+
+std::unique_ptr<antlr4::Token> SV3_1aFastLexer::nextToken() {
+  if (m_index >= m_text.size()) {
+    // Same as antlr4::Lexer::emitEOF
+    return antlr4::CommonTokenFactory::DEFAULT->create(m_sourcePair, antlr4::Token::EOF, "",
+                                                       antlr4::Token::DEFAULT_CHANNEL, m_index, m_index - 1, m_line,
+                                                       m_column);
+  }
+
+  const auto [type, length] = recognize();
+  size_t channel = antlr4::Token::DEFAULT_CHANNEL;
+  bool multiLine = false;
+  switch (type) {
+    case SV3_1aLexer::WHITE_SPACE:
+      channel = SV3_1aLexer::WHITESPACES;
+      multiLine = true;
+      break;
+    case SV3_1aLexer::LINE_COMMENT:
+    case SV3_1aLexer::BLOCK_COMMENT:
+      channel = SV3_1aLexer::COMMENTS;
+      multiLine = true;
+      break;
+    case SV3_1aLexer::PREPROC_BEGIN:
+    case SV3_1aLexer::PREPROC_END: channel = SV3_1aLexer::PREPROC; break;
+    case SV3_1aLexer::QUOTED_STRING:
+    case SV3_1aLexer::ESCAPED_IDENTIFIER: multiLine = true; break;
+    default: break;
+  }
+
+  const size_t start = m_index;
+  std::unique_ptr<antlr4::Token> token = antlr4::CommonTokenFactory::DEFAULT->create(
+      m_sourcePair, type, "", channel, start, start + length - 1, m_line, m_column);
+
+  m_index += length;
+  if (multiLine) {
+    for (size_t i = start; i < m_index; ++i) {
+      if (m_text[i] == '\n') {
+        ++m_line;
+        m_column = 0;
+      } else {
+        ++m_column;
+      }
+    }
+  } else {
+    m_column += length;
+  }
+  return token;
+}
+
+}  // namespace SURELOG
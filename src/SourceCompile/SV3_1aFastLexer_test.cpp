@@ -0,0 +1,130 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/SourceCompile/SV3_1aFastLexer.h"
+
+#include <antlr4-runtime.h>
+#include <gtest/gtest.h>
+#include <parser/SV3_1aLexer.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SURELOG {
+
+namespace {
+std::string describe(antlr4::Token* token) {
+  std::ostringstream out;
+  out << "type " << token->getType() << " channel " << token->getChannel() << " [" << token->getStartIndex() << ", "
+      << token->getStopIndex() << "] at " << token->getLine() << ":" << token->getCharPositionInLine() << " '"
+      << token->getText() << "'";
+  return out.str();
+}
+
+// Lexes text with both SV3_1aLexer and SV3_1aFastLexer and compares the
+// resulting token streams.
+testing::AssertionResult sameTokens(std::string_view text, bool sverilog) {
+  antlr4::ANTLRInputStream expectedInput(text);
+  SV3_1aLexer expectedLexer(&expectedInput);
+  expectedLexer.sverilog = sverilog;
+  expectedLexer.removeErrorListeners();
+  antlr4::CommonTokenStream expectedTokens(&expectedLexer);
+  expectedTokens.fill();
+
+  antlr4::ANTLRInputStream actualInput(text);
+  SV3_1aFastLexer actualLexer(&actualInput);
+  actualLexer.setSVerilog(sverilog);
+  antlr4::CommonTokenStream actualTokens(&actualLexer);
+  actualTokens.fill();
+
+  const std::vector<antlr4::Token*> expected = expectedTokens.getTokens();
+  const std::vector<antlr4::Token*> actual = actualTokens.getTokens();
+  for (size_t i = 0; (i < expected.size()) && (i < actual.size()); ++i) {
+    const std::string expectedToken = describe(expected[i]);
+    const std::string actualToken = describe(actual[i]);
+    if (expectedToken != actualToken) {
+      return testing::AssertionFailure() << "token #" << i << " expected " << expectedToken << ", got " << actualToken;
+    }
+  }
+  if (expected.size() != actual.size()) {
+    return testing::AssertionFailure() << expected.size() << " tokens expected, got " << actual.size();
+  }
+  return testing::AssertionSuccess();
+}
+
+TEST(FastLexerTest, Keywords) {
+  constexpr std::string_view kText =
+      "module top #(parameter type T = logic) (input bit clk, output var byte o);\n"
+      "  always_ff @(posedge clk) begin o <= this.new(); end\n"
+      "  option.per_instance = 1; type_option.weight = 2; typex option\n"
+      "  PATHPULSE$a = 1; $unit::a; $root.top; $display(\"%d\", a);\n"
+      "  -incdir `timescale 1ns/1ps `uselib `foo 1step 1steps\n"
+      "  SURELOG_MACRO_NOT_DEFINED:FOO!!! SURELOG_MACRO_NOT_DEFINED:FOO!!\n"
+      "endmodule\n";
+  EXPECT_TRUE(sameTokens(kText, true));
+  EXPECT_TRUE(sameTokens(kText, false));
+}
+
+TEST(FastLexerTest, Numbers) {
+  constexpr std::string_view kText =
+      "'b0 'b01 'B1 '0 '1 1'b0 1'b01 1'bx 1'bX 1'Bx 1'BX 1'b 1 'b0 12 'hFF 8'sh_f 4'd 5 4'dx_ 'd? 0'd3\n"
+      "'o17 'o8 'h_ 'sb1 's 1.5 1. 1.5e 1e+ 1.5e-3 3e10 1_000.0_1E+1_0 .5 #1 #1.5ns ## 2 #-# #=# #~@x#~@ #~@x\n";
+  EXPECT_TRUE(sameTokens(kText, true));
+}
+
+TEST(FastLexerTest, OperatorsAndMarkers) {
+  constexpr std::string_view kText =
+      "a<<<=b >>>= c <-> d |-> e |=> f ->> g !== h ==? i !?= j =?= k &&& l ~^ m ^~ n *::* o\n"
+      "[*] [ * ] [* [-> [= @* @ * @(*) @( * ) @ (*) @@ @~#12 @~# (* *) (small) (smal) (large)\n"
+      "{!< 12 !} {! 12 >!} {!< 12 >!} {! !}\r\n\t\"a\\\"b\" \"a\\\nb\" \"unterminated\n"
+      "// line\r\n/* block\n comment **/ /*/ x */ /* unterminated\n\xc3\xa9\x01";
+  EXPECT_TRUE(sameTokens(kText, true));
+  EXPECT_TRUE(sameTokens("// comment at end of file", true));
+  EXPECT_TRUE(sameTokens("", true));
+}
+
+// Compares both lexers over every Verilog source of the regression corpora.
+TEST(FastLexerTest, Corpus) {
+#ifdef SURELOG_SOURCE_DIR
+  const std::filesystem::path sourceDir(SURELOG_SOURCE_DIR);
+  size_t fileCount = 0;
+  for (const char* corpus : {"tests", "third_party/tests"}) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(sourceDir / corpus, ec)) continue;
+    for (const std::filesystem::directory_entry& entry :
+         std::filesystem::recursive_directory_iterator(sourceDir / corpus, ec)) {
+      const std::string extension = entry.path().extension().string();
+      if ((extension != ".v") && (extension != ".sv") && (extension != ".svh") && (extension != ".vh")) continue;
+      if (!entry.is_regular_file(ec)) continue;
+      std::ifstream stream(entry.path(), std::ios::binary);
+      std::ostringstream text;
+      text << stream.rdbuf();
+      EXPECT_TRUE(sameTokens(text.str(), extension != ".v")) << entry.path();
+      ++fileCount;
+    }
+  }
+  if (fileCount == 0) GTEST_SKIP() << "No corpus found under " << sourceDir;
+#else
+  GTEST_SKIP() << "SURELOG_SOURCE_DIR is not defined";
+#endif
+}
+}  // namespace
+}  // namespace SURELOG
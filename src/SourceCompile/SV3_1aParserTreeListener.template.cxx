@@ -23,6 +23,7 @@
 
 #include <Surelog/Design/Design.h>
 #include <Surelog/Design/FileContent.h>
+#include <Surelog/Design/VObjectStore.h>
 #include <Surelog/SourceCompile/CompileSourceFile.h>
 #include <Surelog/SourceCompile/Compiler.h>
 #include <Surelog/SourceCompile/ParseFile.h>
@@ -57,40 +58,36 @@ NodeId SV3_1aParserTreeListener::addVObject(antlr4::tree::TerminalNode *node, VO
 
 NodeId SV3_1aParserTreeListener::mergeSubTree(NodeId ppNodeId) {
   const vobjects_t &ppObjects = m_ppFileContent->getVObjects();
-  const VObject &ppObject = ppObjects[ppNodeId];
 
   vobjects_t &objects = *m_fileContent->mutableVObjects();
 
   NodeId firstChildId;
   NodeId lastChildId;
-  NodeId ppChildId = ppObject.m_child;
+  NodeId ppChildId = ppObjects.child(ppNodeId);
   while (ppChildId) {
     NodeId childId = mergeSubTree(ppChildId);
     if (firstChildId) {
-      objects[lastChildId].m_sibling = childId;
+      objects.sibling(lastChildId) = childId;
     } else {
       firstChildId = childId;
     }
     lastChildId = childId;
-    ppChildId = ppObjects[ppChildId].m_sibling;
+    ppChildId = ppObjects.sibling(ppChildId);
   }
 
-  NodeId nodeId = m_fileContent->addObject(ppObject.m_name, ppObject.m_fileId, ppObject.m_type, ppObject.m_startLine,
-                                           ppObject.m_startColumn, ppObject.m_endLine, ppObject.m_endColumn);
-  VObject &inserted = objects[nodeId];
-  inserted.m_ppStartLine = ppObject.m_startLine;
-  inserted.m_ppStartColumn = ppObject.m_startColumn;
-  inserted.m_ppEndLine = ppObject.m_endLine;
-  inserted.m_ppEndColumn = ppObject.m_endColumn;
+  const vobjects_t::Location &ppLocation = ppObjects.location(ppNodeId);
+  NodeId nodeId = m_fileContent->addObject(ppObjects.name(ppNodeId), ppObjects.fileId(ppNodeId),
+                                           ppObjects.type(ppNodeId), ppLocation.m_startLine, ppLocation.m_startColumn,
+                                           ppLocation.m_endLine, ppLocation.m_endColumn);
+  objects.ppLocation(nodeId) = ppLocation;
 
   if (firstChildId) {
-    VObject &object = objects[nodeId];
-    object.m_child = firstChildId;
+    objects.child(nodeId) = firstChildId;
 
     NodeId childId = firstChildId;
     while (childId) {
-      objects[childId].m_parent = nodeId;
-      childId = objects[childId].m_sibling;
+      objects.parent(childId) = nodeId;
+      childId = objects.sibling(childId);
     }
   }
 
@@ -99,8 +96,8 @@ NodeId SV3_1aParserTreeListener::mergeSubTree(NodeId ppNodeId) {
 
 void SV3_1aParserTreeListener::mergeSubTrees(antlr4::tree::ParseTree *tree, NodeId ppNodeId) {
   const vobjects_t &ppObjects = m_ppFileContent->getVObjects();
-  for (NodeId ppChildNodeId = ppObjects[ppNodeId].m_child; ppChildNodeId;
-       ppChildNodeId = ppObjects[ppChildNodeId].m_sibling) {
+  for (NodeId ppChildNodeId = ppObjects.child(ppNodeId); ppChildNodeId;
+       ppChildNodeId = ppObjects.sibling(ppChildNodeId)) {
     addNodeIdForContext(tree, mergeSubTree(ppChildNodeId));
   }
 }
@@ -143,14 +140,16 @@ void SV3_1aParserTreeListener::enterString_value(SV3_1aParser::String_valueConte
 }
 
 void SV3_1aParserTreeListener::overrideLocation(NodeId nodeId, antlr4::Token *token) {
-  VObject *const object = m_fileContent->MutableObject(nodeId);
-  std::tie(object->m_fileId, object->m_startLine, object->m_startColumn, object->m_endLine, object->m_endColumn) =
+  VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+  PathId fileId;
+  std::tie(fileId, object.m_startLine, object.m_startColumn, object.m_endLine, object.m_endColumn) =
       getFileLine(nullptr, token);
-  std::tie(object->m_ppStartLine, object->m_ppStartColumn) = ParseUtils::getLineColumn(token);
-  std::tie(object->m_ppEndLine, object->m_ppEndColumn) = ParseUtils::getEndLineColumn(token);
+  m_fileContent->setFileId(nodeId, fileId);
+  std::tie(object.m_ppStartLine, object.m_ppStartColumn) = ParseUtils::getLineColumn(token);
+  std::tie(object.m_ppEndLine, object.m_ppEndColumn) = ParseUtils::getEndLineColumn(token);
 }
 
-void SV3_1aParserTreeListener::applyLocationOffsets(VObject &object) {
+void SV3_1aParserTreeListener::applyLocationOffsets(vobjects_t::Location &object) {
   uint16_t sc = object.m_startColumn;
   uint16_t scpivot = 0;
   std::pair<offsets_t::const_iterator, offsets_t::const_iterator> slItBounds =
@@ -188,12 +187,15 @@ void SV3_1aParserTreeListener::applyLocationOffsets() {
   // std::cout << std::endl;
 
   vobjects_t &vobjects = *m_fileContent->mutableVObjects();
-  for (vobjects_t::reference object : vobjects) {
-    if (static_cast<int32_t>(object.m_type) < static_cast<int32_t>(VObjectType::paIndexBegin)) {
+  for (size_t i = 0, ni = vobjects.size(); i < ni; ++i) {
+    const NodeId nodeId(i);
+    const VObjectType type = vobjects.type(nodeId);
+    if (static_cast<int32_t>(type) < static_cast<int32_t>(VObjectType::paIndexBegin)) {
       continue;  // Don't apply offsets to ppXXXX types
     }
 
-    if (object.m_type == VObjectType::paTop_level_rule) {
+    vobjects_t::Location &object = vobjects.location(nodeId);
+    if (type == VObjectType::paTop_level_rule) {
       // HACK(HS): For some unknown reason, the top level rule doesn't start
       // at the top of the file and instead starts at where the module (or
       // whatever is in channel 0). Force it to start at 1, 1 so the
@@ -283,13 +285,13 @@ void SV3_1aParserTreeListener::processPendingTokens(antlr4::tree::ParseTree *tre
           const NodeId nodeId = addVObject(tree, trimmed, VObjectType::LINE_COMMENT, true);
           overrideLocation(nodeId, lastToken);
 
-          VObject *const object = m_fileContent->MutableObject(nodeId);
+          VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
           if (hasCR) {
-            --object->m_endLine;
-            object->m_endColumn = object->m_startColumn + trimmed.length();
+            --object.m_endLine;
+            object.m_endColumn = object.m_startColumn + trimmed.length();
 
-            --object->m_ppEndLine;
-            object->m_ppEndColumn = object->m_ppStartColumn + trimmed.length();
+            --object.m_ppEndLine;
+            object.m_ppEndColumn = object.m_ppStartColumn + trimmed.length();
           }
         }
 
@@ -297,10 +299,10 @@ void SV3_1aParserTreeListener::processPendingTokens(antlr4::tree::ParseTree *tre
           const NodeId nodeId = addVObject(tree, "\n", VObjectType::CR, true);
           overrideLocation(nodeId, lastToken);
 
-          VObject *const object = m_fileContent->MutableObject(nodeId);
-          object->m_startColumn += trimmed.length();
-          object->m_ppStartColumn += trimmed.length();
-          applyLocationOffsets(*object);
+          VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+          object.m_startColumn += trimmed.length();
+          object.m_ppStartColumn += trimmed.length();
+          applyLocationOffsets(m_fileContent->mutableVObjects()->location(nodeId));
         }
 
         m_visitedTokens.emplace(lastToken);
@@ -327,31 +329,31 @@ void SV3_1aParserTreeListener::processPendingTokens(antlr4::tree::ParseTree *tre
           }
           if (!part.empty()) {
             const NodeId nodeId = addVObject(tree, part, VObjectType::WHITE_SPACE, true);
-            VObject *const object = m_fileContent->MutableObject(nodeId);
+            VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
 
-            object->m_ppStartLine = object->m_ppEndLine = lc.first;
-            object->m_ppStartColumn = lc.second;
-            object->m_ppEndLine = lc.first;
-            object->m_ppEndColumn = lc.second += part.length();
+            object.m_ppStartLine = object.m_ppEndLine = lc.first;
+            object.m_ppStartColumn = lc.second;
+            object.m_ppEndLine = lc.first;
+            object.m_ppEndColumn = lc.second += part.length();
 
-            object->m_startLine = object->m_endLine = sl;
-            object->m_startColumn = sc;
-            object->m_endColumn = sc += part.length();
+            object.m_startLine = object.m_endLine = sl;
+            object.m_startColumn = sc;
+            object.m_endColumn = sc += part.length();
           }
           if (hasCR) {
             const NodeId nodeId = addVObject(tree, "\n", VObjectType::CR, true);
-            VObject *const object = m_fileContent->MutableObject(nodeId);
-
-            object->m_ppStartLine = lc.first;
-            object->m_ppStartColumn = lc.second;
-            object->m_ppEndLine = ++lc.first;
-            object->m_ppEndColumn = lc.second = 1;
-
-            object->m_startLine = object->m_endLine = sl;
-            object->m_startColumn = sc;
-            object->m_endLine = ++sl;
-            object->m_endColumn = sc = 1;
-            applyLocationOffsets(*object);
+            VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+
+            object.m_ppStartLine = lc.first;
+            object.m_ppStartColumn = lc.second;
+            object.m_ppEndLine = ++lc.first;
+            object.m_ppEndColumn = lc.second = 1;
+
+            object.m_startLine = object.m_endLine = sl;
+            object.m_startColumn = sc;
+            object.m_endLine = ++sl;
+            object.m_endColumn = sc = 1;
+            applyLocationOffsets(m_fileContent->mutableVObjects()->location(nodeId));
           }
         }
         m_visitedTokens.emplace(lastToken);
@@ -435,21 +437,21 @@ void SV3_1aParserTreeListener::visitTerminal(antlr4::tree::TerminalNode *node) {
   // clang-format on
 
   if (nodeId) {
-    VObject *const object = m_fileContent->MutableObject(nodeId);
+    VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
 
     const std::optional<bool> isUnary = isUnaryOperator(node);
     if (isUnary) {
       // clang-format off
       switch (token->getType()) {
-        case SV3_1aParser::BITW_AND: object->m_type = isUnary.value() ? VObjectType::UnaryOp_BitwAnd : VObjectType::BinaryOp_BitwAnd; break;
-        case SV3_1aParser::BITW_OR: object->m_type = isUnary.value() ? VObjectType::UnaryOp_BitwOr : VObjectType::BinaryOp_BitwOr; break;
-        case SV3_1aParser::BITW_XOR: object->m_type = isUnary.value() ? VObjectType::UnaryOp_BitwXor : VObjectType::BinaryOp_BitwXor; break;
-        case SV3_1aParser::MINUS: object->m_type = isUnary.value() ? VObjectType::UnaryOp_Minus : VObjectType::BinaryOp_Minus; break;
-        case SV3_1aParser::PLUS: object->m_type = isUnary.value() ? VObjectType::UnaryOp_Plus : VObjectType::BinaryOp_Plus; break;
-        case SV3_1aParser::REDUCTION_NAND: object->m_type = isUnary.value() ? VObjectType::UnaryOp_ReductNand : VObjectType::BinaryOp_ReductNand; break;
-        case SV3_1aParser::REDUCTION_XNOR1: object->m_type = isUnary.value() ? VObjectType::UnaryOp_ReductXnor1 : VObjectType::BinaryOp_ReductXnor1; break;
-        case SV3_1aParser::REDUCTION_XNOR2: object->m_type = isUnary.value() ? VObjectType::UnaryOp_ReductXnor2 : VObjectType::BinaryOp_ReductXnor2; break;
-        case SV3_1aParser::STAR: object->m_type = VObjectType::BinaryOp_Mult; break;
+        case SV3_1aParser::BITW_AND: object.m_type = isUnary.value() ? VObjectType::UnaryOp_BitwAnd : VObjectType::BinaryOp_BitwAnd; break;
+        case SV3_1aParser::BITW_OR: object.m_type = isUnary.value() ? VObjectType::UnaryOp_BitwOr : VObjectType::BinaryOp_BitwOr; break;
+        case SV3_1aParser::BITW_XOR: object.m_type = isUnary.value() ? VObjectType::UnaryOp_BitwXor : VObjectType::BinaryOp_BitwXor; break;
+        case SV3_1aParser::MINUS: object.m_type = isUnary.value() ? VObjectType::UnaryOp_Minus : VObjectType::BinaryOp_Minus; break;
+        case SV3_1aParser::PLUS: object.m_type = isUnary.value() ? VObjectType::UnaryOp_Plus : VObjectType::BinaryOp_Plus; break;
+        case SV3_1aParser::REDUCTION_NAND: object.m_type = isUnary.value() ? VObjectType::UnaryOp_ReductNand : VObjectType::BinaryOp_ReductNand; break;
+        case SV3_1aParser::REDUCTION_XNOR1: object.m_type = isUnary.value() ? VObjectType::UnaryOp_ReductXnor1 : VObjectType::BinaryOp_ReductXnor1; break;
+        case SV3_1aParser::REDUCTION_XNOR2: object.m_type = isUnary.value() ? VObjectType::UnaryOp_ReductXnor2 : VObjectType::BinaryOp_ReductXnor2; break;
+        case SV3_1aParser::STAR: object.m_type = VObjectType::BinaryOp_Mult; break;
         default: break;
       }
       // clang-format on
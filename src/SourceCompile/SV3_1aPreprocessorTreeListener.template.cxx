@@ -25,6 +25,7 @@
 #include <Surelog/Common/FileSystem.h>
 #include <Surelog/Common/Session.h>
 #include <Surelog/Design/FileContent.h>
+#include <Surelog/Design/VObjectStore.h>
 #include <Surelog/SourceCompile/CompileSourceFile.h>
 #include <Surelog/SourceCompile/MacroInfo.h>
 #include <Surelog/SourceCompile/PreprocessFile.h>
@@ -407,14 +408,14 @@ NodeId SV3_1aPreprocessorTreeListener::addVObject(antlr4::tree::TerminalNode *no
     if (!trimmed.empty()) {
       nodeId = addVObject(node, trimmed, objectType);
       // Adjust the end location of the object
-      VObject *const object = m_fileContent->MutableObject(nodeId);
-      --object->m_endLine;
-      object->m_endColumn = object->m_ppEndColumn = lc.second + trimmed.length();
+      VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+      --object.m_endLine;
+      object.m_endColumn = object.m_ppEndColumn = lc.second + trimmed.length();
     }
     if (hasCR) {
       nodeId = addVObject(node, "\n", VObjectType::CR);
-      VObject *const object = m_fileContent->MutableObject(nodeId);
-      object->m_startColumn = object->m_ppStartColumn = lc.second + trimmed.length();
+      VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+      object.m_startColumn = object.m_ppStartColumn = lc.second + trimmed.length();
     }
   } else {
     nodeId = addVObject(node, node->getText(), objectType);
@@ -427,12 +428,12 @@ void SV3_1aPreprocessorTreeListener::adjustMacroDefinitionLocation(antlr4::tree:
   std::string text = tree->getText();
 
   if (!text.empty() && (text.back() == '\n')) {
-    VObject *const object = m_fileContent->MutableObject(nodeId);
-    object->m_endLine = object->m_ppEndLine = elc.first - 1;
+    VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+    object.m_endLine = object.m_ppEndLine = elc.first - 1;
     text.pop_back();
     const size_t pos = text.rfind('\n');
-    object->m_endColumn = object->m_ppEndColumn =
-        (pos == std::string::npos) ? (object->m_startColumn + text.length()) : text.length() - pos;
+    object.m_endColumn = object.m_ppEndColumn =
+        (pos == std::string::npos) ? (object.m_startColumn + text.length()) : text.length() - pos;
   }
 }
 
@@ -449,22 +450,21 @@ void SV3_1aPreprocessorTreeListener::appendPreprocEnd() {
   const NodeId parentId = m_fileContent->addObject(BadSymbolId, BadPathId, VObjectType::PREPROC_END, 0, 0, 0, 0);
   m_pp->append(StrCat(kPreprocEndPrefix, parentId, kPreprocEndSuffix));
 
-  std::vector<VObject> &objects = *m_fileContent->mutableVObjects();
+  VObjectStore &objects = *m_fileContent->mutableVObjects();
 
   std::set<NodeId> childrenIds;
   for (const auto &[ctx, nodeId] : m_contextToObjectMap) {
-    if (!objects[nodeId].m_parent) childrenIds.insert(nodeId);
+    if (!objects.parent(nodeId)) childrenIds.insert(nodeId);
   }
 
   NodeId prevChildId = parentId;
   for (const NodeId &childId : childrenIds) {
-    VObject &child = objects[childId];
-    if (!child.m_parent) {
-      child.m_parent = parentId;
+    if (!objects.parent(childId)) {
+      objects.parent(childId) = parentId;
       if (prevChildId == parentId) {
-        objects[parentId].m_child = childId;
+        objects.child(parentId) = childId;
       } else {
-        objects[prevChildId].m_sibling = childId;
+        objects.sibling(prevChildId) = childId;
       }
       prevChildId = childId;
     }
@@ -1491,10 +1491,10 @@ void SV3_1aPreprocessorTreeListener::exitComment(SV3_1aPpParser::CommentContext
 
       if (!suffix.empty()) {
         // Adjust the end location of the object, if needed
-        VObject *const object = m_fileContent->MutableObject(nodeId);
-        object->m_endLine -= suffix.length();
+        VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+        object.m_endLine -= suffix.length();
         const std::string::size_type p = text.rfind('\n');
-        object->m_endColumn = (p == std::string::npos) ? object->m_startColumn + text.length() : text.length() - p;
+        object.m_endColumn = (p == std::string::npos) ? object.m_startColumn + text.length() : text.length() - p;
       }
     }
   }
@@ -1592,10 +1592,10 @@ void SV3_1aPreprocessorTreeListener::visitTerminal(antlr4::tree::TerminalNode *n
 
       operators_t::const_iterator it = kOperators.find(best);
       NodeId nodeId = addVObject(node, best, it->second);
-      VObject *const object = m_fileContent->MutableObject(nodeId);
-      std::tie(object->m_endLine, object->m_endColumn) = ParseUtils::getEndLineColumn(m_tokens->get(bestI));
-      object->m_ppEndLine = object->m_endLine;
-      object->m_ppEndColumn = object->m_endColumn;
+      VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+      std::tie(object.m_endLine, object.m_endColumn) = ParseUtils::getEndLineColumn(m_tokens->get(bestI));
+      object.m_ppEndLine = object.m_endLine;
+      object.m_ppEndColumn = object.m_endColumn;
       shouldAddVObject = false;
     }
   }
@@ -1610,16 +1610,15 @@ void SV3_1aPreprocessorTreeListener::visitTerminal(antlr4::tree::TerminalNode *n
 
     if (m_inMacroDefinitionParsing) {
       if (NodeId nodeId = NodeIdFromContext(node)) {
-        if (VObject *const object = m_fileContent->MutableObject(nodeId)) {
-          SymbolTable *const symbols = m_session->getSymbolTable();
-          std::string_view text = symbols->getSymbol(object->m_name);
+        VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+        SymbolTable *const symbols = m_session->getSymbolTable();
+        std::string_view text = symbols->getSymbol(object.m_name);
 
-          operators_t::const_iterator it1 = kOperators.find(text);
-          if (it1 != kOperators.cend()) object->m_type = it1->second;
+        operators_t::const_iterator it1 = kOperators.find(text);
+        if (it1 != kOperators.cend()) object.m_type = it1->second;
 
-          reserved_words_t::const_iterator it2 = kReservedWords.find(text);
-          if (it2 != kReservedWords.cend()) object->m_type = it2->second;
-        }
+        reserved_words_t::const_iterator it2 = kReservedWords.find(text);
+        if (it2 != kReservedWords.cend()) object.m_type = it2->second;
       }
     }
   }
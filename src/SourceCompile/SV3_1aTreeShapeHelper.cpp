@@ -26,6 +26,7 @@
 #include <antlr4-runtime.h>
 
 #include <cstdint>
+#include <regex>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -105,8 +106,8 @@ void SV3_1aTreeShapeHelper::addNestedDesignElement(antlr4::ParserRuleContext* ct
   DesignElement* elem = new DesignElement(registerSymbol(name), fileId, elemtype, generateDesignElemId(), line, column,
                                           endLine, endColumn, InvalidNodeId);
   elem->m_context = ctx;
-  elem->m_timeInfo = m_pf->getCompilationUnit()->getTimeInfo(fileId, line);
-  elem->m_defaultNetType = m_pf->getCompilationUnit()->getDefaultNetType(fileId, line);
+  elem->m_timeInfo = m_pf->getTimeInfo(fileId, line);
+  elem->m_defaultNetType = m_pf->getDefaultNetType(fileId, line);
   if (!m_nestedElements.empty()) {
     elem->m_timeInfo = m_nestedElements.top()->m_timeInfo;
     elem->m_parent = m_nestedElements.top()->m_uniqueId;
@@ -123,8 +124,8 @@ void SV3_1aTreeShapeHelper::addDesignElement(antlr4::ParserRuleContext* ctx, std
   DesignElement* elem = new DesignElement(registerSymbol(name), fileId, elemtype, generateDesignElemId(), line, column,
                                           endLine, endColumn, InvalidNodeId);
   elem->m_context = ctx;
-  elem->m_timeInfo = m_pf->getCompilationUnit()->getTimeInfo(m_pf->getFileId(line), line);
-  elem->m_defaultNetType = m_pf->getCompilationUnit()->getDefaultNetType(fileId, line);
+  elem->m_timeInfo = m_pf->getTimeInfo(m_pf->getFileId(line), line);
+  elem->m_defaultNetType = m_pf->getDefaultNetType(fileId, line);
   m_fileContent->addDesignElement(design_element, elem);
   m_currentElement = m_fileContent->getDesignElements().back();
 }
@@ -176,4 +177,79 @@ std::pair<double, TimeInfo::Unit> SV3_1aTreeShapeHelper::getTimeValue(SV3_1aPars
 
   return std::make_pair(actual_value, unit);
 }
+
+TimeInfo SV3_1aTreeShapeHelper::getTimescaleInfo(ParseFile* pf, SV3_1aParser::Timescale_directiveContext* ctx,
+                                                 SV3_1aTreeShapeHelper* reporter) {
+  TimeInfo compUnitTimeInfo;
+  compUnitTimeInfo.m_type = TimeInfo::Type::Timescale;
+  compUnitTimeInfo.m_fileId = pf->getFileId(0);
+  LineColumn lineCol = ParseUtils::getLineColumn(ctx->TICK_TIMESCALE());
+  compUnitTimeInfo.m_line = lineCol.first;
+  std::regex base_regex("`timescale([0-9]+)([mnsupf]+)/([0-9]+)([mnsupf]+)");
+  std::smatch base_match;
+  const std::string value = ctx->getText();
+  if (std::regex_match(value, base_match, base_regex)) {
+    std::ssub_match base1_sub_match = base_match[1];
+    std::string base1 = base1_sub_match.str();
+    compUnitTimeInfo.m_timeUnitValue = std::stoi(base1);
+    if ((compUnitTimeInfo.m_timeUnitValue != 1) && (compUnitTimeInfo.m_timeUnitValue != 10) &&
+        (compUnitTimeInfo.m_timeUnitValue != 100) && reporter) {
+      reporter->logError(ErrorDefinition::PA_TIMESCALE_INVALID_VALUE, ctx, base1);
+    }
+    compUnitTimeInfo.m_timeUnit = TimeInfo::unitFromString(base_match[2].str());
+    std::ssub_match base2_sub_match = base_match[3];
+    std::string base2 = base2_sub_match.str();
+    compUnitTimeInfo.m_timePrecisionValue = std::stoi(base2);
+    if ((compUnitTimeInfo.m_timePrecisionValue != 1) && (compUnitTimeInfo.m_timePrecisionValue != 10) &&
+        (compUnitTimeInfo.m_timePrecisionValue != 100) && reporter) {
+      reporter->logError(ErrorDefinition::PA_TIMESCALE_INVALID_VALUE, ctx, base2);
+    }
+    uint64_t unitInFs = TimeInfo::femtoSeconds(compUnitTimeInfo.m_timeUnit, compUnitTimeInfo.m_timeUnitValue);
+    compUnitTimeInfo.m_timePrecision = TimeInfo::unitFromString(base_match[4].str());
+    uint64_t precisionInFs =
+        TimeInfo::femtoSeconds(compUnitTimeInfo.m_timePrecision, compUnitTimeInfo.m_timePrecisionValue);
+    if ((unitInFs < precisionInFs) && reporter) {
+      reporter->logError(ErrorDefinition::PA_TIMESCALE_INVALID_SCALE, ctx, "");
+    }
+  }
+  return compUnitTimeInfo;
+}
+
+NetTypeInfo SV3_1aTreeShapeHelper::getDefaultNetTypeInfo(ParseFile* pf, antlr4::CommonTokenStream* tokens,
+                                                         SV3_1aParser::Default_nettype_directiveContext* ctx) {
+  NetTypeInfo info;
+  info.m_type = VObjectType::paNetType_Wire;
+  info.m_fileId = pf->getFileId(0);
+  LineColumn lineCol = ParseUtils::getLineColumn(tokens, ctx);
+  info.m_line = lineCol.first;
+  if (ctx->SIMPLE_IDENTIFIER()) {
+    info.m_type = VObjectType::NO_TYPE;
+  } else if (ctx->net_type()) {
+    if (ctx->net_type()->SUPPLY0())
+      info.m_type = VObjectType::SUPPLY0;
+    else if (ctx->net_type()->SUPPLY1())
+      info.m_type = VObjectType::SUPPLY1;
+    else if (ctx->net_type()->WIRE())
+      info.m_type = VObjectType::paNetType_Wire;
+    else if (ctx->net_type()->UWIRE())
+      info.m_type = VObjectType::paNetType_Uwire;
+    else if (ctx->net_type()->WAND())
+      info.m_type = VObjectType::paNetType_Wand;
+    else if (ctx->net_type()->WOR())
+      info.m_type = VObjectType::paNetType_Wor;
+    else if (ctx->net_type()->TRI())
+      info.m_type = VObjectType::paNetType_Tri;
+    else if (ctx->net_type()->TRIREG())
+      info.m_type = VObjectType::paNetType_TriReg;
+    else if (ctx->net_type()->TRIOR())
+      info.m_type = VObjectType::paNetType_TriOr;
+    else if (ctx->net_type()->TRIAND())
+      info.m_type = VObjectType::paNetType_TriAnd;
+    else if (ctx->net_type()->TRI0())
+      info.m_type = VObjectType::paNetType_Tri0;
+    else if (ctx->net_type()->TRI1())
+      info.m_type = VObjectType::paNetType_Tri1;
+  }
+  return info;
+}
 }  // namespace SURELOG
@@ -39,6 +39,7 @@
 #include "Surelog/Common/SymbolId.h"
 #include "Surelog/Design/Design.h"
 #include "Surelog/Design/FileContent.h"
+#include "Surelog/Design/VObjectStore.h"
 #include "Surelog/ErrorReporting/ErrorDefinition.h"
 #include "Surelog/SourceCompile/CompilationUnit.h"
 #include "Surelog/SourceCompile/Compiler.h"
@@ -505,39 +506,8 @@ void SV3_1aTreeShapeListener::enterTimeUnitsDecl_TimeUnit(SV3_1aParser::TimeUnit
 }
 
 void SV3_1aTreeShapeListener::enterTimescale_directive(SV3_1aParser::Timescale_directiveContext *ctx) {
-  TimeInfo compUnitTimeInfo;
-  compUnitTimeInfo.m_type = TimeInfo::Type::Timescale;
-  compUnitTimeInfo.m_fileId = m_pf->getFileId(0);
-  LineColumn lineCol = ParseUtils::getLineColumn(ctx->TICK_TIMESCALE());
-  compUnitTimeInfo.m_line = lineCol.first;
-  std::regex base_regex("`timescale([0-9]+)([mnsupf]+)/([0-9]+)([mnsupf]+)");
-  std::smatch base_match;
-  const std::string value = ctx->getText();
-  if (std::regex_match(value, base_match, base_regex)) {
-    std::ssub_match base1_sub_match = base_match[1];
-    std::string base1 = base1_sub_match.str();
-    compUnitTimeInfo.m_timeUnitValue = std::stoi(base1);
-    if ((compUnitTimeInfo.m_timeUnitValue != 1) && (compUnitTimeInfo.m_timeUnitValue != 10) &&
-        (compUnitTimeInfo.m_timeUnitValue != 100)) {
-      logError(ErrorDefinition::PA_TIMESCALE_INVALID_VALUE, ctx, base1);
-    }
-    compUnitTimeInfo.m_timeUnit = TimeInfo::unitFromString(base_match[2].str());
-    std::ssub_match base2_sub_match = base_match[3];
-    std::string base2 = base2_sub_match.str();
-    compUnitTimeInfo.m_timePrecisionValue = std::stoi(base2);
-    if ((compUnitTimeInfo.m_timePrecisionValue != 1) && (compUnitTimeInfo.m_timePrecisionValue != 10) &&
-        (compUnitTimeInfo.m_timePrecisionValue != 100)) {
-      logError(ErrorDefinition::PA_TIMESCALE_INVALID_VALUE, ctx, base2);
-    }
-    uint64_t unitInFs = TimeInfo::femtoSeconds(compUnitTimeInfo.m_timeUnit, compUnitTimeInfo.m_timeUnitValue);
-    compUnitTimeInfo.m_timePrecision = TimeInfo::unitFromString(base_match[4].str());
-    uint64_t precisionInFs =
-        TimeInfo::femtoSeconds(compUnitTimeInfo.m_timePrecision, compUnitTimeInfo.m_timePrecisionValue);
-    if (unitInFs < precisionInFs) {
-      logError(ErrorDefinition::PA_TIMESCALE_INVALID_SCALE, ctx, "");
-    }
-  }
-  m_pf->getCompilationUnit()->recordTimeInfo(compUnitTimeInfo);
+  TimeInfo compUnitTimeInfo = getTimescaleInfo(m_pf, ctx, this);
+  m_pf->recordTimeInfo(compUnitTimeInfo);
 }
 
 void SV3_1aTreeShapeListener::enterTimeUnitsDecl_TimePrecision(SV3_1aParser::TimeUnitsDecl_TimePrecisionContext *ctx) {
@@ -1531,18 +1501,20 @@ void SV3_1aTreeShapeListener::processPendingTokens(antlr4::tree::ParseTree *tree
         if (!trimmed.empty()) {
           const NodeId nodeId = addVObject(tree, trimmed, VObjectType::LINE_COMMENT, true);
 
-          VObject *const object = m_fileContent->MutableObject(nodeId);
-          std::tie(object->m_fileId, object->m_startLine, object->m_startColumn, object->m_endLine,
-                   object->m_endColumn) = getFileLine(nullptr, lastToken);
-          std::tie(object->m_ppStartLine, object->m_ppStartColumn) = ParseUtils::getLineColumn(lastToken);
-          std::tie(object->m_ppEndLine, object->m_ppEndColumn) = ParseUtils::getEndLineColumn(lastToken);
+          VObjectStore::Reference object = m_fileContent->MutableObject(nodeId);
+          PathId fileId;
+          std::tie(fileId, object.m_startLine, object.m_startColumn, object.m_endLine, object.m_endColumn) =
+              getFileLine(nullptr, lastToken);
+          m_fileContent->setFileId(nodeId, fileId);
+          std::tie(object.m_ppStartLine, object.m_ppStartColumn) = ParseUtils::getLineColumn(lastToken);
+          std::tie(object.m_ppEndLine, object.m_ppEndColumn) = ParseUtils::getEndLineColumn(lastToken);
 
           if (hasCR) {
-            --object->m_endLine;
-            object->m_endColumn = object->m_startColumn + trimmed.length();
+            --object.m_endLine;
+            object.m_endColumn = object.m_startColumn + trimmed.length();
 
-            --object->m_ppEndLine;
-            object->m_ppEndColumn = object->m_ppStartColumn + trimmed.length();
+            --object.m_ppEndLine;
+            object.m_ppEndColumn = object.m_ppStartColumn + trimmed.length();
           }
         }
       } break;
@@ -1808,43 +1780,13 @@ void SV3_1aTreeShapeListener::exitTf_port_direction(SV3_1aParser::Tf_port_direct
 }
 
 void SV3_1aTreeShapeListener::exitDefault_nettype_directive(SV3_1aParser::Default_nettype_directiveContext *ctx) {
-  NetTypeInfo info;
-  info.m_type = VObjectType::paNetType_Wire;
-  info.m_fileId = m_pf->getFileId(0);
-  LineColumn lineCol = ParseUtils::getLineColumn(m_tokens, ctx);
-  info.m_line = lineCol.first;
+  NetTypeInfo info = getDefaultNetTypeInfo(m_pf, m_tokens, ctx);
   if (ctx->SIMPLE_IDENTIFIER()) {
     addVObject((antlr4::ParserRuleContext *)ctx->SIMPLE_IDENTIFIER(), ctx->SIMPLE_IDENTIFIER()->getText(),
                VObjectType::STRING_CONST);
-    info.m_type = VObjectType::NO_TYPE;
-  } else if (ctx->net_type()) {
-    if (ctx->net_type()->SUPPLY0())
-      info.m_type = VObjectType::SUPPLY0;
-    else if (ctx->net_type()->SUPPLY1())
-      info.m_type = VObjectType::SUPPLY1;
-    else if (ctx->net_type()->WIRE())
-      info.m_type = VObjectType::paNetType_Wire;
-    else if (ctx->net_type()->UWIRE())
-      info.m_type = VObjectType::paNetType_Uwire;
-    else if (ctx->net_type()->WAND())
-      info.m_type = VObjectType::paNetType_Wand;
-    else if (ctx->net_type()->WOR())
-      info.m_type = VObjectType::paNetType_Wor;
-    else if (ctx->net_type()->TRI())
-      info.m_type = VObjectType::paNetType_Tri;
-    else if (ctx->net_type()->TRIREG())
-      info.m_type = VObjectType::paNetType_TriReg;
-    else if (ctx->net_type()->TRIOR())
-      info.m_type = VObjectType::paNetType_TriOr;
-    else if (ctx->net_type()->TRIAND())
-      info.m_type = VObjectType::paNetType_TriAnd;
-    else if (ctx->net_type()->TRI0())
-      info.m_type = VObjectType::paNetType_Tri0;
-    else if (ctx->net_type()->TRI1())
-      info.m_type = VObjectType::paNetType_Tri1;
   }
   addVObject(ctx, VObjectType::paDefault_nettype_directive);
-  m_pf->getCompilationUnit()->recordDefaultNetType(info);
+  m_pf->recordDefaultNetType(info);
 }
 
 void SV3_1aTreeShapeListener::exitParameter_value_assignment(SV3_1aParser::Parameter_value_assignmentContext *ctx) {
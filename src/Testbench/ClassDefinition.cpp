@@ -123,10 +123,7 @@ const DataType* ClassDefinition::getDataType(Design* design, std::string_view na
 void ClassDefinition::insertProperty(Property* p) { m_properties.emplace(p->getName(), p); }
 
 Function* ClassDefinition::getFunction(std::string_view name) const {
-  FunctionMap::const_iterator itr = m_functions.find(name);
-  if (itr != m_functions.end()) {
-    return itr->second;
-  }
+  if (Function* const function = getLocalFunction(name)) return function;
 
   for (const auto& parent : getBaseClassMap()) {
     if (parent.second) {
@@ -219,22 +216,18 @@ const DataType* ClassDefinition::getBaseClass(std::string_view name) const {
 void ClassDefinition::insertBaseClass(DataType* p) { m_baseClasses.emplace(p->getName(), p); }
 
 const DataType* ClassDefinition::getBaseDataType(std::string_view name) const {
-  const DataTypeMap& dataTypes = getDataTypeMap();
-  DataTypeMap::const_iterator itr = dataTypes.find(name);
-  if (itr == dataTypes.end()) {
-    for (const auto& parent : getBaseClassMap()) {
-      if (parent.second) {
-        const ClassDefinition* cparent = datatype_cast<const ClassDefinition*>(parent.second);
-        if (cparent) {
-          const DataType* d = cparent->getBaseDataType(name);
-          if (d) return d;
-        }
+  if (const DataType* const dt = getLocalDataType(name)) return dt;
+
+  for (const auto& parent : getBaseClassMap()) {
+    if (parent.second) {
+      const ClassDefinition* cparent = datatype_cast<const ClassDefinition*>(parent.second);
+      if (cparent) {
+        const DataType* d = cparent->getBaseDataType(name);
+        if (d) return d;
       }
     }
-    return nullptr;
-  } else {
-    return itr->second;
   }
+  return nullptr;
 }
 
 bool ClassDefinition::hasCompleteBaseSpecification() const {
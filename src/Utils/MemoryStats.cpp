@@ -0,0 +1,125 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/Utils/MemoryStats.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+// clang-format off
+#include <psapi.h>
+// clang-format on
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace SURELOG {
+
+uint64_t MemoryStats::getResidentSetSize() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return counters.WorkingSetSize;
+  return 0;
+#elif defined(__APPLE__)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) !=
+      KERN_SUCCESS) {
+    return 0;
+  }
+  return info.resident_size;
+#else
+  // Second field of statm: resident pages
+  unsigned long long size = 0;
+  unsigned long long resident = 0;
+  FILE* const file = std::fopen("/proc/self/statm", "r");
+  if (file == nullptr) return 0;
+  const int32_t read = std::fscanf(file, "%llu %llu", &size, &resident);
+  std::fclose(file);
+  if (read != 2) return 0;
+  return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+uint64_t MemoryStats::getPeakResidentSetSize() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return counters.PeakWorkingSetSize;
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss;  // Bytes
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // KB
+#endif
+#endif
+}
+
+const MemoryStats::Phase& MemoryStats::addPhase(std::string_view name, Counts&& counts) {
+  Phase& phase = m_phases.emplace_back();
+  phase.m_name = name;
+  phase.m_residentSetSize = getResidentSetSize();
+  // The peak is sampled by the OS, at least the current size
+  phase.m_peakResidentSetSize = std::max(getPeakResidentSetSize(), phase.m_residentSetSize);
+  phase.m_counts = std::move(counts);
+  return phase;
+}
+
+std::string MemoryStats::toString(const Phase& phase) {
+  const auto toMB = [](uint64_t bytes) { return std::to_string((bytes + (1 << 19)) >> 20) + "MB"; };
+  std::string result = "Memory after " + phase.m_name + ": RSS " + toMB(phase.m_residentSetSize) + ", peak " +
+                       toMB(phase.m_peakResidentSetSize);
+  for (const auto& [name, bytes] : phase.m_counts) {
+    result.append(", ").append(name).append(" ").append(toMB(bytes));
+  }
+  result += "\n";
+  return result;
+}
+
+std::string MemoryStats::toJson() const {
+  nlohmann::json phases = nlohmann::json::array();
+  for (const Phase& phase : m_phases) {
+    nlohmann::json counts = nlohmann::json::object();
+    for (const auto& [name, bytes] : phase.m_counts) {
+      counts[std::string(name)] = bytes;
+    }
+    nlohmann::json entry;
+    entry["name"] = phase.m_name;
+    entry["rss"] = phase.m_residentSetSize;
+    entry["peak_rss"] = phase.m_peakResidentSetSize;
+    entry["counts"] = counts;
+    phases.emplace_back(entry);
+  }
+  nlohmann::json table;
+  table["phases"] = phases;
+  return table.dump(2);
+}
+
+}  // namespace SURELOG
@@ -0,0 +1,46 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Utils/MemoryStats.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace SURELOG {
+
+namespace {
+TEST(MemoryStatsTest, RecordsPhases) {
+  MemoryStats stats;
+  const MemoryStats::Phase& phase = stats.addPhase("Parse", {{"tokens", 3 * 1024 * 1024}, {"symbols", 100}});
+  EXPECT_EQ(phase.m_name, "Parse");
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+  EXPECT_GT(phase.m_residentSetSize, 0);
+#endif
+  EXPECT_GE(phase.m_peakResidentSetSize, phase.m_residentSetSize);
+
+  const std::string text = MemoryStats::toString(phase);
+  EXPECT_EQ(text.rfind("Memory after Parse: RSS ", 0), 0);
+  EXPECT_NE(text.find(", tokens 3MB, symbols 0MB\n"), std::string::npos);
+
+  stats.addPhase("Compile design", {});
+  ASSERT_EQ(stats.getPhases().size(), 2);
+  const std::string json = stats.toJson();
+  EXPECT_NE(json.find("\"name\": \"Compile design\""), std::string::npos);
+  EXPECT_NE(json.find("\"tokens\": 3145728"), std::string::npos);
+}
+}  // namespace
+}  // namespace SURELOG
@@ -0,0 +1,137 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+ */
+
+#include "Surelog/Utils/Tracer.h"
+
+#include <cstdio>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Surelog/Common/FileSystem.h"
+
+namespace SURELOG {
+
+static void appendJsonString(std::string& out, std::string_view text) {
+  out += '"';
+  for (const char c : text) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+          out += escaped;
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+Tracer::Span::Span(Tracer* tracer, std::string_view category, std::string_view name, std::string_view detail) {
+  if ((tracer == nullptr) || !tracer->enabled()) return;
+  m_tracer = tracer;
+  m_category = category;
+  m_name = name;
+  m_detail = detail;
+  m_begin = tracer->now();
+}
+
+void Tracer::Span::end() {
+  if (m_tracer == nullptr) return;
+  m_tracer->record(m_category, m_name, std::move(m_detail), m_begin);
+  m_tracer = nullptr;
+}
+
+Tracer::~Tracer() {
+  if (m_enabled && !m_written) write();
+}
+
+void Tracer::enable(FileSystem* fileSystem, PathId fileId) {
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  m_fileSystem = fileSystem;
+  m_fileId = fileId;
+  m_origin = std::chrono::steady_clock::now();
+  m_threadIndexes.emplace(std::this_thread::get_id(), 0);
+  m_enabled = true;
+}
+
+uint64_t Tracer::now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_origin).count();
+}
+
+void Tracer::record(std::string_view category, std::string_view name, std::string&& detail, uint64_t begin) {
+  const uint64_t end = now();
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  const uint32_t threadIndex =
+      m_threadIndexes.emplace(std::this_thread::get_id(), static_cast<uint32_t>(m_threadIndexes.size())).first->second;
+  m_events.emplace_back(Event{category, name, std::move(detail), begin, end - begin, threadIndex});
+}
+
+bool Tracer::write() {
+  if (!m_enabled) return false;
+  std::scoped_lock<std::mutex> lock(m_mutex);
+  m_written = true;
+
+  std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (uint32_t i = 0, n = m_threadIndexes.size(); i < n; ++i) {
+    out += "{\"ph\":\"M\",\"pid\":1,\"tid\":";
+    out += std::to_string(i);
+    out += ",\"name\":\"thread_name\",\"args\":{\"name\":";
+    appendJsonString(out, (i == 0) ? "main" : ("worker " + std::to_string(i)));
+    out += "}},\n";
+  }
+  for (const Event& event : m_events) {
+    out += "{\"ph\":\"X\",\"pid\":1,\"tid\":";
+    out += std::to_string(event.m_threadIndex);
+    out += ",\"ts\":";
+    out += std::to_string(event.m_begin);
+    out += ",\"dur\":";
+    out += std::to_string(event.m_duration);
+    out += ",\"cat\":";
+    appendJsonString(out, event.m_category);
+    out += ",\"name\":";
+    appendJsonString(out, event.m_name);
+    if (!event.m_detail.empty()) {
+      out += ",\"args\":{\"detail\":";
+      appendJsonString(out, event.m_detail);
+      out += '}';
+    }
+    out += "},\n";
+  }
+  // Metadata events always precede, so there is a trailing comma to drop
+  out.erase(out.size() - 2);
+  out += "\n]}\n";
+
+  std::ostream& strm = m_fileSystem->openForWrite(m_fileId);
+  if (!strm.good()) {
+    std::cerr << "Could not create trace file: " << PathIdPP(m_fileId, m_fileSystem) << std::endl;
+    return false;
+  }
+  strm << out << std::flush;
+  const bool result = !strm.fail();
+  m_fileSystem->close(strm);
+  return result;
+}
+
+}  // namespace SURELOG
@@ -0,0 +1,88 @@
+/*
+ Copyright 2019 Alain Dargelas
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "Surelog/Utils/Tracer.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "Surelog/Common/PlatformFileSystem.h"
+#include "Surelog/SourceCompile/SymbolTable.h"
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string readFile(const fs::path& filepath) {
+  std::ifstream strm(filepath);
+  return std::string((std::istreambuf_iterator<char>(strm)), std::istreambuf_iterator<char>());
+}
+
+TEST(TracerTest, DisabledRecordsNothing) {
+  Tracer tracer;
+  {
+    Tracer::Span span(&tracer, "file", "Parse", "a.sv");
+  }
+  Tracer::Span nullSpan(nullptr, "file", "Parse");
+  EXPECT_FALSE(tracer.enabled());
+  EXPECT_FALSE(tracer.write());
+}
+
+TEST(TracerTest, WritesSpansPerThread) {
+  const fs::path tracePath = fs::temp_directory_path() / "surelog_tracer_test" / "trace.json";
+  std::error_code ec;
+  fs::remove_all(tracePath.parent_path(), ec);
+  fs::create_directories(tracePath.parent_path(), ec);
+
+  PlatformFileSystem fileSystem(fs::current_path());
+  SymbolTable symbols;
+  Tracer tracer;
+  tracer.enable(&fileSystem, fileSystem.toPathId(tracePath.string(), &symbols));
+  {
+    Tracer::Span span(&tracer, "phase", "Parse");
+    std::thread worker([&tracer] { Tracer::Span fileSpan(&tracer, "file", "Parse", "dir\\\"quoted\".sv"); });
+    worker.join();
+  }
+  Tracer::Span endedSpan(&tracer, "cache", "Save parser cache");
+  endedSpan.end();
+  endedSpan.end();  // No second event
+  ASSERT_TRUE(tracer.write());
+
+  const std::string trace = readFile(tracePath);
+  EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+  EXPECT_NE(trace.find("\"tid\":0,\"name\":\"thread_name\",\"args\":{\"name\":\"main\"}"), std::string::npos);
+  EXPECT_NE(trace.find("\"tid\":1,\"name\":\"thread_name\",\"args\":{\"name\":\"worker 1\"}"), std::string::npos);
+  EXPECT_NE(trace.find("\"cat\":\"phase\",\"name\":\"Parse\"}"), std::string::npos);
+  EXPECT_NE(trace.find("\"cat\":\"file\",\"name\":\"Parse\",\"args\":{\"detail\":\"dir\\\\\\\"quoted\\\".sv\"}"),
+            std::string::npos);
+  size_t count = 0;
+  for (size_t pos = trace.find("\"ph\":\"X\""); pos != std::string::npos; pos = trace.find("\"ph\":\"X\"", pos + 1)) {
+    ++count;
+  }
+  EXPECT_EQ(count, 3);
+  EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+
+  fs::remove_all(tracePath.parent_path(), ec);
+}
+}  // namespace
+}  // namespace SURELOG